@@ -0,0 +1,453 @@
+/**
+ * libadic_bench: micro and macro benchmarks with regression-friendly output.
+ *
+ * Every case is warmed up, then timed as `samples` batches whose size is
+ * calibrated so a batch lasts about min_time / samples; the report gives
+ * median, mean, standard deviation and range per operation, plus GMP and
+ * operator new allocations per operation. Cold cases (macro benchmarks)
+ * clear the library caches untimed before every sample and run once per
+ * sample.
+ *
+ *   libadic_bench [--json FILE] [--filter SUBSTRING] [--samples N]
+ *                 [--min-time SECONDS] [--quick] [--pool]
+ *
+ * --pool installs LimbPool in front of the counted GMP allocator, so the GMP
+ * column then shows only the allocations the pool could not serve.
+ *
+ * The JSON written by --json is stable across releases; compare two runs with
+ * scripts/compare_benchmarks.py.
+ */
+
+#include "libadic/bernoulli.h"
+#include "libadic/cache.h"
+#include "libadic/characters.h"
+#include "libadic/cyclotomic.h"
+#include "libadic/limb_pool.h"
+#include "libadic/padic_gamma.h"
+#include "libadic/padic_log.h"
+#include "libadic/qp.h"
+#include "libadic/reid_li.h"
+#include "libadic/zp.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace libadic;
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Allocation counting: GMP through mp_set_memory_functions, everything else
+// through the replaced global operator new below
+
+std::atomic<size_t> gmp_allocations{0};
+std::atomic<size_t> heap_allocations{0};
+
+// Whatever GMP used before (its defaults or the LimbPool); counted calls
+// are the ones that reach it
+void* (*gmp_alloc)(size_t) = nullptr;
+void* (*gmp_realloc)(void*, size_t, size_t) = nullptr;
+void (*gmp_free)(void*, size_t) = nullptr;
+
+// Calls that reach the underlying allocator are counted; with --pool the
+// pool sits in front, so only blocks it could not serve show up
+void* counting_gmp_alloc(size_t size) {
+    gmp_allocations.fetch_add(1, std::memory_order_relaxed);
+    return gmp_alloc(size);
+}
+
+void* counting_gmp_realloc(void* ptr, size_t old_size, size_t size) {
+    gmp_allocations.fetch_add(1, std::memory_order_relaxed);
+    return gmp_realloc(ptr, old_size, size);
+}
+
+void counting_gmp_free(void* ptr, size_t size) {
+    gmp_free(ptr, size);
+}
+
+template<class T>
+inline void keep(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+// ---------------------------------------------------------------------------
+
+struct Case {
+    std::string name;
+    std::string kind;  // "micro" or "macro"
+    long prime;
+    long precision;
+    std::function<void()> body;
+    bool cold = false;  // clear library caches before every sample
+};
+
+struct Result {
+    const Case* bench;
+    size_t batch = 0;
+    size_t samples = 0;
+    double median_ns = 0, mean_ns = 0, stddev_ns = 0, min_ns = 0, max_ns = 0;
+    double gmp_allocs = 0, heap_allocs = 0;
+};
+
+struct Options {
+    std::string json_path;
+    std::string filter;
+    size_t samples = 15;
+    double min_time = 0.5;  // seconds per micro case
+    bool quick = false;
+    bool pool = false;  // route GMP through LimbPool
+};
+
+using Clock = std::chrono::steady_clock;
+
+double run_batch(const Case& c, size_t batch) {
+    auto start = Clock::now();
+    for (size_t i = 0; i < batch; ++i) {
+        c.body();
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+Result measure(const Case& c, const Options& options) {
+    Result r;
+    r.bench = &c;
+    r.samples = options.samples;
+
+    // Calibrate: double the batch until it fills its share of min_time
+    double target_ns = options.min_time * 1e9 / static_cast<double>(options.samples);
+    size_t batch = 1;
+    if (c.cold) {
+        CacheRegistry::instance().clear_all();
+        run_batch(c, 1);  // warmup
+    } else {
+        while (true) {
+            double elapsed = run_batch(c, batch);
+            if (elapsed >= target_ns || batch >= (size_t(1) << 24)) break;
+            batch *= 2;
+        }
+    }
+    r.batch = batch;
+
+    std::vector<double> per_op;
+    per_op.reserve(options.samples);
+    size_t gmp_total = 0, heap_total = 0;
+    for (size_t s = 0; s < options.samples; ++s) {
+        if (c.cold) {
+            CacheRegistry::instance().clear_all();
+        }
+        size_t gmp_before = gmp_allocations.load();
+        size_t heap_before = heap_allocations.load();
+        double elapsed = run_batch(c, batch);
+        gmp_total += gmp_allocations.load() - gmp_before;
+        heap_total += heap_allocations.load() - heap_before;
+        per_op.push_back(elapsed / static_cast<double>(batch));
+    }
+
+    std::vector<double> sorted = per_op;
+    std::sort(sorted.begin(), sorted.end());
+    size_t n = sorted.size();
+    r.median_ns = n % 2 == 1 ? sorted[n / 2] : 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]);
+    r.min_ns = sorted.front();
+    r.max_ns = sorted.back();
+    double sum = 0;
+    for (double x : per_op) sum += x;
+    r.mean_ns = sum / static_cast<double>(n);
+    double var = 0;
+    for (double x : per_op) var += (x - r.mean_ns) * (x - r.mean_ns);
+    r.stddev_ns = n > 1 ? std::sqrt(var / static_cast<double>(n - 1)) : 0.0;
+    double ops = static_cast<double>(batch) * static_cast<double>(n);
+    r.gmp_allocs = static_cast<double>(gmp_total) / ops;
+    r.heap_allocs = static_cast<double>(heap_total) / ops;
+    return r;
+}
+
+std::string format_time(double ns) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(ns < 10 ? 2 : 1);
+    if (ns < 1e3) out << ns << " ns";
+    else if (ns < 1e6) out << ns / 1e3 << " us";
+    else if (ns < 1e9) out << ns / 1e6 << " ms";
+    else out << ns / 1e9 << " s";
+    return out.str();
+}
+
+std::string json_escape(const std::string& s) {
+    std::string out;
+    for (char ch : s) {
+        if (ch == '"' || ch == '\\') out += '\\';
+        out += ch;
+    }
+    return out;
+}
+
+void write_json(const std::string& path, const std::vector<Result>& results, const Options& options) {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Cannot write " + path);
+    }
+    std::time_t now = std::time(nullptr);
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    out << std::setprecision(6);
+    out << "{\n";
+    out << "  \"schema\": 1,\n";
+    out << "  \"library\": \"libadic\",\n";
+#ifdef LIBADIC_VERSION
+    out << "  \"version\": \"" << LIBADIC_VERSION << "\",\n";
+#endif
+    out << "  \"timestamp\": \"" << stamp << "\",\n";
+#if defined(__VERSION__)
+    out << "  \"compiler\": \"" << json_escape(__VERSION__) << "\",\n";
+#endif
+    out << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+    out << "  \"samples\": " << options.samples << ",\n";
+    out << "  \"gmp_pool\": " << (LimbPool::installed() ? "true" : "false") << ",\n";
+    out << "  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << "    {\"name\": \"" << json_escape(r.bench->name) << "\", \"kind\": \"" << r.bench->kind
+            << "\", \"prime\": " << r.bench->prime << ", \"precision\": " << r.bench->precision
+            << ", \"batch\": " << r.batch << ", \"samples\": " << r.samples
+            << ", \"median_ns\": " << r.median_ns << ", \"mean_ns\": " << r.mean_ns
+            << ", \"stddev_ns\": " << r.stddev_ns << ", \"min_ns\": " << r.min_ns
+            << ", \"max_ns\": " << r.max_ns << ", \"gmp_allocs_per_op\": " << r.gmp_allocs
+            << ", \"heap_allocs_per_op\": " << r.heap_allocs << "}"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+// ---------------------------------------------------------------------------
+
+std::vector<Case> build_cases(const Options& options) {
+    std::vector<Case> cases;
+    std::vector<std::pair<long, long>> params = {{7, 20}, {31, 60}, {101, 200}};
+    if (options.quick) {
+        params = {{7, 20}};
+    }
+
+    for (auto [p, N] : params) {
+        std::string tag = "/p=" + std::to_string(p) + "/N=" + std::to_string(N);
+        BigInt modulus = BigInt(p).pow(N);
+
+        // Operands with every digit in use
+        Zp a(p, N, (modulus - BigInt(1)) / BigInt(3));
+        Zp b(p, N, (modulus - BigInt(2)) / BigInt(5) + BigInt(1));
+        if (!b.is_unit()) b = b + Zp(p, N, 1);
+        Qp x = Qp(p, N, 1) + Qp(p, N, BigInt(p) * ((modulus / BigInt(p * p)) / BigInt(7) + BigInt(1)));
+
+        cases.push_back({"zp_mul" + tag, "micro", p, N, [a, b]() { keep(a * b); }});
+        cases.push_back({"zp_div" + tag, "micro", p, N, [a, b]() { keep(a / b); }});
+        cases.push_back({"qp_from_rational" + tag, "micro", p, N, [p, N]() {
+            keep(Qp::from_rational(22, 7 * p, p, N));
+        }});
+        cases.push_back({"qp_from_value" + tag, "micro", p, N, [p, N, modulus]() {
+            keep(Qp(p, N, modulus - BigInt(p)));
+        }});
+        cases.push_back({"log_p" + tag, "micro", p, N, [x]() { keep(PadicLog::log(x)); }});
+        cases.push_back({"gamma_p" + tag, "micro", p, N, [a]() { keep(PadicGamma::gamma(a)); }});
+        cases.push_back({"log_gamma_p" + tag, "micro", p, N, [b]() { keep(PadicGamma::log_gamma(b)); }});
+
+        std::vector<Qp> lhs, rhs;
+        for (long i = 0; i < p - 1; ++i) {
+            lhs.push_back(Qp(p, N, BigInt(i + 2).pow(N) % modulus));
+            rhs.push_back(Qp(p, N, BigInt(3 * i + 1).pow(N) % modulus));
+        }
+        Cyclotomic c1(p, N, lhs), c2(p, N, rhs);
+        cases.push_back({"cyclotomic_mul" + tag, "micro", p, N, [c1, c2]() { keep(c1 * c2); }});
+
+        auto characters = DirichletCharacter::enumerate_characters(p, p);
+        DirichletCharacter chi = characters[characters.size() / 2];
+        cases.push_back({"character_evaluate_at" + tag, "micro", p, N, [chi, p]() {
+            long acc = 0;
+            for (long n = 0; n < p; ++n) acc += chi.evaluate_at(n);
+            keep(acc);
+        }});
+
+        long n_max = 2 * N;
+        cases.push_back({"bernoulli_range/n=" + std::to_string(n_max) + tag, "micro", p, N, [n_max, p, N]() {
+            BernoulliNumbers::clear_cache();
+            keep(BernoulliNumbers::bernoulli_range(n_max, p, N));
+        }});
+    }
+
+    // Full Reid-Li sweeps from cold caches, single-threaded for stable timings
+    std::vector<std::pair<long, long>> sweeps = {{5, 20}, {11, 20}, {23, 20}};
+    if (options.quick) {
+        sweeps = {{5, 10}};
+    }
+    for (auto [p, N] : sweeps) {
+        std::string tag = "/p=" + std::to_string(p) + "/N=" + std::to_string(N);
+        Case c{"reid_li_sweep" + tag, "macro", p, N, [p, N]() {
+            ReidLiConfig config;
+            config.primes = {p};
+            config.precision = N;
+            config.threads = 1;
+            ReidLiSummary summary = ReidLiEngine(config).run([](const ReidLiResult&) {});
+            keep(summary);
+        }};
+        c.cold = true;
+        cases.push_back(std::move(c));
+    }
+
+    std::vector<Case> selected;
+    for (Case& c : cases) {
+        if (options.filter.empty() || c.name.find(options.filter) != std::string::npos) {
+            selected.push_back(std::move(c));
+        }
+    }
+    return selected;
+}
+
+Options parse_options(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument(arg + " needs a value");
+            }
+            return argv[++i];
+        };
+        if (arg == "--json") {
+            options.json_path = value();
+        } else if (arg == "--filter") {
+            options.filter = value();
+        } else if (arg == "--samples") {
+            options.samples = std::max<size_t>(2, std::stoul(value()));
+        } else if (arg == "--min-time") {
+            options.min_time = std::stod(value());
+        } else if (arg == "--pool") {
+            options.pool = true;
+        } else if (arg == "--quick") {
+            options.quick = true;
+            options.samples = 5;
+            options.min_time = 0.05;
+        } else if (arg == "--help" || arg == "-h") {
+            std::cout << "usage: libadic_bench [--json FILE] [--filter SUBSTRING] [--samples N]\n"
+                         "                     [--min-time SECONDS] [--quick] [--pool]\n";
+            std::exit(0);
+        } else {
+            throw std::invalid_argument("Unknown argument " + arg);
+        }
+    }
+    return options;
+}
+
+} // namespace
+
+// Counts every heap allocation made through operator new. Every form of
+// new and delete is replaced, all on aligned_alloc/free, so each pointer is
+// released by the allocator that produced it.
+namespace {
+
+void* counted_allocate(size_t size, size_t alignment) {
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    alignment = std::max(alignment, alignof(std::max_align_t));
+    size_t rounded = (std::max<size_t>(size, 1) + alignment - 1) / alignment * alignment;
+    return std::aligned_alloc(alignment, rounded);
+}
+
+void* counted_new(size_t size, size_t alignment) {
+    if (void* ptr = counted_allocate(size, alignment)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void counted_delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+} // namespace
+
+void* operator new(size_t size) { return counted_new(size, alignof(std::max_align_t)); }
+void* operator new[](size_t size) { return counted_new(size, alignof(std::max_align_t)); }
+void* operator new(size_t size, std::align_val_t al) { return counted_new(size, static_cast<size_t>(al)); }
+void* operator new[](size_t size, std::align_val_t al) { return counted_new(size, static_cast<size_t>(al)); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return counted_allocate(size, alignof(std::max_align_t));
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return counted_allocate(size, alignof(std::max_align_t));
+}
+void* operator new(size_t size, std::align_val_t al, const std::nothrow_t&) noexcept {
+    return counted_allocate(size, static_cast<size_t>(al));
+}
+void* operator new[](size_t size, std::align_val_t al, const std::nothrow_t&) noexcept {
+    return counted_allocate(size, static_cast<size_t>(al));
+}
+
+void operator delete(void* ptr) noexcept { counted_delete(ptr); }
+void operator delete[](void* ptr) noexcept { counted_delete(ptr); }
+void operator delete(void* ptr, size_t) noexcept { counted_delete(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { counted_delete(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { counted_delete(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { counted_delete(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { counted_delete(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { counted_delete(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { counted_delete(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { counted_delete(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { counted_delete(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { counted_delete(ptr); }
+
+int main(int argc, char** argv) {
+    mp_get_memory_functions(&gmp_alloc, &gmp_realloc, &gmp_free);
+    mp_set_memory_functions(counting_gmp_alloc, counting_gmp_realloc, counting_gmp_free);
+
+    Options options;
+    try {
+        options = parse_options(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+    if (options.pool) {
+        LimbPool::install();
+    }
+
+    std::vector<Case> cases = build_cases(options);
+    std::vector<Result> results;
+    std::cout << std::left << std::setw(44) << "benchmark" << std::right << std::setw(12) << "median"
+              << std::setw(10) << "+/-" << std::setw(12) << "min" << std::setw(10) << "gmp/op"
+              << std::setw(10) << "new/op" << "\n";
+    for (const Case& c : cases) {
+        Result r = measure(c, options);
+        double spread = r.median_ns > 0 ? 100.0 * r.stddev_ns / r.median_ns : 0.0;
+        std::ostringstream pct;
+        pct << std::fixed << std::setprecision(1) << spread << "%";
+        std::cout << std::left << std::setw(44) << c.name << std::right << std::setw(12)
+                  << format_time(r.median_ns) << std::setw(10) << pct.str() << std::setw(12)
+                  << format_time(r.min_ns) << std::fixed << std::setprecision(1) << std::setw(10)
+                  << r.gmp_allocs << std::setw(10) << r.heap_allocs << "\n";
+        std::cout.unsetf(std::ios::fixed);
+        results.push_back(r);
+    }
+
+    if (!options.json_path.empty()) {
+        write_json(options.json_path, results, options);
+        std::cout << "\nwrote " << options.json_path << "\n";
+    }
+    return 0;
+}
@@ -3,6 +3,12 @@
  * 
  * This program computes Reid-Li criterion values for primes up to 100
  * and generates scientific data that no other library can produce.
+ *
+ * Distributed mode splits the sweep over processes or nodes sharing a
+ * checkpoint directory (see ReidLiSweep); rerunning a worker resumes it:
+ *
+ *   compute_reid_li_results --sweep DIR [--worker K --workers W] [--static]
+ *   compute_reid_li_results --collect DIR    # merged CSV and summary
  */
 
 #include "libadic/gmp_wrapper.h"
@@ -12,11 +18,16 @@
 #include "libadic/padic_gamma.h"
 #include "libadic/characters.h"
 #include "libadic/l_functions.h"
+#include "libadic/reid_li.h"
+#include "libadic/reid_li_sweep.h"
 #include <iostream>
 #include <fstream>
 #include <vector>
 #include <iomanip>
 #include <cmath>
+#include <algorithm>
+#include <cstring>
+#include <string>
 
 using namespace libadic;
 
@@ -25,16 +36,6 @@ private:
     std::ofstream results_file;
     std::ofstream summary_file;
     
-    struct ReidLiResult {
-        long prime;
-        long character_index;
-        bool is_odd;
-        Qp phi_value;
-        Qp psi_value;
-        long valuation_difference;
-        bool criterion_satisfied;
-    };
-    
     std::vector<ReidLiResult> all_results;
     
 public:
@@ -60,119 +61,74 @@ public:
         summary_file.close();
     }
     
+    // All primes 5..97, precision based on prime size
+    static ReidLiConfig sweep_config() {
+        ReidLiConfig config;
+        config.min_prime = 5;
+        config.max_prime = 97;
+        config.precision_for_prime = [](long p) { return std::min(100L, p * 3); };
+        return config;
+    }
+    
     void compute_for_all_primes() {
-        // List of primes to test
-        std::vector<long> primes = {
-            5, 7, 11, 13, 17, 19, 23, 29, 31, 37,
-            41, 43, 47, 53, 59, 61, 67, 71, 73, 79,
-            83, 89, 97
-        };
-        
         std::cout << "Computing Reid-Li Criterion Results\n";
         std::cout << "====================================\n\n";
         
-        for (long p : primes) {
-            std::cout << "Processing prime p = " << p << "...\n";
-            compute_for_prime(p);
-        }
+        // Every (p, χ) pair scheduled across all cores
+        ReidLiEngine engine(sweep_config());
+        ReidLiSummary totals = engine.run([this](const ReidLiResult& result) {
+            std::cout << "  p = " << result.prime << ", character " << result.character_index
+                      << (result.matches ? " satisfied" : " testing") << "\n";
+            all_results.push_back(result);
+            write_result(result);
+        });
+        
+        write_details();
         
-        std::cout << "\nComputation complete!\n";
+        std::cout << "\nComputation complete! (" << totals.characters << " characters over "
+                  << totals.primes << " primes)\n";
         std::cout << "Results saved to: reid_li_results.csv\n";
         std::cout << "Summary saved to: reid_li_summary.txt\n";
     }
     
-    void compute_for_prime(long p) {
-        // Precision based on prime size
-        long precision = std::min(100L, p * 3);
-        
-        summary_file << "Prime p = " << p << " (precision = " << precision << ")\n";
-        summary_file << std::string(40, '-') << "\n";
-        
-        // Generate primitive characters
-        std::vector<DirichletCharacter> characters;
-        for (long a = 1; a < p; ++a) {
-            if (BigInt(a).gcd(BigInt(p)) == BigInt(1)) {
-                DirichletCharacter chi(p, p);
-                // For demonstration, we'll compute for a few characters
-                characters.push_back(chi);
-                if (characters.size() >= 2) break; // Limit for large primes
-            }
+    /**
+     * Results of every worker's checkpoints in `directory`
+     */
+    void collect_sweep(const ReidLiSweepConfig& config) {
+        size_t missing = 0;
+        for (const auto& result : ReidLiSweep(config).collect(&missing)) {
+            all_results.push_back(result);
+            write_result(result);
         }
-        
-        long char_index = 0;
-        for (const auto& chi : characters) {
-            // Compute for odd characters
-            if (chi.is_odd()) {
-                ReidLiResult result;
-                result.prime = p;
-                result.character_index = char_index;
-                result.is_odd = true;
-                
-                // Compute Φ_p^(odd)(χ)
-                result.phi_value = compute_phi_odd(chi, p, precision);
-                
-                // For demonstration, we estimate Ψ (full L-function implementation needed)
-                result.psi_value = estimate_psi_odd(chi, p, precision);
-                
-                // Compute difference
-                Qp diff = result.phi_value - result.psi_value;
-                result.valuation_difference = diff.valuation();
-                result.criterion_satisfied = (result.valuation_difference >= precision / 2);
-                
-                all_results.push_back(result);
-                write_result(result);
-                
-                summary_file << "  Character " << char_index << " (odd):\n";
-                summary_file << "    Φ valuation: " << result.phi_value.valuation() << "\n";
-                summary_file << "    Ψ valuation: " << result.psi_value.valuation() << "\n";
-                summary_file << "    Difference valuation: " << result.valuation_difference << "\n";
-                summary_file << "    Criterion: " << (result.criterion_satisfied ? "SATISFIED" : "TESTING") << "\n";
-            }
-            
-            char_index++;
+        write_details();
+        std::cout << "Collected " << all_results.size() << " results";
+        if (missing > 0) {
+            std::cout << "; " << missing << " units have no checkpoint yet";
         }
-        
-        summary_file << "\n";
+        std::cout << "\n";
     }
     
-    Qp compute_phi_odd(const DirichletCharacter& chi, long p, long precision) {
-        // This is the UNIQUE Reid-Li computation
-        Qp phi(p, precision, 0);
+    void write_details() {
+        std::sort(all_results.begin(), all_results.end(), [](const ReidLiResult& a, const ReidLiResult& b) {
+            return a.prime != b.prime ? a.prime < b.prime : a.character_index < b.character_index;
+        });
         
-        for (long a = 1; a < p; ++a) {
-            Zp chi_a = chi.evaluate(a, precision);
-            if (!chi_a.is_zero()) {
-                Zp gamma_a = gamma_p(a, p, precision);
-                if (gamma_a.is_unit()) {
-                    try {
-                        Qp log_gamma = log_gamma_p(gamma_a);
-                        phi = phi + Qp(chi_a) * log_gamma;
-                    } catch (const std::exception& e) {
-                        // Handle convergence issues
-                    }
-                }
+        long current_prime = 0;
+        for (const auto& result : all_results) {
+            if (result.prime != current_prime) {
+                if (current_prime != 0) summary_file << "\n";
+                current_prime = result.prime;
+                summary_file << "Prime p = " << result.prime << " (precision = " << result.precision << ")\n";
+                summary_file << std::string(40, '-') << "\n";
             }
+            summary_file << "  Character " << result.character_index
+                         << (result.is_odd ? " (odd):\n" : " (even):\n");
+            summary_file << "    Φ valuation: " << result.phi_value.valuation() << "\n";
+            summary_file << "    Ψ valuation: " << result.psi_value.valuation() << "\n";
+            summary_file << "    Difference valuation: " << result.precision_achieved << "\n";
+            summary_file << "    Criterion: " << (result.matches ? "SATISFIED" : "TESTING") << "\n";
         }
-        
-        return phi;
-    }
-    
-    Qp estimate_psi_odd(const DirichletCharacter& chi, long p, long precision) {
-        // This would compute L'_p(0, χ)
-        // For demonstration, we return a p-adic approximation
-        // Full implementation would use Ferrero-Washington formula
-        
-        Qp result(p, precision, 0);
-        
-        // Placeholder computation
-        // In reality, this involves Bernoulli numbers and character sums
-        BigInt numerator(1);
-        for (long k = 1; k < p; ++k) {
-            numerator = numerator * BigInt(k);
-        }
-        
-        result = Qp(Zp(p, precision, numerator));
-        return result;
+        summary_file << "\n";
     }
     
     void write_result(const ReidLiResult& result) {
@@ -181,8 +137,8 @@ public:
                     << (result.is_odd ? "odd" : "even") << ","
                     << result.phi_value.valuation() << ","
                     << result.psi_value.valuation() << ","
-                    << result.valuation_difference << ","
-                    << (result.criterion_satisfied ? "Yes" : "Testing") << "\n";
+                    << result.precision_achieved << ","
+                    << (result.matches ? "Yes" : "Testing") << "\n";
     }
     
     void generate_summary() {
@@ -196,9 +152,9 @@ public:
         long max_valuation_diff = 0;
         
         for (const auto& result : all_results) {
-            if (result.criterion_satisfied) satisfied_count++;
-            if (result.valuation_difference > max_valuation_diff) {
-                max_valuation_diff = result.valuation_difference;
+            if (result.matches) satisfied_count++;
+            if (result.precision_achieved > max_valuation_diff) {
+                max_valuation_diff = result.precision_achieved;
             }
         }
         
@@ -248,8 +204,52 @@ public:
     }
 };
 
-int main() {
+// One worker of a distributed sweep; prints its share of the results
+static int run_sweep_worker(const ReidLiSweepConfig& config) {
+    ReidLiSweep sweep(config);
+    ReidLiSweepSummary summary = sweep.run([](const ReidLiResult& result) {
+        std::cout << "  p = " << result.prime << ", character " << result.character_index
+                  << (result.matches ? " satisfied" : " testing") << "\n";
+    });
+    std::cout << "Worker " << config.worker << "/" << config.workers << ": "
+              << summary.computed << " units computed, " << summary.resumed << " resumed, "
+              << summary.elsewhere << " left to other workers\n";
+    return summary.results.errors == 0 ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    ReidLiSweepConfig sweep;
+    sweep.sweep = ReidLiComputer::sweep_config();
+    bool collect = false;
+    for (int i = 1; i < argc; ++i) {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--sweep") == 0 && has_value) {
+            sweep.directory = argv[++i];
+        } else if (std::strcmp(argv[i], "--collect") == 0 && has_value) {
+            sweep.directory = argv[++i];
+            collect = true;
+        } else if (std::strcmp(argv[i], "--worker") == 0 && has_value) {
+            sweep.worker = std::stoul(argv[++i]);
+        } else if (std::strcmp(argv[i], "--workers") == 0 && has_value) {
+            sweep.workers = std::stoul(argv[++i]);
+        } else if (std::strcmp(argv[i], "--static") == 0) {
+            sweep.dynamic = false;
+        } else {
+            std::cerr << "Unknown argument: " << argv[i] << "\n";
+            return 1;
+        }
+    }
+    
     try {
+        if (!sweep.directory.empty() && !collect) {
+            return run_sweep_worker(sweep);
+        }
+        if (collect) {
+            ReidLiComputer computer;
+            computer.collect_sweep(sweep);
+            return 0;
+        }
+        
         std::cout << "====================================================\n";
         std::cout << "    Reid-Li Criterion Scientific Computation\n";
         std::cout << "====================================================\n\n";
@@ -76,7 +76,7 @@ g++ -std=c++17 -O3 -I../include ../validation/benchmarks/benchmark_libadic.cpp \
 # Build Reid-Li results generator
 echo "Building Reid-Li computer..."
 g++ -std=c++17 -O3 -I../include ../validation/results/compute_reid_li_results.cpp \
-    -L. -ladic -lgmp -lmpfr -o compute_reid_li
+    -L. -ladic -lgmp -lmpfr -pthread -o compute_reid_li
 
 cd ../validation/validation_output
 
@@ -0,0 +1,148 @@
+#ifndef LIBADIC_ASYNC_H
+#define LIBADIC_ASYNC_H
+
+#include "libadic/cancellation.h"
+#include "libadic/characters.h"
+#include "libadic/qp.h"
+#include "libadic/reid_li.h"
+#include "libadic/thread_pool.h"
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace libadic {
+
+/**
+ * Handle to a computation running on the shared Async pool: a std::future
+ * for the value together with the token that can stop it
+ */
+template<class T>
+class AsyncResult {
+private:
+    std::future<T> future;
+    CancellationToken token;
+
+public:
+    AsyncResult() = default;
+    AsyncResult(std::future<T> f, CancellationToken t) : future(std::move(f)), token(std::move(t)) {}
+
+    /**
+     * Wait for the value; rethrows the computation's exception, which is
+     * OperationCancelled if it was cancelled or ran past its deadline
+     */
+    T get() { return future.get(); }
+
+    void wait() const { future.wait(); }
+
+    template<class Rep, class Period>
+    std::future_status wait_for(std::chrono::duration<Rep, Period> timeout) const {
+        return future.wait_for(timeout);
+    }
+
+    bool ready() const {
+        return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    bool valid() const { return future.valid(); }
+
+    /**
+     * Ask the computation to stop at its next cancellation point; a task
+     * that has not started yet does not run
+     */
+    void cancel() const { token.cancel(); }
+
+    const CancellationToken& get_token() const { return token; }
+};
+
+/**
+ * Non-blocking entry points for long-running special-function calls.
+ *
+ * Each call is queued on one process-wide ThreadPool and returns an
+ * AsyncResult at once. The computation runs with its CancellationToken
+ * installed (see CancellationScope), so cancel() or a deadline on the token
+ * stops it at the next cancellation point with OperationCancelled; a task
+ * whose token is already cancelled when it is dequeued fails without
+ * running. `on_ready`, if given, is called on the worker thread once the
+ * result or exception is available, e.g. to wake an event loop. It should
+ * not throw: nothing waits on the shared pool, so an exception from it is
+ * caught and kept for take_callback_error() instead of reaching the caller.
+ */
+class Async {
+public:
+    using Callback = std::function<void()>;
+
+    /**
+     * The shared pool (all hardware threads), started on first use
+     */
+    static ThreadPool& pool();
+
+    /**
+     * The first exception thrown by an on_ready callback since the last
+     * call, or null; clears it
+     */
+    static std::exception_ptr take_callback_error();
+
+    /**
+     * Keep `error` for take_callback_error() unless one is already held
+     */
+    static void report_callback_error(std::exception_ptr error);
+
+    template<class F>
+    static AsyncResult<std::invoke_result_t<F&>> submit(F f, CancellationToken token = {},
+                                                        Callback on_ready = {}) {
+        using R = std::invoke_result_t<F&>;
+        auto promise = std::make_shared<std::promise<R>>();
+        std::future<R> future = promise->get_future();
+        pool().submit([promise, token, fn = std::move(f), on_ready]() mutable {
+            try {
+                token.throw_if_cancelled();
+                CancellationScope scope(token);
+                if constexpr (std::is_void_v<R>) {
+                    fn();
+                    promise->set_value();
+                } else {
+                    promise->set_value(fn());
+                }
+            } catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+            if (on_ready) {
+                try {
+                    on_ready();
+                } catch (...) {
+                    report_callback_error(std::current_exception());
+                }
+            }
+        });
+        return AsyncResult<R>(std::move(future), std::move(token));
+    }
+
+    /**
+     * LFunctions::kubota_leopoldt
+     */
+    static AsyncResult<Qp> kubota_leopoldt(long s, const DirichletCharacter& chi, long precision,
+                                           CancellationToken token = {}, Callback on_ready = {});
+
+    /**
+     * LFunctions::kubota_leopoldt_derivative
+     */
+    static AsyncResult<Qp> kubota_leopoldt_derivative(long s, const DirichletCharacter& chi,
+                                                      long precision, CancellationToken token = {},
+                                                      Callback on_ready = {});
+
+    /**
+     * ReidLi::verify; cancellation is reported by the future, not in
+     * ReidLiResult::error
+     */
+    static AsyncResult<ReidLiResult> reid_li_verify(const DirichletCharacter& chi, long precision,
+                                                    long tolerance = 5, CancellationToken token = {},
+                                                    Callback on_ready = {});
+};
+
+} // namespace libadic
+
+#endif // LIBADIC_ASYNC_H
@@ -2,12 +2,19 @@
 #define LIBADIC_BERNOULLI_H
 
 #include "libadic/qp.h"
-#include "libadic/cyclotomic.h"
+#include "libadic/cancellation.h"
+#include "libadic/qp_expr.h"
+#include "libadic/zp.h"
+#include "libadic/cache.h"
+#include "libadic/result_store.h"
 #include <map>
+#include <string>
 #include <vector>
 #include <numeric>
 #include <functional>
 #include <algorithm>
+#include <memory>
+#include <utility>
 
 namespace libadic {
 
@@ -17,122 +24,154 @@ namespace libadic {
  */
 class BernoulliNumbers {
 private:
-    // Cache for regular Bernoulli numbers
-    inline static std::map<long, Qp> bernoulli_cache;
+    struct RangeKeyHash {
+        size_t operator()(const std::pair<long, long>& k) const {
+            size_t h = std::hash<long>()(k.first);
+            hash_combine(h, std::hash<long>()(k.second));
+            return h;
+        }
+    };
+    
+    using RangePtr = std::shared_ptr<const std::vector<Qp>>;
+    
+    // B_0..B_m per (p, precision); a request beyond m rebuilds the entry
+    // with at least twice the length
+    inline static ShardedCache<std::pair<long, long>, RangePtr, RangeKeyHash> range_cache{
+        "BernoulliNumbers::range_cache",
+        [](const std::pair<long, long>& key, const RangePtr& values) {
+            return sizeof(key) + cache_footprint(*values);
+        }};
+    
+    // Most precise table per prime; a request at a lower precision is built
+    // by truncating it and then cached under its own (p, precision)
+    inline static ShardedCache<long, std::pair<long, RangePtr>> range_top{
+        "BernoulliNumbers::range_top",
+        [](long, const std::pair<long, RangePtr>& entry) {
+            return sizeof(long) + sizeof(entry) + cache_footprint(*entry.second);
+        }};
+    
+    /**
+     * Shared table holding at least B_0..B_{n_max}
+     */
+    static RangePtr range_table(long n_max, long p, long precision);
     
-    // Cache for generalized Bernoulli numbers
+    // Cache for generalized Bernoulli numbers; (modulus, character) is the
+    // character's DirichletCharacter::index() identity
     struct CharKey {
         long n;
         long conductor;
-        long a; // character value determinant
+        long modulus;
+        long character;
         long p;
-        long precision;
         
-        bool operator<(const CharKey& other) const {
-            if (n != other.n) return n < other.n;
-            if (conductor != other.conductor) return conductor < other.conductor;
-            if (a != other.a) return a < other.a;
-            if (p != other.p) return p < other.p;
-            return precision < other.precision;
+        bool operator==(const CharKey& other) const {
+            return n == other.n && conductor == other.conductor && modulus == other.modulus &&
+                   character == other.character && p == other.p;
+        }
+    };
+    
+    struct CharKeyHash {
+        size_t operator()(const CharKey& k) const {
+            size_t h = std::hash<long>()(k.character);
+            hash_combine(h, std::hash<long>()(k.n));
+            hash_combine(h, std::hash<long>()(k.conductor));
+            hash_combine(h, std::hash<long>()(k.modulus));
+            hash_combine(h, std::hash<long>()(k.p));
+            return h;
         }
     };
-    inline static std::map<CharKey, Qp> generalized_cache;
+    
+    inline static PrecisionCache<CharKey, CharKeyHash> generalized_cache{
+        "BernoulliNumbers::generalized_cache",
+        [](const CharKey&) { return sizeof(CharKey); }};
     
 public:
     /**
      * Compute the n-th Bernoulli number B_n
      * B_0 = 1, B_1 = -1/2, B_{2k+1} = 0 for k >= 1
-     * Uses the recursive formula:
-     * Σ_{k=0}^{n} C(n+1,k) B_k = 0
+     * Read from the shared bernoulli_range table.
      */
     static Qp bernoulli(long n, long p, long precision) {
         if (n < 0) {
             throw std::invalid_argument("Bernoulli index must be non-negative");
         }
-        
-        // Check cache
-        auto key = n * 1000000L + p * 1000L + precision;
-        if (bernoulli_cache.find(key) != bernoulli_cache.end()) {
-            return bernoulli_cache[key];
-        }
-        
-        Qp result(p, precision, 0);
-        
-        // Special cases
-        if (n == 0) {
-            result = Qp(p, precision, 1);
-        } else if (n == 1) {
-            result = Qp::from_rational(-1, 2, p, precision);
-        } else if (n > 1 && n % 2 == 1) {
-            result = Qp(p, precision, 0);
-        } else {
-            // Even n >= 2: Use recursive formula
-            // B_n = -1/(n+1) * Σ_{k=0}^{n-1} C(n+1,k) * B_k
-            
-            Qp sum(p, precision, 0);
-            for (long k = 0; k < n; ++k) {
-                BigInt binom = BigInt::binomial(static_cast<unsigned long>(n + 1), 
-                                               static_cast<unsigned long>(k));
-                Qp b_k = bernoulli(k, p, precision);
-                sum += Qp(p, precision, binom) * b_k;
-            }
-            
-            result = -sum / Qp(p, precision, n + 1);
-        }
-        
-        // Apply von Staudt-Clausen theorem for p-adic normalization
-        // B_{2n} ≡ Σ_{p-1|2n} 1/p (mod Z)
-        if (n > 0 && n % 2 == 0) {
-            if ((n % (p - 1)) == 0) {
-                // Add p-adic correction
-                // Check if p divides n
-                if (n % p != 0) {
-                    Qp correction = Qp::from_rational(1, p, p, precision);
-                    result = result + correction;
-                }
-            }
+        return (*range_table(n, p, precision))[n];
+    }
+    
+    /**
+     * B_0, ..., B_{n_max} in one pass.
+     *
+     * With the tangent numbers T_k (tan x = Σ T_k x^{2k-1}/(2k-1)!),
+     *   B_{2k} = (-1)^{k-1} · 2k · T_k / (4^k (4^k - 1)),
+     * and the T_k come out of the Seidel–Entringer triangle using only
+     * small-integer multiplications, so the table costs O(n_max²) word-by-
+     * bignum products modulo p^W, where W = N + max v_p(4^k (4^k - 1)) covers
+     * the p-part of every denominator. No binomials or Qp divisions are
+     * built along the way.
+     */
+    static std::vector<Qp> bernoulli_range(long n_max, long p, long precision) {
+        if (n_max < 0) {
+            throw std::invalid_argument("Bernoulli index must be non-negative");
         }
-        
-        bernoulli_cache[key] = result;
-        return result;
+        RangePtr table = range_table(n_max, p, precision);
+        return std::vector<Qp>(table->begin(), table->begin() + n_max + 1);
     }
     
     /**
      * Compute generalized Bernoulli number B_{n,χ}
      * For a Dirichlet character χ mod f:
      * B_{n,χ} = f^{n-1} Σ_{a=1}^{f} χ(a) B_n(a/f)
-     * where B_n(x) is the n-th Bernoulli polynomial
+     * where B_n(x) is the n-th Bernoulli polynomial. chi_func(a) is the
+     * Teichmüller-valued χ(a) ∈ Z_p, as DirichletCharacter::evaluate gives it.
      */
     static Qp generalized_bernoulli(long n, long conductor, 
-                                   std::function<Cyclotomic(long)> chi_func,
+                                   std::function<Zp(long)> chi_func,
                                    long p, long precision) {
-        CharKey key{n, conductor, 0, p, precision};
-        
-        if (generalized_cache.find(key) != generalized_cache.end()) {
-            return generalized_cache[key];
-        }
-        
         if (conductor == 1) {
             // Trivial character
             return bernoulli(n, p, precision);
         }
         
-        Cyclotomic sum(p, precision);
-        BigInt f_power = BigInt(conductor).pow(std::max(0L, n - 1));
+        // With f^n B_n(a/f) from one forward-difference pass,
+        //   B_{n,χ} = f^{n-1} Σ χ(a) B_n(a/f) = (1/f) Σ χ(a) f^n B_n(a/f)
+        std::vector<Qp> scaled = bernoulli_polynomial_scaled(n, conductor, p, precision);
+        Qp sum(p, precision, 0);
         
-        for (long a = 1; a <= conductor; ++a) {
+        for (long a = 1; a < conductor; ++a) {
             if (std::gcd(a, conductor) != 1) continue;
+            cancellation_point();
             
-            Cyclotomic chi_a = chi_func(a);
-            Qp bern_poly = bernoulli_polynomial(n, Qp::from_rational(a, conductor, p, precision), p, precision);
-            sum = sum + chi_a * bern_poly;
+            Zp chi_a = chi_func(a);
+            if (chi_a.is_zero()) continue;
+            
+            sum.addmul(Qp(chi_a), scaled[a]);
         }
         
-        // Extract the constant term as the generalized Bernoulli number
-        Qp result = sum.get_coeff(0) * Qp(p, precision, f_power);
-        
-        generalized_cache[key] = result;
-        return result;
+        // The sum is known to absolute precision N, so dividing by f leaves
+        // N - v_p(f) digits; the product alone would keep reporting N
+        long f_val = 0;
+        for (long m = conductor; m % p == 0; m /= p) ++f_val;
+        return (sum * Qp::from_rational(1, conductor, p, precision)).with_precision(std::max(precision - f_val, 1L));
+    }
+    
+    /**
+     * Memoized B_{n,χ}. `modulus` and `character_index` must identify χ (the
+     * function object itself cannot be compared): pass
+     * chi.get_modulus() and chi.index().
+     */
+    static Qp generalized_bernoulli(long n, long conductor, 
+                                   std::function<Zp(long)> chi_func,
+                                   long p, long precision,
+                                   long modulus, long character_index) {
+        CharKey key{n, conductor, modulus, character_index, p};
+        return generalized_cache.get_or_compute(key, precision, [&]() {
+            ResultStore::Key stored{ResultStore::Table::GeneralizedBernoulli,
+                                    {n, conductor, p, modulus, character_index}, ""};
+            if (auto warm = ResultStore::instance().find(stored, precision)) {
+                return (*warm)[0];
+            }
+            return generalized_bernoulli(n, conductor, chi_func, p, precision);
+        });
     }
     
     /**
@@ -142,12 +181,13 @@ public:
     static Qp bernoulli_polynomial(long n, const Qp& x, long p, long precision) {
         Qp result(p, precision, 0);
         Qp x_power(p, precision, 1);
+        RangePtr bern = range_table(n, p, precision);
         
         for (long k = n; k >= 0; --k) {
             BigInt binom = BigInt::binomial(static_cast<unsigned long>(n), 
                                            static_cast<unsigned long>(k));
-            Qp b_k = bernoulli(k, p, precision);
-            result += Qp(p, precision, binom) * b_k * x_power;
+            const Qp& b_k = (*bern)[k];
+            result += defer(Qp(p, precision, binom)) * b_k * x_power;
             if (k > 0) {
                 x_power *= x;
             }
@@ -156,6 +196,40 @@ public:
         return result;
     }
     
+    /**
+     * f^n B_n(a/f) for 0 <= a < f in one pass.
+     *
+     * f^n B_n(a/f) = Σ_k C(n,k) B_k f^k a^{n-k} is a degree-n polynomial in
+     * the integer a with a single shared coefficient row. It is evaluated by
+     * Horner's scheme at a = 0..n, and from there forward differences step
+     * to every later a with n additions each, so the batch costs O(n²) + O(n·f)
+     * additions instead of a fresh binomial expansion per residue. Keeping
+     * the f^n factor avoids dividing by powers of p when p | f.
+     */
+    static std::vector<Qp> bernoulli_polynomial_scaled(long n, long f, long p, long precision);
+    
+    /**
+     * B_n(a/f) for 0 <= a < f, from bernoulli_polynomial_scaled
+     */
+    static std::vector<Qp> bernoulli_polynomial_values(long n, long f, long p, long precision) {
+        std::vector<Qp> values = bernoulli_polynomial_scaled(n, f, p, precision);
+        // f^{-n} = p^{-e} u^{-1}; apply it to the unit and valuation directly
+        // so the N - v unit digits of each result are all meaningful
+        BigInt unit = BigInt(f).pow(n);
+        BigInt prime_big(p);
+        long e = static_cast<long>(mpz_remove(unit.get_mpz(), unit.get_mpz(), prime_big.get_mpz()));
+        // B_n(x) has valuation >= -1 - e here, so N + e + 1 digits of u^{-1} suffice
+        BigInt inverse = unit.mod_inverse(prime_big.pow(precision + e + 1));
+        for (Qp& v : values) {
+            if (v.is_zero()) continue;
+            long val = v.valuation() - e;
+            BigInt m = prime_big.pow(precision - val);
+            const BigInt& inv = precision - val <= precision + e + 1 ? inverse : unit.mod_inverse(m);
+            v = Qp::from_unit_and_valuation(p, precision, (v.get_unit().get_value() * inv) % m, val);
+        }
+        return values;
+    }
+    
     /**
      * Compute B_{1,χ} for the Reid-Li criterion
      * This is crucial for L_p(0,χ) = -(1 - χ(p)p^{-1}) B_{1,χ}
@@ -185,8 +259,14 @@ public:
     /**
      * Clear caches (useful for memory management in long computations)
      */
+    /**
+     * Copy the Bernoulli tables and memoized B_{n,χ} into `store`
+     */
+    static void export_cache(ResultStore& store);
+    
     static void clear_cache() {
-        bernoulli_cache.clear();
+        range_cache.clear();
+        range_top.clear();
         generalized_cache.clear();
     }
     
@@ -0,0 +1,433 @@
+#ifndef LIBADIC_CACHE_H
+#define LIBADIC_CACHE_H
+
+#include "libadic/cyclotomic.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace libadic {
+
+/**
+ * Counters for one cache (or a sum over several)
+ */
+struct CacheStats {
+    std::string name;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+    size_t budget = 0;
+
+    double hit_rate() const {
+        uint64_t lookups = hits + misses;
+        return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+    }
+};
+
+inline void hash_combine(size_t& seed, size_t value) {
+    seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+/**
+ * Approximate heap + inline footprint of cached values, used as the Sizer
+ * for library caches. Counts mpz limbs, which dominate for p-adic values.
+ */
+inline size_t cache_footprint(const BigInt& x) {
+    return sizeof(BigInt) + mpz_size(x.get_mpz()) * sizeof(mp_limb_t);
+}
+
+inline size_t cache_footprint(const Qp& x) {
+    return sizeof(Qp) + mpz_size(x.get_unit().get_value().get_mpz()) * sizeof(mp_limb_t);
+}
+
+inline size_t cache_footprint(const Cyclotomic& x) {
+    size_t bytes = sizeof(Cyclotomic);
+    for (const Qp& c : x.get_coeffs()) {
+        bytes += cache_footprint(c);
+    }
+    return bytes;
+}
+
+template<class T>
+size_t cache_footprint(const std::vector<T>& xs) {
+    size_t bytes = sizeof(std::vector<T>);
+    for (const T& x : xs) {
+        bytes += cache_footprint(x);
+    }
+    return bytes;
+}
+
+/**
+ * Type-erased handle used by CacheRegistry to resize and inspect caches
+ */
+class CacheBase {
+public:
+    virtual ~CacheBase() = default;
+    virtual void set_budget(size_t bytes) = 0;
+    virtual void clear() = 0;
+    virtual CacheStats stats() const = 0;
+};
+
+/**
+ * Process-wide list of library caches with a shared memory budget.
+ *
+ * The total budget is split evenly between registered caches; a cache that
+ * registers later (caches are created lazily) receives its share on
+ * registration and the others are rebalanced.
+ */
+class CacheRegistry {
+private:
+    mutable std::mutex mutex;
+    std::vector<CacheBase*> caches;
+    size_t total_budget = size_t(256) << 20;
+
+    CacheRegistry() = default;
+
+    void rebalance() {
+        if (caches.empty()) return;
+        size_t share = total_budget / caches.size();
+        for (CacheBase* c : caches) {
+            c->set_budget(share);
+        }
+    }
+
+public:
+    static CacheRegistry& instance() {
+        static CacheRegistry registry;
+        return registry;
+    }
+
+    void add(CacheBase* cache) {
+        std::lock_guard<std::mutex> lock(mutex);
+        caches.push_back(cache);
+        rebalance();
+    }
+
+    void remove(CacheBase* cache) {
+        std::lock_guard<std::mutex> lock(mutex);
+        caches.erase(std::remove(caches.begin(), caches.end(), cache), caches.end());
+        rebalance();
+    }
+
+    void set_total_budget(size_t bytes) {
+        std::lock_guard<std::mutex> lock(mutex);
+        total_budget = bytes;
+        rebalance();
+    }
+
+    size_t get_total_budget() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return total_budget;
+    }
+
+    std::vector<CacheStats> stats() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<CacheStats> result;
+        result.reserve(caches.size());
+        for (const CacheBase* c : caches) {
+            result.push_back(c->stats());
+        }
+        return result;
+    }
+
+    void clear_all() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (CacheBase* c : caches) {
+            c->clear();
+        }
+    }
+};
+
+/**
+ * Thread-safe memo table with LRU eviction under a byte budget.
+ *
+ * Keys are spread over independently locked shards so that concurrent
+ * lookups from different threads rarely contend. Each shard keeps an
+ * intrusive LRU list and evicts from its tail once its share of the budget
+ * is exceeded; entry size comes from the Sizer supplied at construction.
+ * The most recently used entry of a shard may exceed that share on its own
+ * (a large table at high precision, say) as long as it fits the whole
+ * cache's budget: it is kept, and the cache then evicts entries of the
+ * other shards, least recently used first, until the total is back within
+ * budget.
+ * Lookups return copies, since a reference could be invalidated by another
+ * thread's eviction.
+ */
+template<class Key, class Value, class Hash = std::hash<Key>>
+class ShardedCache : public CacheBase {
+public:
+    using Sizer = std::function<size_t(const Key&, const Value&)>;
+
+private:
+    struct Entry {
+        Key key;
+        Value value;
+        size_t bytes;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::list<Entry> lru;  // front = most recently used
+        std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> index;
+        size_t bytes = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+
+    std::string name;
+    Sizer sizer;
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::atomic<size_t> budget;        // whole cache
+    std::atomic<size_t> shard_budget;  // budget / shards
+    std::atomic<size_t> total_bytes{0};
+    Hash hasher;
+
+    Shard& shard_for(const Key& key) const {
+        size_t h = hasher(key);
+        hash_combine(h, 0);  // spread low bits before picking a shard
+        return *shards[h % shards.size()];
+    }
+
+    void evict_back_locked(Shard& s) {
+        Entry& victim = s.lru.back();
+        s.bytes -= victim.bytes;
+        total_bytes.fetch_sub(victim.bytes, std::memory_order_relaxed);
+        s.index.erase(victim.key);
+        s.lru.pop_back();
+        ++s.evictions;
+    }
+
+    // Evict down to the shard's share, except that the front entry alone may
+    // exceed it when it fits the cache budget; true if that happened
+    bool evict_locked(Shard& s) {
+        size_t limit = shard_budget.load(std::memory_order_relaxed);
+        while (s.bytes > limit && !s.lru.empty()) {
+            if (s.lru.size() == 1 && s.bytes <= budget.load(std::memory_order_relaxed)) {
+                return true;
+            }
+            evict_back_locked(s);
+        }
+        return false;
+    }
+
+    // Bring the whole cache back within budget after an oversized entry was
+    // kept in `keep` (null after a budget change), least recently used
+    // entries first; `keep` is skipped, as evict_locked left it holding only
+    // that entry
+    void evict_globally(const Shard* keep) {
+        size_t limit = budget.load(std::memory_order_relaxed);
+        for (auto& s : shards) {
+            if (total_bytes.load(std::memory_order_relaxed) <= limit) return;
+            if (s.get() == keep) continue;
+            std::lock_guard<std::mutex> lock(s->mutex);
+            while (total_bytes.load(std::memory_order_relaxed) > limit && !s->lru.empty()) {
+                evict_back_locked(*s);
+            }
+        }
+    }
+
+public:
+    ShardedCache(std::string cache_name, Sizer entry_sizer, size_t shard_count = 16)
+        : name(std::move(cache_name)), sizer(std::move(entry_sizer)), budget(0), shard_budget(0) {
+        shards.reserve(shard_count);
+        for (size_t i = 0; i < shard_count; ++i) {
+            shards.emplace_back(new Shard());
+        }
+        CacheRegistry::instance().add(this);
+    }
+
+    ~ShardedCache() override {
+        CacheRegistry::instance().remove(this);
+    }
+
+    ShardedCache(const ShardedCache&) = delete;
+    ShardedCache& operator=(const ShardedCache&) = delete;
+
+    std::optional<Value> find(const Key& key) {
+        Shard& s = shard_for(key);
+        std::lock_guard<std::mutex> lock(s.mutex);
+        auto it = s.index.find(key);
+        if (it == s.index.end()) {
+            ++s.misses;
+            return std::nullopt;
+        }
+        ++s.hits;
+        s.lru.splice(s.lru.begin(), s.lru, it->second);
+        return it->second->value;
+    }
+
+    void insert(const Key& key, const Value& value) {
+        size_t bytes = sizer(key, value);
+        Shard& s = shard_for(key);
+        bool oversized;
+        {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            auto it = s.index.find(key);
+            if (it != s.index.end()) {
+                s.bytes -= it->second->bytes;
+                total_bytes.fetch_sub(it->second->bytes, std::memory_order_relaxed);
+                it->second->value = value;
+                it->second->bytes = bytes;
+                s.lru.splice(s.lru.begin(), s.lru, it->second);
+            } else {
+                s.lru.push_front(Entry{key, value, bytes});
+                s.index.emplace(key, s.lru.begin());
+            }
+            s.bytes += bytes;
+            total_bytes.fetch_add(bytes, std::memory_order_relaxed);
+            oversized = evict_locked(s);
+        }
+        if (oversized) {
+            evict_globally(&s);
+        }
+    }
+
+    /**
+     * Return the cached value or compute, store and return it. The
+     * computation runs without holding a lock, so two threads may race to
+     * fill the same key; both get the same value.
+     */
+    template<class Compute>
+    Value get_or_compute(const Key& key, Compute&& compute) {
+        if (auto hit = find(key)) {
+            return std::move(*hit);
+        }
+        Value value = compute();
+        insert(key, value);
+        return value;
+    }
+
+    /**
+     * Call f(key, value) for every entry, one shard at a time under its lock;
+     * f must not touch this cache.
+     */
+    template<class F>
+    void for_each(F&& f) const {
+        for (const auto& s : shards) {
+            std::lock_guard<std::mutex> lock(s->mutex);
+            for (const Entry& e : s->lru) {
+                f(e.key, e.value);
+            }
+        }
+    }
+
+    void set_budget(size_t bytes) override {
+        budget.store(bytes, std::memory_order_relaxed);
+        shard_budget.store(bytes / shards.size(), std::memory_order_relaxed);
+        for (auto& s : shards) {
+            std::lock_guard<std::mutex> lock(s->mutex);
+            evict_locked(*s);
+        }
+        evict_globally(nullptr);
+    }
+
+    void clear() override {
+        for (auto& s : shards) {
+            std::lock_guard<std::mutex> lock(s->mutex);
+            s->lru.clear();
+            s->index.clear();
+            total_bytes.fetch_sub(s->bytes, std::memory_order_relaxed);
+            s->bytes = 0;
+        }
+    }
+
+    CacheStats stats() const override {
+        CacheStats total;
+        total.name = name;
+        total.budget = budget.load(std::memory_order_relaxed);
+        for (const auto& s : shards) {
+            std::lock_guard<std::mutex> lock(s->mutex);
+            total.hits += s->hits;
+            total.misses += s->misses;
+            total.evictions += s->evictions;
+            total.entries += s->index.size();
+            total.bytes += s->bytes;
+        }
+        return total;
+    }
+};
+
+/**
+ * ShardedCache of p-adic values keyed without their precision.
+ *
+ * Each key keeps the value computed at the highest precision requested so
+ * far; a lookup at precision N is a hit whenever that precision is at least
+ * N and returns the value truncated with with_precision(). A computation at
+ * a higher precision replaces the entry, so a multi-precision study pays for
+ * each key once per precision increase rather than once per precision.
+ */
+template<class Key, class Hash = std::hash<Key>>
+class PrecisionCache {
+public:
+    using KeySizer = std::function<size_t(const Key&)>;
+
+private:
+    struct Stored {
+        long precision;  // precision the value was requested at
+        Qp value;
+    };
+
+    ShardedCache<Key, Stored, Hash> cache;
+
+public:
+    PrecisionCache(std::string cache_name, KeySizer key_bytes)
+        : cache(std::move(cache_name), [key_bytes](const Key& key, const Stored& s) {
+              return key_bytes(key) + sizeof(long) + cache_footprint(s.value);
+          }) {}
+
+    std::optional<Qp> find(const Key& key, long precision) {
+        auto hit = cache.find(key);
+        if (!hit || hit->precision < precision) {
+            return std::nullopt;
+        }
+        return hit->value.with_precision(std::min(precision, hit->value.get_precision()));
+    }
+
+    /**
+     * Store `value`, computed at `precision`, unless a more precise one is cached
+     */
+    void insert(const Key& key, long precision, const Qp& value) {
+        auto existing = cache.find(key);
+        if (existing && existing->precision >= precision) {
+            return;
+        }
+        cache.insert(key, Stored{precision, value});
+    }
+
+    template<class Compute>
+    Qp get_or_compute(const Key& key, long precision, Compute&& compute) {
+        if (auto hit = find(key, precision)) {
+            return std::move(*hit);
+        }
+        Qp value = compute();
+        insert(key, precision, value);
+        return value;
+    }
+
+    /**
+     * Call f(key, precision, value) for every entry
+     */
+    template<class F>
+    void for_each(F&& f) const {
+        cache.for_each([&f](const Key& key, const Stored& s) { f(key, s.precision, s.value); });
+    }
+
+    void clear() { cache.clear(); }
+};
+
+} // namespace libadic
+
+#endif // LIBADIC_CACHE_H
@@ -0,0 +1,133 @@
+#ifndef LIBADIC_CANCELLATION_H
+#define LIBADIC_CANCELLATION_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+namespace libadic {
+
+/**
+ * Thrown at a cancellation point once the current computation's token has
+ * been cancelled or its deadline has passed
+ */
+class OperationCancelled : public std::runtime_error {
+private:
+    bool deadline;
+
+public:
+    explicit OperationCancelled(bool deadline_exceeded)
+        : std::runtime_error(deadline_exceeded ? "libadic: deadline exceeded"
+                                               : "libadic: operation cancelled"),
+          deadline(deadline_exceeded) {}
+
+    bool deadline_exceeded() const { return deadline; }
+};
+
+/**
+ * Shared cancellation flag with an optional deadline.
+ *
+ * Copies share one state, so a caller keeps a copy and cancels while a
+ * worker computes with another. Long-running loops (the character sums of
+ * LFunctions, log Γ_p tables, the p-adic logarithm and exponential,
+ * generalized Bernoulli numbers) call cancellation_point(), which checks the
+ * token installed on the calling thread by a CancellationScope and throws
+ * OperationCancelled. Cancellation is cooperative: a computation stops at
+ * its next cancellation point, and work it hands to other threads (e.g. a
+ * threaded LogGammaTable build) runs to completion first. Caches are only
+ * filled with finished values, so a cancelled call leaves them consistent.
+ */
+class CancellationToken {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    CancellationToken() : state(std::make_shared<State>()) {}
+
+    template<class Rep, class Period>
+    static CancellationToken with_timeout(std::chrono::duration<Rep, Period> timeout) {
+        CancellationToken token;
+        token.set_deadline(Clock::now() + std::chrono::duration_cast<Clock::duration>(timeout));
+        return token;
+    }
+
+    void cancel() const { state->cancelled.store(true, std::memory_order_relaxed); }
+
+    void set_deadline(Clock::time_point deadline) const {
+        state->deadline.store(deadline.time_since_epoch().count(), std::memory_order_relaxed);
+    }
+
+    bool has_deadline() const {
+        return state->deadline.load(std::memory_order_relaxed) != State::no_deadline;
+    }
+
+    bool cancel_requested() const { return state->cancelled.load(std::memory_order_relaxed); }
+
+    bool deadline_passed() const {
+        int64_t deadline = state->deadline.load(std::memory_order_relaxed);
+        return deadline != State::no_deadline && Clock::now().time_since_epoch().count() >= deadline;
+    }
+
+    /**
+     * Cancelled or past the deadline
+     */
+    bool is_cancelled() const { return cancel_requested() || deadline_passed(); }
+
+    void throw_if_cancelled() const {
+        if (cancel_requested()) {
+            throw OperationCancelled(false);
+        }
+        if (deadline_passed()) {
+            throw OperationCancelled(true);
+        }
+    }
+
+private:
+    struct State {
+        static constexpr int64_t no_deadline = std::numeric_limits<int64_t>::max();
+        std::atomic<bool> cancelled{false};
+        std::atomic<int64_t> deadline{no_deadline};
+    };
+
+    std::shared_ptr<State> state;
+};
+
+namespace detail {
+inline thread_local const CancellationToken* current_cancellation = nullptr;
+} // namespace detail
+
+/**
+ * Makes `token` the calling thread's current token until destroyed, then
+ * restores the previous one
+ */
+class CancellationScope {
+private:
+    const CancellationToken* previous;
+
+public:
+    explicit CancellationScope(const CancellationToken& token)
+        : previous(detail::current_cancellation) {
+        detail::current_cancellation = &token;
+    }
+
+    ~CancellationScope() { detail::current_cancellation = previous; }
+
+    CancellationScope(const CancellationScope&) = delete;
+    CancellationScope& operator=(const CancellationScope&) = delete;
+};
+
+/**
+ * Throw OperationCancelled if the current thread's token asks for it; a
+ * thread-local load when no token is installed
+ */
+inline void cancellation_point() {
+    if (const CancellationToken* token = detail::current_cancellation) {
+        token->throw_if_cancelled();
+    }
+}
+
+} // namespace libadic
+
+#endif // LIBADIC_CANCELLATION_H
@@ -0,0 +1,134 @@
+#ifndef LIBADIC_CHARACTER_SUMS_H
+#define LIBADIC_CHARACTER_SUMS_H
+
+#include "libadic/qp.h"
+#include "libadic/characters.h"
+#include "libadic/zp_vector.h"
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace libadic {
+
+/**
+ * Per-operation costs (ns) that CharacterSumBatch weighs its two paths with.
+ * The defaults were fitted on one machine; CharacterSumBatch::calibrate
+ * measures this one, and set_cost_model installs either.
+ */
+struct CharacterSumCosts {
+    double qp_base = 70.0;     // Qp::addmul, fixed part
+    double qp_per_bit = 0.47;  // Qp::addmul, per bit of p^N
+    double word_term = 1.8;    // one gathered word product in a residue plane
+    double convert = 150.0;    // one value into or out of residues
+    double split = 10.0;       // per value converted in, per plane
+    double combine = 3.0;      // per result, per plane squared (Garner)
+    double setup = 2000.0;     // fixed cost of a residue-path call
+};
+
+/**
+ * Σ_{a=1}^{p-1} χ(a) f(a) for every Dirichlet character χ mod p at once.
+ *
+ * With g the generator used by DirichletCharacter and ω = ω(g) its
+ * Teichmüller lift, the characters mod p are χ_k(g^e) = ω^{ke}, so the
+ * vector of sums is the length-(p-1) DFT of e ↦ f(g^e) with root ω. The
+ * transform is a mixed-radix Cooley-Tukey over the prime factors of p-1,
+ * costing O(p Σ q_i) Qp operations instead of O(p²) for a full sweep.
+ *
+ * When every f(a) lies in Z_p and the radices are large (p - 1 with a big
+ * prime factor), the sums are instead taken directly as
+ * Σ_e ω^{ke} f(g^e) over ZpVector residue planes, exact integers reduced
+ * mod p^N once per result; orbit_sum does the same for its d-term sums.
+ * A cost model over per-operation times (CharacterSumCosts) picks the path,
+ * and both give the same residues.
+ *
+ * Index k of the result is the character with character_values = {k}, i.e.
+ * position k of DirichletCharacter::enumerate_characters(p, p).
+ */
+class CharacterSumBatch {
+private:
+    long prime;
+    long precision;
+    long group_order;                 // p - 1
+    long generator;
+    std::vector<long> exponent_of;    // exponent_of[a] = e with g^e ≡ a, a in [1, p)
+    std::vector<long> power_of;       // power_of[e] = g^e mod p
+    std::vector<Qp> roots;            // roots[j] = ω^j
+    std::vector<long> radices;        // prime factors of p - 1, ascending
+
+    // ω^j as RNS residues, built on first use by the word-level sums
+    mutable std::once_flag root_residues_once;
+    mutable std::unique_ptr<const ZpVector> root_residues;
+
+    void transform(const std::vector<Qp>& in, size_t offset, size_t stride,
+                   size_t len, size_t level, std::vector<Qp>& out) const;
+
+    const ZpVector& roots_in_rns() const;
+    bool residues_of(const std::vector<Qp>& f, ZpVector& out) const;
+    bool rns_cheaper(double terms, double outputs, double qp_operations) const;
+
+public:
+    CharacterSumBatch(long p, long N);
+
+    /**
+     * The costs the path choice uses, for every batch
+     */
+    static CharacterSumCosts cost_model();
+    static void set_cost_model(const CharacterSumCosts& costs);
+
+    /**
+     * Costs measured on this machine: Qp::addmul at two sizes of p^N below
+     * 400 bits (base and per-bit terms) and the word-level dot product. The other word-level
+     * costs are scaled from their defaults by the measured word_term. Takes
+     * a few tens of milliseconds; the result is returned, not installed.
+     */
+    static CharacterSumCosts calibrate();
+
+    /**
+     * Shared batch for (p, N), kept in the library cache
+     */
+    static std::shared_ptr<const CharacterSumBatch> get(long p, long N);
+
+    long get_prime() const { return prime; }
+    long get_precision() const { return precision; }
+    long get_generator() const { return generator; }
+    size_t size() const { return static_cast<size_t>(group_order); }
+
+    /**
+     * ω^j, 0 <= j < p-1
+     */
+    const Qp& root(size_t j) const { return roots[j]; }
+
+    /**
+     * Discrete logarithm of a unit a mod p to the base of the generator
+     */
+    long discrete_log(long a) const;
+
+    /**
+     * Position of χ in the result vectors (χ must be a character mod p)
+     */
+    static long index_of(const DirichletCharacter& chi);
+
+    /**
+     * sums[k] = Σ_{a=1}^{p-1} χ_k(a) f[a]; f has size p and f[0] is ignored
+     */
+    std::vector<Qp> sum(const std::vector<Qp>& f) const;
+    std::vector<Qp> sum(const std::function<Qp(long)>& f) const;
+
+    /**
+     * The sums for the Galois orbit of one character only: result[i] belongs
+     * to representative.galois_orbit()[i].
+     *
+     * For χ_k of order d, χ_k(g^e) depends on e mod d, so the sum is the
+     * element Σ_j S_j ζ_d^j of Q_p[ζ_d] with S_j = Σ_{e ≡ j (d)} f(g^e),
+     * evaluated at ζ_d = ω^k. The conjugate χ_k^a is the image under
+     * ζ_d ↦ ζ_d^a, so after p-1 additions for the S_j each member costs d
+     * multiplications instead of a full p-1 term sum.
+     */
+    std::vector<Qp> orbit_sum(const DirichletCharacter& representative, const std::vector<Qp>& f) const;
+};
+
+} // namespace libadic
+
+#endif // LIBADIC_CHARACTER_SUMS_H
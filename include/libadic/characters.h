@@ -5,8 +5,11 @@
 #include "libadic/cyclotomic.h"
 #include <vector>
 #include <map>
+#include <memory>
+#include <optional>
 #include <numeric>
 #include <functional>
+#include <iterator>
 
 namespace libadic {
 
@@ -26,14 +29,22 @@ public:  // Made public for Python bindings
     std::vector<long> generators;  // Generators of (Z/nZ)*
     std::vector<long> generator_orders;  // Orders of generators
     std::vector<long> character_values;  // Values on generators
-    mutable std::map<long, Cyclotomic> value_cache;  // Cache computed values
     
 private:
+    /**
+     * Generators, discrete logarithms and primitive root for one modulus,
+     * built once and shared by every character of that modulus
+     */
+    struct GroupTable;
+    std::shared_ptr<const GroupTable> group;
+    
+    static std::shared_ptr<const GroupTable> group_table(long modulus);
     
     /**
      * Find generators of (Z/nZ)*
      */
-    void compute_generators();
+    static void compute_generators(long modulus, std::vector<long>& generators,
+                                   std::vector<long>& generator_orders);
     
     static long pow_mod(long base, long exp, long mod);
     
@@ -65,6 +76,11 @@ public:
      */
     long evaluate_at(long n) const;
     
+    /**
+     * evaluate_at(n) for every residue n in [0, modulus), for bulk consumers
+     */
+    std::vector<long> values() const;
+    
     /**
      * Evaluate character and lift to p-adic number using Teichmüller lift
      */
@@ -100,6 +116,19 @@ public:
      */
     long get_order() const;
     
+    /**
+     * Position of χ in enumerate_characters(modulus, p): the generator
+     * values read as a mixed-radix number over the generator orders. With
+     * the modulus it identifies χ exactly and costs a few multiplications,
+     * so caches key on (modulus, index()) instead of a string fingerprint.
+     */
+    long index() const;
+    
+    /**
+     * The character at position `index` of enumerate_characters(modulus, prime)
+     */
+    static DirichletCharacter from_index(long modulus, long prime, long index);
+    
     /**
      * Enumerate all Dirichlet characters modulo n
      */
@@ -109,10 +138,25 @@ public:
      * Enumerate primitive characters only
      */
     static std::vector<DirichletCharacter> enumerate_primitive_characters(long modulus, long prime);
-    
+
+    /**
+     * The Galois orbit of χ: χ^a for every a in [1, ord(χ)) coprime to
+     * ord(χ), in increasing a, so χ itself comes first. Conjugates share the
+     * order, parity and conductor of χ.
+     */
+    std::vector<DirichletCharacter> galois_orbit() const;
+
+    /**
+     * The characters modulo n partitioned into Galois orbits. Orbits are
+     * listed by their smallest index(), which is the first member.
+     */
+    static std::vector<std::vector<DirichletCharacter>> galois_orbits(long modulus, long prime);
+
     /**
      * Compute Gauss sum: g(χ) = Σ_{a mod n} χ(a) e^{2πia/n}
      * In p-adic setting, we use Teichmüller characters
+     * For characters mod p, GaussSums (gauss_sums.h) gives the Teichmüller
+     * Gauss sums through Gross–Koblitz without cyclotomic products
      */
     Cyclotomic gauss_sum(long precision) const;
     
@@ -123,6 +167,78 @@ public:
     Qp L_value(long s, long precision) const;
 };
 
+/**
+ * The characters modulo n in enumerate_characters order, produced one at a
+ * time instead of materialized.
+ *
+ * An iterator owns a single DirichletCharacter sharing the per-modulus
+ * group table, and stepping it rewrites the generator values in place, so
+ * walking all φ(n) characters takes constant memory. The reference returned
+ * by operator* is only valid until the next increment; copy the character
+ * to keep it. For parallel sweeps, split [0, group_order()) into blocks and
+ * start each worker at DirichletCharacter::from_index or begin_at().
+ */
+class CharacterRange {
+private:
+    long modulus;
+    long prime;
+    bool primitive_only;
+    long order = 1;  // |(Z/nZ)*|, the number of characters
+
+public:
+    class iterator {
+    private:
+        const CharacterRange* range = nullptr;
+        long position = 0;
+        std::optional<DirichletCharacter> current;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = DirichletCharacter;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const DirichletCharacter*;
+        using reference = const DirichletCharacter&;
+
+        iterator() = default;
+        iterator(const CharacterRange* r, long start);
+
+        reference operator*() const { return *current; }
+        pointer operator->() const { return &*current; }
+        iterator& operator++();
+
+        long index() const { return position; }
+
+        bool operator==(const iterator& other) const { return position == other.position; }
+        bool operator!=(const iterator& other) const { return position != other.position; }
+    };
+
+    /**
+     * All characters mod `modulus`, or only the primitive ones
+     */
+    CharacterRange(long modulus, long prime, bool primitive_only = false);
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, order); }
+
+    /**
+     * Iterator at enumeration position `index` (the next primitive one at or
+     * after it when filtering)
+     */
+    iterator begin_at(long index) const { return iterator(this, index); }
+
+    long group_order() const { return order; }
+
+    /**
+     * Number of characters the range yields: group_order(), or, when
+     * filtering, the count of a full walk over the range (O(φ(n)) conductor
+     * checks)
+     */
+    long size() const;
+    long get_modulus() const { return modulus; }
+    long get_prime() const { return prime; }
+    bool primitive() const { return primitive_only; }
+};
+
 } // namespace libadic
 
 #endif // LIBADIC_CHARACTERS_H
\ No newline at end of file
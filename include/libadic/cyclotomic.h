@@ -2,6 +2,7 @@
 #define LIBADIC_CYCLOTOMIC_H
 
 #include "libadic/qp.h"
+#include "libadic/packed_cyclotomic.h"
 #include <vector>
 #include <stdexcept>
 
@@ -13,6 +14,10 @@ namespace libadic {
  * The p-th cyclotomic polynomial Φ_p(x) = 1 + x + ... + x^(p-1) = 0
  */
 class Cyclotomic {
+public:
+    // Largest p for which addmul multiplies coefficient by coefficient
+    static constexpr long fma_schoolbook_max_prime = 7;
+
 private:
     long prime;
     long precision;
@@ -104,55 +109,89 @@ public:
         return Cyclotomic(prime, std::min(precision, other.precision), result_coeffs);
     }
     
+    /**
+     * Product in Q_p(ζ), computed on the packed representation: one
+     * Kronecker-substituted integer multiplication and a single reduction
+     * modulo Φ_p
+     */
     Cyclotomic operator*(const Cyclotomic& other) const {
         if (prime != other.prime) {
             throw std::invalid_argument("Cannot multiply cyclotomic elements with different primes");
         }
         
-        long new_prec = std::min(precision, other.precision);
-        std::vector<Qp> result_coeffs(2 * prime - 2, Qp(prime, new_prec, 0));
-        
-        // Polynomial multiplication
+        return (PackedCyclotomic(*this) * PackedCyclotomic(other)).to_cyclotomic();
+    }
+    
+    Cyclotomic operator*(const Qp& scalar) const {
+        std::vector<Qp> result_coeffs(prime - 1);
         for (long i = 0; i < prime - 1; ++i) {
-            for (long j = 0; j < prime - 1; ++j) {
-                result_coeffs[i + j] += get_coeff(i) * other.get_coeff(j);
+            result_coeffs[i] = coeffs[i] * scalar;
+        }
+        return Cyclotomic(prime, precision, result_coeffs);
+    }
+    
+    /**
+     * Fused multiply-accumulate: *this += a * b without an intermediate
+     * product element. For p up to fma_schoolbook_max_prime the (p-1)²
+     * coefficient products are accumulated in place with Qp::addmul, the
+     * ones landing on ζ^{p-1} gathered in a single Qp and folded in at the
+     * end; above it the packed Kronecker product is added coefficient by
+     * coefficient.
+     */
+    Cyclotomic& addmul(const Cyclotomic& a, const Cyclotomic& b) {
+        if (a.prime != prime || b.prime != prime) {
+            throw std::invalid_argument("Cannot combine cyclotomic elements with different primes");
+        }
+        if (&a == this || &b == this) {
+            Cyclotomic self(*this);
+            return addmul(&a == this ? self : a, &b == this ? self : b);
+        }
+        precision = std::min(precision, std::min(a.precision, b.precision));
+        long n = prime - 1;
+        if (prime > fma_schoolbook_max_prime) {
+            PackedCyclotomic product = PackedCyclotomic(a) * PackedCyclotomic(b);
+            for (long i = 0; i < n; ++i) {
+                coeffs[i] += product.coeff(i);
             }
+            return *this;
         }
-        
-        // Reduce using cyclotomic polynomial relation
-        // ζ^p = 1, so ζ^(p-1) = -1 - ζ - ... - ζ^(p-2)
-        for (long k = 2 * prime - 3; k >= prime - 1; --k) {
-            Qp coeff = result_coeffs[k];
-            long reduced_power = k % (prime - 1);
-            
-            if (k >= prime - 1) {
-                // ζ^k = ζ^(k mod (p-1)) when k >= p-1
-                // But we need to handle ζ^(p-1) = -1 - ζ - ... - ζ^(p-2)
-                long quotient = k / (prime - 1);
-                
-                for (long iter = 0; iter < quotient; ++iter) {
-                    // Each application of ζ^(p-1) adds -1 to all coefficients
-                    for (long i = 0; i < prime - 1; ++i) {
-                        result_coeffs[i] -= coeff;
-                    }
-                }
-                
-                if (reduced_power > 0) {
-                    result_coeffs[reduced_power] += coeff;
+        Qp high(prime, precision, 0);
+        for (long i = 0; i < n; ++i) {
+            if (a.coeffs[i].is_zero()) continue;
+            for (long j = 0; j < n; ++j) {
+                long k = i + j;
+                if (k == n) {
+                    high.addmul(a.coeffs[i], b.coeffs[j]);
+                } else {
+                    coeffs[k < prime ? k : k - prime].addmul(a.coeffs[i], b.coeffs[j]);
                 }
             }
         }
-        
-        result_coeffs.resize(prime - 1);
-        return Cyclotomic(prime, new_prec, result_coeffs);
+        // ζ^{p-1} = -(1 + ζ + ... + ζ^{p-2})
+        if (!high.is_zero()) {
+            for (auto& c : coeffs) {
+                c -= high;
+            }
+        }
+        return *this;
     }
     
-    Cyclotomic operator*(const Qp& scalar) const {
-        std::vector<Qp> result_coeffs(prime - 1);
+    /**
+     * *this += a * scalar, in place on the coefficients
+     */
+    Cyclotomic& addmul(const Cyclotomic& a, const Qp& scalar) {
+        if (a.prime != prime) {
+            throw std::invalid_argument("Cannot combine cyclotomic elements with different primes");
+        }
+        if (&a == this) {
+            Cyclotomic self(*this);
+            return addmul(self, scalar);
+        }
+        precision = std::min(precision, std::min(a.precision, scalar.get_precision()));
         for (long i = 0; i < prime - 1; ++i) {
-            result_coeffs[i] = coeffs[i] * scalar;
+            coeffs[i].addmul(a.coeffs[i], scalar);
         }
-        return Cyclotomic(prime, precision, result_coeffs);
+        return *this;
     }
     
     Cyclotomic operator-() const {
@@ -217,6 +256,22 @@ public:
         return z;
     }
     
+    /**
+     * ζ^k as a direct monomial (k reduced mod p; ζ^{p-1} = -(1 + ... + ζ^{p-2}))
+     */
+    static Cyclotomic zeta_power(long p, long N, long k) {
+        Cyclotomic z(p, N);
+        k = ((k % p) + p) % p;
+        if (k < p - 1) {
+            z.coeffs[k] = Qp(p, N, 1);
+        } else {
+            for (auto& c : z.coeffs) {
+                c = Qp(p, N, -1);
+            }
+        }
+        return z;
+    }
+    
     /**
      * Evaluate at a specific p-adic number
      * Useful for testing and validation
@@ -230,7 +285,7 @@ public:
         Qp x_power = x;
         
         for (size_t i = 1; i < coeffs.size(); ++i) {
-            result += coeffs[i] * x_power;
+            result.addmul(coeffs[i], x_power);
             x_power *= x;
         }
         
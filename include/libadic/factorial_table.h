@@ -0,0 +1,68 @@
+#ifndef LIBADIC_FACTORIAL_TABLE_H
+#define LIBADIC_FACTORIAL_TABLE_H
+
+#include "libadic/gmp_wrapper.h"
+#include "libadic/padic_context.h"
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace libadic {
+
+/**
+ * Prefix factorials a! mod p^N for 0 <= a < p.
+ *
+ * Morita's Γ_p(a) = (-1)^a (a-1)! for 0 < a < p, so a sweep over all
+ * residues (log Γ_p tables, character sums) reads one shared row built in a
+ * single pass of p-1 products instead of p separate factorial chains.
+ */
+class FactorialTable {
+private:
+    long prime;
+    long precision;
+    std::vector<BigInt> values;  // values[a] = a! mod p^N
+
+public:
+    /**
+     * Primes up to this bound are tabulated; larger ones fall back to
+     * product_mod per call
+     */
+    static constexpr long max_tabulated_prime = 1L << 15;
+
+    FactorialTable(long p, long N);
+
+    /**
+     * Shared table for (p, N), built on first use and kept in the library cache
+     */
+    static std::shared_ptr<const FactorialTable> get(long p, long N);
+
+    long get_prime() const { return prime; }
+    long get_precision() const { return precision; }
+
+    /**
+     * a! mod p^N for 0 <= a < p
+     */
+    const BigInt& operator[](long a) const { return values[a]; }
+
+    const BigInt& at(long a) const {
+        if (a < 0 || a >= prime) {
+            throw std::out_of_range("FactorialTable index must satisfy 0 <= a < p");
+        }
+        return values[a];
+    }
+
+    /**
+     * Γ_p(a) = (-1)^a (a-1)! mod p^N for 0 < a < p
+     */
+    BigInt gamma(long a) const;
+
+    /**
+     * n! mod p^N for 0 <= n < p, from the shared table when p is small
+     * enough and through product_mod otherwise
+     */
+    static BigInt factorial(long n, long p, long N);
+};
+
+} // namespace libadic
+
+#endif // LIBADIC_FACTORIAL_TABLE_H
@@ -0,0 +1,74 @@
+#ifndef LIBADIC_GAMMA_ENGINE_H
+#define LIBADIC_GAMMA_ENGINE_H
+
+#include "libadic/qp.h"
+#include "libadic/zp.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace libadic {
+
+/**
+ * Morita's Γ_p at arbitrary x ∈ Z_p^× to precision N in time polynomial in N.
+ *
+ * Write x = qY + x_0 with q = p (q = 4 for p = 2) and 0 < x_0 < q. Grouping
+ * the product Γ_p(x) = (-1)^x ∏_{j<x, p∤j} j into windows of length q,
+ *
+ *   ∏_{b<Y} P(b),   P(b) = ∏_{0<i<q, p∤i} (qb + i) = W · ∏_i (1 + qb/i),
+ *
+ * and Σ_{b<Y} log ∏_i (1 + qb/i) = Σ_k (-1)^{k+1} q^k H_k / k · S_k(Y),
+ * with H_k = Σ_i i^{-k} and S_k(Y) = Σ_{b<Y} b^k the Faulhaber polynomial.
+ * Every term is continuous in Y, so the finite window product extends to
+ * Y ∈ Z_p:
+ *
+ *   Γ_p(x) = ± exp(Y log(-W) + Σ_k c_k S_k(Y)) · ∏_{0<i<x_0, p∤i} (qY + i).
+ *
+ * The polynomial Σ_k c_k S_k(Y) + Y log(-W) (degree ≈ N, built once per
+ * (p, N) from bernoulli_range) replaces the p^N-term product, so an
+ * evaluation is a Horner pass, one exponential and fewer than q products.
+ */
+class GammaEngine {
+private:
+    long prime;
+    long precision;
+    long working;              // N plus guard digits for the Bernoulli denominators
+    long block;                // q
+    std::vector<Qp> poly;      // coefficients of Y^m at precision `working`
+
+    /**
+     * Split x into Y and x_0 and return log_Iw of the partial window
+     * ∏_{0<i<x_0, p∤i} (qY + i) together with the polynomial part
+     */
+    Qp log_gamma_parts(const Zp& x, BigInt& Y, long& x0, BigInt& partial) const;
+
+public:
+    GammaEngine(long p, long N);
+
+    /**
+     * Shared engine for (p, N), built on first use and kept in the library cache
+     */
+    static std::shared_ptr<const GammaEngine> get(long p, long N);
+
+    long get_prime() const { return prime; }
+    long get_precision() const { return precision; }
+
+    /**
+     * Degree of the window polynomial
+     */
+    size_t degree() const { return poly.empty() ? 0 : poly.size() - 1; }
+
+    /**
+     * Γ_p(x) for a unit x (precision min(N, precision of x))
+     */
+    Zp gamma(const Zp& x) const;
+
+    /**
+     * log Γ_p(x) (Iwasawa logarithm) for a unit x
+     */
+    Qp log_gamma(const Zp& x) const;
+};
+
+} // namespace libadic
+
+#endif // LIBADIC_GAMMA_ENGINE_H
@@ -0,0 +1,91 @@
+#ifndef LIBADIC_GAUSS_SUMS_H
+#define LIBADIC_GAUSS_SUMS_H
+
+#include "libadic/characters.h"
+#include "libadic/cyclotomic.h"
+#include "libadic/qp.h"
+#include "libadic/zp.h"
+#include <memory>
+#include <vector>
+
+namespace libadic {
+
+/**
+ * A Gauss sum in Gross–Koblitz form: g = π^exponent · coefficient, where π
+ * is the root of π^{p-1} = -p with ζ ≡ 1 + π (mod π²) for the ζ of
+ * Cyclotomic. π itself lies outside Q_p, so the value is kept factored.
+ */
+struct GaussSum {
+    long prime;
+    long exponent;     // a in [0, p-2], with χ = ω^{-a}
+    Zp coefficient;    // -Γ_p(a/(p-1))
+
+    /**
+     * g^{p-1} = (-p)^a · coefficient^{p-1}, which lies in Q_p
+     */
+    Qp power_p_minus_one() const;
+};
+
+/**
+ * Gauss sums g(χ) = Σ_{x=1}^{p-1} χ(x) ζ^x and Jacobi sums of the
+ * characters mod p through the Gross–Koblitz formula.
+ *
+ * The characters mod p are the powers of the Teichmüller character ω
+ * (χ_k = ω^k for the character at index k), and for 0 <= a < p-1
+ *
+ *   g(ω^{-a}) = -π^a Γ_p(a/(p-1)),
+ *
+ * so a Gauss sum is one Γ_p value from the shared GammaEngine instead of p
+ * cyclotomic products. The p-1 values Γ_p(a/(p-1)) are built once per
+ * (p, N), half of them through the reflection formula
+ * Γ_p(x) Γ_p(1-x) = ±1, and every Gauss and Jacobi sum for that p is
+ * assembled from them with O(1) Zp operations.
+ *
+ * Characters must have modulus p; other moduli throw std::invalid_argument.
+ */
+class GaussSums {
+public:
+    /**
+     * Γ_p(a/(p-1)) for a = 0, ..., p-2 (Γ_p(0) = 1), shared per (p, N)
+     */
+    static std::shared_ptr<const std::vector<Zp>> gamma_fractions(long p, long N);
+
+    /**
+     * The a in [0, p-2] with χ = ω^{-a}
+     */
+    static long teichmuller_exponent(const DirichletCharacter& chi);
+
+    /**
+     * g(χ) by Gross–Koblitz
+     */
+    static GaussSum gauss_sum(const DirichletCharacter& chi, long N);
+
+    /**
+     * g(χ) for every character mod p, indexed as enumerate_characters(p, p)
+     */
+    static std::vector<GaussSum> gauss_sums(long p, long N);
+
+    /**
+     * g(χ) as an element of Q_p(ζ), written down directly from the p-1
+     * values χ(x) in O(p) coefficient operations
+     */
+    static Cyclotomic gauss_sum_cyclotomic(const DirichletCharacter& chi, long N);
+
+    /**
+     * J(χ1, χ2) = Σ_{x mod p} χ1(x) χ2(1-x) with χ(0) = 0 for every χ.
+     *
+     * When χ1, χ2 and χ1χ2 are non-trivial, J = g(χ1) g(χ2) / g(χ1χ2), i.e.
+     * -Γ_aΓ_b/Γ_{a+b} for a + b < p-1 and p Γ_aΓ_b/Γ_{a+b-(p-1)} otherwise;
+     * J(χ, χ̄) = -χ(-1), J(ε, χ) = -1 and J(ε, ε) = p - 2.
+     */
+    static Zp jacobi_sum(const DirichletCharacter& chi1, const DirichletCharacter& chi2, long N);
+
+    /**
+     * J(χ, ψ) for every character ψ mod p, indexed as enumerate_characters(p, p)
+     */
+    static std::vector<Zp> jacobi_sums(const DirichletCharacter& chi, long N);
+};
+
+} // namespace libadic
+
+#endif // LIBADIC_GAUSS_SUMS_H
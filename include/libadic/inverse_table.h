@@ -0,0 +1,57 @@
+#ifndef LIBADIC_INVERSE_TABLE_H
+#define LIBADIC_INVERSE_TABLE_H
+
+#include "libadic/gmp_wrapper.h"
+#include "libadic/qp.h"
+#include <memory>
+#include <vector>
+
+namespace libadic {
+
+/**
+ * 1/n for 1 <= n <= bound as p^{-v_p(n)} times a unit, modulo p^N.
+ *
+ * Unit inverses are kept modulo p^{N + v}, v the largest v_p(n) in range, so
+ * inverse(n) carries the same N + v_p(n) unit digits as
+ * Qp::from_rational(1, n, p, N). The whole table is one batch_mod_inverse:
+ * a single modular inversion instead of one per term for the series loops
+ * dividing by n.
+ */
+class InverseTable {
+private:
+    long prime;
+    long precision;
+    long max_n;
+    std::vector<long> valuations;  // valuations[n] = v_p(n)
+    std::vector<BigInt> units;     // units[n] = (n / p^{v_p(n)})^{-1}, units[0] = 0
+
+public:
+    InverseTable(long p, long N, long bound);
+
+    /**
+     * Shared table for (p, N) covering at least 1..bound, kept in the library
+     * cache; a request beyond the cached bound rebuilds it at least twice as
+     * large
+     */
+    static std::shared_ptr<const InverseTable> get(long p, long N, long bound);
+
+    long get_prime() const { return prime; }
+    long get_precision() const { return precision; }
+    long bound() const { return max_n; }
+
+    long valuation(long n) const { return valuations[n]; }
+
+    /**
+     * (n / p^{v_p(n)})^{-1}, reduced modulo a power of p at least N + v_p(n)
+     */
+    const BigInt& unit_inverse(long n) const { return units[n]; }
+
+    /**
+     * 1/n to absolute precision N
+     */
+    Qp inverse(long n) const;
+};
+
+} // namespace libadic
+
+#endif // LIBADIC_INVERSE_TABLE_H
@@ -4,6 +4,7 @@
 #include "zp.h"
 #include "qp.h"
 #include "padic_log.h"
+#include "factorial_table.h"
 #include <vector>
 
 namespace libadic {
@@ -110,53 +111,22 @@ public:
         }
     }
     
-private:
-    static BigInt factorial_mod(long n, const BigInt& mod) {
-        BigInt result(1);
-        for (long i = 2; i <= n; ++i) {
-            result = (result * BigInt(i)) % mod;
-        }
-        return result;
-    }
-    
-public:
     /**
      * Compute log Γ_p(a) for 0 < a < p
      * 
-     * Uses the Iwasawa logarithm to handle roots of unity properly.
-     * For Γ_p(1) = -1, we use special values from p-adic regulator theory.
+     * Uses the Iwasawa logarithm to handle roots of unity properly, so
+     * log Γ_p(1) = log_Iw(-1) = 0.
      */
     static Qp log_gamma_direct(long a, long p, long precision) {
         if (a <= 0 || a >= p) {
             throw std::domain_error("log_gamma_direct requires 0 < a < p");
         }
         
-        if (a == 1) {
-            // Γ_p(1) = -1
-            // For the Iwasawa logarithm of -1, we use known values from p-adic regulator theory
-            // These values ensure log_Iw(-1) ≠ 0, which is crucial for the theory
-            
-            if (p == 5) {
-                // Known value from p-adic regulator theory
-                BigInt val = BigInt(2) * BigInt(p) + BigInt(3) * BigInt(p).pow(2);
-                return Qp(p, precision, val);
-            } else if (p == 7) {
-                BigInt val = BigInt(3) * BigInt(p) + BigInt(5) * BigInt(p).pow(2);
-                return Qp(p, precision, val);
-            } else if (p == 11) {
-                BigInt val = BigInt(5) * BigInt(p) + BigInt(7) * BigInt(p).pow(2);
-                return Qp(p, precision, val);
-            } else {
-                // Generic formula for log_Iw(-1) using cyclotomic units
-                BigInt val = BigInt((p-1)/2) * BigInt(p);
-                return Qp(p, precision, val);
-            }
-        }
-        
-        // For a > 1, compute Γ_p(a) = (-1)^a * (a-1)! and use Iwasawa logarithm
+        // Compute Γ_p(a) = (-1)^a * (a-1)! and use Iwasawa logarithm
         // Morita's Gamma: Γ_p(a) = (-1)^a * (a-1)!
-        BigInt p_power = BigInt(p).pow(precision);
-        BigInt result = factorial_mod(a - 1, p_power);
+        const PadicContext& ctx = PadicContext::get(p, precision);
+        const BigInt& p_power = ctx.modulus();
+        BigInt result = FactorialTable::factorial(a - 1, p, precision);
         
         // Apply the sign
         BigInt sign = (a % 2 == 0) ? BigInt(1) : BigInt(-1);
@@ -246,25 +216,8 @@ private:
      * Compute the Teichmüller lift of g^k mod p
      */
     static Zp teichmuller_lift(long g, long k, long p, long precision) {
-        // Start with g^k mod p
-        BigInt p_big(p);
-        BigInt g_big(g);
-        BigInt val = g_big.pow_mod(BigInt(k), p_big);
-        
-        // Lift using Hensel's lemma
-        // The Teichmüller lift ω(a) satisfies ω(a)^(p-1) = 1 and ω(a) ≡ a (mod p)
-        BigInt result = val;
-        BigInt p_power = p_big;
-        
-        for (long n = 1; n < precision && n < 10; ++n) {
-            p_power = p_power * p_big;
-            
-            // Use the formula: ω(a) = lim a^(p^n) as n → ∞
-            // For practical computation: ω(a) ≡ a^(p^n) (mod p^(n+1))
-            result = result.pow_mod(p_big, p_power);
-        }
-        
-        return Zp(p, precision, result);
+        BigInt val = BigInt(g).pow_mod(BigInt(k), BigInt(p));
+        return Zp(p, precision, TeichmullerTable::lift(val, p, precision));
     }
 };
 
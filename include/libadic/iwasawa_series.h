@@ -0,0 +1,92 @@
+#ifndef LIBADIC_IWASAWA_SERIES_H
+#define LIBADIC_IWASAWA_SERIES_H
+
+#include "libadic/qp.h"
+#include "libadic/zp.h"
+#include "libadic/characters.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace libadic {
+
+/**
+ * Iwasawa power series of the p-adic L-function: with u = 1 + p and
+ * T = u^s - 1,
+ *
+ *   L_p(s, χ) = G(u^s - 1),   G(T) = Σ_m g_m T^m,
+ *
+ * for the analytic branch through LFunctions::kubota_leopoldt(0, χ): in
+ * Kubota-Leopoldt's normalization it is L_p(s, χω), which takes the values
+ * -B_{n,χ}/n at s = 1 - n for n ≡ 1 (mod p-1). G has Z_p coefficients
+ * except when χω is trivial, where L_p has its pole at s = 1; then
+ * H(T) = (T - p)·G(T) is stored and evaluation divides by T - p.
+ *
+ * Construction interpolates G by Newton divided differences at the nodes
+ * T_i = u^{-(p-1)i} - 1, where the values are B_{n,χ} with n = 1 + (p-1)i
+ * for the Teichmüller-valued χ, as at s = 0. All nodes share one pass of
+ * power sums Σ χ(a) a^j. Since v(T_i) >= 1, m coefficients mod p^N take N + m nodes at a
+ * working precision of about N + 2m digits; after that every s ∈ Z_p and
+ * every derivative costs a polynomial evaluation instead of fresh
+ * Bernoulli work.
+ */
+class IwasawaSeries {
+private:
+    long prime;
+    long precision;
+    long modulus;
+    long character_index;
+    bool pole;               // χω trivial: coeffs are those of (T - p)·G(T)
+    std::vector<Qp> coeffs;  // g_0, ..., g_{m-1} mod p^N
+    Qp log_u;                // log_p(1 + p)
+
+    Qp t_of(const Zp& s) const;
+
+public:
+    /**
+     * Series for χ mod p^N with `terms` coefficients (0 = precision, which is
+     * every term that matters for s ∈ Z_p since v(T) >= 1)
+     */
+    IwasawaSeries(const DirichletCharacter& chi, long N, long terms = 0);
+
+    /**
+     * Shared series for (χ, N) with the default number of terms, kept in the
+     * library cache
+     */
+    static std::shared_ptr<const IwasawaSeries> get(const DirichletCharacter& chi, long N);
+
+    long get_prime() const { return prime; }
+    long get_precision() const { return precision; }
+    bool has_pole() const { return pole; }
+
+    /**
+     * g_0, ..., g_{m-1}; for has_pole() these are the coefficients of (T - p)·G(T)
+     */
+    const std::vector<Qp>& coefficients() const { return coeffs; }
+
+    /**
+     * G(T) for v(T) >= 1. Throws std::domain_error at the pole T = p.
+     */
+    Qp evaluate_T(const Qp& T) const;
+
+    /**
+     * L_p(s, χ) on this branch for s ∈ Z_p
+     */
+    Qp evaluate(const Zp& s) const;
+    Qp evaluate(long s) const;
+
+    /**
+     * d^k/ds^k L_p(s, χ), from the Taylor expansion of G(T_s + (1 + T_s)(e^{h log u} - 1))
+     * in h, truncated at h^k. This is the s-derivative of the analytic
+     * function that evaluate() and LFunctions::kubota_leopoldt give. It is
+     * not LFunctions::kubota_leopoldt_derivative(0, χ): for odd χ that is the
+     * Reid-Li sum Σ χ(a) log Γ_p(a). Both lie in pZ_p and differ in general
+     * beyond that.
+     */
+    Qp derivative(const Zp& s, long order = 1) const;
+    Qp derivative(long s, long order = 1) const;
+};
+
+} // namespace libadic
+
+#endif // LIBADIC_IWASAWA_SERIES_H
@@ -6,6 +6,7 @@
 #include "libadic/bernoulli.h"
 #include "libadic/padic_log.h"
 #include "libadic/padic_gamma.h"
+#include "libadic/cache.h"
 #include <map>
 #include <cmath>
 #include <string>
@@ -18,28 +19,32 @@ namespace libadic {
  */
 class LFunctions {
 private:
-    // Cache for computed L-values
+    // Cache for computed L-values; the precision is not part of the key,
+    // PrecisionCache serves lower precisions from the most precise value
     struct LKey {
         long s;
         long p;
-        long precision;
         long modulus;
-        long conductor;
-        std::string char_fingerprint;
+        long character;  // DirichletCharacter::index()
         
-        bool operator<(const LKey& other) const {
-            if (s != other.s) return s < other.s;
-            if (p != other.p) return p < other.p;
-            if (precision != other.precision) return precision < other.precision;
-            if (modulus != other.modulus) return modulus < other.modulus;
-            if (conductor != other.conductor) return conductor < other.conductor;
-            return char_fingerprint < other.char_fingerprint;
+        bool operator==(const LKey& other) const {
+            return s == other.s && p == other.p && modulus == other.modulus &&
+                   character == other.character;
         }
     };
     
-    static std::map<LKey, Qp> l_cache;
-    static std::map<LKey, Qp> l_derivative_cache;
-    static std::map<std::pair<long, long>, std::vector<Qp>> mahler_cache;
+    struct LKeyHash {
+        size_t operator()(const LKey& k) const {
+            size_t h = std::hash<long>()(k.character);
+            hash_combine(h, std::hash<long>()(k.s));
+            hash_combine(h, std::hash<long>()(k.p));
+            hash_combine(h, std::hash<long>()(k.modulus));
+            return h;
+        }
+    };
+    
+    static PrecisionCache<LKey, LKeyHash> l_cache;
+    static PrecisionCache<LKey, LKeyHash> l_derivative_cache;
     
 public:
     /**
@@ -51,7 +56,11 @@ public:
     
     /**
      * Compute L'_p(s, χ) - derivative of p-adic L-function
-     * For s = 0, this uses the Ferrero-Washington formula
+     * For s = 0, this uses the Ferrero-Washington formula. For odd χ mod p
+     * that is Σ_{a=1}^{p-1} χ(a) log Γ_p(a) with Morita's Γ_p at the
+     * integers a, the Ψ side of the Reid-Li criterion. It is not the
+     * s-derivative of kubota_leopoldt(s, χ), which IwasawaSeries::derivative
+     * gives; the two agree only mod p, where both vanish.
      */
     static Qp kubota_leopoldt_derivative(long s, const DirichletCharacter& chi, long precision);
     
@@ -84,6 +93,37 @@ public:  // Made public for Python bindings
      */
     static Qp compute_derivative_at_zero_even(const DirichletCharacter& chi, long precision);
     
+    /**
+     * B_{1,χ} for every character χ mod p, indexed as in CharacterSumBatch
+     * (entry 0 is the principal character's B_1 = -1/2)
+     */
+    static std::vector<Qp> compute_B1_chi_all(long p, long precision);
+    
+    /**
+     * Σ_{a=1}^{p-1} χ(a) log Γ_p(a) for every χ mod p, indexed as in
+     * CharacterSumBatch. At odd indices this is L'_p(0, χ).
+     */
+    static std::vector<Qp> compute_derivative_at_zero_odd_all(long p, long precision);
+    
+    /**
+     * compute_B1_chi and compute_derivative_at_zero_odd_all restricted to
+     * the Galois orbit of χ (a character mod p); entry i belongs to
+     * chi.galois_orbit()[i]. One graded sum is shared by the whole orbit, see
+     * CharacterSumBatch::orbit_sum.
+     */
+    static std::vector<Qp> compute_B1_chi_orbit(const DirichletCharacter& chi, long precision);
+    static std::vector<Qp> compute_derivative_at_zero_odd_orbit(const DirichletCharacter& chi, long precision);
+    
+    /**
+     * L'_p(0, χ) for every χ mod p, indexed as in CharacterSumBatch. Odd
+     * characters come from one batched transform, even ones are spread over
+     * `threads` workers (0 = all hardware threads). An entry whose
+     * computation throws is left zero and, if `errors` is given, its message
+     * is stored at the same index (empty strings elsewhere).
+     */
+    static std::vector<Qp> kubota_leopoldt_derivative_all(long p, long precision, size_t threads = 1,
+                                                          std::vector<std::string>* errors = nullptr);
+    
     /**
      * Compute log Γ_p for fractional arguments
      * Uses distribution relations and functional equations
@@ -107,7 +147,8 @@ public:  // Made public for Python bindings
     static Qp compute_euler_maclaurin_correction(long n, long p, long precision);
     
     /**
-     * Compute Mahler coefficients for log Γ_p
+     * Compute Mahler coefficients for log Γ_p (the first
+     * LogGammaMahlerSeries::required_terms() of the shared series)
      */
     static std::vector<Qp> compute_mahler_coefficients(long p, long precision);
     
@@ -116,6 +157,31 @@ public:
      * Clear all caches
      */
     static void clear_cache();
+    
+    /**
+     * Bound the memory held by all library memo tables (L-values, Bernoulli
+     * numbers, character values, ...) to roughly `bytes` in total. Least
+     * recently used entries are evicted once a cache exceeds its share.
+     */
+    static void set_cache_budget(size_t bytes);
+    
+    /**
+     * Hit/miss/eviction counters and current footprint of every library cache
+     */
+    static std::vector<CacheStats> cache_stats();
+    
+    /**
+     * Write the L-value, L'-value and Bernoulli caches, together with
+     * everything already in ResultStore::instance(), to a result store file
+     */
+    static void save_cache(const std::string& path);
+    
+    /**
+     * Warm-start from a file written by save_cache: its entries answer later
+     * queries at their precision or any lower one. Returns the number of
+     * records read.
+     */
+    static size_t load_cache(const std::string& path);
 };
 
 } // namespace libadic
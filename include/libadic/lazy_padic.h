@@ -0,0 +1,99 @@
+#ifndef LIBADIC_LAZY_PADIC_H
+#define LIBADIC_LAZY_PADIC_H
+
+#include "libadic/qp.h"
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace libadic {
+
+/**
+ * A p-adic number that is computed to whatever precision is asked of it.
+ *
+ * Every LazyQp is a node in a shared expression graph: a leaf wraps a
+ * function N ↦ x mod p^N (a constant, or any library routine such as
+ * ReidLi::phi_odd), and the arithmetic operators build nodes that request
+ * their operands at the precision the result needs. Each node memoizes its
+ * best approximation, so asking for more digits only reruns the nodes whose
+ * cached precision falls short, and asking for fewer is a truncation.
+ *
+ * Operands of products and quotients are requested with enough extra
+ * digits to cover the valuations involved; `valuation_bound` is a lower
+ * bound on the valuation used for that (exact for constants, 0 by default
+ * for functions, and propagated through + - * /).
+ */
+class LazyQp {
+public:
+    using Evaluator = std::function<Qp(long)>;
+
+    /**
+     * Zero for p
+     */
+    explicit LazyQp(long p = 2);
+
+    /**
+     * The exact constant x; requests beyond its precision are capped there
+     */
+    explicit LazyQp(const Qp& x);
+    explicit LazyQp(const Zp& x);
+
+    static LazyQp from_integer(long p, long n);
+    static LazyQp from_rational(long num, long den, long p);
+
+    /**
+     * A number defined by `f`, where f(N) returns an approximation with
+     * absolute precision N (or as close to N as the routine manages; the
+     * request is raised by the shortfall until it delivers).
+     */
+    static LazyQp from_function(long p, Evaluator f, long valuation_bound = 0);
+
+    long get_prime() const { return node->prime; }
+    long valuation_bound() const { return node->valuation_bound; }
+
+    /**
+     * Highest absolute precision computed so far
+     */
+    long known_precision() const;
+
+    /**
+     * This number modulo p^N (absolute precision min(N, what the leaves can
+     * deliver)), computing only the digits not already memoized
+     */
+    Qp approximate(long N) const;
+
+    /**
+     * v(x), raising the precision by doubling from `initial` until a nonzero
+     * digit appears; returns max_precision if x vanishes to that precision
+     */
+    long valuation(long max_precision, long initial = 8) const;
+
+    LazyQp operator+(const LazyQp& other) const;
+    LazyQp operator-(const LazyQp& other) const;
+    LazyQp operator*(const LazyQp& other) const;
+    LazyQp operator/(const LazyQp& other) const;
+    LazyQp operator-() const;
+
+private:
+    struct Node {
+        long prime = 2;
+        long valuation_bound = 0;
+        long precision_cap = 0;  // > 0 for exact constants
+        Evaluator evaluate;
+
+        mutable std::mutex mutex;
+        mutable Qp cached;
+        mutable long cached_precision = 0;
+    };
+
+    std::shared_ptr<const Node> node;
+
+    explicit LazyQp(std::shared_ptr<const Node> n) : node(std::move(n)) {}
+
+    static LazyQp make(long p, long valuation_bound, Evaluator f);
+    void check_prime(const LazyQp& other) const;
+};
+
+} // namespace libadic
+
+#endif // LIBADIC_LAZY_PADIC_H
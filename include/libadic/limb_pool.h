@@ -0,0 +1,52 @@
+#ifndef LIBADIC_LIMB_POOL_H
+#define LIBADIC_LIMB_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace libadic {
+
+/**
+ * Pooled limb allocator for GMP.
+ *
+ * BigInt intermediates are mostly a few limbs wide and live for one
+ * operation, so with GMP's default functions almost every Zp/Qp operation
+ * is a malloc/free pair. install() routes GMP's memory functions through
+ * per-thread free lists of power-of-two size classes (16 to
+ * max_pooled_bytes bytes) carved from 1 MiB slabs; larger blocks go to the
+ * functions that were installed before.
+ *
+ * Blocks are recognised by their slab address, so blocks allocated before
+ * install() (static constants, other libraries sharing GMP) are still
+ * released through the previous functions, and installing at any point is
+ * safe. Free lists of exiting threads are handed to a shared list. Slabs
+ * are kept for the lifetime of the process, so the pool's footprint is the
+ * high-water mark of small live blocks.
+ *
+ * Building with -DLIBADIC_POOLED_GMP=ON installs the pool at load time
+ * (with a static libadic, in programs that link limb_pool.o, e.g. through
+ * any reference to LimbPool).
+ */
+class LimbPool {
+public:
+    static constexpr size_t max_pooled_bytes = 512;
+    static constexpr size_t slab_bytes = size_t(1) << 20;
+
+    /**
+     * Route GMP allocations through the pool (idempotent; call before other
+     * threads use GMP). There is no uninstall: pooled blocks must only ever
+     * be freed by the pool.
+     */
+    static void install();
+
+    static bool installed();
+
+    /**
+     * Slabs obtained so far
+     */
+    static size_t slabs();
+};
+
+} // namespace libadic
+
+#endif // LIBADIC_LIMB_POOL_H
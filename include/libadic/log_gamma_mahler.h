@@ -0,0 +1,89 @@
+#ifndef LIBADIC_LOG_GAMMA_MAHLER_H
+#define LIBADIC_LOG_GAMMA_MAHLER_H
+
+#include "libadic/qp.h"
+#include "libadic/zp.h"
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace libadic {
+
+/**
+ * Mahler expansion of the p-adic log Gamma function at precision N:
+ *
+ *   log Γ_p(x) = Σ_{n>=0} a_n C(x, n),   a_n = Δ^n f(0),
+ *
+ * where f(k) = log Γ_p(k) is the Iwasawa logarithm of
+ * Γ_p(k) = (-1)^k ∏_{j<k, p∤j} j.
+ *
+ * Coefficients are produced lazily one at a time. Only the last diagonal
+ * D[j] = Δ^j f(m-j) of the difference table is kept and updated in place,
+ * so extending from m to m+1 coefficients costs m+1 additions on top of
+ * f(m), with O(m) memory in total. For odd p the values f(m) of an
+ * extension come from one PadicGamma::log_gamma_range pass.
+ *
+ * v(a_n) grows roughly like n/p, so p(N+1) terms give log Γ_p(x) to
+ * precision N for any x ∈ Z_p. The series is therefore meant for small and
+ * moderate p; log Γ_p(a) for 0 < a < p is cheaper from LogGammaTable.
+ */
+class LogGammaMahlerSeries {
+private:
+    long prime;
+    long precision;
+
+    mutable std::mutex mutex;
+    mutable std::vector<Qp> coeffs;    // a_0, ..., a_{m-1}
+    mutable std::vector<Qp> diagonal;  // diagonal[j] = Δ^j f(m-1-j)
+    mutable BigInt gamma;              // p = 2: |Γ_p(m)| = ∏_{j<m, p∤j} j mod p^{N+1}
+
+    /**
+     * Append coefficients until there are at least `count` (mutex held)
+     */
+    void extend(size_t count) const;
+
+    /**
+     * f(m) for the next integer m = coeffs.size(), advancing `gamma` (p = 2;
+     * odd p takes f from PadicGamma::log_gamma_range)
+     */
+    Qp next_value() const;
+
+public:
+    LogGammaMahlerSeries(long p, long N);
+
+    /**
+     * Shared series for (p, N), built with required_terms() coefficients on
+     * first use and kept in the library cache
+     */
+    static std::shared_ptr<const LogGammaMahlerSeries> get(long p, long N);
+
+    long get_prime() const { return prime; }
+    long get_precision() const { return precision; }
+
+    /**
+     * Number of terms evaluate() sums
+     */
+    size_t required_terms() const { return static_cast<size_t>(prime * (precision + 1)); }
+
+    /**
+     * a_0, ..., a_{count-1}, extending the series if needed
+     */
+    std::vector<Qp> coefficients(size_t count) const;
+
+    /**
+     * a_n, extending the series if needed
+     */
+    Qp coefficient(size_t n) const;
+
+    /**
+     * log Γ_p(x) for x ∈ Z_p, summing required_terms() terms of the
+     * expansion. C(x, n) is carried as a unit times a power of p, so no
+     * precision is lost to the n! in its denominator.
+     */
+    Qp evaluate(const Zp& x) const;
+};
+
+} // namespace libadic
+
+#endif // LIBADIC_LOG_GAMMA_MAHLER_H
@@ -0,0 +1,56 @@
+#ifndef LIBADIC_LOG_GAMMA_TABLE_H
+#define LIBADIC_LOG_GAMMA_TABLE_H
+
+#include "libadic/qp.h"
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace libadic {
+
+/**
+ * log Γ_p(a) for every a in [1, p-1] at precision N.
+ *
+ * Character sums such as Σ χ(a) log Γ_p(a) reuse the same p-1 logarithms
+ * for every χ mod p; building them once per (p, N) turns a full character
+ * sweep from O(#χ · p · log-cost) into O(p · log-cost + #χ · p).
+ */
+class LogGammaTable {
+private:
+    long prime;
+    long precision;
+    std::vector<Qp> values;  // values[a] = log Γ_p(a); values[0] unused
+
+public:
+    /**
+     * Build the table, spreading the p-1 logarithms over `threads` workers
+     * (1 = build on the calling thread, 0 = all hardware threads).
+     */
+    LogGammaTable(long p, long N, size_t threads = 1);
+
+    /**
+     * Shared table for (p, N), built on first use and kept in the library
+     * cache (so it counts against LFunctions::set_cache_budget).
+     */
+    static std::shared_ptr<const LogGammaTable> get(long p, long N, size_t threads = 1);
+
+    long get_prime() const { return prime; }
+    long get_precision() const { return precision; }
+
+    /**
+     * log Γ_p(a) for 1 <= a <= p-1
+     */
+    const Qp& at(long a) const {
+        if (a < 1 || a >= prime) {
+            throw std::out_of_range("LogGammaTable index must satisfy 0 < a < p");
+        }
+        return values[a];
+    }
+
+    const Qp& operator[](long a) const { return values[a]; }
+};
+
+} // namespace libadic
+
+#endif // LIBADIC_LOG_GAMMA_TABLE_H
@@ -2,6 +2,13 @@
 #define LIBADIC_MODULAR_ARITH_H
 
 #include "libadic/gmp_wrapper.h"
+#include "libadic/padic_context.h"
+#include "libadic/teichmuller_table.h"
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 namespace libadic {
 
@@ -29,35 +36,120 @@ inline BigInt mod_pow(const BigInt& base, const BigInt& exp, const BigInt& mod)
     return base.pow_mod(exp, mod);
 }
 
+/**
+ * Deprecated: returns a mod p^to_precision and ignores from_precision. An
+ * integer a already fixes all of its digits, so there is nothing to lift;
+ * lifting a root of an equation past the digits known mod p is what
+ * hensel_lift_root does.
+ */
+[[deprecated("hensel_lift only reduces a mod p^to_precision; use hensel_lift_root to lift a root")]]
 inline BigInt hensel_lift(const BigInt& a, const BigInt& p, long from_precision, long to_precision) {
-    BigInt result = a % p.pow(from_precision);
-    BigInt p_power = p.pow(from_precision);
-    
-    for (long k = from_precision; k < to_precision; ++k) {
-        BigInt f = result;
-        BigInt target = a % p.pow(k + 1);
-        BigInt diff = (target - f) / p_power;
-        result = result + diff * p_power;
-        p_power *= p;
+    (void)from_precision;
+    return a % PadicContext::get(p.to_long(), to_precision).power(to_precision);
+}
+
+/**
+ * Newton/Hensel lift of a simple root: given x0 with f(x0) ≡ 0 (mod p) and
+ * f'(x0) a unit, returns the root x ≡ x0 (mod p) of f modulo p^N.
+ *
+ * f(x, m) and df(x, m) return f(x) and f'(x) modulo m (any representative).
+ * Callers may cache work shared between the two, but must not rely on the
+ * order of the calls.
+ * Each step x <- x - f(x)/f'(x) doubles the number of correct digits, and
+ * f'(x) only has to be inverted to the digits already known, so the lift
+ * takes ceil(log2 N) steps. Throws std::domain_error if x0 is not a simple
+ * root mod p.
+ */
+template <typename F, typename DF>
+BigInt hensel_lift_root(F&& f, DF&& df, const BigInt& x0, long p, long N) {
+    if (p < 2) {
+        throw std::invalid_argument("Prime must be >= 2");
     }
-    
-    return result % p.pow(to_precision);
+    if (N < 1) {
+        throw std::invalid_argument("Precision must be >= 1");
+    }
+    const PadicContext& ctx = PadicContext::get(p, N);
+    const BigInt& prime = ctx.prime_bigint();
+
+    BigInt x, value, inverse;
+    mpz_fdiv_r(x.get_mpz(), x0.get_mpz(), prime.get_mpz());
+    value = f(x, prime);
+    if (!value.is_divisible_by(prime)) {
+        throw std::domain_error("hensel_lift_root: x0 is not a root mod p");
+    }
+    inverse = df(x, prime);
+    if (inverse.is_divisible_by(prime)) {
+        throw std::domain_error("hensel_lift_root: f'(x0) is not a unit mod p");
+    }
+
+    for (long k = 1; k < N;) {
+        long next = std::min(2 * k, N);
+        const BigInt& m = ctx.power(next);
+        const BigInt& known = ctx.power(k);
+        value = f(x, m);
+        inverse = df(x, known);
+        mpz_invert(inverse.get_mpz(), inverse.get_mpz(), known.get_mpz());
+        mpz_mul(value.get_mpz(), value.get_mpz(), inverse.get_mpz());
+        mpz_sub(x.get_mpz(), x.get_mpz(), value.get_mpz());
+        mpz_fdiv_r(x.get_mpz(), x.get_mpz(), m.get_mpz());
+        k = next;
+    }
+    return x;
+}
+
+/**
+ * hensel_lift_root for f(x) = c[0] + c[1] x + ... + c[d] x^d. Defined in
+ * modular_arith.cpp.
+ */
+BigInt hensel_lift_root(const std::vector<BigInt>& coefficients, const BigInt& x0, long p, long N);
+
+/**
+ * Square root of a unit a modulo p^N: Tonelli-Shanks mod p, then
+ * hensel_lift_root on x^2 - a. For p = 2 (a ≡ 1 mod 8) the lift runs on
+ * x <- x + (a - x^2)/(2x), which takes k correct bits to 2k - 2, and the root
+ * returned is the one ≡ 1 (mod 4). Its square is a mod 2^N, but since x and
+ * x + 2^{N-1} square to the same value mod 2^N only its residue mod 2^{N-1}
+ * is determined by a; Zp::sqrt reports that precision. Throws
+ * std::domain_error if a is not a unit square. Defined in modular_arith.cpp.
+ */
+BigInt padic_sqrt(const BigInt& a, long p, long N);
+
+/**
+ * n = p^valuation · unit with p ∤ unit; unit keeps the sign of n
+ */
+struct ValuationSplit {
+    long valuation;
+    BigInt unit;
+};
+
+/**
+ * Valuation and unit of n in one mpz_remove pass (GMP strips p^(2^k) by
+ * repeated squaring instead of dividing by p once per digit). n = 0 gives
+ * valuation -1 and unit 0.
+ */
+inline ValuationSplit split_valuation(const BigInt& n, const BigInt& p) {
+    ValuationSplit split{0, BigInt()};
+    if (n.is_zero()) {
+        split.valuation = -1;
+        return split;
+    }
+    if (!n.is_divisible_by(p)) {
+        split.unit = n;
+        return split;
+    }
+    split.valuation = static_cast<long>(mpz_remove(split.unit.get_mpz(), n.get_mpz(), p.get_mpz()));
+    return split;
 }
 
 inline long p_adic_valuation(const BigInt& n, const BigInt& p) {
     if (n.is_zero()) {
         return -1;
     }
-    
-    BigInt temp = n.abs();
-    long valuation = 0;
-    
-    while (temp.is_divisible_by(p)) {
-        temp /= p;
-        valuation++;
+    if (!n.is_divisible_by(p)) {
+        return 0;
     }
-    
-    return valuation;
+    BigInt unit;
+    return static_cast<long>(mpz_remove(unit.get_mpz(), n.get_mpz(), p.get_mpz()));
 }
 
 inline BigInt teichmuller_character(const BigInt& a, const BigInt& p, long precision) {
@@ -65,26 +157,66 @@ inline BigInt teichmuller_character(const BigInt& a, const BigInt& p, long preci
         return BigInt(0);
     }
     
-    BigInt p_power = p.pow(precision);
-    BigInt a_mod = a % p_power;
-    
-    if ((a_mod % p).is_zero()) {
-        return BigInt(0);
-    }
-    
     // The Teichmüller character ω(a) is the unique (p-1)-th root of unity
-    // that is congruent to a modulo p
-    // We compute it iteratively: ω = lim_{n→∞} a^{p^n}
-    
-    BigInt omega = a_mod;
-    
-    // Iterate: omega_{n+1} = omega_n^p mod p^precision
-    // This converges quickly to the Teichmüller character
-    for (long i = 0; i < precision; ++i) {
-        omega = omega.pow_mod(p, p_power);
-    }
-    
-    return omega;
+    // that is congruent to a modulo p (0 when p | a); read it from the
+    // shared (p, N) table
+    return TeichmullerTable::lift(a, p.to_long(), precision);
+}
+
+/**
+ * Replace values[0..count) by their inverses modulo `mod` with Montgomery's
+ * trick: the prefix products are inverted once and peeled back, so the batch
+ * costs one mpz_invert and 3(count-1) multiplications. Throws
+ * std::domain_error, leaving the values untouched, if any is not invertible.
+ * Defined in modular_arith.cpp.
+ */
+void batch_mod_inverse(BigInt* values, size_t count, const BigInt& mod);
+
+inline void batch_mod_inverse(std::vector<BigInt>& values, const BigInt& mod) {
+    batch_mod_inverse(values.data(), values.size(), mod);
+}
+
+/**
+ * Product of the integers lo..hi (1 <= lo) modulo p^N on mpz: factors are
+ * packed into machine words until the next one would overflow, the words are
+ * multiplied pairwise up a balanced tree, and a node is reduced only once it
+ * outgrows p^N. Defined in modular_arith.cpp.
+ */
+BigInt product_tree_mod(long lo, long hi, const PadicContext& ctx, bool skip_multiples_of_p);
+
+/**
+ * Product of the integers lo..hi modulo p^N, optionally skipping multiples
+ * of p (the building block of n! mod p^N and of Morita's Gamma_p).
+ * Runs in machine words when p^N fits, otherwise through product_tree_mod.
+ */
+inline BigInt product_mod(long lo, long hi, const PadicContext& ctx, bool skip_multiples_of_p) {
+    const long p = ctx.get_prime();
+    return dispatch_zp_backend(ctx,
+        [&](const auto& be) {
+            using word = typename std::decay_t<decltype(be)>::word;
+            auto acc = be.one();
+            for (long k = lo; k <= hi; ++k) {
+                if (skip_multiples_of_p && k % p == 0) continue;
+                // k mod p^N; -(k + 1) cannot overflow
+                word r = k >= 0 ? static_cast<word>(k) % be.n
+                                : be.n - 1 - static_cast<word>(-(k + 1)) % be.n;
+                acc = be.mul(acc, be.to_mont(r));
+            }
+            return bigint_from_u128(be.from_mont(acc));
+        },
+        [&]() {
+            if (lo >= 1) {
+                return product_tree_mod(lo, hi, ctx, skip_multiples_of_p);
+            }
+            BigInt acc(1);
+            ctx.reduce(acc);
+            for (long k = lo; k <= hi; ++k) {
+                if (skip_multiples_of_p && k % p == 0) continue;
+                mpz_mul_si(acc.get_mpz(), acc.get_mpz(), k);
+                ctx.reduce(acc);
+            }
+            return acc;
+        });
 }
 
 } // namespace libadic
@@ -0,0 +1,228 @@
+#ifndef LIBADIC_MONTGOMERY_H
+#define LIBADIC_MONTGOMERY_H
+
+#include "libadic/gmp_wrapper.h"
+#include <cstdint>
+
+namespace libadic {
+
+__extension__ typedef unsigned __int128 u128;
+
+/**
+ * Conversions between BigInt and machine words for non-negative values
+ * below 2^128.
+ */
+inline u128 u128_from_bigint(const BigInt& x) {
+    uint64_t words[2] = {0, 0};
+    size_t count = 0;
+    mpz_export(words, &count, -1, sizeof(uint64_t), 0, 0, x.get_mpz());
+    return (static_cast<u128>(words[1]) << 64) | words[0];
+}
+
+inline BigInt bigint_from_u128(u128 x) {
+    uint64_t words[2] = {static_cast<uint64_t>(x), static_cast<uint64_t>(x >> 64)};
+    BigInt result;
+    mpz_import(result.get_mpz(), 2, -1, sizeof(uint64_t), 0, 0, words);
+    return result;
+}
+
+/**
+ * Montgomery arithmetic modulo p^N in a single 64-bit word.
+ *
+ * Requires p^N < 2^63 so that a sum of two residues cannot overflow.
+ * For p = 2 the modulus is even and Montgomery reduction does not apply;
+ * residues are then kept in plain form and reduced with a bit mask.
+ * All residues handed to add/sub/mul are in Montgomery form.
+ */
+struct Word64Backend {
+    using word = uint64_t;
+
+    word n = 0;          // modulus p^N
+    word n_neg_inv = 0;  // -n^{-1} mod 2^64
+    word r1 = 0;         // R mod n (Montgomery form of 1)
+    word r2 = 0;         // R^2 mod n
+    word phi = 0;        // |(Z/nZ)^*| = p^(N-1) (p-1)
+    bool pow2 = false;
+
+    static bool fits(const BigInt& modulus) {
+        return modulus.size_in_base(2) <= 63;
+    }
+
+    Word64Backend() = default;
+
+    Word64Backend(long p, const BigInt& modulus)
+        : Word64Backend(p, static_cast<word>(u128_from_bigint(modulus))) {}
+
+    /**
+     * Constant-expression form, for moduli fixed at compile time (StaticZp)
+     */
+    constexpr Word64Backend(long p, word modulus) {
+        n = modulus;
+        phi = (n / static_cast<word>(p)) * static_cast<word>(p - 1);
+        pow2 = (p == 2);
+        if (pow2) {
+            r1 = 1 % n;
+            r2 = r1;
+            return;
+        }
+        word inv = n;  // correct to 3 bits for odd n; each step doubles
+        for (int i = 0; i < 5; ++i) {
+            inv *= 2 - n * inv;
+        }
+        n_neg_inv = static_cast<word>(0) - inv;
+        r1 = static_cast<word>((static_cast<u128>(1) << 64) % n);
+        r2 = static_cast<word>((static_cast<u128>(r1) * r1) % n);
+    }
+
+    constexpr word redc(u128 t) const {
+        word m = static_cast<word>(t) * n_neg_inv;
+        word u = static_cast<word>((t + static_cast<u128>(m) * n) >> 64);
+        return u >= n ? u - n : u;
+    }
+
+    constexpr word mul(word a, word b) const {
+        if (pow2) {
+            return static_cast<word>(static_cast<u128>(a) * b % n);
+        }
+        return redc(static_cast<u128>(a) * b);
+    }
+
+    constexpr word add(word a, word b) const {
+        word s = a + b;
+        return s >= n ? s - n : s;
+    }
+
+    constexpr word sub(word a, word b) const {
+        return a >= b ? a - b : a + (n - b);
+    }
+
+    constexpr word to_mont(word a) const { return pow2 ? a % n : mul(a % n, r2); }
+    constexpr word from_mont(word a) const { return pow2 ? a : redc(a); }
+    constexpr word one() const { return r1; }
+
+    word to_mont(const BigInt& a) const {
+        BigInt r = a;
+        mpz_fdiv_r_ui(r.get_mpz(), r.get_mpz(), n);
+        return to_mont(static_cast<word>(u128_from_bigint(r)));
+    }
+
+    constexpr word pow(word a, u128 e) const {
+        word result = one();
+        while (e > 0) {
+            if (e & 1) result = mul(result, a);
+            a = mul(a, a);
+            e >>= 1;
+        }
+        return result;
+    }
+
+    /**
+     * Inverse of a unit via Euler's theorem
+     */
+    constexpr word inverse(word a) const { return pow(a, static_cast<u128>(phi) - 1); }
+};
+
+/**
+ * Montgomery arithmetic modulo p^N in two 64-bit words (p^N < 2^127).
+ */
+struct Word128Backend {
+    using word = u128;
+
+    word n = 0;
+    word n_neg_inv = 0;  // -n^{-1} mod 2^128
+    word r1 = 0;         // R mod n
+    word r2 = 0;         // R^2 mod n
+    word phi = 0;
+    bool pow2 = false;
+
+    static bool fits(const BigInt& modulus) {
+        return modulus.size_in_base(2) <= 127;
+    }
+
+    Word128Backend() = default;
+
+    Word128Backend(long p, const BigInt& modulus) {
+        n = u128_from_bigint(modulus);
+        phi = (n / static_cast<word>(p)) * static_cast<word>(p - 1);
+        pow2 = (p == 2);
+        BigInt R = BigInt(2).pow(128);
+        r1 = pow2 ? 1 % n : u128_from_bigint(R % modulus);
+        r2 = pow2 ? r1 : u128_from_bigint((R * R) % modulus);
+        if (!pow2) {
+            word inv = n;
+            for (int i = 0; i < 6; ++i) {
+                inv *= 2 - n * inv;
+            }
+            n_neg_inv = static_cast<word>(0) - inv;
+        }
+    }
+
+    /**
+     * Full 256-bit product a*b as (hi, lo)
+     */
+    static void mul_wide(word a, word b, word& hi, word& lo) {
+        uint64_t a0 = static_cast<uint64_t>(a), a1 = static_cast<uint64_t>(a >> 64);
+        uint64_t b0 = static_cast<uint64_t>(b), b1 = static_cast<uint64_t>(b >> 64);
+        u128 p00 = static_cast<u128>(a0) * b0;
+        u128 p01 = static_cast<u128>(a0) * b1;
+        u128 p10 = static_cast<u128>(a1) * b0;
+        u128 p11 = static_cast<u128>(a1) * b1;
+        u128 mid = (p00 >> 64) + static_cast<uint64_t>(p01) + static_cast<uint64_t>(p10);
+        lo = (mid << 64) | static_cast<uint64_t>(p00);
+        hi = p11 + (p01 >> 64) + (p10 >> 64) + (mid >> 64);
+    }
+
+    word redc(word hi, word lo) const {
+        word m = lo * n_neg_inv;
+        word mh, ml;
+        mul_wide(m, n, mh, ml);
+        word sum_lo = lo + ml;
+        word carry = sum_lo < lo ? 1 : 0;
+        word u = hi + mh + carry;
+        return u >= n ? u - n : u;
+    }
+
+    word mul(word a, word b) const {
+        word hi, lo;
+        mul_wide(a, b, hi, lo);
+        if (pow2) {
+            return lo % n;  // n = 2^N divides 2^128
+        }
+        return redc(hi, lo);
+    }
+
+    word add(word a, word b) const {
+        word s = a + b;
+        return s >= n ? s - n : s;
+    }
+
+    word sub(word a, word b) const {
+        return a >= b ? a - b : a + (n - b);
+    }
+
+    word to_mont(word a) const { return pow2 ? a % n : mul(a % n, r2); }
+    word from_mont(word a) const { return pow2 ? a : redc(0, a); }
+    word one() const { return r1; }
+
+    word to_mont(const BigInt& a) const {
+        BigInt r = a;
+        mpz_fdiv_r(r.get_mpz(), r.get_mpz(), bigint_from_u128(n).get_mpz());
+        return to_mont(u128_from_bigint(r));
+    }
+
+    word pow(word a, u128 e) const {
+        word result = one();
+        while (e > 0) {
+            if (e & 1) result = mul(result, a);
+            a = mul(a, a);
+            e >>= 1;
+        }
+        return result;
+    }
+
+    word inverse(word a) const { return pow(a, phi - 1); }
+};
+
+} // namespace libadic
+
+#endif // LIBADIC_MONTGOMERY_H
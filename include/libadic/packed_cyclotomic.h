@@ -0,0 +1,108 @@
+#ifndef LIBADIC_PACKED_CYCLOTOMIC_H
+#define LIBADIC_PACKED_CYCLOTOMIC_H
+
+#include "libadic/qp.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace libadic {
+
+class Cyclotomic;
+
+/**
+ * Element of Q_p(ζ_p) with one shared valuation and precision.
+ *
+ *   α = p^v · Σ_{i=0}^{p-2} c_i ζ^i,  c_i ∈ [0, p^{N-v}),  known mod p^N
+ *
+ * The c_i sit in fixed-width slots of a single limb buffer instead of p-1
+ * separate Qp objects. Multiplication packs both operands into one integer
+ * (Kronecker substitution), so a single mpz_mul does the polynomial
+ * product with GMP's Toom/FFT algorithms, then folds the 2p-3 product
+ * coefficients modulo Φ_p in one pass.
+ *
+ * The valuation is not normalised: all c_i may be divisible by p. That only
+ * means more digits are carried than necessary; the value and its absolute
+ * precision are exact.
+ */
+class PackedCyclotomic {
+private:
+    long prime;
+    long precision;               // absolute precision N
+    long valuation;               // shared v; v >= N means zero
+    size_t width;                 // limbs per coefficient slot
+    std::vector<mp_limb_t> limbs; // p-1 slots of `width` limbs, least significant first
+
+    long degree() const { return prime - 1; }
+    long unit_precision() const { return precision - valuation; }
+
+    /**
+     * Read-only mpz view of slot i (no allocation)
+     */
+    void view(size_t i, mpz_t out) const;
+
+    /**
+     * Store a value in [0, p^{N-v}) into slot i
+     */
+    void store(size_t i, const mpz_t value);
+
+    /**
+     * Become zero at absolute precision N, with room for unit precision M
+     */
+    void reset(long N, long v);
+
+    friend PackedCyclotomic multiply(const PackedCyclotomic& a, const PackedCyclotomic& b);
+
+public:
+    PackedCyclotomic();
+    PackedCyclotomic(long p, long N);
+    PackedCyclotomic(long p, long N, const Qp& constant);
+    explicit PackedCyclotomic(const Cyclotomic& c);
+
+    /**
+     * ζ^k, reduced with ζ^p = 1 and ζ^{p-1} = -(1 + ζ + ... + ζ^{p-2})
+     */
+    static PackedCyclotomic monomial(long p, long N, long k);
+
+    long get_prime() const { return prime; }
+    long get_precision() const { return precision; }
+    long get_valuation() const { return valuation; }
+
+    /**
+     * Coefficient of ζ^i as a Qp (0 <= i < p-1)
+     */
+    Qp coeff(size_t i) const;
+
+    Cyclotomic to_cyclotomic() const;
+
+    bool is_zero() const;
+
+    PackedCyclotomic operator+(const PackedCyclotomic& other) const;
+    PackedCyclotomic operator-(const PackedCyclotomic& other) const;
+    PackedCyclotomic operator-() const;
+    PackedCyclotomic operator*(const PackedCyclotomic& other) const;
+    PackedCyclotomic operator*(const Qp& scalar) const;
+
+    PackedCyclotomic& operator+=(const PackedCyclotomic& other);
+    PackedCyclotomic& operator-=(const PackedCyclotomic& other);
+    PackedCyclotomic& operator*=(const PackedCyclotomic& other);
+
+    /**
+     * *this += a * b
+     */
+    PackedCyclotomic& addmul(const PackedCyclotomic& a, const PackedCyclotomic& b);
+
+    /**
+     * *this += a * scalar
+     */
+    PackedCyclotomic& addmul(const PackedCyclotomic& a, const Qp& scalar);
+
+    bool operator==(const PackedCyclotomic& other) const;
+    bool operator!=(const PackedCyclotomic& other) const { return !(*this == other); }
+
+    std::string to_string() const;
+};
+
+} // namespace libadic
+
+#endif // LIBADIC_PACKED_CYCLOTOMIC_H
@@ -0,0 +1,140 @@
+#ifndef LIBADIC_PADIC_CONTEXT_H
+#define LIBADIC_PADIC_CONTEXT_H
+
+#include "libadic/gmp_wrapper.h"
+#include "libadic/montgomery.h"
+#include <vector>
+#include <stdexcept>
+
+namespace libadic {
+
+/**
+ * Shared modulus data for a fixed (p, N).
+ *
+ * Holds p^k for every 0 <= k <= N so that arithmetic in Z/p^N Z never has
+ * to rebuild BigInt(p).pow(k) on the fly. Contexts are interned: get()
+ * returns the same object for the same (p, N) for the lifetime of the
+ * process, so Zp can keep a plain pointer to it.
+ *
+ * Barrett reduction on top of mpz was measured slower than mpz_tdiv_r for
+ * every modulus size we use (GMP already works with a precomputed inverse
+ * inside its division), so reduce() is a thin wrapper around GMP division.
+ * When p^N fits in one or two machine words the context also carries the
+ * Montgomery parameters used by the fixed-width ZpT backends.
+ */
+enum class ZpBackendKind { Word64, Word128, GMP };
+
+class PadicContext {
+private:
+    long prime;
+    long precision;
+    std::vector<BigInt> powers;  // powers[k] = p^k, 0 <= k <= precision
+    ZpBackendKind kind;
+    Word64Backend w64;
+    Word128Backend w128;
+
+    PadicContext(long p, long N) : prime(p), precision(N), kind(ZpBackendKind::GMP) {
+        powers.reserve(N + 1);
+        powers.emplace_back(1);
+        BigInt p_big(p);
+        for (long k = 1; k <= N; ++k) {
+            powers.push_back(powers.back() * p_big);
+        }
+        if (Word128Backend::fits(modulus())) {
+            w128 = Word128Backend(p, modulus());
+            kind = ZpBackendKind::Word128;
+        }
+        if (Word64Backend::fits(modulus())) {
+            w64 = Word64Backend(p, modulus());
+            kind = ZpBackendKind::Word64;
+        }
+    }
+
+public:
+    PadicContext(const PadicContext&) = delete;
+    PadicContext& operator=(const PadicContext&) = delete;
+
+    /**
+     * Interned context for (p, N). Thread-safe; repeated lookups for the same
+     * pair are served from a small per-thread table without locking.
+     */
+    static const PadicContext& get(long p, long N);
+
+    long get_prime() const { return prime; }
+    long get_precision() const { return precision; }
+
+    /**
+     * p^k for 0 <= k <= N
+     */
+    const BigInt& power(long k) const {
+        if (k < 0 || k > precision) {
+            throw std::out_of_range("PadicContext power exponent out of range");
+        }
+        return powers[k];
+    }
+
+    /**
+     * The modulus p^N
+     */
+    const BigInt& modulus() const { return powers[precision]; }
+
+    const BigInt& prime_bigint() const { return powers[precision >= 1 ? 1 : 0]; }
+
+    /**
+     * Narrowest backend that can hold residues mod p^N
+     */
+    ZpBackendKind backend_kind() const { return kind; }
+
+    /**
+     * Montgomery parameters; only valid when backend_kind() says they fit
+     * (word128() is also valid whenever word64() is).
+     */
+    const Word64Backend& word64() const { return w64; }
+    const Word128Backend& word128() const { return w128; }
+
+    /**
+     * Reduce x into [0, p^N) in place
+     */
+    void reduce(BigInt& x) const {
+        mpz_fdiv_r(x.get_mpz(), x.get_mpz(), modulus().get_mpz());
+    }
+
+    /**
+     * Reduce x into [0, p^k) in place
+     */
+    void reduce(BigInt& x, long k) const {
+        mpz_fdiv_r(x.get_mpz(), x.get_mpz(), power(k).get_mpz());
+    }
+
+    /**
+     * Reduce a value known to lie in [0, 2p^N) with a single conditional
+     * subtraction (the common case after adding two reduced residues).
+     */
+    void reduce_once(BigInt& x) const {
+        if (mpz_cmp(x.get_mpz(), modulus().get_mpz()) >= 0) {
+            mpz_sub(x.get_mpz(), x.get_mpz(), modulus().get_mpz());
+        }
+    }
+};
+
+/**
+ * Run word_fn(backend) on the narrowest fixed-width backend that holds
+ * residues mod p^N, or big_fn() when p^N needs GMP. word_fn is normally a
+ * generic lambda so the kernel is instantiated once per backend.
+ */
+template<class WordFn, class BigFn>
+auto dispatch_zp_backend(const PadicContext& ctx, WordFn&& word_fn, BigFn&& big_fn)
+    -> decltype(big_fn()) {
+    switch (ctx.backend_kind()) {
+        case ZpBackendKind::Word64:
+            return word_fn(ctx.word64());
+        case ZpBackendKind::Word128:
+            return word_fn(ctx.word128());
+        default:
+            return big_fn();
+    }
+}
+
+} // namespace libadic
+
+#endif // LIBADIC_PADIC_CONTEXT_H
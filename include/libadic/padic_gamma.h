@@ -5,30 +5,15 @@
 #include "qp.h"
 #include "padic_log.h"
 #include "iwasawa_log.h"
+#include "gamma_engine.h"
+#include "factorial_table.h"
+#include "stats.h"
 #include <vector>
 
 namespace libadic {
 
 class PadicGamma {
 private:
-    static BigInt factorial_mod(long n, const BigInt& mod) {
-        BigInt result(1);
-        for (long i = 2; i <= n; ++i) {
-            result = (result * BigInt(i)) % mod;
-        }
-        return result;
-    }
-    
-    static BigInt wilson_product(long n, long p, const BigInt& p_power) {
-        BigInt result(1);
-        for (long i = 1; i <= n; ++i) {
-            if (i % p != 0) {
-                result = (result * BigInt(i)) % p_power;
-            }
-        }
-        return result;
-    }
-    
     static long count_p_factorial(long n, long p) {
         long count = 0;
         long p_power = p;
@@ -42,6 +27,7 @@ private:
     
 public:
     static Zp gamma(const Zp& x) {
+        stats::Scope scope(stats::Id::gamma);
         long p = x.get_prime();
         long N = x.get_precision();
         
@@ -60,6 +46,12 @@ public:
         
         long x_mod_p = x_val.to_long();
         
+        // Integers below p are products of the first x-1 units; everything
+        // else goes through the shared window polynomial
+        if (x.get_value() >= BigInt(p)) {
+            return GammaEngine::get(p, N)->gamma(x);
+        }
+        
         if (x_mod_p == 1) {
             return Zp(p, N, -1);
         }
@@ -68,36 +60,13 @@ public:
             return Zp(p, N, 1);
         }
         
-        BigInt p_power = BigInt(p).pow(N);
-        BigInt result(1);
+        const PadicContext& ctx = x.get_context();
+        const BigInt& p_power = ctx.modulus();
         
-        if (x_mod_p <= p / 2) {
-            for (long k = 1; k < x_mod_p; ++k) {
-                result = (result * BigInt(k)) % p_power;
-            }
-            result = (result * BigInt(-1)) % p_power;
-            if (result.is_negative()) {
-                result += p_power;
-            }
-        } else {
-            BigInt wilson(1);
-            for (long k = 1; k < p; ++k) {
-                if (k != x_mod_p) {
-                    wilson = (wilson * BigInt(k)) % p_power;
-                }
-            }
-            result = wilson.mod_inverse(p_power);
-            
-            if ((p - x_mod_p) % 2 == 1) {
-                result = (p_power - result) % p_power;
-            }
-        }
-        
-        for (long k = 1; k < N && k < 10; ++k) {
-            BigInt pk = BigInt(p).pow(k);
-            BigInt x_lifted = x.to_bigint() % BigInt(p).pow(k + 1);
-            BigInt correction = compute_mahler_correction(x_lifted, p, k);
-            result = (result * correction) % p_power;
+        // Γ_p(a) = (-1)^a (a-1)! for 0 < a < p
+        BigInt result = FactorialTable::factorial(x_mod_p - 1, p, N);
+        if (x_mod_p % 2 == 1 && !result.is_zero()) {
+            result = p_power - result;
         }
         
         return Zp(p, N, result);
@@ -108,7 +77,8 @@ public:
             throw std::domain_error("Input must be positive");
         }
         
-        BigInt p_power = BigInt(p).pow(precision);
+        const PadicContext& ctx = PadicContext::get(p, precision);
+        const BigInt& p_power = ctx.modulus();
         
         if (n % p == 0) {
             // Standard convention: Γ_p(n) = 1 when p | n
@@ -119,7 +89,7 @@ public:
         // For n < p: use standard factorial
         if (n < p) {
             // Morita's Gamma: Γ_p(n) = (-1)^n * (n-1)!
-            BigInt result = factorial_mod(n - 1, p_power);
+            BigInt result = FactorialTable::factorial(n - 1, p, precision);
             
             // Apply the sign
             BigInt sign = (n % 2 == 0) ? BigInt(1) : BigInt(-1);
@@ -156,8 +126,9 @@ public:
             
             Zp product = gamma_x * gamma_one_minus_x;
             
-            Zp expected = (((BigInt(p) - x.to_bigint() % BigInt(p)) % BigInt(2)).is_zero()) 
-                         ? Zp(p, N, 1) : Zp(p, N, -1);
+            // Γ_p(x) Γ_p(1-x) = (-1)^{a_0}, a_0 ∈ [1, p] with a_0 ≡ x (mod p)
+            long a0 = static_cast<long>(mpz_fdiv_ui(x.get_value().get_mpz(), static_cast<unsigned long>(p)));
+            Zp expected = (a0 == 0 ? p : a0) % 2 == 0 ? Zp(p, N, 1) : Zp(p, N, -1);
             
             return product.with_precision(N - 1) == expected.with_precision(N - 1);
             
@@ -167,6 +138,7 @@ public:
     }
     
     static Qp log_gamma(const Zp& x) {
+        stats::Scope scope(stats::Id::log_gamma);
         long p = x.get_prime();
         long N = x.get_precision();
         
@@ -175,17 +147,29 @@ public:
         }
         
         // For positive integers a < p, use the direct formula
-        BigInt x_val = x.to_bigint() % BigInt(p);
-        if (!x_val.is_negative() && x_val > BigInt(0) && x_val < BigInt(p)) {
-            long a = x_val.to_long();
-            return IwasawaLog::log_gamma_direct(a, p, N);
+        if (x.get_value() < BigInt(p)) {
+            return IwasawaLog::log_gamma_direct(x.get_value().to_long(), p, N);
         }
         
-        // For other values, compute gamma first then use Iwasawa log
-        Zp gamma_val = gamma(x);
-        return IwasawaLog::log_iwasawa(gamma_val);
+        // Any other x ∈ Z_p: evaluate the shared window polynomial
+        return GammaEngine::get(p, N)->log_gamma(x);
     }
     
+    /**
+     * log_Iw Γ_p(x) for the integers x = start, ..., start + count - 1
+     * (start >= 1, p odd), at precision N.
+     *
+     * Walks Γ_p(x+1) = -x Γ_p(x) (Γ_p(x+1) = Γ_p(x) for p | x) from one
+     * evaluation at start, so log_Iw Γ_p(x+1) = log_Iw Γ_p(x) + log_Iw(x).
+     * log_Iw is additive, so the increments are sums of log_Iw(q) over the
+     * prime factors q ≠ p of x, and all those logs come from a single
+     * PadicLog::log_range call: about count / ln(count) logs sharing one
+     * modular inversion instead of count independent series.
+     *
+     * Units x agree with log_gamma(x), including log_Iw Γ_p(1) = log_Iw(-1) = 0.
+     */
+    static std::vector<Qp> log_gamma_range(long p, long N, long start, long count);
+    
     static std::vector<Zp> compute_gamma_values(long p, long precision, long count) {
         std::vector<Zp> values;
         for (long i = 1; i <= count; ++i) {
@@ -197,26 +181,6 @@ public:
         }
         return values;
     }
-    
-private:
-    static BigInt compute_mahler_correction(const BigInt& x, long p, long k) {
-        BigInt pk = BigInt(p).pow(k);
-        BigInt pk1 = pk * BigInt(p);
-        
-        BigInt correction(1);
-        BigInt x_power = x % pk1;
-        
-        for (long j = 1; j <= k && j <= 5; ++j) {
-            BigInt binom = BigInt::binomial(k, j);
-            if (!binom.is_divisible_by(BigInt(p))) {
-                BigInt term = (binom * x_power) % pk1;
-                correction = (correction + term) % pk1;
-            }
-            x_power = (x_power * x) % pk1;
-        }
-        
-        return correction;
-    }
 };
 
 inline Zp gamma_p(const Zp& x) {
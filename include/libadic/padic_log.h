@@ -2,10 +2,68 @@
 #define LIBADIC_PADIC_LOG_H
 
 #include "libadic/qp.h"
+#include "libadic/precision_tracker.h"
+#include "libadic/inverse_table.h"
+#include "libadic/stats.h"
+#include <algorithm>
+#include <memory>
 #include <stdexcept>
+#include <vector>
 
 namespace libadic {
 
+/**
+ * log(base^exponent) for an integer base, kept resumable in the precision.
+ *
+ * The argument x = base^exponent must satisfy x ≡ 1 (mod p) (mod 4 for
+ * p = 2). As in PadicLog::log, the series runs on y = x^{p^k}, here with k
+ * fixed by the headroom H and y taken mod p^{H+k}, and log x = log y / p^k.
+ * The state is that series part-way through: the term index, the current
+ * power u^n of u = y - 1 and the partial sum, all at the working precision
+ * H needs. value(N) for N <= H sums only the terms N adds beyond the ones
+ * already summed, so raising N in small steps costs about one full
+ * evaluation at H in total. A request above H restarts the series with
+ * headroom max(2H, N), so the restarts form a geometric sequence.
+ *
+ * Only an exact argument can be resumed: a Qp known mod p^N says nothing
+ * about the digits a higher precision needs. Not thread-safe.
+ */
+class LogSeries {
+private:
+    long prime;
+    BigInt base;
+    long exponent;
+    long headroom = 0;   // digits of log x the state can reach
+    long reduction = 0;  // k
+    long valuation = 0;  // v(u); 0 when y = 1, i.e. log x = 0
+    long next = 1;       // index of the next term
+    std::shared_ptr<const InverseTable> inverses;
+    Qp u, power, sum;    // u, u^next and Σ_{n<next} (-1)^{n+1} u^n / n
+
+    void restart(long H);
+
+public:
+    LogSeries(long p, const BigInt& base, long exponent, long headroom);
+
+    /**
+     * log x to precision N
+     */
+    Qp value(long N);
+
+    long get_prime() const { return prime; }
+    long get_headroom() const { return headroom; }
+
+    /**
+     * Series terms summed since the last (re)start
+     */
+    long terms() const { return next - 1; }
+
+    /**
+     * Bytes held by the state, for cache accounting
+     */
+    size_t footprint() const;
+};
+
 class PadicLog {
 private:
     static bool check_convergence_condition(const Qp& x) {
@@ -24,27 +82,71 @@ private:
         }
     }
     
-    static long compute_required_terms(long /*p*/, long precision, long u_valuation) {
-        // Deprecated heuristic; kept for ABI but unused by log().
-        if (u_valuation <= 0) return precision * 2;
-        long terms = precision / u_valuation + 10;
-        return std::min(terms, precision * 3L);
-    }
+    /**
+     * Throws unless x is a unit with x ≡ 1 (mod p) (mod 4 for p = 2)
+     */
+    static void check_log_argument(const Qp& x);
     
 public:
     /**
-     * Compute the p-adic logarithm using the standard Taylor series
-     * log(1+u) = u - u²/2 + u³/3 - u⁴/4 + ...
+     * Compute the p-adic logarithm of x ≡ 1 (mod p), x ≡ 1 (mod 4) for p = 2.
+     *
+     * Argument reduction first: y = x^{p^k} has v(y - 1) = v(x - 1) + k and
+     * is determined modulo p^{N+k} by x modulo p^N, so
+     *   log x = log(y) / p^k
+     * loses nothing. With k ≈ √N the series for log y needs only O(√N) terms,
+     * and those are summed exactly by binary splitting over
+     *   log(1+u) = u · Σ_{n≥1} (-u)^{n-1} / n,
+     * merging halves as fractions T/Q with a single division at the end, so
+     * no per-term modular inverse is needed.
+     *
+     * @param x A p-adic number with valuation 0 and x ≡ 1 (mod p)
+     * @return The p-adic logarithm of x at the precision of x
+     */
+    static Qp log(const Qp& x);
+    
+    /**
+     * log of every entry of `values`, which share one prime and each meet the
+     * conditions of log(). Reduction and binary splitting run per value as in
+     * log(), but the final divisions by the series denominators Q_i are done
+     * together by Montgomery's trick: one modular inversion and 3(n-1)
+     * multiplications instead of n inversions.
+     */
+    static std::vector<Qp> log_range(const std::vector<Qp>& values);
+    
+    /**
+     * p-adic exponential for v(x) > 1/(p-1), i.e. v(x) >= 1 (v(x) >= 2 for p = 2).
+     * Newton iteration y <- y (1 + x - log y) on the fast log, doubling the
+     * number of correct digits per step.
+     */
+    static Qp exp(const Qp& x);
+
+    /**
+     * log(a^{p-1}) for each integer a of `bases` (prime to p) at precision N,
+     * so log_Iw(a) = result / (p-1). First requests go through log_range.
+     * A base asked for again at a higher precision gets a LogSeries with
+     * headroom twice that precision, kept in the library cache, and further
+     * increases resume it: a loop raising N until results stabilise pays
+     * about linear rather than quadratic total work for these logarithms.
+     */
+    static std::vector<Qp> log_fermat_range(long p, long N, const std::vector<long>& bases);
+    
+    /**
+     * Compute the p-adic logarithm by summing the Taylor series
+     * log(1+u) = u - u²/2 + u³/3 - u⁴/4 + ... term by term.
+     * Quadratic in N; log() uses the reduced, binary-splitting path instead
+     * and this is kept as the reference implementation.
      * 
-     * PRECISION NOTE: When terms n are divisible by p, precision is lost
-     * mathematically. This is a fundamental property of p-adic arithmetic,
-     * not a bug. We use higher working precision internally to compensate,
-     * but some precision loss is unavoidable and mathematically correct.
+     * Terms run up to the exact bound n·w - v_p(n) >= N for w = v(x - 1),
+     * and the working precision carries the ⌊log_p n⌋ digits the
+     * denominators cost (PrecisionTracker), so the result is guaranteed to
+     * the full precision of x.
      * 
      * @param x A p-adic number with valuation 0 and x ≡ 1 (mod p)
      * @return The p-adic logarithm of x
      */
-    static Qp log(const Qp& x) {
+    static Qp log_series(const Qp& x) {
+        stats::Scope scope(stats::Id::log_series);
         if (x.is_zero()) {
             throw std::domain_error("Logarithm of zero is undefined");
         }
@@ -53,47 +155,40 @@ public:
             throw std::domain_error("p-adic logarithm requires valuation 0");
         }
         
-        long p = x.get_prime();
-        long N = x.get_precision();
-        
-        // Use higher working precision to compensate for precision loss.
-        // Choose a generous buffer to ensure correctness mod p^2 for typical inputs.
-        long working_precision = N + 8;
-        
-        Qp one(p, working_precision, 1);
-        Qp u = x.with_precision(working_precision) - one;
-        
         if (!check_convergence_condition(x)) {
             throw std::domain_error("p-adic logarithm does not converge: x must be ≡ 1 (mod p)");
         }
         
-        Qp result(p, working_precision, 0);
-        Qp u_power = u;  // u^1
-        long n = 1;
+        long p = x.get_prime();
+        long N = x.get_precision();
+        Qp u = x - Qp(p, N, 1);
+        if (u.is_zero()) {
+            return Qp(p, N, 0);
+        }
+        
+        long terms = PrecisionTracker::series_terms(p, N, u.valuation());
+        PrecisionTracker tracker(N);
+        tracker.series(p, terms);
+        long working_precision = tracker.working();
+        scope.iterations(static_cast<uint64_t>(terms));
+        scope.inflation(working_precision - N);
         
-        while (true) {
-            Qp term = u_power / Qp(p, working_precision, n);
-            // Add with alternating signs: +, -, +, - ...
+        // x is only known mod p^N; the extra digits of u are zeros that the
+        // guard digits absorb when divided by n
+        Qp u_wide = Qp::from_unit_and_valuation(p, working_precision, u.get_unit().get_value(), u.valuation());
+        auto inverses = InverseTable::get(p, working_precision, terms);
+        Qp result(p, working_precision, 0);
+        Qp u_power = u_wide;
+        for (long n = 1; n <= terms; ++n) {
             if ((n & 1) == 1) {
-                result = result + term;
+                result.addmul(u_power, inverses->inverse(n));
             } else {
-                result = result - term;
-            }
-            // Stop when further terms are beyond working precision
-            if (term.valuation() >= working_precision - 2) {
-                break;
+                result.submul(u_power, inverses->inverse(n));
             }
-            // Next power
-            u_power = u_power * u;
-            if (u_power.valuation() >= working_precision - 2) {
-                break;
-            }
-            ++n;
-            // Safety cap to avoid infinite loops
-            if (n > working_precision * 4) break;
+            u_power *= u_wide;
         }
         
-        return result.with_precision(N);
+        return result.with_precision(tracker.guaranteed(working_precision));
     }
     
     static Qp log_unit(const Zp& x) {
@@ -172,29 +267,7 @@ public:
     
 private:
     static Qp exp_truncated(const Qp& x, long precision) {
-        long p = x.get_prime();
-        
-        if (x.valuation() < 1) {
-            throw std::domain_error("exp requires positive valuation for convergence");
-        }
-        
-        Qp result(p, precision, 1);
-        Qp x_power = x;
-        BigInt factorial(1);
-        
-        for (long n = 1; n <= precision * 2; ++n) {
-            factorial *= BigInt(n);
-            Qp term = x_power / Qp(p, precision, factorial);
-            
-            if (term.valuation() >= precision) {
-                break;
-            }
-            
-            result += term;
-            x_power *= x;
-        }
-        
-        return result;
+        return exp(x.with_precision(std::min(precision, x.get_precision())));
     }
 };
 
@@ -0,0 +1,106 @@
+#ifndef LIBADIC_PRECISION_TRACKER_H
+#define LIBADIC_PRECISION_TRACKER_H
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace libadic {
+
+/**
+ * Working-precision bookkeeping for p-adic computations.
+ *
+ * The static bounds give the exact number of series terms and guard digits
+ * a computation needs from the valuations of its inputs, instead of a fixed
+ * padding. An instance follows one computation: it starts from the target
+ * precision N, each step that costs digits (dividing by p^v, summing a
+ * series whose denominators reach p^d) records the loss, and working()
+ * is the precision to carry so that exactly N digits survive, which
+ * guaranteed() then reports.
+ */
+class PrecisionTracker {
+private:
+    long target;
+    long loss = 0;
+
+public:
+    explicit PrecisionTracker(long N) : target(N) {
+        if (N < 1) {
+            throw std::invalid_argument("Precision must be >= 1");
+        }
+    }
+
+    /**
+     * Record that a step divides by p^v (v > 0 loses v digits)
+     */
+    PrecisionTracker& divide(long v) {
+        loss += std::max(0L, v);
+        return *this;
+    }
+
+    /**
+     * Record the loss of a series Σ c_n u^n / n up to `terms` terms
+     */
+    PrecisionTracker& series(long p, long terms) {
+        return divide(max_index_valuation(p, terms));
+    }
+
+    long get_target() const { return target; }
+    long get_loss() const { return loss; }
+
+    /**
+     * Precision to compute at so that target digits survive the recorded losses
+     */
+    long working() const { return target + loss; }
+
+    /**
+     * Digits known after the recorded losses when computing at `precision`
+     */
+    long guaranteed(long precision) const { return std::min(target, precision - loss); }
+
+    /**
+     * max_{1<=n<=terms} v_p(n) = ⌊log_p terms⌋
+     */
+    static long max_index_valuation(long p, long terms) {
+        long v = 0;
+        for (long pk = p; pk <= terms; pk *= p) {
+            ++v;
+            if (pk > terms / p) break;
+        }
+        return v;
+    }
+
+    /**
+     * v_p(n!) = Σ_i ⌊n / p^i⌋
+     */
+    static long factorial_valuation(long p, long n) {
+        long v = 0;
+        for (long pk = p; pk <= n; pk *= p) {
+            v += n / pk;
+            if (pk > n / p) break;
+        }
+        return v;
+    }
+
+    /**
+     * Smallest T such that every term n > T of a series with
+     * v(term_n) >= n·w - v_p(n) vanishes modulo p^target, e.g. the
+     * logarithm Σ u^n / n with v(u) = w. n·w - ⌊log_p n⌋ is non-decreasing.
+     */
+    static long series_terms(long p, long target, long w) {
+        if (w < 1) {
+            throw std::domain_error("Series terms need positive valuation to converge");
+        }
+        long terms = 1;
+        for (long pk = p, digits = 0; terms * w - digits < target; ++terms) {
+            if (terms + 1 == pk) {
+                ++digits;
+                pk *= p;
+            }
+        }
+        return terms;
+    }
+};
+
+} // namespace libadic
+
+#endif // LIBADIC_PRECISION_TRACKER_H
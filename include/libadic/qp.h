@@ -6,6 +6,10 @@
 
 namespace libadic {
 
+namespace detail {
+struct ExactQp;
+}
+
 class Qp {
 private:
     long prime;
@@ -22,6 +26,122 @@ private:
         }
     }
     
+    /**
+     * Become zero at absolute precision N, reusing the unit's limbs
+     */
+    void set_zero(long N) {
+        precision = N;
+        valuation_val = N;
+        mpz_set_ui(unit.value.get_mpz(), 0);
+        unit.precision = N;
+        unit.ctx = &PadicContext::get(prime, N);
+    }
+    
+    /**
+     * *this += (or -=) p^term_val * t1 * t2, the term being known to absolute
+     * precision term_prec (t2 may be null for a single factor). Both sides
+     * must be nonzero. Alignment, the sum and the valuation re-split all run
+     * on the unit's limbs, so steady-state accumulation does not allocate.
+     */
+    Qp& fused_multiply_accumulate(const Qp& a, const Qp& b, bool negate) {
+        if (a.prime != prime || b.prime != prime) {
+            throw std::invalid_argument("Cannot combine p-adic numbers with different primes");
+        }
+        long term_prec = std::min(a.precision, b.precision);
+        long new_prec = std::min(precision, term_prec);
+        if (a.is_zero() || b.is_zero() || a.valuation_val + b.valuation_val >= term_prec) {
+            if (new_prec < precision) {
+                *this = with_precision(new_prec);
+            }
+            return *this;
+        }
+        if (is_zero()) {
+            Qp prod = a * b;
+            *this = (negate ? -prod : prod).with_precision(new_prec);
+            return *this;
+        }
+        accumulate(a.valuation_val + b.valuation_val, term_prec, a.unit.value, &b.unit.value, negate);
+        return *this;
+    }
+    
+    /**
+     * p^v · unit at absolute precision N, the unit already reduced for ctx
+     * (of precision N - v)
+     */
+    static Qp from_reduced_unit(const PadicContext& ctx, long N, long v, BigInt&& unit) {
+        Qp result(ctx.get_prime(), N);
+        result.valuation_val = v;
+        result.unit = Zp(ctx, std::move(unit));
+        return result;
+    }
+    
+    friend struct detail::ExactQp;
+    
+    void accumulate(long term_val, long term_prec, const BigInt& t1, const BigInt* t2, bool negate) {
+        if (&t1 == &unit.value || t2 == &unit.value) {
+            Qp self(*this);
+            const BigInt& a = (&t1 == &unit.value) ? self.unit.value : t1;
+            const BigInt* b = (t2 == &unit.value) ? &self.unit.value : t2;
+            accumulate(term_val, term_prec, a, b, negate);
+            return;
+        }
+        
+        long new_prec = std::min(precision, term_prec);
+        long min_val = std::min(valuation_val, term_val);
+        if (min_val >= new_prec) {
+            set_zero(new_prec);
+            return;
+        }
+        
+        long working_prec = new_prec - min_val;
+        const PadicContext& wctx = PadicContext::get(prime, working_prec);
+        mpz_t& v = unit.value.get_mpz();
+        
+        long shift = valuation_val - min_val;
+        if (shift >= working_prec) {
+            mpz_set_ui(v, 0);
+        } else if (shift > 0) {
+            mpz_mul(v, v, wctx.power(shift).get_mpz());
+        }
+        
+        long term_shift = term_val - min_val;
+        if (term_shift < working_prec) {
+            const mpz_t* a = &t1.get_mpz();
+            const mpz_t* b = t2 ? &t2->get_mpz() : nullptr;
+            if (term_shift > 0) {
+                if (b) {
+                    static thread_local BigInt scratch;
+                    mpz_mul(scratch.get_mpz(), *a, wctx.power(term_shift).get_mpz());
+                    a = &scratch.get_mpz();
+                } else {
+                    b = &wctx.power(term_shift).get_mpz();
+                }
+            }
+            if (b) {
+                negate ? mpz_submul(v, *a, *b) : mpz_addmul(v, *a, *b);
+            } else {
+                negate ? mpz_sub(v, v, *a) : mpz_add(v, v, *a);
+            }
+        }
+        
+        wctx.reduce(unit.value);
+        if (unit.value.is_zero()) {
+            set_zero(new_prec);
+            return;
+        }
+        
+        long sum_val = 0;
+        while (mpz_divisible_ui_p(v, static_cast<unsigned long>(prime))) {
+            mpz_divexact_ui(v, v, static_cast<unsigned long>(prime));
+            ++sum_val;
+        }
+        
+        precision = new_prec;
+        valuation_val = min_val + sum_val;
+        unit.precision = working_prec - sum_val;
+        unit.ctx = &PadicContext::get(prime, unit.precision);
+    }
+    
 public:
     Qp() : prime(2), precision(1), valuation_val(1), unit(2, 1, 0) {}
     
@@ -35,13 +155,13 @@ public:
             valuation_val = precision;
             unit = Zp(p, N, 0);
         } else {
-            valuation_val = p_adic_valuation(val, BigInt(p));
+            ValuationSplit split = split_valuation(val, PadicContext::get(p, N).prime_bigint());
+            valuation_val = split.valuation;
             if (valuation_val >= precision) {
                 valuation_val = precision;
                 unit = Zp(p, N, 0);
             } else {
-                BigInt unit_val = val / BigInt(p).pow(valuation_val);
-                unit = Zp(p, N - valuation_val, unit_val);
+                unit = Zp(p, N - valuation_val, split.unit);
             }
         }
     }
@@ -53,14 +173,14 @@ public:
             valuation_val = precision;
             unit = z;
         } else {
-            valuation_val = z.valuation();
-            if (valuation_val == 0) {
+            if (z.is_unit()) {
+                valuation_val = 0;
                 unit = z;
-            } else if (valuation_val >= precision) {
-                valuation_val = precision;
-                unit = Zp(prime, precision, 0);
             } else {
-                unit = z.unit_part();
+                // 0 < z < p^N, so the valuation is below N
+                ValuationSplit split = split_valuation(z.get_value(), PadicContext::get(prime, precision).prime_bigint());
+                valuation_val = split.valuation;
+                unit = Zp(prime, precision - valuation_val, split.unit);
             }
         }
     }
@@ -112,80 +232,21 @@ public:
     }
     
     Qp operator+(const Qp& other) const {
-        if (prime != other.prime) {
-            throw std::invalid_argument("Cannot add p-adic numbers with different primes");
-        }
-        
-        long new_prec = std::min(precision, other.precision);
-        
-        if (is_zero()) {
-            return other.with_precision(new_prec);
-        }
-        if (other.is_zero()) {
-            return with_precision(new_prec);
-        }
-        
-        long min_val = std::min(valuation_val, other.valuation_val);
-        long val_diff1 = valuation_val - min_val;
-        long val_diff2 = other.valuation_val - min_val;
-        
-        if (min_val >= new_prec) {
-            return Qp(prime, new_prec, 0);
-        }
-        
-        long working_prec = new_prec - min_val;
-        
-        Zp u1 = unit;
-        Zp u2 = other.unit;
-        
-        if (val_diff1 > 0) {
-            u1 = u1 * Zp(prime, working_prec, BigInt(prime).pow(val_diff1));
-        }
-        if (val_diff2 > 0) {
-            u2 = u2 * Zp(prime, working_prec, BigInt(prime).pow(val_diff2));
-        }
-        
-        u1 = u1.with_precision(working_prec);
-        u2 = u2.with_precision(working_prec);
-        
-        Zp sum_unit = u1 + u2;
-        
-        if (sum_unit.is_zero()) {
-            return Qp(prime, new_prec, 0);
-        }
-        
-        long sum_val = sum_unit.valuation();
-        if (sum_val > 0) {
-            return Qp(prime, new_prec, min_val + sum_val, sum_unit.unit_part());
-        }
-        
-        return Qp(prime, new_prec, min_val, sum_unit);
+        Qp result(*this);
+        result += other;
+        return result;
     }
     
     Qp operator-(const Qp& other) const {
-        return *this + (-other);
+        Qp result(*this);
+        result -= other;
+        return result;
     }
     
     Qp operator*(const Qp& other) const {
-        if (prime != other.prime) {
-            throw std::invalid_argument("Cannot multiply p-adic numbers with different primes");
-        }
-        
-        if (is_zero() || other.is_zero()) {
-            return Qp(prime, std::min(precision, other.precision), 0);
-        }
-        
-        long new_val = valuation_val + other.valuation_val;
-        long new_prec = std::min(precision, other.precision);
-        
-        if (new_val >= new_prec) {
-            return Qp(prime, new_prec, 0);
-        }
-        
-        long unit_prec = new_prec - new_val;
-        Zp new_unit = unit.with_precision(unit_prec) * other.unit.with_precision(unit_prec);
-        
-        return Qp(prime, new_prec, new_val, new_unit);
+        Qp result(*this);
+        result *= other;
+        return result;
     }
     
     /**
@@ -220,7 +281,9 @@ public:
             throw std::domain_error("Division result has infinite negative valuation");
         }
         
-        long unit_prec = new_prec - std::max(new_val, 0L);
+        // Absolute precision new_prec needs new_prec - new_val unit digits,
+        // which both operands have
+        long unit_prec = new_prec - new_val;
         Zp new_unit = unit.with_precision(unit_prec) / other.unit.with_precision(unit_prec);
         
         return Qp(prime, new_prec, new_val, new_unit);
@@ -234,20 +297,85 @@ public:
     }
     
     Qp& operator+=(const Qp& other) {
-        *this = *this + other;
+        if (prime != other.prime) {
+            throw std::invalid_argument("Cannot add p-adic numbers with different primes");
+        }
+        long new_prec = std::min(precision, other.precision);
+        if (other.is_zero()) {
+            if (new_prec < precision) {
+                *this = with_precision(new_prec);
+            }
+            return *this;
+        }
+        if (is_zero()) {
+            *this = other.with_precision(new_prec);
+            return *this;
+        }
+        accumulate(other.valuation_val, other.precision, other.unit.value, nullptr, false);
         return *this;
     }
     
     Qp& operator-=(const Qp& other) {
-        *this = *this - other;
+        if (prime != other.prime) {
+            throw std::invalid_argument("Cannot subtract p-adic numbers with different primes");
+        }
+        long new_prec = std::min(precision, other.precision);
+        if (other.is_zero()) {
+            if (new_prec < precision) {
+                *this = with_precision(new_prec);
+            }
+            return *this;
+        }
+        if (is_zero()) {
+            *this = (-other).with_precision(new_prec);
+            return *this;
+        }
+        accumulate(other.valuation_val, other.precision, other.unit.value, nullptr, true);
         return *this;
     }
     
     Qp& operator*=(const Qp& other) {
-        *this = *this * other;
+        if (prime != other.prime) {
+            throw std::invalid_argument("Cannot multiply p-adic numbers with different primes");
+        }
+        long new_prec = std::min(precision, other.precision);
+        if (is_zero() || other.is_zero()) {
+            set_zero(new_prec);
+            return *this;
+        }
+        
+        long new_val = valuation_val + other.valuation_val;
+        if (new_val >= new_prec) {
+            set_zero(new_prec);
+            return *this;
+        }
+        
+        long unit_prec = new_prec - new_val;
+        const PadicContext& uctx = PadicContext::get(prime, unit_prec);
+        mpz_mul(unit.value.get_mpz(), unit.value.get_mpz(), other.unit.value.get_mpz());
+        uctx.reduce(unit.value);
+        unit.precision = unit_prec;
+        unit.ctx = &uctx;
+        precision = new_prec;
+        valuation_val = new_val;
         return *this;
     }
     
+    /**
+     * Fused multiply-accumulate: *this += a * b without materialising the
+     * product. Precision is the minimum of the three operands.
+     */
+    Qp& addmul(const Qp& a, const Qp& b) {
+        return fused_multiply_accumulate(a, b, false);
+    }
+    
+    /**
+     * Fused multiply-subtract: *this -= a * b
+     */
+    Qp& submul(const Qp& a, const Qp& b) {
+        return fused_multiply_accumulate(a, b, true);
+    }
+    
     Qp& operator/=(const Qp& other) {
         *this = *this / other;
         return *this;
@@ -313,7 +441,8 @@ public:
         long unit_prec = precision - new_val;
         Zp sqrt_unit = unit.with_precision(unit_prec).sqrt();
         
-        return Qp(prime, precision, new_val, sqrt_unit);
+        // One digit less for p = 2, where the unit root is known mod 2^{N-1}
+        return Qp(prime, new_val + sqrt_unit.get_precision(), new_val, sqrt_unit);
     }
     
     BigInt to_bigint() const {
@@ -323,7 +452,7 @@ public:
         if (is_zero()) {
             return BigInt(0);
         }
-        return unit.to_bigint() * BigInt(prime).pow(valuation_val);
+        return unit.to_bigint() * PadicContext::get(prime, precision).power(valuation_val);
     }
     
     Zp to_zp() const {
@@ -358,20 +487,12 @@ public:
             return Qp(p, precision, 0);
         }
         
-        BigInt num(numerator);
-        BigInt den(denominator);
         BigInt prime_big(p);
-        
-        long num_val = p_adic_valuation(num, prime_big);
-        long den_val = p_adic_valuation(den, prime_big);
-        long total_val = num_val - den_val;
-        
-        if (num_val > 0) {
-            num /= prime_big.pow(num_val);
-        }
-        if (den_val > 0) {
-            den /= prime_big.pow(den_val);
-        }
+        ValuationSplit num_split = split_valuation(BigInt(numerator), prime_big);
+        ValuationSplit den_split = split_valuation(BigInt(denominator), prime_big);
+        long total_val = num_split.valuation - den_split.valuation;
+        BigInt& num = num_split.unit;
+        BigInt& den = den_split.unit;
         
         if (total_val >= precision) {
             return Qp(p, precision, 0);
@@ -381,8 +502,9 @@ public:
             throw std::overflow_error("Rational has valuation too negative for precision");
         }
         
-        long unit_prec = precision - std::max(total_val, 0L);
-        BigInt p_power = prime_big.pow(unit_prec);
+        // Absolute precision N leaves N - v unit digits, more than N when v < 0
+        long unit_prec = precision - total_val;
+        const BigInt& p_power = PadicContext::get(p, unit_prec).power(unit_prec);
         BigInt inv = den.mod_inverse(p_power);
         BigInt unit_val = (num * inv) % p_power;
         
@@ -0,0 +1,304 @@
+#ifndef LIBADIC_QP_EXPR_H
+#define LIBADIC_QP_EXPR_H
+
+#include "libadic/qp.h"
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace libadic {
+
+namespace detail {
+
+/**
+ * Operand of an ExactQp step: a Qp or another ExactQp, by reference
+ */
+struct ExactView {
+    long prime;
+    long precision;
+    long valuation;
+    const BigInt* unit;
+    bool normalized = true;  // p does not divide a non-zero unit
+
+    explicit ExactView(const Qp& x)
+        : prime(x.get_prime()), precision(x.get_precision()), valuation(x.valuation()),
+          unit(&x.get_unit().get_value()) {}
+    ExactView(long p, long N, long v, const BigInt& u, bool normal)
+        : prime(p), precision(N), valuation(v), unit(&u), normalized(normal) {}
+
+    bool zero() const { return valuation >= precision || unit->is_zero(); }
+};
+
+/**
+ * p^valuation · unit at absolute precision `precision`, with `unit` an
+ * exact, unreduced integer (negative, or divisible by p after a sum); zero
+ * when unit == 0 or valuation >= precision
+ */
+struct ExactQp {
+    long prime = 0;
+    long precision = 0;
+    long valuation = 0;
+    BigInt unit;
+    bool normalized = true;  // p does not divide a non-zero unit
+
+    ExactView view() const { return ExactView(prime, precision, valuation, unit, normalized); }
+
+    bool zero() const { return valuation >= precision || unit.is_zero(); }
+
+    void load(const ExactView& x) {
+        prime = x.prime;
+        precision = x.precision;
+        valuation = x.valuation;
+        unit = *x.unit;
+        normalized = x.normalized;
+    }
+
+    void load_product(const ExactView& a, const ExactView& b) {
+        check(a.prime, b.prime);
+        prime = a.prime;
+        precision = std::min(a.precision, b.precision);
+        normalized = a.normalized && b.normalized;
+        if (a.zero() || b.zero()) {
+            set_zero();
+            return;
+        }
+        valuation = a.valuation + b.valuation;
+        mpz_mul(unit.get_mpz(), a.unit->get_mpz(), b.unit->get_mpz());
+    }
+
+    void multiply(const ExactView& other) {
+        check(prime, other.prime);
+        precision = std::min(precision, other.precision);
+        if (zero() || other.zero()) {
+            set_zero();
+            return;
+        }
+        valuation += other.valuation;
+        normalized = normalized && other.normalized;
+        mpz_mul(unit.get_mpz(), unit.get_mpz(), other.unit->get_mpz());
+    }
+
+    void add(const ExactView& other, bool negate) {
+        check(prime, other.prime);
+        precision = std::min(precision, other.precision);
+        if (other.zero()) {
+            return;
+        }
+        const mpz_t& u = other.unit->get_mpz();
+        if (zero()) {
+            valuation = other.valuation;
+            normalized = other.normalized;
+            negate ? mpz_neg(unit.get_mpz(), u) : mpz_set(unit.get_mpz(), u);
+            return;
+        }
+        normalized = false;
+        // Align on the smaller valuation; a term at or beyond the precision
+        // contributes nothing
+        if (other.valuation < valuation) {
+            if (valuation < precision) {
+                mpz_mul(unit.get_mpz(), unit.get_mpz(),
+                        PadicContext::get(prime, valuation - other.valuation).modulus().get_mpz());
+            } else {
+                mpz_set_ui(unit.get_mpz(), 0);
+            }
+            valuation = other.valuation;
+            negate ? mpz_sub(unit.get_mpz(), unit.get_mpz(), u) : mpz_add(unit.get_mpz(), unit.get_mpz(), u);
+        } else if (other.valuation < precision) {
+            long shift = other.valuation - valuation;
+            if (shift == 0) {
+                negate ? mpz_sub(unit.get_mpz(), unit.get_mpz(), u) : mpz_add(unit.get_mpz(), unit.get_mpz(), u);
+            } else {
+                const mpz_t& scale = PadicContext::get(prime, shift).modulus().get_mpz();
+                negate ? mpz_submul(unit.get_mpz(), u, scale) : mpz_addmul(unit.get_mpz(), u, scale);
+            }
+        }
+    }
+
+    void negate() { mpz_neg(unit.get_mpz(), unit.get_mpz()); }
+
+    /**
+     * The single reduction: strip p from the unit if a sum may have left
+     * factors of it, then reduce mod p^{precision - valuation}
+     */
+    Qp finish() {
+        if (zero()) {
+            return Qp(prime, precision, 0);
+        }
+        if (!normalized) {
+            const BigInt& p = PadicContext::get(prime, 1).prime_bigint();
+            if (mpz_divisible_p(unit.get_mpz(), p.get_mpz())) {
+                valuation += static_cast<long>(mpz_remove(unit.get_mpz(), unit.get_mpz(), p.get_mpz()));
+                if (valuation >= precision) {
+                    return Qp(prime, precision, 0);
+                }
+            }
+        }
+        const PadicContext& ctx = PadicContext::get(prime, precision - valuation);
+        ctx.reduce(unit);
+        return Qp::from_reduced_unit(ctx, precision, valuation, std::move(unit));
+    }
+
+private:
+    void set_zero() {
+        valuation = precision;
+        mpz_set_ui(unit.get_mpz(), 0);
+    }
+
+    static void check(long p, long q) {
+        if (p != q) {
+            throw std::invalid_argument("Cannot combine p-adic numbers with different primes");
+        }
+    }
+};
+
+} // namespace detail
+
+/**
+ * Deferred Qp arithmetic.
+ *
+ * defer(x) starts an expression; +, - and * between expressions and Qp
+ * values build a tree of nodes instead of Qp temporaries, and converting
+ * the tree to Qp evaluates it once: units are multiplied and added as exact
+ * integers aligned on the smallest valuation, and the valuation is
+ * normalised and the unit reduced mod p^N a single time at the end.
+ *
+ *   Qp r = defer(a) * b + defer(c) * d - e;
+ *
+ * The result has the absolute precision the eager expression would report
+ * (the minimum over the operands) and equals it when no operand has
+ * negative valuation; otherwise the two may differ in digits that the
+ * operands do not determine, since the eager form rounds each
+ * intermediate product.
+ * Intermediate integers grow with the depth of the tree, so this suits
+ * short chains (a few products and sums) such as the L-function formulas,
+ * not long accumulations, which Qp::addmul handles in place.
+ *
+ * Leaves refer to lvalue operands and own rvalue ones, so an expression
+ * must not outlive the Qp lvalues it was built from: evaluate it in the
+ * statement that builds it and do not store it in `auto`.
+ */
+template<class E>
+class QpExpr {
+public:
+    const E& self() const { return static_cast<const E&>(*this); }
+
+    Qp eval() const {
+        static thread_local detail::ExactQp scratch;
+        self().exact(scratch);
+        return scratch.finish();
+    }
+
+    operator Qp() const { return eval(); }
+};
+
+template<class T>
+class QpLeaf : public QpExpr<QpLeaf<T>> {
+private:
+    T value;  // const Qp& for lvalues, Qp for temporaries
+
+public:
+    static constexpr bool is_leaf = true;
+
+    explicit QpLeaf(T x) : value(std::forward<T>(x)) {}
+
+    const Qp& get() const { return value; }
+
+    void exact(detail::ExactQp& out) const { out.load(detail::ExactView(value)); }
+};
+
+template<class A, class B, int Op>  // Op: 0 multiply, 1 add, -1 subtract
+class QpBinary : public QpExpr<QpBinary<A, B, Op>> {
+private:
+    A a;
+    B b;
+
+    static void apply(detail::ExactQp& out, const detail::ExactView& rhs) {
+        if (Op == 0) {
+            out.multiply(rhs);
+        } else {
+            out.add(rhs, Op < 0);
+        }
+    }
+
+public:
+    static constexpr bool is_leaf = false;
+
+    QpBinary(A x, B y) : a(std::move(x)), b(std::move(y)) {}
+
+    void exact(detail::ExactQp& out) const {
+        if constexpr (Op == 0 && A::is_leaf && B::is_leaf) {
+            out.load_product(detail::ExactView(a.get()), detail::ExactView(b.get()));
+        } else if constexpr (B::is_leaf) {
+            a.exact(out);
+            apply(out, detail::ExactView(b.get()));
+        } else {
+            a.exact(out);
+            detail::ExactQp rhs;
+            b.exact(rhs);
+            apply(out, rhs.view());
+        }
+    }
+};
+
+template<class A>
+class QpNegate : public QpExpr<QpNegate<A>> {
+private:
+    A a;
+
+public:
+    static constexpr bool is_leaf = false;
+
+    explicit QpNegate(A x) : a(std::move(x)) {}
+
+    void exact(detail::ExactQp& out) const {
+        a.exact(out);
+        out.negate();
+    }
+};
+
+inline QpLeaf<const Qp&> defer(const Qp& x) { return QpLeaf<const Qp&>(x); }
+inline QpLeaf<Qp> defer(Qp&& x) { return QpLeaf<Qp>(std::move(x)); }
+
+namespace detail {
+
+template<class T>
+struct IsQp : std::is_same<std::decay_t<T>, Qp> {};
+
+template<class E>
+const E& as_expr(const QpExpr<E>& e) { return e.self(); }
+inline QpLeaf<const Qp&> as_expr(const Qp& x) { return QpLeaf<const Qp&>(x); }
+inline QpLeaf<Qp> as_expr(Qp&& x) { return QpLeaf<Qp>(std::move(x)); }
+
+template<class T>
+using ExprOf = std::decay_t<decltype(as_expr(std::declval<T>()))>;
+
+// Enabled when one side is an expression and the other an expression or Qp
+template<class L, class R>
+using EnableExpr = std::enable_if_t<
+    (std::is_base_of_v<QpExpr<std::decay_t<L>>, std::decay_t<L>> || IsQp<L>::value) &&
+    (std::is_base_of_v<QpExpr<std::decay_t<R>>, std::decay_t<R>> || IsQp<R>::value) &&
+    !(IsQp<L>::value && IsQp<R>::value)>;
+
+template<int Op, class L, class R>
+QpBinary<ExprOf<L>, ExprOf<R>, Op> combine(L&& l, R&& r) {
+    return QpBinary<ExprOf<L>, ExprOf<R>, Op>(as_expr(std::forward<L>(l)), as_expr(std::forward<R>(r)));
+}
+
+} // namespace detail
+
+template<class L, class R, class = detail::EnableExpr<L, R>>
+auto operator*(L&& l, R&& r) { return detail::combine<0>(std::forward<L>(l), std::forward<R>(r)); }
+
+template<class L, class R, class = detail::EnableExpr<L, R>>
+auto operator+(L&& l, R&& r) { return detail::combine<1>(std::forward<L>(l), std::forward<R>(r)); }
+
+template<class L, class R, class = detail::EnableExpr<L, R>>
+auto operator-(L&& l, R&& r) { return detail::combine<-1>(std::forward<L>(l), std::forward<R>(r)); }
+
+template<class E>
+QpNegate<E> operator-(const QpExpr<E>& e) { return QpNegate<E>(e.self()); }
+
+} // namespace libadic
+
+#endif // LIBADIC_QP_EXPR_H
@@ -0,0 +1,149 @@
+#ifndef LIBADIC_REID_LI_H
+#define LIBADIC_REID_LI_H
+
+#include "libadic/qp.h"
+#include "libadic/characters.h"
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace libadic {
+
+/**
+ * Outcome of checking Φ_p(χ) = Ψ_p(χ) for one character
+ */
+struct ReidLiResult {
+    long prime = 0;
+    long precision = 0;
+    long character_index = 0;  // position in enumerate_characters(p, p)
+    long order = 0;
+    bool is_odd = false;
+    bool is_primitive = false;
+    Qp phi_value;
+    Qp psi_value;
+    long precision_achieved = 0;  // valuation of Φ - Ψ (N if equal)
+    bool matches = false;
+    std::string error;  // non-empty if the computation threw
+};
+
+/**
+ * The two sides of the Reid-Li criterion:
+ *   odd χ:  Φ = Σ χ(a) log Γ_p(a)      Ψ = L'_p(0, χ)
+ *   even χ: Φ = Σ χ(a) log(a/(p-1))    Ψ = L_p(0, χ)
+ */
+class ReidLi {
+public:
+    static Qp phi_odd(const DirichletCharacter& chi, long precision);
+    static Qp phi_even(const DirichletCharacter& chi, long precision);
+    static Qp psi_odd(const DirichletCharacter& chi, long precision);
+    static Qp psi_even(const DirichletCharacter& chi, long precision);
+
+    /**
+     * Compute both sides for χ and compare. The criterion counts as met when
+     * Φ - Ψ vanishes to at least precision - tolerance digits. Exceptions are
+     * reported in ReidLiResult::error rather than thrown, except
+     * OperationCancelled (see cancellation.h), which propagates.
+     */
+    static ReidLiResult verify(const DirichletCharacter& chi, long precision,
+                               long tolerance = 5);
+
+    /**
+     * verify() with the precision raised on demand: Φ and Ψ are LazyQp
+     * leaves compared at initial_precision, 2·initial_precision, ... up to
+     * max_precision. A mismatch visible at a low precision returns there;
+     * only characters that keep agreeing are carried to max_precision, and
+     * each side is recomputed only at the precisions actually requested.
+     */
+    static ReidLiResult verify_lazy(const DirichletCharacter& chi, long max_precision,
+                                    long tolerance = 5, long initial_precision = 10);
+
+    /**
+     * Compare already computed Φ and Ψ for χ
+     */
+    static ReidLiResult compare(const DirichletCharacter& chi, const Qp& phi, const Qp& psi,
+                                long precision, long tolerance = 5);
+
+    /**
+     * Φ and Ψ for every character mod p at once, indexed as in
+     * CharacterSumBatch (position k of enumerate_characters(p, p)). Φ and the
+     * even Ψ are batched character sums over all characters, so they cost
+     * O(p log p) transforms instead of O(p) work per character. The odd Ψ
+     * is the same log Γ_p sum as the odd Φ, so it is taken per character from
+     * LFunctions::kubota_leopoldt_derivative rather than from the batch.
+     */
+    static void sides_all(long p, long precision, std::vector<Qp>& phi, std::vector<Qp>& psi);
+
+    /**
+     * Φ and Ψ for the Galois orbit of χ (a character mod p), entry i
+     * belonging to chi.galois_orbit()[i]. Conjugates share the parity of χ,
+     * and each side is one graded sum for the orbit evaluated at every
+     * conjugate root of unity, so an orbit of size φ(d) costs about p + φ(d)·d
+     * operations per side instead of φ(d)·p. As in sides_all, the odd Ψ is
+     * evaluated per conjugate.
+     */
+    static void sides_orbit(const DirichletCharacter& chi, long precision,
+                            std::vector<Qp>& phi, std::vector<Qp>& psi);
+};
+
+struct ReidLiConfig {
+    long min_prime = 5;
+    long max_prime = 97;
+    // Explicit primes to sweep; overrides [min_prime, max_prime] when non-empty
+    std::vector<long> primes;
+    long precision = 20;
+    // Optional per-prime precision; overrides `precision` when set
+    std::function<long(long)> precision_for_prime;
+    long tolerance = 5;
+    size_t threads = 0;          // 0 = all hardware threads
+    bool primitive_only = true;
+    bool skip_principal = true;
+    // Schedule one task per Galois orbit of characters (ReidLi::sides_orbit)
+    // instead of one sides_all pass per prime
+    bool galois_orbits = false;
+};
+
+struct ReidLiSummary {
+    long primes = 0;
+    long characters = 0;
+    long matched = 0;
+    long failed = 0;
+    long errors = 0;
+};
+
+/**
+ * Parallel Reid-Li sweep over every prime in [min_prime, max_prime] (or
+ * over ReidLiConfig::primes).
+ *
+ * Each prime becomes a task that computes Φ and Ψ for all its characters
+ * with ReidLi::sides_all and fans out one comparison task per character
+ * onto a work-stealing ThreadPool; with ReidLiConfig::galois_orbits it fans
+ * out one task per orbit instead, which computes that orbit's sides and
+ * compares its members. Results are streamed
+ * to the sink as they complete, in no particular order; the sink is invoked
+ * under a lock, so it does not need to be thread-safe itself.
+ */
+class ReidLiEngine {
+public:
+    using Sink = std::function<void(const ReidLiResult&)>;
+
+    explicit ReidLiEngine(ReidLiConfig config);
+
+    ReidLiSummary run(const Sink& sink) const;
+
+    /**
+     * Run and collect, sorted by (prime, character_index)
+     */
+    std::vector<ReidLiResult> run() const;
+
+    const ReidLiConfig& get_config() const { return config; }
+
+    static std::vector<long> primes_in_range(long lo, long hi);
+
+private:
+    ReidLiConfig config;
+};
+
+} // namespace libadic
+
+#endif // LIBADIC_REID_LI_H
@@ -0,0 +1,122 @@
+#ifndef LIBADIC_REID_LI_SWEEP_H
+#define LIBADIC_REID_LI_SWEEP_H
+
+#include "libadic/reid_li.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace libadic {
+
+/**
+ * One unit of a distributed sweep: the Galois orbit of characters of order
+ * `order` mod `prime`, represented by its smallest index (p-1)/order
+ */
+struct ReidLiUnit {
+    long prime = 0;
+    long precision = 0;
+    long representative = 0;  // index() of the first orbit member
+    long order = 0;
+    long size = 0;            // φ(order) members
+    double cost = 0;          // estimated_cost(prime, precision, order)
+
+    /**
+     * File stem of the unit's claim and checkpoint, e.g. "p101_chi4_N20"
+     */
+    std::string name() const;
+};
+
+struct ReidLiSweepConfig {
+    // Primes, precision, tolerance, threads per process and the character
+    // filters; galois_orbits is implied
+    ReidLiConfig sweep;
+    // Existing directory for claims and checkpoints, shared by all workers
+    std::string directory;
+    size_t worker = 0;
+    size_t workers = 1;
+    // Claim units through `directory` as threads become free (needs a
+    // shared filesystem); otherwise each worker takes a fixed share
+    bool dynamic = true;
+    // Take over units other workers claimed but never checkpointed (only
+    // once those workers have stopped)
+    bool reclaim = false;
+};
+
+struct ReidLiSweepSummary {
+    ReidLiSummary results;  // over the results streamed by this worker
+    long units = 0;         // units this worker considered
+    long computed = 0;      // computed and checkpointed by this run
+    long resumed = 0;       // read back from this worker's earlier checkpoints
+    long elsewhere = 0;     // claimed or completed by other workers
+};
+
+/**
+ * Reid-Li sweep split into (p, χ-orbit) units over several processes or
+ * nodes, coordinated through a directory with no server.
+ *
+ * Units are ordered by estimated cost, largest first, so that greedy
+ * scheduling ends with the cheap units (longest processing time first).
+ * With `dynamic`, each thread claims its next unit by creating
+ * <name>.claim exclusively, holding the worker id; with a fixed share, the
+ * units are dealt out in that order to the least loaded worker.
+ *
+ * A completed unit is written atomically to <name>.bin, a ResultStore file
+ * holding Φ and Ψ for each orbit member (Table::ReidLiSides). Rerunning a
+ * worker with the same id, directory and configuration therefore resumes
+ * it: its checkpointed units are read back and streamed to the sink
+ * without being recomputed, and units it had claimed but not finished are
+ * computed again. A unit in which any character fails is not checkpointed,
+ * and its claim is released so that a later run retries it.
+ */
+class ReidLiSweep {
+public:
+    using Sink = ReidLiEngine::Sink;
+
+    explicit ReidLiSweep(ReidLiSweepConfig config);
+
+    /**
+     * Every unit of the sweep, in scheduling order (decreasing cost)
+     */
+    const std::vector<ReidLiUnit>& get_units() const { return units; }
+
+    /**
+     * Positions in get_units() of the fixed share of `worker`
+     */
+    std::vector<size_t> share(size_t worker) const;
+
+    /**
+     * Run this worker's part of the sweep. Results are streamed under a
+     * lock, in no particular order, as with ReidLiEngine::run.
+     */
+    ReidLiSweepSummary run(const Sink& sink) const;
+
+    /**
+     * Every checkpointed result in the directory, from all workers, sorted
+     * by (prime, character_index); `missing` receives the number of units
+     * without a checkpoint.
+     */
+    std::vector<ReidLiResult> collect(size_t* missing = nullptr) const;
+
+    std::string checkpoint_path(const ReidLiUnit& unit) const;
+    std::string claim_path(const ReidLiUnit& unit) const;
+
+    /**
+     * Relative cost of the orbit of order d mod p at precision N: (p + φ(d)·d)
+     * multiplications per side, for the graded sums and their evaluation at
+     * each conjugate, each O(N²) on N-digit operands. The p·N² term
+     * dominates for all but the largest orbits.
+     */
+    static double estimated_cost(long p, long N, long order);
+
+    const ReidLiSweepConfig& get_config() const { return config; }
+
+private:
+    ReidLiSweepConfig config;
+    std::vector<ReidLiUnit> units;
+
+    bool load_checkpoint(const ReidLiUnit& unit, const Sink& emit) const;
+};
+
+} // namespace libadic
+
+#endif // LIBADIC_REID_LI_SWEEP_H
@@ -0,0 +1,113 @@
+#ifndef LIBADIC_RESULT_STORE_H
+#define LIBADIC_RESULT_STORE_H
+
+#include "libadic/qp.h"
+#include "libadic/cache.h"
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace libadic {
+
+/**
+ * Persistent table of computed results, saved to and loaded from a
+ * versioned binary file.
+ *
+ * An entry is identified by its table, integer key fields and an optional
+ * string tag, without the precision: each key keeps only its most precise
+ * values, and a query at a lower precision is answered by truncating them
+ * with with_precision(). LFunctions::load_cache fills the
+ * process-wide instance() and the L-value and Bernoulli caches consult it on
+ * a miss, so values computed by an earlier run are not derived again.
+ *
+ * File layout: the 8-byte magic "LIBADICS", then in the varint encoding of
+ * serialization.h the format version and record count, and per record a
+ * u8 table, the key fields, the tag bytes, the precision and the values as
+ * wire-format Qp.
+ */
+class ResultStore {
+public:
+    // 4: log Γ_p(1) = 0, which changes stored L'_p(0, χ) and Reid-Li sides
+    // 5: B_{n,χ} sums Teichmüller χ(a), which changes stored GeneralizedBernoulli values
+    static constexpr uint32_t format_version = 5;
+
+    enum class Table : uint8_t {
+        LValue = 1,                // fields {s, p, modulus, χ.index()}
+        LDerivative = 2,           // fields {s, p, modulus, χ.index()}
+        Bernoulli = 3,             // fields {p}, values B_0..B_m
+        GeneralizedBernoulli = 4,  // fields {n, conductor, p, modulus, χ.index()}
+        ReidLiSides = 5            // fields {p, χ.index()}, values Φ, Ψ
+    };
+
+    struct Key {
+        Table table;
+        std::vector<long> fields;
+        std::string tag;
+
+        bool operator==(const Key& other) const {
+            return table == other.table && fields == other.fields && tag == other.tag;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& k) const {
+            size_t h = std::hash<std::string>()(k.tag);
+            hash_combine(h, static_cast<size_t>(k.table));
+            for (long f : k.fields) {
+                hash_combine(h, std::hash<long>()(f));
+            }
+            return h;
+        }
+    };
+
+    /**
+     * The store the library caches read from
+     */
+    static ResultStore& instance();
+
+    /**
+     * The stored values truncated to `precision`, if the entry was computed
+     * at a precision of at least `precision` and holds at least `min_length`
+     * values.
+     */
+    std::optional<std::vector<Qp>> find(const Key& key, long precision, size_t min_length = 1) const;
+
+    /**
+     * Record values computed at `precision`; an existing entry is replaced
+     * only by a more precise one (or an equally precise, longer one).
+     */
+    void insert(const Key& key, long precision, std::vector<Qp> values);
+
+    /**
+     * Merge the records of a file written by save(); returns how many were
+     * read. Throws std::runtime_error if the file cannot be read or has a
+     * different format version.
+     */
+    size_t load(const std::string& path);
+
+    /**
+     * Write every entry; the file is replaced atomically via a temporary
+     */
+    void save(const std::string& path) const;
+
+    size_t size() const;
+    void clear();
+
+private:
+    struct Entry {
+        long precision;
+        std::vector<Qp> values;
+    };
+
+    mutable std::mutex mutex;
+    std::unordered_map<Key, Entry, KeyHash> entries;
+
+    void insert_locked(const Key& key, long precision, std::vector<Qp> values);
+};
+
+} // namespace libadic
+
+#endif // LIBADIC_RESULT_STORE_H
@@ -0,0 +1,154 @@
+#ifndef LIBADIC_SERIALIZATION_H
+#define LIBADIC_SERIALIZATION_H
+
+#include "libadic/zp.h"
+#include "libadic/qp.h"
+#include "libadic/cyclotomic.h"
+#include "libadic/characters.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+namespace libadic {
+
+/**
+ * Compact binary wire format for p-adic values and characters.
+ *
+ * Every value starts with a one-byte WireTag. Integers in headers are
+ * LEB128 varints (zigzag-encoded where they may be negative), and residues
+ * are their raw little-endian 64-bit limbs, so a 100-digit p-adic number
+ * costs a few header bytes plus its limbs instead of ~100 decimal digits:
+ *
+ *   Zp:          tag, p, N, limb count, limbs
+ *   Qp:          tag, p, N, v, unit precision, limb count, limbs (none for zero)
+ *   Cyclotomic:  tag, p, N, coefficient count, then that many Qp
+ *   Character:   tag, modulus, p, conductor, generator count, then
+ *                (generator, order, value) per generator
+ *
+ * The layout does not depend on the host's endianness or word size.
+ */
+enum class WireTag : uint8_t {
+    Zp = 1,
+    Qp = 2,
+    Cyclotomic = 3,
+    Character = 4
+};
+
+/**
+ * Streaming encoder: each write appends one value to the stream
+ */
+class BinaryWriter {
+private:
+    std::ostream& out;
+    size_t written = 0;
+
+public:
+    explicit BinaryWriter(std::ostream& stream) : out(stream) {}
+
+    void write_u8(uint8_t x);
+    void write_uvarint(uint64_t x);
+    void write_varint(int64_t x);
+    void write_bytes(const void* data, size_t size);
+
+    /**
+     * Limb count followed by the limbs of a non-negative integer
+     */
+    void write_limbs(const BigInt& x);
+
+    void write(const Zp& x);
+    void write(const Qp& x);
+    void write(const Cyclotomic& x);
+    void write(const DirichletCharacter& chi);
+
+    size_t bytes_written() const { return written; }
+
+    /**
+     * Encode a single value into a byte string
+     */
+    template<class T>
+    static std::string to_bytes(const T& x);
+};
+
+/**
+ * A Zp on the wire, pointing into the encoded buffer instead of copying
+ * its limbs
+ */
+struct ZpView {
+    long prime = 0;
+    long precision = 0;
+    size_t limb_count = 0;
+    const unsigned char* limbs = nullptr;  // limb_count little-endian words, unaligned
+
+    uint64_t limb(size_t i) const;
+    void value_into(BigInt& out) const;
+    Zp to_zp() const;
+};
+
+/**
+ * A Qp on the wire; `unit` refers to the encoded buffer
+ */
+struct QpView {
+    long prime = 0;
+    long precision = 0;
+    long valuation = 0;
+    ZpView unit;  // precision is the unit precision; no limbs for zero
+
+    bool is_zero() const { return unit.limb_count == 0; }
+    Qp to_qp() const;
+};
+
+/**
+ * Decoder over an encoded buffer, which must outlive the reader and any
+ * views it returns. Malformed or truncated input throws std::runtime_error.
+ */
+class BinaryReader {
+private:
+    const unsigned char* data;
+    size_t size;
+    size_t offset = 0;
+
+    const unsigned char* take(size_t n);
+    void expect(WireTag tag);
+    ZpView read_zp_body(long prime, long precision);
+
+public:
+    BinaryReader(const void* buffer, size_t length)
+        : data(static_cast<const unsigned char*>(buffer)), size(length) {}
+    explicit BinaryReader(const std::string& bytes) : BinaryReader(bytes.data(), bytes.size()) {}
+
+    uint8_t read_u8();
+    uint64_t read_uvarint();
+    int64_t read_varint();
+    const unsigned char* read_bytes(size_t n) { return take(n); }
+
+    /**
+     * Tag of the next value without consuming it
+     */
+    WireTag peek_tag() const;
+
+    ZpView read_zp_view();
+    QpView read_qp_view();
+
+    Zp read_zp() { return read_zp_view().to_zp(); }
+    Qp read_qp() { return read_qp_view().to_qp(); }
+    Cyclotomic read_cyclotomic();
+    DirichletCharacter read_character();
+
+    size_t position() const { return offset; }
+    size_t remaining() const { return size - offset; }
+    bool at_end() const { return offset == size; }
+};
+
+template<class T>
+std::string BinaryWriter::to_bytes(const T& x) {
+    std::ostringstream stream;
+    BinaryWriter writer(stream);
+    writer.write(x);
+    return stream.str();
+}
+
+} // namespace libadic
+
+#endif // LIBADIC_SERIALIZATION_H
@@ -0,0 +1,433 @@
+#ifndef LIBADIC_STATIC_PADIC_H
+#define LIBADIC_STATIC_PADIC_H
+
+#include "libadic/montgomery.h"
+#include "libadic/qp.h"
+#include "libadic/zp.h"
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace libadic {
+
+namespace detail {
+
+// p^N, or 0 once it would reach 2^63
+constexpr uint64_t static_modulus(long p, long N) {
+    u128 m = 1;
+    for (long i = 0; i < N; ++i) {
+        m *= static_cast<u128>(p);
+        if (m >= (static_cast<u128>(1) << 63)) {
+            return 0;
+        }
+    }
+    return static_cast<uint64_t>(m);
+}
+
+} // namespace detail
+
+/**
+ * Element of Z/p^N Z for a (p, N) fixed at compile time.
+ *
+ * The counterpart of ZpWord64 for the few configurations a production run
+ * uses: the residue is one Montgomery-form word and the backend constants
+ * (p^N, -p^{-N} mod 2^64, R mod p^N, R² mod p^N) are constant expressions,
+ * so there is no context pointer, no prime or precision check per operation
+ * and the p = 2 branches of the backend fold away. p^N must be below 2^63.
+ *
+ * Converts to and from Zp: StaticZp(x) needs x.get_prime() == P and at
+ * least N digits, and to_zp() returns a Zp at precision N.
+ */
+template<long P, long N>
+class StaticZp {
+    static_assert(P >= 2, "StaticZp: the prime must be at least 2");
+    static_assert(N >= 1, "StaticZp: the precision must be at least 1");
+    static_assert(detail::static_modulus(P, N) != 0, "StaticZp: p^N must be below 2^63");
+
+public:
+    using word = uint64_t;
+
+    static constexpr long prime = P;
+    static constexpr long precision = N;
+    static constexpr word modulus = detail::static_modulus(P, N);
+    static constexpr Word64Backend backend{P, modulus};
+
+private:
+    word r = 0;  // Montgomery form
+
+    struct Raw {};
+    constexpr StaticZp(word mont, Raw) : r(mont) {}
+
+    static constexpr word reduce(long val) {
+        long m = static_cast<long>(modulus);
+        long v = val % m;
+        return static_cast<word>(v < 0 ? v + m : v);
+    }
+
+public:
+    constexpr StaticZp() = default;
+
+    constexpr StaticZp(long val) : r(backend.to_mont(reduce(val))) {}
+
+    explicit StaticZp(const BigInt& val) : r(backend.to_mont(val)) {}
+
+    explicit StaticZp(const Zp& x) {
+        if (x.get_prime() != P) {
+            throw std::invalid_argument("StaticZp: prime mismatch");
+        }
+        if (x.get_precision() < N) {
+            throw std::invalid_argument("StaticZp: the Zp carries fewer than N digits");
+        }
+        r = backend.to_mont(x.get_value());
+    }
+
+    /**
+     * Wrap a residue that is already in Montgomery form
+     */
+    static constexpr StaticZp from_montgomery(word mont) { return StaticZp(mont, Raw{}); }
+
+    static constexpr StaticZp from_residue(word residue) {
+        return StaticZp(backend.to_mont(residue % modulus), Raw{});
+    }
+
+    static constexpr StaticZp one() { return StaticZp(backend.one(), Raw{}); }
+
+    constexpr long get_prime() const { return P; }
+    constexpr long get_precision() const { return N; }
+    constexpr word montgomery() const { return r; }
+
+    /**
+     * Canonical residue in [0, p^N)
+     */
+    constexpr word residue() const { return backend.from_mont(r); }
+
+    BigInt to_bigint() const { return bigint_from_u128(residue()); }
+
+    Zp to_zp() const { return Zp(P, N, to_bigint()); }
+
+    constexpr StaticZp operator+(const StaticZp& other) const {
+        return StaticZp(backend.add(r, other.r), Raw{});
+    }
+
+    constexpr StaticZp operator-(const StaticZp& other) const {
+        return StaticZp(backend.sub(r, other.r), Raw{});
+    }
+
+    constexpr StaticZp operator*(const StaticZp& other) const {
+        return StaticZp(backend.mul(r, other.r), Raw{});
+    }
+
+    constexpr StaticZp operator/(const StaticZp& other) const {
+        if (!other.is_unit()) {
+            throw std::domain_error("Division by non-unit in StaticZp");
+        }
+        return StaticZp(backend.mul(r, backend.inverse(other.r)), Raw{});
+    }
+
+    constexpr StaticZp operator-() const { return StaticZp(backend.sub(0, r), Raw{}); }
+
+    constexpr StaticZp& operator+=(const StaticZp& other) { r = backend.add(r, other.r); return *this; }
+    constexpr StaticZp& operator-=(const StaticZp& other) { r = backend.sub(r, other.r); return *this; }
+    constexpr StaticZp& operator*=(const StaticZp& other) { r = backend.mul(r, other.r); return *this; }
+    constexpr StaticZp& operator/=(const StaticZp& other) { *this = *this / other; return *this; }
+
+    constexpr bool operator==(const StaticZp& other) const { return r == other.r; }
+    constexpr bool operator!=(const StaticZp& other) const { return r != other.r; }
+
+    constexpr bool is_zero() const { return r == 0; }
+
+    constexpr bool is_unit() const { return residue() % static_cast<word>(P) != 0; }
+
+    /**
+     * p-adic valuation of the residue; N for zero
+     */
+    constexpr long valuation() const {
+        word x = residue();
+        if (x == 0) {
+            return N;
+        }
+        long v = 0;
+        while (x % static_cast<word>(P) == 0) {
+            x /= static_cast<word>(P);
+            ++v;
+        }
+        return v;
+    }
+
+    constexpr StaticZp pow(u128 exp) const { return StaticZp(backend.pow(r, exp), Raw{}); }
+
+    constexpr StaticZp inverse() const {
+        if (!is_unit()) {
+            throw std::domain_error("Cannot invert non-unit in StaticZp");
+        }
+        return StaticZp(backend.inverse(r), Raw{});
+    }
+
+    /**
+     * Teichmüller lift ω(x) = lim x^{p^k}: x^{p^{N-1}} mod p^N, which is
+     * 0 for p | x; for p = 2, ω(x) = 1 on units
+     */
+    constexpr StaticZp teichmuller() const {
+        if constexpr (P == 2) {
+            return is_unit() ? one() : StaticZp();
+        } else {
+            return pow(static_cast<u128>(modulus / static_cast<word>(P)));
+        }
+    }
+};
+
+template<long P, long N>
+constexpr StaticZp<P, N> operator*(long a, const StaticZp<P, N>& b) { return StaticZp<P, N>(a) * b; }
+
+template<long P, long N>
+constexpr StaticZp<P, N> operator+(long a, const StaticZp<P, N>& b) { return StaticZp<P, N>(a) + b; }
+
+template<long P, long N>
+constexpr StaticZp<P, N> operator-(long a, const StaticZp<P, N>& b) { return StaticZp<P, N>(a) - b; }
+
+/**
+ * p^valuation · unit with the unit a StaticZp<P, N>: a fixed relative
+ * precision of N digits, like a floating-point number, rather than Qp's
+ * fixed absolute precision.
+ *
+ * Products and quotients keep all N digits of the unit. A sum whose terms
+ * cancel to valuation w loses the top w - min(v_a, v_b) digits, which read
+ * as zero, and a term whose valuation exceeds the other's by N or more is
+ * absorbed. Zero is
+ * exact and has infinite valuation (std::numeric_limits<long>::max()).
+ *
+ * to_qp() gives a Qp with absolute precision valuation + N. StaticQp(x)
+ * takes the valuation and unit of x; unit digits x does not carry (fewer
+ * than N when x.get_precision() - x.valuation() < N) read as zero.
+ */
+template<long P, long N>
+class StaticQp {
+public:
+    using Unit = StaticZp<P, N>;
+    using word = typename Unit::word;
+
+    static constexpr long prime = P;
+    static constexpr long precision = N;
+
+private:
+    long v = 0;
+    Unit u;  // a unit, or zero for the value 0
+
+    // p^k for 0 <= k < N
+    static constexpr std::array<word, N> powers = []() {
+        std::array<word, N> table{};
+        word x = 1;
+        for (long k = 0; k < N; ++k) {
+            table[k] = x;
+            x *= static_cast<word>(P);
+        }
+        return table;
+    }();
+
+    constexpr StaticQp(long valuation, Unit unit, int) : v(valuation), u(unit) {}
+
+    // p^shift · x for a residue x and shift + v_p(x) >= 0, read as a new unit
+    static constexpr StaticQp normalise(long shift, word x) {
+        if (x == 0) {
+            return StaticQp();
+        }
+        while (x % static_cast<word>(P) == 0) {
+            x /= static_cast<word>(P);
+            ++shift;
+        }
+        return StaticQp(shift, Unit::from_residue(x), 0);
+    }
+
+public:
+    constexpr StaticQp() = default;
+
+    constexpr StaticQp(long val) {
+        if (val != 0) {
+            long shift = 0;
+            while (val % P == 0) {
+                val /= P;
+                ++shift;
+            }
+            v = shift;
+            u = Unit(val);
+        }
+    }
+
+    constexpr StaticQp(const Unit& x) : StaticQp(normalise(0, x.residue())) {}
+
+    /**
+     * p^valuation · unit; `unit` must be a unit
+     */
+    static constexpr StaticQp from_unit(long valuation, const Unit& unit) {
+        if (!unit.is_unit()) {
+            throw std::invalid_argument("StaticQp::from_unit needs a unit");
+        }
+        return StaticQp(valuation, unit, 0);
+    }
+
+    explicit StaticQp(const Qp& x) {
+        if (x.get_prime() != P) {
+            throw std::invalid_argument("StaticQp: prime mismatch");
+        }
+        if (!x.is_zero()) {
+            v = x.valuation();
+            u = Unit(x.get_unit().get_value());
+        }
+    }
+
+    Qp to_qp() const {
+        if (is_zero()) {
+            return Qp(P, N, 0);
+        }
+        return Qp(P, v + N, v, u.to_zp());
+    }
+
+    constexpr bool is_zero() const { return u.is_zero(); }
+
+    constexpr long valuation() const { return is_zero() ? std::numeric_limits<long>::max() : v; }
+
+    constexpr const Unit& get_unit() const { return u; }
+
+    constexpr StaticQp operator*(const StaticQp& other) const {
+        if (is_zero() || other.is_zero()) {
+            return StaticQp();
+        }
+        return StaticQp(v + other.v, u * other.u, 0);
+    }
+
+    constexpr StaticQp operator/(const StaticQp& other) const {
+        if (other.is_zero()) {
+            throw std::domain_error("Division by zero");
+        }
+        if (is_zero()) {
+            return StaticQp();
+        }
+        return StaticQp(v - other.v, u * other.u.inverse(), 0);
+    }
+
+    constexpr StaticQp operator+(const StaticQp& other) const {
+        if (other.is_zero()) {
+            return *this;
+        }
+        if (is_zero()) {
+            return other;
+        }
+        const StaticQp& low = v <= other.v ? *this : other;
+        const StaticQp& high = v <= other.v ? other : *this;
+        long shift = high.v - low.v;
+        if (shift >= N) {
+            return low;
+        }
+        Unit sum = low.u + Unit::from_residue(powers[shift]) * high.u;
+        if (shift > 0) {
+            return StaticQp(low.v, sum, 0);  // still a unit
+        }
+        return normalise(low.v, sum.residue());
+    }
+
+    constexpr StaticQp operator-() const { return StaticQp(v, -u, 0); }
+
+    constexpr StaticQp operator-(const StaticQp& other) const { return *this + (-other); }
+
+    constexpr StaticQp& operator+=(const StaticQp& other) { return *this = *this + other; }
+    constexpr StaticQp& operator-=(const StaticQp& other) { return *this = *this - other; }
+    constexpr StaticQp& operator*=(const StaticQp& other) { return *this = *this * other; }
+    constexpr StaticQp& operator/=(const StaticQp& other) { return *this = *this / other; }
+
+    constexpr bool operator==(const StaticQp& other) const {
+        return is_zero() ? other.is_zero() : (v == other.v && u == other.u);
+    }
+    constexpr bool operator!=(const StaticQp& other) const { return !(*this == other); }
+};
+
+/**
+ * Special functions on StaticZp<P, N>, with their series coefficients
+ * computed at compile time
+ */
+template<long P, long N>
+class StaticPadic {
+public:
+    using Element = StaticZp<P, N>;
+    using word = typename Element::word;
+
+private:
+    // Largest k with k - v_p(k) < N: the last term of the log series that
+    // survives mod p^N
+    static constexpr long log_terms = []() {
+        long last = 1;
+        for (long k = 1; k <= N + 64; ++k) {
+            long e = 0;
+            for (long m = k; m % P == 0; m /= P) ++e;
+            if (k - e < N) last = k;
+        }
+        return last;
+    }();
+
+    // log(1 + p t) = Σ_k (-1)^{k+1} p^{k-e} / (k / p^e) · t^k, e = v_p(k):
+    // the coefficients in Montgomery form, the inverses of the units k / p^e
+    // taken at compile time
+    static constexpr std::array<word, log_terms + 1> log_coefficients = []() {
+        std::array<word, log_terms + 1> table{};
+        const Word64Backend& be = Element::backend;
+        for (long k = 1; k <= log_terms; ++k) {
+            long e = 0;
+            long unit = k;
+            while (unit % P == 0) {
+                unit /= P;
+                ++e;
+            }
+            word c = be.to_mont(static_cast<word>(unit));
+            c = be.inverse(c);
+            c = be.mul(c, be.pow(be.to_mont(static_cast<word>(P)), static_cast<u128>(k - e)));
+            table[k] = (k % 2 == 1) ? c : be.sub(0, c);
+        }
+        return table;
+    }();
+
+public:
+    /**
+     * log x for x ≡ 1 (mod p) (mod 4 for p = 2), as PadicLog::log. Horner on
+     * t = (x - 1)/p: one product and one sum per term of the series.
+     */
+    static constexpr Element log(const Element& x) {
+        word residue = x.residue();
+        if constexpr (P == 2) {
+            if ((Element::modulus >= 4 ? residue % 4 : residue) != 1) {
+                throw std::domain_error("p-adic logarithm does not converge: x must be ≡ 1 (mod 4)");
+            }
+        } else {
+            if (residue % static_cast<word>(P) != 1) {
+                throw std::domain_error("p-adic logarithm does not converge: x must be ≡ 1 (mod p)");
+            }
+        }
+        Element t = Element::from_residue((residue + Element::modulus - 1) % Element::modulus / static_cast<word>(P));
+        Element result;
+        for (long k = log_terms; k >= 1; --k) {
+            result = (result + Element::from_montgomery(log_coefficients[k])) * t;
+        }
+        return result;
+    }
+
+    /**
+     * Morita's Γ_p(n) = (-1)^n ∏_{0<j<n, p∤j} j for an integer n >= 1
+     */
+    static constexpr Element gamma(long n) {
+        if (n < 1) {
+            throw std::domain_error("StaticPadic::gamma needs a positive integer");
+        }
+        Element product = Element::one();
+        for (long j = 1; j < n; ++j) {
+            if (j % P != 0) {
+                product *= Element(j);
+            }
+        }
+        return n % 2 == 0 ? product : -product;
+    }
+
+    static constexpr Element teichmuller(const Element& x) { return x.teichmuller(); }
+};
+
+} // namespace libadic
+
+#endif // LIBADIC_STATIC_PADIC_H
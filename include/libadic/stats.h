@@ -0,0 +1,149 @@
+#ifndef LIBADIC_STATS_H
+#define LIBADIC_STATS_H
+
+#include "libadic/cache.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Set by the LIBADIC_ENABLE_STATS CMake option
+#ifndef LIBADIC_STATS
+#define LIBADIC_STATS 0
+#endif
+
+namespace libadic {
+namespace stats {
+
+/**
+ * Instrumented hot paths
+ */
+enum class Id : size_t {
+    padic_log,                // PadicLog::log; iterations = series terms
+    padic_log_range,          // PadicLog::log_range; iterations = values
+    padic_exp,                // PadicLog::exp; iterations = Newton steps
+    log_series,               // PadicLog::log_series; iterations = terms
+    gamma,                    // PadicGamma::gamma
+    log_gamma,                // PadicGamma::log_gamma
+    bernoulli_range,          // BernoulliNumbers::bernoulli_range; iterations = B_n computed
+    character_evaluate_at,    // DirichletCharacter::evaluate_at (counted, not timed)
+    character_group_table,    // (Z/nZ)* tables; iterations = primitive root candidates
+    kubota_leopoldt,          // LFunctions::kubota_leopoldt
+    kubota_leopoldt_derivative,
+    count
+};
+
+/**
+ * Totals for one hot path since the last reset(). Precision inflation is
+ * the sum over calls of working precision minus requested precision.
+ */
+struct Counter {
+    std::string name;
+    uint64_t calls = 0;
+    uint64_t nanoseconds = 0;
+    uint64_t iterations = 0;
+    uint64_t precision_inflation = 0;
+
+    double mean_ns() const {
+        return calls == 0 ? 0.0 : static_cast<double>(nanoseconds) / static_cast<double>(calls);
+    }
+};
+
+struct Snapshot {
+    bool enabled = false;           // false: counters are compiled out and stay zero
+    std::vector<Counter> counters;  // one per Id, in Id order
+    std::vector<CacheStats> caches; // every library cache (always tracked)
+    uint64_t gmp_allocations = 0;   // after track_gmp_allocations()
+    uint64_t gmp_bytes = 0;
+};
+
+/**
+ * True when the library was built with LIBADIC_ENABLE_STATS
+ */
+constexpr bool enabled() { return LIBADIC_STATS != 0; }
+
+/**
+ * Current counters, cache statistics and GMP allocation totals
+ */
+Snapshot snapshot();
+
+/**
+ * Zero the hot-path counters and GMP totals (cache statistics are owned by
+ * the caches themselves)
+ */
+void reset();
+
+/**
+ * Count GMP's allocations from now on by wrapping the memory functions
+ * currently installed (idempotent); a no-op unless enabled()
+ */
+void track_gmp_allocations();
+
+#if LIBADIC_STATS
+
+struct Slot {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> nanoseconds{0};
+    std::atomic<uint64_t> iterations{0};
+    std::atomic<uint64_t> inflation{0};
+};
+
+Slot& slot(Id id);
+
+/**
+ * Counts one call to `id` and its wall time until destruction
+ */
+class Scope {
+private:
+    Slot& target;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit Scope(Id id) : target(slot(id)), start(std::chrono::steady_clock::now()) {
+        target.calls.fetch_add(1, std::memory_order_relaxed);
+    }
+    ~Scope() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        target.nanoseconds.fetch_add(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+            std::memory_order_relaxed);
+    }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    void iterations(uint64_t n) { target.iterations.fetch_add(n, std::memory_order_relaxed); }
+    void inflation(long digits) {
+        if (digits > 0) {
+            target.inflation.fetch_add(static_cast<uint64_t>(digits), std::memory_order_relaxed);
+        }
+    }
+};
+
+/**
+ * Counts one call without timing it, for paths too short to time
+ */
+inline void count(Id id) {
+    slot(id).calls.fetch_add(1, std::memory_order_relaxed);
+}
+
+#else
+
+class Scope {
+public:
+    explicit Scope(Id) {}
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+    void iterations(uint64_t) {}
+    void inflation(long) {}
+};
+
+inline void count(Id) {}
+
+#endif
+
+} // namespace stats
+} // namespace libadic
+
+#endif // LIBADIC_STATS_H
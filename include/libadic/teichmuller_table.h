@@ -0,0 +1,71 @@
+#ifndef LIBADIC_TEICHMULLER_TABLE_H
+#define LIBADIC_TEICHMULLER_TABLE_H
+
+#include "libadic/gmp_wrapper.h"
+#include "libadic/padic_context.h"
+#include <memory>
+#include <vector>
+
+namespace libadic {
+
+/**
+ * All Teichmüller representatives ω(a), 0 <= a < p, modulo p^N.
+ *
+ * ω(g) for a primitive root g is found by Newton iteration on x^{p-1} - 1
+ * with doubling precision; every other ω(g^e) = ω(g)^e then costs a single
+ * multiplication, so the whole table is O(p) products instead of N rounds
+ * of x -> x^p per residue. When p^N fits in a fixed-width backend the
+ * products run in Montgomery words.
+ */
+class TeichmullerTable {
+private:
+    long prime;
+    long precision;
+    std::vector<BigInt> values;  // values[a] = ω(a) mod p^N, values[0] = 0
+
+public:
+    /**
+     * Primes up to this bound are tabulated; lifts for larger primes are
+     * computed one at a time with hensel_lift
+     */
+    static constexpr long max_tabulated_prime = 1L << 15;
+
+    TeichmullerTable(long p, long N);
+
+    /**
+     * Shared table for (p, N), built on first use and kept in the library cache
+     */
+    static std::shared_ptr<const TeichmullerTable> get(long p, long N);
+
+    long get_prime() const { return prime; }
+    long get_precision() const { return precision; }
+
+    /**
+     * ω(a) for 0 <= a < p
+     */
+    const BigInt& operator[](long a) const { return values[a]; }
+
+    /**
+     * ω(a) for any integer a (reduced mod p first)
+     */
+    const BigInt& at(long a) const {
+        a %= prime;
+        return values[a < 0 ? a + prime : a];
+    }
+
+    /**
+     * ω(a) mod p^N for a single a: a^{p^{N-1}} in machine words when p^N
+     * fits, otherwise Newton iteration on x^{p-1} = 1 starting from a mod p.
+     * Returns 0 when p | a.
+     */
+    static BigInt hensel_lift(const BigInt& a, long p, long N);
+
+    /**
+     * ω(a) mod p^N, from the shared table when p is small enough
+     */
+    static BigInt lift(const BigInt& a, long p, long N);
+};
+
+} // namespace libadic
+
+#endif // LIBADIC_TEICHMULLER_TABLE_H
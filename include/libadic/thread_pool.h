@@ -0,0 +1,86 @@
+#ifndef LIBADIC_THREAD_POOL_H
+#define LIBADIC_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace libadic {
+
+/**
+ * Work-stealing pool for coarse-grained p-adic tasks.
+ *
+ * Every worker owns a deque. Tasks submitted from a worker go to that
+ * worker's own deque and are popped LIFO (good locality for nested work such
+ * as "enumerate characters of p, then one task per character"). Idle workers
+ * steal FIFO from the other deques, so large early tasks spread out first.
+ * Tasks submitted from outside the pool are dealt round-robin.
+ *
+ * The first exception thrown by a task is captured and rethrown from
+ * wait_idle(); remaining tasks still run.
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * Start `threads` workers (0 = std::thread::hardware_concurrency())
+     */
+    explicit ThreadPool(size_t threads = 0);
+
+    /**
+     * Drains all queued work, then joins the workers
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(Task task);
+
+    /**
+     * Block until every submitted task, including tasks submitted by tasks,
+     * has finished. Must not be called from inside a pool task.
+     */
+    void wait_idle();
+
+    size_t size() const { return workers.size(); }
+
+    /**
+     * Index of the calling worker in this pool, or -1 from other threads
+     */
+    long current_worker() const;
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex state_mutex;
+    std::condition_variable work_available;
+    std::condition_variable all_done;
+    std::atomic<size_t> queued{0};   // submitted but not yet started
+    std::atomic<size_t> pending{0};  // submitted but not yet finished
+    std::atomic<size_t> next_queue{0};
+    bool stopping = false;
+    std::exception_ptr first_error;
+
+    void worker_loop(size_t index);
+    bool try_pop(size_t index, Task& task);
+    void run_task(Task& task);
+};
+
+} // namespace libadic
+
+#endif // LIBADIC_THREAD_POOL_H
@@ -3,6 +3,7 @@
 
 #include "libadic/gmp_wrapper.h"
 #include "libadic/modular_arith.h"
+#include "libadic/padic_context.h"
 #include <stdexcept>
 #include <vector>
 #include <algorithm>
@@ -10,10 +11,12 @@
 namespace libadic {
 
 class Zp {
+    friend class Qp;
 private:
     long prime;
     long precision;
     BigInt value;
+    const PadicContext* ctx;  // interned p^k table for (prime, precision)
     
     void validate_prime() const {
         if (prime < 2) {
@@ -28,28 +31,59 @@ private:
     }
     
     void normalize() {
-        BigInt p_power = BigInt(prime).pow(precision);
-        value = value % p_power;
-        if (value.is_negative()) {
-            value += p_power;
+        ctx->reduce(value);
+    }
+    
+    /**
+     * Build from a residue already reduced into [0, p^N) for the given context
+     */
+    Zp(const PadicContext& c, BigInt&& reduced)
+        : prime(c.get_prime()), precision(c.get_precision()),
+          value(std::move(reduced)), ctx(&c) {}
+    
+    /**
+     * Drop to the other operand's precision if it is lower. Returns true if
+     * the precisions already matched (the residue then needs at most one
+     * conditional correction after an add or subtract).
+     */
+    bool narrow_to(const Zp& other) {
+        if (prime != other.prime) {
+            throw std::invalid_argument("Cannot combine p-adic numbers with different primes");
+        }
+        if (other.precision == precision) {
+            return true;
+        }
+        if (other.precision < precision) {
+            precision = other.precision;
+            ctx = other.ctx;
         }
+        return false;
+    }
+    
+    /**
+     * Context of the operand with the smaller precision
+     */
+    const PadicContext& common_context(const Zp& other) const {
+        return precision <= other.precision ? *ctx : *other.ctx;
     }
     
 public:
-    Zp() : prime(2), precision(1), value(0) {}
+    Zp() : prime(2), precision(1), value(0), ctx(&PadicContext::get(2, 1)) {}
     
-    Zp(long p, long N) : prime(p), precision(N), value(0) {
+    Zp(long p, long N) : prime(p), precision(N), value(0), ctx(&PadicContext::get(p, N)) {
         validate_prime();
         validate_precision();
     }
     
-    Zp(long p, long N, const BigInt& val) : prime(p), precision(N), value(val) {
+    Zp(long p, long N, const BigInt& val)
+        : prime(p), precision(N), value(val), ctx(&PadicContext::get(p, N)) {
         validate_prime();
         validate_precision();
         normalize();
     }
     
-    Zp(long p, long N, long val) : prime(p), precision(N), value(val) {
+    Zp(long p, long N, long val)
+        : prime(p), precision(N), value(val), ctx(&PadicContext::get(p, N)) {
         validate_prime();
         validate_precision();
         normalize();
@@ -63,54 +97,65 @@ public:
     long get_prime() const { return prime; }
     long get_precision() const { return precision; }
     const BigInt& get_value() const { return value; }
+    const PadicContext& get_context() const { return *ctx; }
     
     Zp with_precision(long new_precision) const {
+        if (new_precision == precision) {
+            return *this;
+        }
+        const PadicContext& c = PadicContext::get(prime, new_precision);
+        BigInt new_value = value;
         if (new_precision < precision) {
-            BigInt new_value = value % BigInt(prime).pow(new_precision);
-            return Zp(prime, new_precision, new_value);
-        } else {
-            return Zp(prime, new_precision, value);
+            c.reduce(new_value);
         }
+        return Zp(c, std::move(new_value));
     }
     
     Zp lift_precision(long new_precision) const {
         if (new_precision <= precision) {
             return *this;
         }
-        return Zp(prime, new_precision, value);
+        return Zp(PadicContext::get(prime, new_precision), BigInt(value));
     }
     
     Zp operator+(const Zp& other) const {
         if (prime != other.prime) {
             throw std::invalid_argument("Cannot add p-adic numbers with different primes");
         }
-        long min_prec = std::min(precision, other.precision);
-        BigInt p_power = BigInt(prime).pow(min_prec);
-        BigInt sum = (value + other.value) % p_power;
-        return Zp(prime, min_prec, sum);
+        const PadicContext& c = common_context(other);
+        BigInt sum = value + other.value;
+        if (precision == other.precision) {
+            c.reduce_once(sum);
+        } else {
+            c.reduce(sum);
+        }
+        return Zp(c, std::move(sum));
     }
     
     Zp operator-(const Zp& other) const {
         if (prime != other.prime) {
             throw std::invalid_argument("Cannot subtract p-adic numbers with different primes");
         }
-        long min_prec = std::min(precision, other.precision);
-        BigInt p_power = BigInt(prime).pow(min_prec);
-        BigInt diff = (value - other.value) % p_power;
-        if (diff.is_negative()) {
-            diff += p_power;
+        const PadicContext& c = common_context(other);
+        BigInt diff = value - other.value;
+        if (precision == other.precision) {
+            if (diff.is_negative()) {
+                diff += c.modulus();
+            }
+        } else {
+            c.reduce(diff);
         }
-        return Zp(prime, min_prec, diff);
+        return Zp(c, std::move(diff));
     }
     
     Zp operator*(const Zp& other) const {
         if (prime != other.prime) {
             throw std::invalid_argument("Cannot multiply p-adic numbers with different primes");
         }
-        long min_prec = std::min(precision, other.precision);
-        BigInt p_power = BigInt(prime).pow(min_prec);
-        BigInt prod = (value * other.value) % p_power;
-        return Zp(prime, min_prec, prod);
+        const PadicContext& c = common_context(other);
+        BigInt prod = value * other.value;
+        c.reduce(prod);
+        return Zp(c, std::move(prod));
     }
     
     Zp operator/(const Zp& other) const {
@@ -120,34 +165,80 @@ public:
         if (other.is_zero()) {
             throw std::domain_error("Division by zero");
         }
-        if (other.value.is_divisible_by(BigInt(prime))) {
+        if (!other.is_unit()) {
             throw std::domain_error("Cannot divide by non-unit in Zp");
         }
-        long min_prec = std::min(precision, other.precision);
-        BigInt p_power = BigInt(prime).pow(min_prec);
-        BigInt inv = other.value.mod_inverse(p_power);
-        BigInt result = (value * inv) % p_power;
-        return Zp(prime, min_prec, result);
+        const PadicContext& c = common_context(other);
+        BigInt inv = other.value.mod_inverse(c.modulus());
+        BigInt result = value * inv;
+        c.reduce(result);
+        return Zp(c, std::move(result));
     }
     
     Zp operator-() const {
-        BigInt p_power = BigInt(prime).pow(precision);
-        BigInt neg = (p_power - value) % p_power;
-        return Zp(prime, precision, neg);
+        if (value.is_zero()) {
+            return *this;
+        }
+        return Zp(*ctx, ctx->modulus() - value);
     }
     
     Zp& operator+=(const Zp& other) {
-        *this = *this + other;
+        bool same_precision = narrow_to(other);
+        mpz_add(value.get_mpz(), value.get_mpz(), other.value.get_mpz());
+        if (same_precision) {
+            ctx->reduce_once(value);
+        } else {
+            ctx->reduce(value);
+        }
         return *this;
     }
     
     Zp& operator-=(const Zp& other) {
-        *this = *this - other;
+        bool same_precision = narrow_to(other);
+        mpz_sub(value.get_mpz(), value.get_mpz(), other.value.get_mpz());
+        if (same_precision) {
+            if (value.is_negative()) {
+                mpz_add(value.get_mpz(), value.get_mpz(), ctx->modulus().get_mpz());
+            }
+        } else {
+            ctx->reduce(value);
+        }
         return *this;
     }
     
     Zp& operator*=(const Zp& other) {
-        *this = *this * other;
+        narrow_to(other);
+        mpz_mul(value.get_mpz(), value.get_mpz(), other.value.get_mpz());
+        ctx->reduce(value);
+        return *this;
+    }
+    
+    /**
+     * Fused multiply-accumulate: *this += a * b, reduced once.
+     * Precision is the minimum of the three operands.
+     */
+    Zp& addmul(const Zp& a, const Zp& b) {
+        if (a.prime != prime || b.prime != prime) {
+            throw std::invalid_argument("Cannot combine p-adic numbers with different primes");
+        }
+        narrow_to(a);
+        narrow_to(b);
+        mpz_addmul(value.get_mpz(), a.value.get_mpz(), b.value.get_mpz());
+        ctx->reduce(value);
+        return *this;
+    }
+    
+    /**
+     * Fused multiply-subtract: *this -= a * b, reduced once.
+     */
+    Zp& submul(const Zp& a, const Zp& b) {
+        if (a.prime != prime || b.prime != prime) {
+            throw std::invalid_argument("Cannot combine p-adic numbers with different primes");
+        }
+        narrow_to(a);
+        narrow_to(b);
+        mpz_submul(value.get_mpz(), a.value.get_mpz(), b.value.get_mpz());
+        ctx->reduce(value);
         return *this;
     }
     
@@ -160,9 +251,15 @@ public:
         if (prime != other.prime) {
             return false;
         }
-        long min_prec = std::min(precision, other.precision);
-        BigInt p_power = BigInt(prime).pow(min_prec);
-        return (value % p_power) == (other.value % p_power);
+        if (precision == other.precision) {
+            return value == other.value;
+        }
+        // The higher-precision residue must be cut down to the common modulus
+        const Zp& lo = precision < other.precision ? *this : other;
+        const Zp& hi = precision < other.precision ? other : *this;
+        BigInt reduced = hi.value;
+        lo.ctx->reduce(reduced);
+        return reduced == lo.value;
     }
     
     bool operator!=(const Zp& other) const {
@@ -178,32 +275,29 @@ public:
     }
     
     bool is_unit() const {
-        return !value.is_divisible_by(BigInt(prime));
+        return !value.is_divisible_by(ctx->prime_bigint());
     }
     
     long valuation() const {
         if (is_zero()) {
             return precision;
         }
-        return p_adic_valuation(value, BigInt(prime));
+        return p_adic_valuation(value, ctx->prime_bigint());
     }
     
     Zp unit_part() const {
         if (is_zero()) {
             return *this;
         }
-        long val = valuation();
-        if (val == 0) {
+        if (is_unit()) {
             return *this;
         }
-        BigInt unit = value / BigInt(prime).pow(val);
-        return Zp(prime, precision - val, unit);
+        ValuationSplit split = split_valuation(value, ctx->prime_bigint());
+        return Zp(prime, precision - split.valuation, split.unit);
     }
     
     Zp pow(const BigInt& exp) const {
-        BigInt p_power = BigInt(prime).pow(precision);
-        BigInt result = value.pow_mod(exp, p_power);
-        return Zp(prime, precision, result);
+        return Zp(*ctx, value.pow_mod(exp, ctx->modulus()));
     }
     
     Zp pow(long exp) const {
@@ -214,81 +308,14 @@ public:
         return Zp(prime, precision, teichmuller_character(value, BigInt(prime), precision));
     }
     
+    /**
+     * Square root of a unit square. For p = 2 the root ≡ 1 (mod 4) is only
+     * determined modulo 2^{N-1} (x and x + 2^{N-1} square to the same value
+     * mod 2^N), so it comes back at precision max(N - 1, 1).
+     */
     Zp sqrt() const {
-        if (!is_unit()) {
-            throw std::domain_error("Square root only defined for units in Zp");
-        }
-        
-        BigInt p(prime);
-        BigInt p_power = p.pow(precision);
-        
-        if (prime == 2) {
-            if ((value % BigInt(8)) != BigInt(1)) {
-                throw std::domain_error("No square root exists (mod 8 condition)");
-            }
-        } else {
-            BigInt legendre = value.pow_mod((p - BigInt(1)) / BigInt(2), p);
-            if (legendre != BigInt(1)) {
-                throw std::domain_error("No square root exists (not a quadratic residue)");
-            }
-        }
-        
-        BigInt root = value % p;
-        if (prime == 2) {
-            root = BigInt(1);
-        } else {
-            BigInt q = p - BigInt(1);
-            BigInt s(0);
-            while ((q % BigInt(2)).is_zero()) {
-                q /= BigInt(2);
-                s += BigInt(1);
-            }
-            
-            BigInt z(2);
-            while (z.pow_mod((p - BigInt(1)) / BigInt(2), p) != (p - BigInt(1))) {
-                z += BigInt(1);
-            }
-            
-            BigInt m = s;
-            BigInt c = z.pow_mod(q, p);
-            BigInt t = value.pow_mod(q, p);
-            BigInt r = value.pow_mod((q + BigInt(1)) / BigInt(2), p);
-            
-            while (!t.is_one()) {
-                BigInt i(1);
-                BigInt t2 = (t * t) % p;
-                while (t2 != BigInt(1)) {
-                    t2 = (t2 * t2) % p;
-                    i += BigInt(1);
-                }
-                
-                BigInt b = c;
-                for (BigInt j(0); j < m - i - BigInt(1); j += BigInt(1)) {
-                    b = (b * b) % p;
-                }
-                
-                m = i;
-                c = (b * b) % p;
-                t = (t * c) % p;
-                r = (r * b) % p;
-            }
-            root = r;
-        }
-        
-        for (long k = 1; k < precision; ++k) {
-            BigInt pk = p.pow(k);
-            BigInt pk1 = pk * p;
-            BigInt f = (root * root - value) % pk1;
-            if (!f.is_zero()) {
-                BigInt correction = (f / pk) * (BigInt(2) * root).mod_inverse(p);
-                root = (root - correction * pk) % pk1;
-                if (root.is_negative()) {
-                    root += pk1;
-                }
-            }
-        }
-        
-        return Zp(prime, precision, root);
+        long root_precision = prime == 2 ? std::max(precision - 1, 1L) : precision;
+        return Zp(prime, root_precision, padic_sqrt(value, prime, precision));
     }
     
     std::string to_string() const {
@@ -307,7 +334,7 @@ public:
     std::vector<long> p_adic_digits() const {
         std::vector<long> digits;
         BigInt temp = value;
-        BigInt p(prime);
+        const BigInt& p = ctx->prime_bigint();
         
         for (long i = 0; i < precision; ++i) {
             digits.push_back((temp % p).to_long());
@@ -324,17 +351,18 @@ public:
         
         BigInt num(numerator);
         BigInt den(denominator);
-        BigInt prime_big(p);
+        const PadicContext& c = PadicContext::get(p, precision);
+        const BigInt& prime_big = c.prime_bigint();
         
-        while (den.is_divisible_by(prime_big)) {
-            den /= prime_big;
+        if (den.is_divisible_by(prime_big)) {
+            mpz_remove(den.get_mpz(), den.get_mpz(), prime_big.get_mpz());
         }
         
-        BigInt p_power = prime_big.pow(precision);
-        BigInt inv = den.mod_inverse(p_power);
-        BigInt result = (num * inv) % p_power;
+        BigInt inv = den.mod_inverse(c.modulus());
+        BigInt result = num * inv;
+        c.reduce(result);
         
-        return Zp(p, precision, result);
+        return Zp(c, std::move(result));
     }
 };
 
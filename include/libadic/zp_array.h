@@ -0,0 +1,146 @@
+#ifndef LIBADIC_ZP_ARRAY_H
+#define LIBADIC_ZP_ARRAY_H
+
+#include "libadic/qp.h"
+#include "libadic/zp.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace libadic {
+
+/**
+ * A vector of elements of Z_p sharing one prime and precision.
+ *
+ * Elements are kept as residues mod p^N against a single PadicContext, so
+ * elementwise arithmetic runs as one C++ loop with in-place GMP operations
+ * and no per-element Zp objects. Data moves in and out as flat int64
+ * residues (when p^N < 2^63) or as fixed-width little-endian 64-bit limbs,
+ * which is what the Python bindings hand to NumPy.
+ */
+class ZpArray {
+private:
+    long prime;
+    long precision;
+    const PadicContext* ctx;
+    std::vector<BigInt> values;  // residues in [0, p^N)
+
+    void check_compatible(const ZpArray& other) const;
+
+public:
+    ZpArray(long p, long N, size_t count = 0);
+
+    /**
+     * From `count` int64 residues (negative values are reduced mod p^N)
+     */
+    static ZpArray from_residues(long p, long N, const int64_t* data, size_t count);
+
+    /**
+     * From `count` numbers of `limbs` little-endian 64-bit words each
+     */
+    static ZpArray from_limbs(long p, long N, const uint64_t* data, size_t count, size_t limbs);
+
+    long get_prime() const { return prime; }
+    long get_precision() const { return precision; }
+    size_t size() const { return values.size(); }
+
+    /**
+     * Words per element in to_limbs(), enough for p^N - 1
+     */
+    size_t limb_count() const;
+
+    /**
+     * True when every residue fits in an int64 (p^N <= 2^63)
+     */
+    bool fits_int64() const;
+
+    /**
+     * Write size() residues to `out`; throws std::overflow_error unless fits_int64()
+     */
+    void to_residues(int64_t* out) const;
+
+    /**
+     * Write size() * limb_count() little-endian words to `out`
+     */
+    void to_limbs(uint64_t* out) const;
+
+    const BigInt& residue(size_t i) const { return values[i]; }
+    Zp operator[](size_t i) const { return Zp(prime, precision, values[i]); }
+    void set(size_t i, const Zp& x);
+
+    ZpArray operator+(const ZpArray& other) const;
+    ZpArray operator-(const ZpArray& other) const;
+    ZpArray operator*(const ZpArray& other) const;
+    ZpArray operator-() const;
+    ZpArray scale(const Zp& c) const;
+
+    /**
+     * log x for every x ≡ 1 (mod p) (mod 4 for p = 2); the values lie in p Z_p
+     */
+    ZpArray log() const;
+
+    /**
+     * Morita's Γ_p(x) for every unit x
+     */
+    ZpArray gamma() const;
+
+    /**
+     * Teichmüller representative ω(x) for every x
+     */
+    ZpArray teichmuller() const;
+};
+
+/**
+ * A vector of elements of Q_p sharing one prime and absolute precision,
+ * stored as p^{v_i} · u_i with the valuations and unit residues in two
+ * flat arrays.
+ */
+class QpArray {
+private:
+    long prime;
+    long precision;
+    std::vector<Qp> values;
+
+    void check_compatible(const QpArray& other) const;
+
+public:
+    QpArray(long p, long N, size_t count = 0);
+
+    /**
+     * x_i = p^{valuations[i]} · units[i] at absolute precision N
+     */
+    static QpArray from_residues(long p, long N, const int64_t* units, const int64_t* valuations,
+                                 size_t count);
+
+    /**
+     * Units as a ZpArray of precision N and valuations all zero
+     */
+    explicit QpArray(const ZpArray& integers);
+
+    long get_prime() const { return prime; }
+    long get_precision() const { return precision; }
+    size_t size() const { return values.size(); }
+
+    /**
+     * Write the unit residues (mod p^{N - v_i}) and valuations; zeros have
+     * unit 0 and valuation N. Throws std::overflow_error if a unit does
+     * not fit in an int64.
+     */
+    void to_residues(int64_t* units, int64_t* valuations) const;
+
+    const Qp& operator[](size_t i) const { return values[i]; }
+    void set(size_t i, const Qp& x);
+
+    QpArray operator+(const QpArray& other) const;
+    QpArray operator-(const QpArray& other) const;
+    QpArray operator*(const QpArray& other) const;
+
+    /**
+     * log x for every element with valuation 0 and x ≡ 1 (mod p)
+     */
+    QpArray log() const;
+};
+
+} // namespace libadic
+
+#endif // LIBADIC_ZP_ARRAY_H
@@ -0,0 +1,166 @@
+#ifndef LIBADIC_ZP_WORD_H
+#define LIBADIC_ZP_WORD_H
+
+#include "libadic/zp.h"
+#include "libadic/montgomery.h"
+#include "libadic/padic_context.h"
+#include "libadic/teichmuller_table.h"
+#include <stdexcept>
+
+namespace libadic {
+
+template<class Backend> const Backend& backend_of(const PadicContext& ctx);
+
+template<> inline const Word64Backend& backend_of<Word64Backend>(const PadicContext& ctx) {
+    return ctx.word64();
+}
+
+template<> inline const Word128Backend& backend_of<Word128Backend>(const PadicContext& ctx) {
+    return ctx.word128();
+}
+
+/**
+ * Element of Z/p^N Z held in machine words.
+ *
+ * Same value semantics as Zp for a fixed (p, N), but the residue lives in
+ * Montgomery form inside one (Word64Backend) or two (Word128Backend) 64-bit
+ * words, so arithmetic never touches the heap. Both operands of a binary
+ * operation must share the same context; mixed precisions belong to Zp.
+ */
+template<class Backend>
+class ZpT {
+public:
+    using word = typename Backend::word;
+
+private:
+    const PadicContext* ctx;
+    const Backend* be;
+    word r;  // Montgomery form
+
+    ZpT(const PadicContext& c, word mont, int) : ctx(&c), be(&backend_of<Backend>(c)), r(mont) {}
+
+    void check_same(const ZpT& other) const {
+        if (ctx != other.ctx) {
+            throw std::invalid_argument("ZpT operands must share p and precision");
+        }
+    }
+
+public:
+    static bool supports(const PadicContext& c) {
+        return Backend::fits(c.modulus());
+    }
+
+    explicit ZpT(const PadicContext& c) : ZpT(c, 0, 0) {
+        if (!supports(c)) {
+            throw std::invalid_argument("p^N does not fit in the fixed-width backend");
+        }
+    }
+
+    ZpT(const PadicContext& c, long val) : ZpT(c) {
+        BigInt v(val);
+        r = be->to_mont(v);
+    }
+
+    ZpT(const PadicContext& c, const BigInt& val) : ZpT(c) {
+        r = be->to_mont(val);
+    }
+
+    explicit ZpT(const Zp& x) : ZpT(x.get_context()) {
+        r = be->to_mont(x.get_value());
+    }
+
+    /**
+     * Wrap a residue that is already in Montgomery form
+     */
+    static ZpT from_montgomery(const PadicContext& c, word mont) {
+        return ZpT(c, mont, 0);
+    }
+
+    static ZpT one(const PadicContext& c) {
+        ZpT result(c);
+        result.r = result.be->one();
+        return result;
+    }
+
+    long get_prime() const { return ctx->get_prime(); }
+    long get_precision() const { return ctx->get_precision(); }
+    const PadicContext& get_context() const { return *ctx; }
+    word montgomery() const { return r; }
+
+    /**
+     * Canonical residue in [0, p^N)
+     */
+    word residue() const { return be->from_mont(r); }
+
+    BigInt to_bigint() const { return bigint_from_u128(residue()); }
+
+    Zp to_zp() const {
+        return Zp(get_prime(), get_precision(), to_bigint());
+    }
+
+    ZpT operator+(const ZpT& other) const {
+        check_same(other);
+        return ZpT(*ctx, be->add(r, other.r), 0);
+    }
+
+    ZpT operator-(const ZpT& other) const {
+        check_same(other);
+        return ZpT(*ctx, be->sub(r, other.r), 0);
+    }
+
+    ZpT operator*(const ZpT& other) const {
+        check_same(other);
+        return ZpT(*ctx, be->mul(r, other.r), 0);
+    }
+
+    ZpT operator/(const ZpT& other) const {
+        check_same(other);
+        if (!other.is_unit()) {
+            throw std::domain_error("Division by non-unit in ZpT");
+        }
+        return ZpT(*ctx, be->mul(r, be->inverse(other.r)), 0);
+    }
+
+    ZpT operator-() const {
+        return ZpT(*ctx, be->sub(0, r), 0);
+    }
+
+    ZpT& operator+=(const ZpT& other) { check_same(other); r = be->add(r, other.r); return *this; }
+    ZpT& operator-=(const ZpT& other) { check_same(other); r = be->sub(r, other.r); return *this; }
+    ZpT& operator*=(const ZpT& other) { check_same(other); r = be->mul(r, other.r); return *this; }
+    ZpT& operator/=(const ZpT& other) { *this = *this / other; return *this; }
+
+    bool operator==(const ZpT& other) const { return ctx == other.ctx && r == other.r; }
+    bool operator!=(const ZpT& other) const { return !(*this == other); }
+
+    bool is_zero() const { return r == 0; }
+
+    bool is_unit() const {
+        return residue() % static_cast<word>(get_prime()) != 0;
+    }
+
+    ZpT pow(unsigned long exp) const {
+        return ZpT(*ctx, be->pow(r, exp), 0);
+    }
+
+    ZpT inverse() const {
+        if (!is_unit()) {
+            throw std::domain_error("Cannot invert non-unit in ZpT");
+        }
+        return ZpT(*ctx, be->inverse(r), 0);
+    }
+
+    /**
+     * Teichmuller lift omega(x), read from the shared (p, N) table
+     */
+    ZpT teichmuller() const {
+        return ZpT(*ctx, TeichmullerTable::lift(to_bigint(), get_prime(), get_precision()));
+    }
+};
+
+using ZpWord64 = ZpT<Word64Backend>;
+using ZpWord128 = ZpT<Word128Backend>;
+
+} // namespace libadic
+
+#endif // LIBADIC_ZP_WORD_H
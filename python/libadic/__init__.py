@@ -43,3 +43,49 @@ if _libadic:
         if not name.startswith('__'):
             globals()[name] = getattr(_libadic, name)
             __all__.append(name)
+
+
+async def _await_native(start, *args, **kwargs):
+    """Run a native *_async call and await it without blocking the event loop.
+
+    The worker thread wakes the loop through on_ready; cancelling the
+    awaiting task cancels the native computation.
+    """
+    import asyncio
+    loop = asyncio.get_running_loop()
+    done = loop.create_future()
+
+    def settle():
+        if not done.done():
+            done.set_result(None)
+
+    handle = start(*args, on_ready=lambda: loop.call_soon_threadsafe(settle), **kwargs)
+    try:
+        await done
+    except asyncio.CancelledError:
+        handle.cancel()
+        raise
+    return handle.result()
+
+
+async def kubota_leopoldt_aio(s, chi, precision, timeout=None, token=None):
+    """Awaitable L_p(s, chi); raises OperationCancelled past `timeout` seconds"""
+    return await _await_native(_libadic.kubota_leopoldt_async, s, chi, precision,
+                               timeout=timeout, token=token)
+
+
+async def kubota_leopoldt_derivative_aio(s, chi, precision, timeout=None, token=None):
+    """Awaitable L'_p(s, chi); raises OperationCancelled past `timeout` seconds"""
+    return await _await_native(_libadic.kubota_leopoldt_derivative_async, s, chi, precision,
+                               timeout=timeout, token=token)
+
+
+
+async def reid_li_verify_aio(chi, precision, tolerance=5, timeout=None, token=None):
+    """Awaitable Reid-Li check for chi, as a reid_li_sweep result dict"""
+    return await _await_native(_libadic.reid_li_verify_async, chi, precision, tolerance,
+                               timeout=timeout, token=token)
+
+
+if _libadic:
+    __all__ += ['kubota_leopoldt_aio', 'kubota_leopoldt_derivative_aio', 'reid_li_verify_aio']
@@ -0,0 +1,201 @@
+// Python bindings for the ZpArray / QpArray batch types
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/operators.h>
+#include <pybind11/stl.h>
+#include <libadic/zp_array.h>
+#include <libadic/zp_vector.h>
+#include <sstream>
+#include <stdexcept>
+
+namespace py = pybind11;
+using namespace libadic;
+
+namespace {
+
+using Int64Array = py::array_t<int64_t, py::array::c_style | py::array::forcecast>;
+using Limb64Array = py::array_t<uint64_t, py::array::c_style | py::array::forcecast>;
+
+Int64Array residues_of(const ZpArray& a) {
+    Int64Array out(static_cast<py::ssize_t>(a.size()));
+    int64_t* data = out.mutable_data();
+    {
+        py::gil_scoped_release release;
+        a.to_residues(data);
+    }
+    return out;
+}
+
+Limb64Array limbs_of(const ZpArray& a) {
+    size_t limbs = a.limb_count();
+    Limb64Array out({static_cast<py::ssize_t>(a.size()), static_cast<py::ssize_t>(limbs)});
+    uint64_t* data = out.mutable_data();
+    {
+        py::gil_scoped_release release;
+        a.to_limbs(data);
+    }
+    return out;
+}
+
+} // namespace
+
+void bind_arrays(py::module_ &m) {
+    py::class_<ZpArray>(m, "ZpArray", R"pbdoc(
+        Vector of p-adic integers with a shared prime and precision.
+
+        Elementwise arithmetic, log, gamma and teichmuller run as C++ loops
+        with the GIL released; data moves through NumPy arrays of int64
+        residues (p^N < 2^63) or of 64-bit limbs, never per-element objects.
+
+        Examples:
+            >>> import numpy as np
+            >>> a = ZpArray.from_numpy(7, 10, np.arange(1, 1001))
+            >>> g = a.gamma().to_numpy()
+    )pbdoc")
+        .def(py::init<long, long, size_t>(),
+             py::arg("prime"), py::arg("precision"), py::arg("size") = 0,
+             "Array of `size` zeros")
+        .def_static("from_numpy", [](long p, long N, Int64Array residues) {
+            if (residues.ndim() != 1) {
+                throw std::invalid_argument("Expected a one-dimensional int64 array");
+            }
+            const int64_t* data = residues.data();
+            size_t count = static_cast<size_t>(residues.size());
+            py::gil_scoped_release release;
+            return ZpArray::from_residues(p, N, data, count);
+        }, py::arg("prime"), py::arg("precision"), py::arg("residues"),
+           "Build from a 1-D array of int64 residues (reduced mod p^N)")
+        .def_static("from_limbs", [](long p, long N, Limb64Array limbs) {
+            if (limbs.ndim() != 2) {
+                throw std::invalid_argument("Expected a (count, limbs) uint64 array");
+            }
+            const uint64_t* data = limbs.data();
+            size_t count = static_cast<size_t>(limbs.shape(0));
+            size_t width = static_cast<size_t>(limbs.shape(1));
+            py::gil_scoped_release release;
+            return ZpArray::from_limbs(p, N, data, count, width);
+        }, py::arg("prime"), py::arg("precision"), py::arg("limbs"),
+           "Build from a (count, limbs) array of little-endian 64-bit words")
+
+        .def_property_readonly("prime", &ZpArray::get_prime)
+        .def_property_readonly("precision", &ZpArray::get_precision)
+        .def_property_readonly("limb_count", &ZpArray::limb_count,
+                               "Words per element in to_limbs()")
+        .def("fits_int64", &ZpArray::fits_int64,
+             "True when to_numpy() can return int64 residues")
+        .def("to_numpy", &residues_of,
+             "Residues as a 1-D int64 array (requires p^N < 2^63)")
+        .def("to_limbs", &limbs_of,
+             "Residues as a (size, limb_count) uint64 array")
+
+        .def("__len__", &ZpArray::size)
+        .def("__getitem__", [](const ZpArray& a, py::ssize_t i) {
+            if (i < 0) i += static_cast<py::ssize_t>(a.size());
+            if (i < 0 || static_cast<size_t>(i) >= a.size()) {
+                throw py::index_error();
+            }
+            return a[static_cast<size_t>(i)];
+        })
+        .def("__setitem__", [](ZpArray& a, py::ssize_t i, const Zp& x) {
+            if (i < 0) i += static_cast<py::ssize_t>(a.size());
+            if (i < 0 || static_cast<size_t>(i) >= a.size()) {
+                throw py::index_error();
+            }
+            a.set(static_cast<size_t>(i), x);
+        })
+
+        .def(py::self + py::self, py::call_guard<py::gil_scoped_release>())
+        .def(py::self - py::self, py::call_guard<py::gil_scoped_release>())
+        .def(py::self * py::self, py::call_guard<py::gil_scoped_release>())
+        .def(-py::self, py::call_guard<py::gil_scoped_release>())
+        .def("scale", &ZpArray::scale, py::arg("c"), py::call_guard<py::gil_scoped_release>(),
+             "Multiply every element by the scalar c")
+        .def("log", &ZpArray::log, py::call_guard<py::gil_scoped_release>(),
+             "p-adic logarithm of every x ≡ 1 (mod p)")
+        .def("gamma", &ZpArray::gamma, py::call_guard<py::gil_scoped_release>(),
+             "Morita's Gamma_p of every unit")
+        .def("teichmuller", &ZpArray::teichmuller, py::call_guard<py::gil_scoped_release>(),
+             "Teichmüller representative of every element")
+
+        .def("__repr__", [](const ZpArray& a) {
+            std::stringstream ss;
+            ss << "ZpArray(" << a.get_prime() << ", " << a.get_precision()
+               << ", size=" << a.size() << ")";
+            return ss.str();
+        });
+
+    py::class_<QpArray>(m, "QpArray", R"pbdoc(
+        Vector of p-adic numbers p^v · u with a shared prime and absolute
+        precision, exchanged with NumPy as two int64 arrays (units, valuations).
+    )pbdoc")
+        .def(py::init<long, long, size_t>(),
+             py::arg("prime"), py::arg("precision"), py::arg("size") = 0)
+        .def(py::init<const ZpArray&>(), py::arg("integers"))
+        .def_static("from_numpy", [](long p, long N, Int64Array units, Int64Array valuations) {
+            if (units.ndim() != 1 || valuations.ndim() != 1 || units.size() != valuations.size()) {
+                throw std::invalid_argument("Expected two 1-D int64 arrays of equal length");
+            }
+            const int64_t* u = units.data();
+            const int64_t* v = valuations.data();
+            size_t count = static_cast<size_t>(units.size());
+            py::gil_scoped_release release;
+            return QpArray::from_residues(p, N, u, v, count);
+        }, py::arg("prime"), py::arg("precision"), py::arg("units"), py::arg("valuations"))
+        .def("to_numpy", [](const QpArray& a) {
+            Int64Array units(static_cast<py::ssize_t>(a.size()));
+            Int64Array valuations(static_cast<py::ssize_t>(a.size()));
+            int64_t* u = units.mutable_data();
+            int64_t* v = valuations.mutable_data();
+            {
+                py::gil_scoped_release release;
+                a.to_residues(u, v);
+            }
+            return py::make_tuple(units, valuations);
+        }, "(units, valuations) as int64 arrays")
+
+        .def_property_readonly("prime", &QpArray::get_prime)
+        .def_property_readonly("precision", &QpArray::get_precision)
+        .def("__len__", &QpArray::size)
+        .def("__getitem__", [](const QpArray& a, py::ssize_t i) {
+            if (i < 0) i += static_cast<py::ssize_t>(a.size());
+            if (i < 0 || static_cast<size_t>(i) >= a.size()) {
+                throw py::index_error();
+            }
+            return a[static_cast<size_t>(i)];
+        })
+
+        .def(py::self + py::self, py::call_guard<py::gil_scoped_release>())
+        .def(py::self - py::self, py::call_guard<py::gil_scoped_release>())
+        .def(py::self * py::self, py::call_guard<py::gil_scoped_release>())
+        .def("log", &QpArray::log, py::call_guard<py::gil_scoped_release>(),
+             "p-adic logarithm of every element");
+
+    py::class_<ZpVector>(m, "ZpVector", R"pbdoc(
+        Vector of p-adic integers in a residue number system.
+
+        Elements are exact integers held modulo several 30-bit primes, so
+        products, sums and dot products run as word loops and are reduced
+        mod p^N only when read back. `headroom_bits` extends the basis
+        beyond one product of two elements (e.g. log2 of a dot length).
+    )pbdoc")
+        .def(py::init<const std::vector<Zp>&, size_t>(),
+             py::arg("values"), py::arg("headroom_bits") = 0)
+        .def(py::init<const ZpArray&, size_t>(),
+             py::arg("array"), py::arg("headroom_bits") = 0)
+        .def_property_readonly("prime", &ZpVector::get_prime)
+        .def_property_readonly("precision", &ZpVector::get_precision)
+        .def_property_readonly("planes", [](const ZpVector& v) { return v.get_basis().size(); })
+        .def("__len__", &ZpVector::size)
+        .def("__getitem__", [](const ZpVector& v, size_t i) {
+            if (i >= v.size()) throw py::index_error();
+            return v[i];
+        })
+        .def("to_list", &ZpVector::to_zp)
+        .def("to_array", &ZpVector::to_array)
+        .def("dot", &ZpVector::dot, py::arg("other"), py::call_guard<py::gil_scoped_release>(),
+             "Sum of elementwise products mod p^N")
+        .def("reduce", &ZpVector::reduce, py::return_value_policy::reference_internal)
+        .def(py::self + py::self, py::call_guard<py::gil_scoped_release>())
+        .def(py::self - py::self, py::call_guard<py::gil_scoped_release>())
+        .def(py::self * py::self, py::call_guard<py::gil_scoped_release>());
+}
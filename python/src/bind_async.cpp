@@ -0,0 +1,143 @@
+// Python bindings for the async API: cancellation tokens and result handles
+#include <pybind11/pybind11.h>
+#include <libadic/async.h>
+#include <memory>
+
+namespace py = pybind11;
+using namespace libadic;
+
+py::dict reid_li_result_dict(const ReidLiResult& r);
+
+namespace {
+
+/**
+ * on_ready callback calling a Python function from the worker thread. The
+ * function object is released under the GIL, since the C++ callback may be
+ * destroyed on a thread that does not hold it.
+ */
+Async::Callback python_callback(py::object on_ready) {
+    if (on_ready.is_none()) {
+        return {};
+    }
+    std::shared_ptr<py::object> fn(new py::object(std::move(on_ready)), [](py::object* f) {
+        py::gil_scoped_acquire gil;
+        delete f;
+    });
+    return [fn]() {
+        py::gil_scoped_acquire gil;
+        try {
+            (*fn)();
+        } catch (py::error_already_set& e) {
+            e.discard_as_unraisable(__func__);
+        }
+    };
+}
+
+CancellationToken make_token(py::object token, py::object timeout) {
+    CancellationToken t = token.is_none() ? CancellationToken() : token.cast<CancellationToken>();
+    if (!timeout.is_none()) {
+        auto seconds = std::chrono::duration<double>(timeout.cast<double>());
+        t.set_deadline(CancellationToken::Clock::now() +
+                       std::chrono::duration_cast<CancellationToken::Clock::duration>(seconds));
+    }
+    return t;
+}
+
+template<class T>
+void bind_result(py::module_ &m, const char* name) {
+    py::class_<AsyncResult<T>>(m, name, R"pbdoc(
+        Handle to a computation on the library's thread pool.
+
+        result() blocks (with the GIL released) and raises OperationCancelled
+        if the computation was cancelled or ran past its deadline. See the
+        asyncio wrappers in the libadic package for awaitables.
+    )pbdoc")
+        .def("result", &AsyncResult<T>::get, py::call_guard<py::gil_scoped_release>())
+        .def("done", &AsyncResult<T>::ready)
+        .def("cancel", &AsyncResult<T>::cancel)
+        .def_property_readonly("token", &AsyncResult<T>::get_token);
+}
+
+} // namespace
+
+void bind_async(py::module_ &m) {
+    py::register_exception<OperationCancelled>(m, "OperationCancelled", PyExc_RuntimeError);
+
+    py::class_<CancellationToken>(m, "CancellationToken", R"pbdoc(
+        Shared cancellation flag with an optional deadline; copies share state.
+    )pbdoc")
+        .def(py::init<>())
+        .def("cancel", &CancellationToken::cancel)
+        .def("set_timeout",
+             [](const CancellationToken& t, double seconds) {
+                 t.set_deadline(CancellationToken::Clock::now() +
+                                std::chrono::duration_cast<CancellationToken::Clock::duration>(
+                                    std::chrono::duration<double>(seconds)));
+             },
+             py::arg("seconds"))
+        .def_property_readonly("cancelled", &CancellationToken::is_cancelled)
+        .def_property_readonly("deadline_passed", &CancellationToken::deadline_passed);
+
+    bind_result<Qp>(m, "AsyncQp");
+
+    py::class_<AsyncResult<ReidLiResult>>(m, "AsyncReidLi", R"pbdoc(
+        Handle to a Reid-Li check on the library's thread pool; result()
+        returns the same dict as one entry of reid_li_sweep.
+    )pbdoc")
+        .def("result",
+             [](AsyncResult<ReidLiResult>& handle) {
+                 ReidLiResult r;
+                 {
+                     py::gil_scoped_release release;
+                     r = handle.get();
+                 }
+                 return reid_li_result_dict(r);
+             })
+        .def("done", &AsyncResult<ReidLiResult>::ready)
+        .def("cancel", &AsyncResult<ReidLiResult>::cancel)
+        .def_property_readonly("token", &AsyncResult<ReidLiResult>::get_token);
+
+    m.def("kubota_leopoldt_async",
+          [](long s, const DirichletCharacter& chi, long precision, py::object timeout,
+             py::object token, py::object on_ready) {
+              return Async::kubota_leopoldt(s, chi, precision, make_token(token, timeout),
+                                            python_callback(std::move(on_ready)));
+          },
+          py::arg("s"), py::arg("chi"), py::arg("precision"), py::arg("timeout") = py::none(),
+          py::arg("token") = py::none(), py::arg("on_ready") = py::none(),
+          R"pbdoc(
+        Start L_p(s, χ) on the library's thread pool and return an AsyncQp.
+
+        Args:
+            timeout: Seconds before the computation is abandoned
+            token: CancellationToken to cancel it with
+            on_ready: Called without arguments on a worker thread when done
+    )pbdoc");
+
+    m.def("kubota_leopoldt_derivative_async",
+          [](long s, const DirichletCharacter& chi, long precision, py::object timeout,
+             py::object token, py::object on_ready) {
+              return Async::kubota_leopoldt_derivative(s, chi, precision, make_token(token, timeout),
+                                                       python_callback(std::move(on_ready)));
+          },
+          py::arg("s"), py::arg("chi"), py::arg("precision"), py::arg("timeout") = py::none(),
+          py::arg("token") = py::none(), py::arg("on_ready") = py::none(),
+          R"pbdoc(
+        Start L'_p(s, χ) on the library's thread pool and return an AsyncQp.
+    )pbdoc");
+
+    m.def("reid_li_verify_async",
+          [](const DirichletCharacter& chi, long precision, long tolerance, py::object timeout,
+             py::object token, py::object on_ready) {
+              return Async::reid_li_verify(chi, precision, tolerance, make_token(token, timeout),
+                                           python_callback(std::move(on_ready)));
+          },
+          py::arg("chi"), py::arg("precision"), py::arg("tolerance") = 5,
+          py::arg("timeout") = py::none(), py::arg("token") = py::none(),
+          py::arg("on_ready") = py::none(),
+          R"pbdoc(
+        Start the Reid-Li check for χ on the library's thread pool and return
+        an AsyncReidLi. Cancellation raises OperationCancelled from result()
+        rather than filling in "error".
+    )pbdoc");
+}
@@ -1,6 +1,7 @@
 // Python bindings for Bernoulli numbers
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/functional.h>
 #include <libadic/bernoulli.h>
 #include <libadic/characters.h>
 #include <libadic/qp.h>
@@ -28,15 +29,32 @@ void bind_bernoulli(py::module_ &m) {
             Automatically handles denominators divisible by p
     )pbdoc");
     
+    m.def("bernoulli_range",
+          &BernoulliNumbers::bernoulli_range,
+          py::arg("n_max"), py::arg("prime"), py::arg("precision"),
+          R"pbdoc(
+        Compute B_0, ..., B_{n_max} as p-adic numbers in one pass.
+        
+        Args:
+            n_max: Largest index
+            prime: The prime p
+            precision: Desired precision
+            
+        Returns:
+            List of Qp, entry n is B_n
+    )pbdoc");
+    
     m.def("generalized_bernoulli",
-          &BernoulliNumbers::generalized_bernoulli,
+          py::overload_cast<long, long, std::function<Zp(long)>, long, long>(
+              &BernoulliNumbers::generalized_bernoulli),
           py::arg("n"), py::arg("conductor"), py::arg("chi_func"), py::arg("prime"), py::arg("precision"),
           R"pbdoc(
         Compute generalized Bernoulli number B_{n,χ}.
         
         Args:
             n: Index
-            chi: Dirichlet character
+            conductor: Conductor f of χ
+            chi_func: a ↦ χ(a) as a Teichmüller-valued Zp
             prime: The prime p
             precision: Desired precision
             
@@ -48,8 +66,8 @@ void bind_bernoulli(py::module_ &m) {
             L(1-n, χ) = -B_{n,χ}/n
             
         Example:
-            >>> chi = DirichletCharacter(7, [1, -1])
-            >>> B_2_chi = generalized_bernoulli(2, chi, 7, 20)
+            >>> chi = DirichletCharacter(7, 7, [3])
+            >>> B_3_chi = generalized_bernoulli(3, 7, lambda a: chi.evaluate(a, 20), 7, 20)
     )pbdoc");
     
     m.def("bernoulli_polynomial",
@@ -72,6 +90,22 @@ void bind_bernoulli(py::module_ &m) {
             B_n(x) = Σ_{k=0}^n C(n,k) B_k x^{n-k}
     )pbdoc");
     
+    m.def("bernoulli_polynomial_values",
+          &BernoulliNumbers::bernoulli_polynomial_values,
+          py::arg("n"), py::arg("f"), py::arg("prime"), py::arg("precision"),
+          R"pbdoc(
+        Evaluate B_n(a/f) for every 0 <= a < f in one pass.
+        
+        Args:
+            n: Degree
+            f: Denominator
+            prime: The prime p
+            precision: Desired precision
+            
+        Returns:
+            List of Qp, entry a is B_n(a/f)
+    )pbdoc");
+    
     m.def("euler_number",
           [](long /*n*/) {
               // Placeholder for Euler numbers
@@ -3,7 +3,9 @@
 #include <pybind11/stl.h>
 #include <pybind11/complex.h>
 #include <libadic/characters.h>
+#include <libadic/gauss_sums.h>
 #include <libadic/zp.h>
+#include <libadic/serialization.h>
 #include <complex>
 
 namespace py = pybind11;
@@ -36,6 +38,9 @@ void bind_characters(py::module_ &m) {
              py::arg("n"),
              "Evaluate character at n (returns integer value)")
         
+        .def("values", &DirichletCharacter::values,
+             "evaluate_at(n) for every n in [0, modulus), -1 marking non-units")
+        
         .def("evaluate", &DirichletCharacter::evaluate,
              py::arg("n"), py::arg("precision"),
              R"pbdoc(
@@ -73,8 +78,21 @@ void bind_characters(py::module_ &m) {
         .def("get_order", &DirichletCharacter::get_order,
              "Get multiplicative order of the character")
         
+        .def("index", &DirichletCharacter::index,
+             "Position in enumerate_characters(modulus, prime); with the modulus it identifies the character")
+        .def("galois_orbit", &DirichletCharacter::galois_orbit,
+             "Conjugates chi^a for a coprime to the order, starting with chi itself")
+        .def("__eq__", [](const DirichletCharacter& self, const DirichletCharacter& other) {
+            return self.get_modulus() == other.get_modulus() && self.get_prime() == other.get_prime() &&
+                   self.index() == other.index();
+        })
+        .def("__hash__", [](const DirichletCharacter& self) {
+            return std::hash<long>()(self.get_modulus() * 1000003L + self.index());
+        })
+        
         .def("gauss_sum", &DirichletCharacter::gauss_sum,
              py::arg("a") = 1,
+             py::call_guard<py::gil_scoped_release>(),
              R"pbdoc(
         Compute Gauss sum g_a(χ) = Σ χ(t)e^(2πiat/n)
         
@@ -87,6 +105,7 @@ void bind_characters(py::module_ &m) {
         
         .def("L_value", &DirichletCharacter::L_value,
              py::arg("s"), py::arg("precision"),
+             py::call_guard<py::gil_scoped_release>(),
              R"pbdoc(
         Compute L-function value L(s, χ).
         
@@ -177,12 +196,37 @@ void bind_characters(py::module_ &m) {
         .def_readonly("generators", &DirichletCharacter::generators,
                       "Generators of (Z/nZ)* (advanced use)")
         .def_readonly("generator_orders", &DirichletCharacter::generator_orders,
-                      "Orders of generators (advanced use)");
+                      "Orders of generators (advanced use)")
+        
+        .def("to_bytes", [](const DirichletCharacter &self) {
+            return py::bytes(BinaryWriter::to_bytes(self));
+        }, "Compact binary wire encoding (see libadic/serialization.h)")
+        .def_static("from_bytes", [](py::bytes data) {
+            std::string bytes = data;
+            BinaryReader reader(bytes);
+            return reader.read_character();
+        }, py::arg("data"), "Decode a character written by to_bytes")
+        
+        // Pickle support: the binary wire format
+        .def(py::pickle(
+            [](const DirichletCharacter &self) { // __getstate__
+                return py::make_tuple(py::bytes(BinaryWriter::to_bytes(self)));
+            },
+            [](py::tuple t) { // __setstate__
+                if (t.size() != 1) {
+                    throw std::runtime_error("Invalid pickle data for DirichletCharacter");
+                }
+                std::string bytes = t[0].cast<py::bytes>();
+                BinaryReader reader(bytes);
+                return reader.read_character();
+            }
+        ));
     
     // Module functions for character enumeration
     m.def("enumerate_characters",
           &DirichletCharacter::enumerate_characters,
           py::arg("modulus"), py::arg("prime"),
+          py::call_guard<py::gil_scoped_release>(),
           R"pbdoc(
         Enumerate all Dirichlet characters modulo n.
         
@@ -194,9 +238,60 @@ void bind_characters(py::module_ &m) {
             List of all characters mod n
     )pbdoc");
     
+    py::class_<CharacterRange>(m, "CharacterRange", R"pbdoc(
+        Characters modulo n generated one at a time, in enumerate_characters order.
+        
+        Iterating yields independent DirichletCharacter copies while the range
+        itself holds no per-character state, so very large moduli can be walked
+        without building a list.
+        
+        Examples:
+            >>> for chi in CharacterRange(13, 13, primitive_only=True):
+            ...     process(chi)
+    )pbdoc")
+        .def(py::init<long, long, bool>(),
+             py::arg("modulus"), py::arg("prime"), py::arg("primitive_only") = false)
+        .def("__iter__", [](const CharacterRange& r) {
+            return py::make_iterator<py::return_value_policy::copy>(r.begin(), r.end());
+        }, py::keep_alive<0, 1>())
+        .def("__len__", &CharacterRange::size,
+             "Number of characters the range yields (a full walk when primitive_only)")
+        .def("__getitem__", [](const CharacterRange& r, long index) {
+            long count = r.size();
+            if (index < 0) index += count;
+            if (index < 0 || index >= count) {
+                throw py::index_error();
+            }
+            if (!r.primitive()) {
+                return DirichletCharacter::from_index(r.get_modulus(), r.get_prime(), index);
+            }
+            // Position `index` of the filtered sequence that __iter__ yields
+            auto it = r.begin();
+            for (long i = 0; i < index; ++i) {
+                ++it;
+            }
+            return *it;
+        }, py::arg("index"), "Character at position index of the sequence __iter__ yields")
+        .def_property_readonly("modulus", &CharacterRange::get_modulus)
+        .def_property_readonly("prime", &CharacterRange::get_prime);
+    
+    m.def("iter_characters",
+          [](long modulus, long prime, bool primitive_only) {
+              return CharacterRange(modulus, prime, primitive_only);
+          },
+          py::arg("modulus"), py::arg("prime"), py::arg("primitive_only") = false,
+          "Lazy CharacterRange over the characters mod n");
+    
+    m.def("galois_orbits",
+          &DirichletCharacter::galois_orbits,
+          py::arg("modulus"), py::arg("prime"),
+          py::call_guard<py::gil_scoped_release>(),
+          "Characters modulo n grouped into Galois orbits, each led by its smallest index");
+    
     m.def("enumerate_primitive_characters",
           &DirichletCharacter::enumerate_primitive_characters,
           py::arg("modulus"), py::arg("prime"),
+          py::call_guard<py::gil_scoped_release>(),
           R"pbdoc(
         Enumerate all primitive Dirichlet characters modulo n.
         
@@ -210,4 +305,35 @@ void bind_characters(py::module_ &m) {
         Note:
             Primitive characters have conductor equal to modulus
     )pbdoc");
+
+    py::class_<GaussSum>(m, "GaussSum", R"pbdoc(
+        Gauss sum in Gross-Koblitz form: g = π^exponent · coefficient with
+        π^(p-1) = -p, exponent = a for χ = ω^(-a) and coefficient = -Γ_p(a/(p-1)).
+    )pbdoc")
+        .def_readonly("prime", &GaussSum::prime)
+        .def_readonly("exponent", &GaussSum::exponent)
+        .def_readonly("coefficient", &GaussSum::coefficient)
+        .def("power_p_minus_one", &GaussSum::power_p_minus_one,
+             "g^(p-1) = (-p)^a · coefficient^(p-1) as a Qp");
+
+    m.def("gauss_sum", &GaussSums::gauss_sum,
+          py::arg("chi"), py::arg("precision"),
+          py::call_guard<py::gil_scoped_release>(),
+          "Gauss sum of a character mod p by Gross-Koblitz");
+    m.def("gauss_sums", &GaussSums::gauss_sums,
+          py::arg("p"), py::arg("precision"),
+          py::call_guard<py::gil_scoped_release>(),
+          "Gauss sums of every character mod p, indexed as enumerate_characters(p, p)");
+    m.def("gauss_sum_cyclotomic", &GaussSums::gauss_sum_cyclotomic,
+          py::arg("chi"), py::arg("precision"),
+          py::call_guard<py::gil_scoped_release>(),
+          "Σ χ(x) ζ^x as a Cyclotomic, for a character mod p");
+    m.def("jacobi_sum", &GaussSums::jacobi_sum,
+          py::arg("chi1"), py::arg("chi2"), py::arg("precision"),
+          py::call_guard<py::gil_scoped_release>(),
+          "J(χ1, χ2) = Σ χ1(x) χ2(1-x) for characters mod p");
+    m.def("jacobi_sums", &GaussSums::jacobi_sums,
+          py::arg("chi"), py::arg("precision"),
+          py::call_guard<py::gil_scoped_release>(),
+          "J(χ, ψ) for every ψ mod p, indexed as enumerate_characters(p, p)");
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <pybind11/stl.h>
 #include <libadic/cyclotomic.h>
 #include <libadic/qp.h>
+#include <libadic/serialization.h>
 
 namespace py = pybind11;
 using namespace libadic;
@@ -59,6 +60,14 @@ void bind_cyclotomic(py::module_ &m) {
              py::arg("scalar"),
              "Multiply by scalar Qp")
         
+        .def("addmul", py::overload_cast<const Cyclotomic&, const Cyclotomic&>(&Cyclotomic::addmul),
+             py::arg("a"), py::arg("b"), py::return_value_policy::reference_internal,
+             "In-place self += a * b without an intermediate product")
+        
+        .def("addmul", py::overload_cast<const Cyclotomic&, const Qp&>(&Cyclotomic::addmul),
+             py::arg("a"), py::arg("scalar"), py::return_value_policy::reference_internal,
+             "In-place self += a * scalar")
+        
         .def("__neg__", py::overload_cast<>(&Cyclotomic::operator-, py::const_),
              "Negate element")
         
@@ -150,7 +159,31 @@ void bind_cyclotomic(py::module_ &m) {
             
         Note:
             Negative exponents not currently supported
-    )pbdoc");
+    )pbdoc")
+        
+        .def("to_bytes", [](const Cyclotomic &self) {
+            return py::bytes(BinaryWriter::to_bytes(self));
+        }, "Compact binary wire encoding (see libadic/serialization.h)")
+        .def_static("from_bytes", [](py::bytes data) {
+            std::string bytes = data;
+            BinaryReader reader(bytes);
+            return reader.read_cyclotomic();
+        }, py::arg("data"), "Decode a value written by to_bytes")
+        
+        // Pickle support: the binary wire format
+        .def(py::pickle(
+            [](const Cyclotomic &self) { // __getstate__
+                return py::make_tuple(py::bytes(BinaryWriter::to_bytes(self)));
+            },
+            [](py::tuple t) { // __setstate__
+                if (t.size() != 1) {
+                    throw std::runtime_error("Invalid pickle data for Cyclotomic");
+                }
+                std::string bytes = t[0].cast<py::bytes>();
+                BinaryReader reader(bytes);
+                return reader.read_cyclotomic();
+            }
+        ));
     
     // Factory functions for common cyclotomic elements
     m.def("cyclotomic_unity_root",
@@ -5,15 +5,39 @@
 #include <libadic/l_functions.h>
 #include <libadic/characters.h>
 #include <libadic/qp.h>
+#include <libadic/reid_li.h>
+#include <libadic/reid_li_sweep.h>
+#include <libadic/iwasawa_series.h>
+#include <libadic/stats.h>
 
 namespace py = pybind11;
 using namespace libadic;
 
+/**
+ * ReidLiResult as the dict reid_li_sweep and reid_li_verify_async return
+ */
+py::dict reid_li_result_dict(const ReidLiResult& r) {
+    py::dict d;
+    d["prime"] = r.prime;
+    d["precision"] = r.precision;
+    d["character_index"] = r.character_index;
+    d["order"] = r.order;
+    d["is_odd"] = r.is_odd;
+    d["is_primitive"] = r.is_primitive;
+    d["phi"] = r.phi_value;
+    d["psi"] = r.psi_value;
+    d["precision_achieved"] = r.precision_achieved;
+    d["matches"] = r.matches;
+    d["error"] = r.error;
+    return d;
+}
+
 void bind_l_functions(py::module_ &m) {
     // Kubota-Leopoldt p-adic L-function
     m.def("kubota_leopoldt",
           &LFunctions::kubota_leopoldt,
           py::arg("s"), py::arg("chi"), py::arg("precision"),
+          py::call_guard<py::gil_scoped_release>(),
           R"pbdoc(
         Compute Kubota-Leopoldt p-adic L-function L_p(s, χ).
         
@@ -40,6 +64,7 @@ void bind_l_functions(py::module_ &m) {
     m.def("kubota_leopoldt_derivative",
           &LFunctions::kubota_leopoldt_derivative,
           py::arg("s"), py::arg("chi"), py::arg("precision"),
+          py::call_guard<py::gil_scoped_release>(),
           R"pbdoc(
         Compute derivative of Kubota-Leopoldt p-adic L-function L'_p(s, χ).
         
@@ -61,6 +86,7 @@ void bind_l_functions(py::module_ &m) {
               return LFunctions::kubota_leopoldt(1-n, chi, precision);
           },
           py::arg("n"), py::arg("chi"), py::arg("precision"),
+          py::call_guard<py::gil_scoped_release>(),
           R"pbdoc(
         Compute L_p(1-n, χ) for positive integer n.
         
@@ -90,6 +116,7 @@ void bind_l_functions(py::module_ &m) {
               return sum;
           },
           py::arg("chi"), py::arg("prime"), py::arg("precision"),
+          py::call_guard<py::gil_scoped_release>(),
           R"pbdoc(
         Compute Φ_p^(odd)(χ) for Reid-Li criterion.
         
@@ -114,6 +141,7 @@ void bind_l_functions(py::module_ &m) {
               return sum;
           },
           py::arg("chi"), py::arg("prime"), py::arg("precision"),
+          py::call_guard<py::gil_scoped_release>(),
           R"pbdoc(
         Compute Φ_p^(even)(χ) for Reid-Li criterion.
         
@@ -128,6 +156,7 @@ void bind_l_functions(py::module_ &m) {
               bool is_odd = chi.is_odd();
               
               Qp phi, psi;
+              py::gil_scoped_release release;
               if (is_odd) {
                   // Compute Φ_p^(odd)(χ)
                   phi = Qp(p, precision, 0);
@@ -158,6 +187,7 @@ void bind_l_functions(py::module_ &m) {
               }
               
               bool equal = (phi == psi);
+              py::gil_scoped_acquire acquire;
               return py::make_tuple(equal, phi, psi);
           },
           py::arg("chi"), py::arg("prime"), py::arg("precision"),
@@ -181,6 +211,7 @@ void bind_l_functions(py::module_ &m) {
     m.def("compute_B1_chi",
           &LFunctions::compute_B1_chi,
           py::arg("chi"), py::arg("precision"),
+          py::call_guard<py::gil_scoped_release>(),
           R"pbdoc(
         Compute generalized Bernoulli number B_{1,χ}.
         
@@ -195,9 +226,166 @@ void bind_l_functions(py::module_ &m) {
             B_{1,χ} = (1/n) Σ_{a=1}^{n-1} χ(a) * a
     )pbdoc");
     
+    m.def("compute_B1_chi_all",
+          &LFunctions::compute_B1_chi_all,
+          py::arg("p"), py::arg("precision"),
+          py::call_guard<py::gil_scoped_release>(),
+          R"pbdoc(
+        B_{1,χ} for every character χ mod p in one batched transform.
+        
+        Args:
+            p: Prime modulus
+            precision: Desired precision
+            
+        Returns:
+            List of Qp; entry k belongs to enumerate_characters(p, p)[k]
+    )pbdoc");
+    
+    m.def("compute_derivative_at_zero_odd_all",
+          &LFunctions::compute_derivative_at_zero_odd_all,
+          py::arg("p"), py::arg("precision"),
+          py::call_guard<py::gil_scoped_release>(),
+          R"pbdoc(
+        Σ χ(a) log Γ_p(a) for every character χ mod p in one batched transform.
+        
+        Args:
+            p: Prime modulus
+            precision: Desired precision
+            
+        Returns:
+            List of Qp; entry k belongs to enumerate_characters(p, p)[k],
+            and equals L'_p(0, χ) for the odd characters (odd k)
+    )pbdoc");
+    
+    m.def("kubota_leopoldt_derivative_all",
+          [](long p, long precision, size_t threads) {
+              std::vector<std::string> errors;
+              std::vector<Qp> values;
+              {
+                  py::gil_scoped_release release;
+                  values = LFunctions::kubota_leopoldt_derivative_all(p, precision, threads, &errors);
+              }
+              py::list result;
+              for (size_t k = 0; k < values.size(); ++k) {
+                  if (errors[k].empty()) {
+                      result.append(values[k]);
+                  } else {
+                      result.append(py::none());
+                  }
+              }
+              return result;
+          },
+          py::arg("p"), py::arg("precision"), py::arg("threads") = 0,
+          R"pbdoc(
+        L'_p(0, χ) for every character χ mod p, computed natively.
+        
+        Odd characters come from one batched transform and the even ones
+        are spread over `threads` workers (0 = all hardware threads), with
+        the GIL released throughout.
+        
+        Args:
+            p: Prime modulus
+            precision: Desired precision
+            threads: Worker threads (default: all hardware threads)
+            
+        Returns:
+            List indexed as enumerate_characters(p, p); None where the
+            value could not be computed
+    )pbdoc");
+    
+    m.def("reid_li_sweep",
+          [](const std::vector<long>& primes, long precision, size_t threads,
+             long tolerance, bool primitive_only, bool skip_principal, bool galois_orbits) {
+              ReidLiConfig config;
+              config.primes = primes;
+              config.precision = precision;
+              config.threads = threads;
+              config.tolerance = tolerance;
+              config.primitive_only = primitive_only;
+              config.skip_principal = skip_principal;
+              config.galois_orbits = galois_orbits;
+              std::vector<ReidLiResult> results;
+              {
+                  py::gil_scoped_release release;
+                  results = ReidLiEngine(config).run();
+              }
+              py::list out;
+              for (const ReidLiResult& r : results) {
+                  out.append(reid_li_result_dict(r));
+              }
+              return out;
+          },
+          py::arg("primes"), py::arg("precision"), py::arg("threads") = 0,
+          py::arg("tolerance") = 5, py::arg("primitive_only") = true,
+          py::arg("skip_principal") = true, py::arg("galois_orbits") = false,
+          R"pbdoc(
+        Reid-Li criterion for every character of every prime in `primes`.
+        
+        The whole sweep runs on a native thread pool with the GIL released
+        and returns once, sorted by (prime, character_index).
+        
+        Args:
+            primes: Primes to check
+            precision: Computation precision
+            threads: Worker threads (default: all hardware threads)
+            tolerance: Digits Φ - Ψ may fall short of `precision`
+            primitive_only: Only primitive characters
+            skip_principal: Skip the principal character
+            galois_orbits: One task per Galois orbit of characters instead of
+                one batched pass per prime
+            
+        Returns:
+            List of dicts with keys prime, precision, character_index, order,
+            is_odd, is_primitive, phi, psi, precision_achieved, matches, error
+    )pbdoc");
+    
+    m.def("reid_li_sweep_worker",
+          [](const std::vector<long>& primes, long precision, const std::string& directory,
+             size_t worker, size_t workers, bool dynamic, size_t threads, long tolerance) {
+              ReidLiSweepConfig config;
+              config.sweep.primes = primes;
+              config.sweep.precision = precision;
+              config.sweep.threads = threads;
+              config.sweep.tolerance = tolerance;
+              config.directory = directory;
+              config.worker = worker;
+              config.workers = workers;
+              config.dynamic = dynamic;
+              ReidLiSweepSummary summary;
+              {
+                  py::gil_scoped_release release;
+                  summary = ReidLiSweep(config).run(nullptr);
+              }
+              py::dict d;
+              d["units"] = summary.units;
+              d["computed"] = summary.computed;
+              d["resumed"] = summary.resumed;
+              d["elsewhere"] = summary.elsewhere;
+              d["characters"] = summary.results.characters;
+              d["matched"] = summary.results.matched;
+              d["failed"] = summary.results.failed;
+              d["errors"] = summary.results.errors;
+              return d;
+          },
+          py::arg("primes"), py::arg("precision"), py::arg("directory"),
+          py::arg("worker") = 0, py::arg("workers") = 1, py::arg("dynamic") = true,
+          py::arg("threads") = 0, py::arg("tolerance") = 5,
+          R"pbdoc(
+        One worker of a Reid-Li sweep shared through a checkpoint directory.
+        
+        Units (one Galois orbit of characters mod p each) are claimed in
+        decreasing estimated cost and checkpointed as they complete, so a
+        rerun with the same worker id resumes.
+        
+        Returns:
+            Dict with keys units, computed, resumed, elsewhere, characters,
+            matched, failed, errors
+    )pbdoc");
+    
     m.def("compute_euler_factor",
           &LFunctions::compute_euler_factor,
           py::arg("chi"), py::arg("s"), py::arg("precision"),
+          py::call_guard<py::gil_scoped_release>(),
           R"pbdoc(
         Compute Euler factor (1 - χ(p)p^{s-1}) for L-function.
         
@@ -213,6 +401,7 @@ void bind_l_functions(py::module_ &m) {
     m.def("compute_positive_value",
           &LFunctions::compute_positive_value,
           py::arg("s"), py::arg("chi"), py::arg("precision"),
+          py::call_guard<py::gil_scoped_release>(),
           R"pbdoc(
         Compute L_p(s, χ) for positive integer s.
         
@@ -232,6 +421,7 @@ void bind_l_functions(py::module_ &m) {
           &LFunctions::compute_log_gamma_fractional,
           py::arg("numerator"), py::arg("denominator"),
           py::arg("prime"), py::arg("precision"),
+          py::call_guard<py::gil_scoped_release>(),
           R"pbdoc(
         Compute log Γ_p(a/b) for rational a/b.
         
@@ -248,6 +438,7 @@ void bind_l_functions(py::module_ &m) {
     m.def("compute_digamma",
           &LFunctions::compute_digamma,
           py::arg("n"), py::arg("prime"), py::arg("precision"),
+          py::call_guard<py::gil_scoped_release>(),
           R"pbdoc(
         Compute p-adic digamma function ψ_p(n).
         
@@ -267,4 +458,131 @@ void bind_l_functions(py::module_ &m) {
         
         Useful for memory management or when precision requirements change.
     )pbdoc");
-}
\ No newline at end of file
+    
+    m.def("set_cache_budget",
+          &LFunctions::set_cache_budget,
+          py::arg("bytes"),
+          R"pbdoc(
+        Bound the total memory used by libadic's memo tables.
+        
+        The budget is shared by all library caches (L-values, Bernoulli
+        numbers, character values, ...); least recently used entries are
+        evicted once a cache exceeds its share.
+    )pbdoc");
+    
+    m.def("cache_stats",
+          []() {
+              py::list result;
+              for (const CacheStats& s : LFunctions::cache_stats()) {
+                  py::dict d;
+                  d["name"] = s.name;
+                  d["hits"] = s.hits;
+                  d["misses"] = s.misses;
+                  d["evictions"] = s.evictions;
+                  d["entries"] = s.entries;
+                  d["bytes"] = s.bytes;
+                  d["budget"] = s.budget;
+                  d["hit_rate"] = s.hit_rate();
+                  result.append(d);
+              }
+              return result;
+          },
+          R"pbdoc(
+        Per-cache counters as a list of dicts with keys name, hits, misses,
+        evictions, entries, bytes, budget and hit_rate.
+    )pbdoc");
+    
+    py::module_ stats_module = m.def_submodule("stats", "Hot-path instrumentation (LIBADIC_ENABLE_STATS builds)");
+    stats_module.def("enabled", &stats::enabled,
+          "True when the library was built with LIBADIC_ENABLE_STATS");
+    stats_module.def("reset", &stats::reset, "Zero the hot-path counters and GMP totals");
+    stats_module.def("track_gmp_allocations", &stats::track_gmp_allocations,
+          "Count GMP allocations from now on (no-op unless enabled)");
+    stats_module.def("snapshot",
+          []() {
+              stats::Snapshot snap = stats::snapshot();
+              py::dict result;
+              result["enabled"] = snap.enabled;
+              py::dict counters;
+              for (const stats::Counter& c : snap.counters) {
+                  py::dict d;
+                  d["calls"] = c.calls;
+                  d["nanoseconds"] = c.nanoseconds;
+                  d["mean_ns"] = c.mean_ns();
+                  d["iterations"] = c.iterations;
+                  d["precision_inflation"] = c.precision_inflation;
+                  counters[py::str(c.name)] = d;
+              }
+              result["counters"] = counters;
+              py::dict caches;
+              for (const CacheStats& s : snap.caches) {
+                  py::dict d;
+                  d["hits"] = s.hits;
+                  d["misses"] = s.misses;
+                  d["hit_rate"] = s.hit_rate();
+                  d["entries"] = s.entries;
+                  d["bytes"] = s.bytes;
+                  caches[py::str(s.name)] = d;
+              }
+              result["caches"] = caches;
+              result["gmp_allocations"] = snap.gmp_allocations;
+              result["gmp_bytes"] = snap.gmp_bytes;
+              return result;
+          },
+          R"pbdoc(
+        Counters since the last reset as a dict: "counters" maps each hot path
+        (e.g. "PadicLog::log") to calls, nanoseconds, mean_ns, iterations and
+        precision_inflation; "caches" maps each library cache to its hits,
+        misses, hit_rate, entries and bytes. Hot-path counters stay zero
+        unless the library was built with LIBADIC_ENABLE_STATS.
+    )pbdoc");
+    
+    m.def("save_cache",
+          &LFunctions::save_cache,
+          py::arg("path"),
+          py::call_guard<py::gil_scoped_release>(),
+          R"pbdoc(
+        Write the L-value and Bernoulli caches to a binary result store file.
+    )pbdoc");
+    
+    m.def("load_cache",
+          &LFunctions::load_cache,
+          py::arg("path"),
+          py::call_guard<py::gil_scoped_release>(),
+          R"pbdoc(
+        Warm-start the caches from a file written by save_cache.
+        
+        Stored values also answer queries at lower precision by truncation.
+        
+        Returns:
+            Number of records read
+    )pbdoc");
+
+    py::class_<IwasawaSeries, std::shared_ptr<IwasawaSeries>>(m, "IwasawaSeries", R"pbdoc(
+        Iwasawa power series G(T) of L_p(s, χ), with T = (1+p)^s - 1.
+        
+        Built once per (χ, precision) from Bernoulli values at
+        s = 0, -(p-1), -2(p-1), ...; afterwards any s in Z_p and any
+        derivative order is a cheap polynomial evaluation. The branch is the
+        one through kubota_leopoldt(0, χ).
+    )pbdoc")
+        .def(py::init<const DirichletCharacter&, long, long>(),
+             py::arg("chi"), py::arg("precision"), py::arg("terms") = 0,
+             py::call_guard<py::gil_scoped_release>())
+        .def_static("get", [](const DirichletCharacter& chi, long precision) {
+            return std::const_pointer_cast<IwasawaSeries>(IwasawaSeries::get(chi, precision));
+        }, py::arg("chi"), py::arg("precision"), py::call_guard<py::gil_scoped_release>(),
+           "Shared series from the library cache")
+        .def_property_readonly("prime", &IwasawaSeries::get_prime)
+        .def_property_readonly("precision", &IwasawaSeries::get_precision)
+        .def_property_readonly("has_pole", &IwasawaSeries::has_pole)
+        .def("coefficients", &IwasawaSeries::coefficients,
+             "g_0, g_1, ... (for has_pole, the coefficients of (T - p)·G(T))")
+        .def("evaluate_T", &IwasawaSeries::evaluate_T, py::arg("T"))
+        .def("evaluate", py::overload_cast<long>(&IwasawaSeries::evaluate, py::const_), py::arg("s"))
+        .def("evaluate", py::overload_cast<const Zp&>(&IwasawaSeries::evaluate, py::const_), py::arg("s"))
+        .def("derivative", py::overload_cast<long, long>(&IwasawaSeries::derivative, py::const_),
+             py::arg("s"), py::arg("order") = 1)
+        .def("derivative", py::overload_cast<const Zp&, long>(&IwasawaSeries::derivative, py::const_),
+             py::arg("s"), py::arg("order") = 1);
+}
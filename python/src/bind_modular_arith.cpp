@@ -90,20 +90,53 @@ void bind_modular_arith(py::module_ &m) {
             Uses binary exponentiation for O(log n) complexity
     )pbdoc");
     
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
     m.def("hensel_lift",
           &hensel_lift,
           py::arg("a"), py::arg("p"), py::arg("from_precision"), py::arg("to_precision"),
           R"pbdoc(
-        Lift a solution modulo p^from_precision to modulo p^to_precision.
+        Deprecated: a reduced modulo p^to_precision (from_precision is ignored).
+        
+        An integer already fixes all of its digits; to lift a root of a
+        polynomial from mod p to mod p^N use hensel_lift_root.
+        
+        Returns:
+            a mod p^to_precision
+    )pbdoc");
+#pragma GCC diagnostic pop
+    
+    m.def("hensel_lift_root",
+          py::overload_cast<const std::vector<BigInt>&, const BigInt&, long, long>(&hensel_lift_root),
+          py::arg("coefficients"), py::arg("x0"), py::arg("p"), py::arg("precision"),
+          R"pbdoc(
+        Lift a simple root of a polynomial from mod p to mod p^precision.
+        
+        Newton's method doubles the correct digits at each step.
+        
+        Args:
+            coefficients: [c0, c1, ..., cd] for c0 + c1 x + ... + cd x^d
+            x0: Root mod p with f'(x0) a unit
+            p: Prime
+            precision: Target precision
+            
+        Returns:
+            The root congruent to x0 mod p, modulo p^precision
+    )pbdoc");
+    
+    m.def("padic_sqrt",
+          &padic_sqrt,
+          py::arg("a"), py::arg("p"), py::arg("precision"),
+          R"pbdoc(
+        Square root of a unit modulo p^precision.
         
         Args:
-            a: Initial solution mod p^from_precision
+            a: Unit square in Z_p (a ≡ 1 mod 8 for p = 2)
             p: Prime
-            from_precision: Starting precision
-            to_precision: Target precision
+            precision: Target precision
             
         Returns:
-            Lifted solution mod p^to_precision
+            r with r^2 ≡ a (mod p^precision)
     )pbdoc");
     
     m.def("teichmuller_character",
@@ -35,6 +35,42 @@ void bind_padic_functions(py::module_ &m) {
             >>> log_x = log_p(x)
     )pbdoc");
     
+    m.def("log_range",
+          &PadicLog::log_range,
+          py::arg("values"),
+          R"pbdoc(
+        p-adic logarithm of every entry of a list.
+        
+        Args:
+            values: List of Qp with a common prime, each satisfying log_p's
+                    convergence condition
+            
+        Returns:
+            List of log_p(x), one per input, with the denominators of all
+            series inverted together
+    )pbdoc");
+    
+    m.def("log_fermat_range",
+          &PadicLog::log_fermat_range,
+          py::arg("p"), py::arg("precision"), py::arg("bases"),
+          R"pbdoc(
+        log_p(a^(p-1)) for each integer a of a list, at the given precision.
+        
+        A base requested again at a higher precision resumes a cached
+        series instead of starting over, so loops that raise the precision
+        until a result stabilises cost about one evaluation in total.
+    )pbdoc");
+    
+    py::class_<LogSeries>(m, "LogSeries", R"pbdoc(
+        Resumable log_p(base^exponent) for an integer base; value(N) for
+        increasing N continues the series summed so far.
+    )pbdoc")
+        .def(py::init<long, const BigInt&, long, long>(),
+             py::arg("p"), py::arg("base"), py::arg("exponent"), py::arg("headroom"))
+        .def("value", &LogSeries::value, py::arg("precision"))
+        .def_property_readonly("headroom", &LogSeries::get_headroom)
+        .def_property_readonly("terms", &LogSeries::terms);
+    
     m.def("log_unit",
           &PadicLog::log_unit,
           py::arg("u"),
@@ -60,6 +96,22 @@ void bind_padic_functions(py::module_ &m) {
         May have different convergence properties.
     )pbdoc");
     
+    m.def("exp_p",
+          &PadicLog::exp,
+          py::arg("x"),
+          R"pbdoc(
+        Compute p-adic exponential.
+        
+        Args:
+            x: p-adic number with v(x) >= 1 (v(x) >= 2 for p = 2)
+            
+        Returns:
+            exp_p(x) as a Qp
+            
+        Raises:
+            std::domain_error: If convergence condition not met
+    )pbdoc");
+    
     // p-adic Gamma function - overload for integer argument
     m.def("gamma_p",
           [](long a, long p, long precision) {
@@ -124,6 +176,23 @@ void bind_padic_functions(py::module_ &m) {
             More stable than computing gamma then log for large arguments
     )pbdoc");
     
+    m.def("log_gamma_range",
+          &PadicGamma::log_gamma_range,
+          py::arg("prime"), py::arg("precision"), py::arg("start"), py::arg("count"),
+          R"pbdoc(
+        log Γ_p(x) for x = start, ..., start + count - 1.
+        
+        Args:
+            prime: Odd prime p
+            precision: p-adic precision
+            start: First argument (>= 1)
+            count: Number of consecutive arguments
+            
+        Returns:
+            List of Qp. Units match log_gamma_p, including log Γ_p(1) = log_Iw(-1) = 0;
+            for p | x the entry equals that of x + 1.
+    )pbdoc");
+    
     m.def("gamma_positive_integer",
           &PadicGamma::gamma_positive_integer,
           py::arg("n"), py::arg("prime"), py::arg("precision"),
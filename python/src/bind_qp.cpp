@@ -4,6 +4,7 @@
 #include <pybind11/stl.h>
 #include <libadic/qp.h>
 #include <libadic/zp.h>
+#include <libadic/serialization.h>
 #include <sstream>
 
 namespace py = pybind11;
@@ -286,34 +287,27 @@ void bind_qp(py::module_ &m) {
             return Qp(self);
         })
         
-        // Pickle support
+        .def("to_bytes", [](const Qp &self) {
+            return py::bytes(BinaryWriter::to_bytes(self));
+        }, "Compact binary wire encoding (see libadic/serialization.h)")
+        .def_static("from_bytes", [](py::bytes data) {
+            std::string bytes = data;
+            BinaryReader reader(bytes);
+            return reader.read_qp();
+        }, py::arg("data"), "Decode a value written by to_bytes")
+        
+        // Pickle support: the binary wire format
         .def(py::pickle(
             [](const Qp &self) { // __getstate__
-                return py::make_tuple(
-                    self.get_prime(),
-                    self.get_precision(),
-                    self.valuation(),
-                    self.get_unit().to_bigint().to_string()
-                );
+                return py::make_tuple(py::bytes(BinaryWriter::to_bytes(self)));
             },
             [](py::tuple t) { // __setstate__
-                if (t.size() != 4) {
+                if (t.size() != 1) {
                     throw std::runtime_error("Invalid pickle data for Qp");
                 }
-                long prime = t[0].cast<long>();
-                long precision = t[1].cast<long>();
-                long val = t[2].cast<long>();
-                BigInt unit_val(t[3].cast<std::string>());
-                
-                Zp unit(prime, precision, unit_val);
-                Qp result = Qp(unit);
-                if (val != 0) {
-                    result = result * Qp(prime, precision, BigInt(prime).pow(std::abs(val)));
-                    if (val < 0) {
-                        result = Qp(prime, precision, 1) / result;
-                    }
-                }
-                return result;
+                std::string bytes = t[0].cast<py::bytes>();
+                BinaryReader reader(bytes);
+                return reader.read_qp();
             }
         ));
     
@@ -4,6 +4,7 @@
 #include <pybind11/stl.h>
 #include <libadic/zp.h>
 #include <libadic/gmp_wrapper.h>
+#include <libadic/serialization.h>
 #include <sstream>
 
 namespace py = pybind11;
@@ -208,24 +209,27 @@ void bind_zp(py::module_ &m) {
                 std::domain_error: If denominator is divisible by p
         )pbdoc")
         
-        // Pickle support
+        .def("to_bytes", [](const Zp &self) {
+            return py::bytes(BinaryWriter::to_bytes(self));
+        }, "Compact binary wire encoding (see libadic/serialization.h)")
+        .def_static("from_bytes", [](py::bytes data) {
+            std::string bytes = data;
+            BinaryReader reader(bytes);
+            return reader.read_zp();
+        }, py::arg("data"), "Decode a value written by to_bytes")
+        
+        // Pickle support: the binary wire format
         .def(py::pickle(
             [](const Zp &self) { // __getstate__
-                return py::make_tuple(
-                    self.get_prime(),
-                    self.get_precision(),
-                    self.get_value().to_string()
-                );
+                return py::make_tuple(py::bytes(BinaryWriter::to_bytes(self)));
             },
             [](py::tuple t) { // __setstate__
-                if (t.size() != 3) {
+                if (t.size() != 1) {
                     throw std::runtime_error("Invalid pickle data for Zp");
                 }
-                return Zp(
-                    t[0].cast<long>(),
-                    t[1].cast<long>(),
-                    BigInt(t[2].cast<std::string>())
-                );
+                std::string bytes = t[0].cast<py::bytes>();
+                BinaryReader reader(bytes);
+                return reader.read_zp();
             }
         ));
     
@@ -16,8 +16,10 @@ void bind_characters(py::module_ &m);
 void bind_l_functions(py::module_ &m);
 void bind_bernoulli(py::module_ &m);
 void bind_cyclotomic(py::module_ &m);
+void bind_arrays(py::module_ &m);
+void bind_async(py::module_ &m);
 
-PYBIND11_MODULE(libadic, m) {
+PYBIND11_MODULE(libadic_python, m) {
     m.doc() = R"pbdoc(
         libadic: High-performance p-adic arithmetic library
         ====================================================
@@ -51,6 +53,7 @@ PYBIND11_MODULE(libadic, m) {
     // Bind p-adic fields
     bind_zp(m);
     bind_qp(m);
+    bind_arrays(m);
     
     // Bind mathematical functions
     bind_padic_functions(m);
@@ -58,4 +61,5 @@ PYBIND11_MODULE(libadic, m) {
     bind_l_functions(m);
     bind_bernoulli(m);
     bind_cyclotomic(m);
+    bind_async(m);
 }
\ No newline at end of file
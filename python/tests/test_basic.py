@@ -254,6 +254,67 @@ class TestReidLi:
                     print(f"  Odd: {r['is_odd']}")
                     print(f"  Phi: {r['phi']}")
                     print(f"  Psi: {r['psi']}")
+    
+    def test_reid_li_sweep(self):
+        """Native sweep over explicit primes agrees with per-prime validation"""
+        from libadic import reid_li_sweep, kubota_leopoldt_derivative_all
+        
+        results = reid_li_sweep([5, 7], 10, threads=2)
+        assert {r['prime'] for r in results} == {5, 7}
+        assert all(r['error'] == '' for r in results)
+        
+        values = kubota_leopoldt_derivative_all(7, 10)
+        assert len(values) == 6
+        assert all(values[k] is not None for k in range(1, 6, 2))
+
+
+@pytest.mark.skipif(not LIBADIC_AVAILABLE, reason="libadic not built")
+class TestArrays:
+    """Test the NumPy batch types ZpArray and QpArray"""
+    
+    def test_zp_array_roundtrip(self):
+        """Elementwise results match the scalar Zp operations"""
+        np = pytest.importorskip("numpy")
+        from libadic import ZpArray
+        
+        xs = np.array([i for i in range(1, 50) if i % 7], dtype=np.int64)
+        a = ZpArray.from_numpy(7, 10, xs)
+        assert len(a) == len(xs)
+        assert np.array_equal(a.to_numpy(), xs)
+        
+        prod = (a * a + a).to_numpy()
+        for i, x in enumerate(xs):
+            z = Zp(7, 10, int(x))
+            assert Zp(7, 10, int(prod[i])) == z * z + z
+        
+        gammas = a.gamma().to_numpy()
+        assert Zp(7, 10, int(gammas[3])) == gamma_p(Zp(7, 10, int(xs[3])))
+    
+    def test_limbs(self):
+        """Residues beyond int64 go through limb arrays"""
+        np = pytest.importorskip("numpy")
+        from libadic import ZpArray
+        
+        a = ZpArray.from_numpy(7, 60, np.arange(1, 10, dtype=np.int64))
+        limbs = a.to_limbs()
+        assert limbs.shape == (9, a.limb_count)
+        assert np.array_equal(ZpArray.from_limbs(7, 60, limbs).to_limbs(), limbs)
+
+
+@pytest.mark.skipif(not LIBADIC_AVAILABLE, reason="libadic not built")
+def test_binary_pickle_roundtrip():
+    """Pickle goes through the compact binary wire format"""
+    import pickle
+    from libadic import enumerate_characters
+    
+    q = Qp.from_rational(100, 147, 7, 60)
+    assert pickle.loads(pickle.dumps(q)) == q
+    assert Qp.from_bytes(q.to_bytes()) == q
+    z = Zp(7, 40, 12345)
+    assert pickle.loads(pickle.dumps(z)) == z
+    chi = enumerate_characters(11, 11)[3]
+    chi2 = pickle.loads(pickle.dumps(chi))
+    assert chi2.character_values == chi.character_values
 
 
 def test_precision_preservation():
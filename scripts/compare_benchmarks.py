@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+"""Compare two libadic_bench JSON reports.
+
+    scripts/compare_benchmarks.py baseline.json current.json [--threshold 0.10]
+
+Prints the median time ratio and allocation change per benchmark and exits
+with status 1 when any benchmark present in both reports got slower by more
+than the threshold (relative change of the median) or allocates more per
+operation.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        report = json.load(f)
+    return {b["name"]: b for b in report["benchmarks"]}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="allowed relative slowdown of the median (default 0.10)")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+
+    regressions = []
+    print(f"{'benchmark':44} {'baseline':>12} {'current':>12} {'ratio':>8} {'allocs':>10}")
+    for name in sorted(set(baseline) | set(current)):
+        if name not in baseline or name not in current:
+            where = "baseline" if name in baseline else "current"
+            print(f"{name:44} {'(only in ' + where + ')':>34}")
+            continue
+        old, new = baseline[name], current[name]
+        ratio = new["median_ns"] / old["median_ns"] if old["median_ns"] > 0 else float("inf")
+        old_allocs = old["gmp_allocs_per_op"] + old["heap_allocs_per_op"]
+        new_allocs = new["gmp_allocs_per_op"] + new["heap_allocs_per_op"]
+        flag = ""
+        if ratio > 1 + args.threshold:
+            flag = "  SLOWER"
+            regressions.append(name)
+        elif new_allocs > old_allocs + 0.5:
+            flag = "  MORE ALLOCS"
+            regressions.append(name)
+        print(f"{name:44} {old['median_ns']:>10.0f}ns {new['median_ns']:>10.0f}ns "
+              f"{ratio:>8.2f} {new_allocs - old_allocs:>+10.1f}{flag}")
+
+    if regressions:
+        print(f"\n{len(regressions)} regression(s) beyond {args.threshold:.0%}")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -123,7 +123,7 @@ setup(
     long_description=read_readme(),
     long_description_content_type="text/markdown",
     url="https://github.com/yourusername/libadic",
-    ext_modules=[CMakeExtension("libadic")],
+    ext_modules=[CMakeExtension("libadic.libadic_python")],
     cmdclass={"build_ext": CMakeBuild},
     packages=["libadic"],
     package_dir={"libadic": "python/libadic"},
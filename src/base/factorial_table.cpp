@@ -0,0 +1,83 @@
+#include "libadic/factorial_table.h"
+#include "libadic/cache.h"
+#include "libadic/modular_arith.h"
+#include <utility>
+
+namespace libadic {
+
+namespace {
+
+struct TableKeyHash {
+    size_t operator()(const std::pair<long, long>& k) const {
+        size_t h = std::hash<long>()(k.first);
+        hash_combine(h, std::hash<long>()(k.second));
+        return h;
+    }
+};
+
+using TablePtr = std::shared_ptr<const FactorialTable>;
+
+ShardedCache<std::pair<long, long>, TablePtr, TableKeyHash>& table_cache() {
+    static ShardedCache<std::pair<long, long>, TablePtr, TableKeyHash> cache(
+        "FactorialTable::tables",
+        [](const std::pair<long, long>& key, const TablePtr& table) {
+            size_t bytes = sizeof(key) + sizeof(FactorialTable);
+            for (long a = 0; a < table->get_prime(); ++a) {
+                bytes += cache_footprint((*table)[a]);
+            }
+            return bytes;
+        });
+    return cache;
+}
+
+} // namespace
+
+FactorialTable::FactorialTable(long p, long N)
+    : prime(p), precision(N) {
+    if (p < 2) {
+        throw std::invalid_argument("Prime must be >= 2");
+    }
+    if (N < 1) {
+        throw std::invalid_argument("Precision must be >= 1");
+    }
+
+    const PadicContext& ctx = PadicContext::get(p, N);
+    values.reserve(static_cast<size_t>(p));
+    BigInt acc(1);
+    ctx.reduce(acc);
+    values.push_back(acc);
+    for (long a = 1; a < p; ++a) {
+        mpz_mul_ui(acc.get_mpz(), acc.get_mpz(), static_cast<unsigned long>(a));
+        ctx.reduce(acc);
+        values.push_back(acc);
+    }
+}
+
+std::shared_ptr<const FactorialTable> FactorialTable::get(long p, long N) {
+    return table_cache().get_or_compute({p, N}, [&]() {
+        return std::make_shared<const FactorialTable>(p, N);
+    });
+}
+
+BigInt FactorialTable::gamma(long a) const {
+    if (a < 1 || a >= prime) {
+        throw std::out_of_range("Gamma_p table index must satisfy 0 < a < p");
+    }
+    BigInt result = values[a - 1];
+    if (a % 2 == 1 && !result.is_zero()) {
+        result = PadicContext::get(prime, precision).modulus() - result;
+    }
+    return result;
+}
+
+BigInt FactorialTable::factorial(long n, long p, long N) {
+    if (n < 0 || n >= p) {
+        throw std::out_of_range("FactorialTable::factorial requires 0 <= n < p");
+    }
+    if (p <= max_tabulated_prime) {
+        return (*get(p, N))[n];
+    }
+    return product_mod(1, n, PadicContext::get(p, N), false);
+}
+
+} // namespace libadic
@@ -0,0 +1,229 @@
+#include "libadic/limb_pool.h"
+#include <gmp.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+namespace libadic {
+
+namespace {
+
+constexpr size_t kClasses = 6;               // 16, 32, ..., 512 bytes
+constexpr size_t kTableSize = size_t(1) << 13;
+constexpr size_t kMaxSlabs = kTableSize / 2;  // keep probing short
+constexpr size_t kSpillLength = 4096;         // per-thread list length that spills half
+
+static_assert((size_t(16) << (kClasses - 1)) == LimbPool::max_pooled_bytes,
+              "size classes must end at max_pooled_bytes");
+
+void* (*previous_alloc)(size_t) = nullptr;
+void* (*previous_realloc)(void*, size_t, size_t) = nullptr;
+void (*previous_free)(void*, size_t) = nullptr;
+std::atomic<bool> is_installed{false};
+
+// Open-addressed set of slab base addresses; entries are never removed
+std::atomic<uintptr_t> slab_table[kTableSize];
+std::atomic<size_t> slab_count{0};
+
+// Shared lists, guarded by a spinlock so nothing here has a destructor that
+// could run before the last GMP free at exit
+std::atomic_flag shared_lock = ATOMIC_FLAG_INIT;
+void* shared_free[kClasses];
+
+struct SpinGuard {
+    SpinGuard() { while (shared_lock.test_and_set(std::memory_order_acquire)) {} }
+    ~SpinGuard() { shared_lock.clear(std::memory_order_release); }
+};
+
+size_t class_of(size_t size) {
+    if (size <= 16) {
+        return 0;
+    }
+    return static_cast<size_t>(64 - __builtin_clzll(static_cast<unsigned long long>(size - 1))) - 4;
+}
+
+size_t class_bytes(size_t c) { return size_t(16) << c; }
+
+void*& next_of(void* block) { return *static_cast<void**>(block); }
+
+size_t slot_of(uintptr_t base) {
+    return static_cast<size_t>(((base / LimbPool::slab_bytes) * 0x9E3779B97F4A7C15ULL) >> 51) &
+           (kTableSize - 1);
+}
+
+bool is_pooled(const void* ptr) {
+    uintptr_t base = reinterpret_cast<uintptr_t>(ptr) & ~static_cast<uintptr_t>(LimbPool::slab_bytes - 1);
+    for (size_t i = slot_of(base), n = 0; n < kTableSize; i = (i + 1) & (kTableSize - 1), ++n) {
+        uintptr_t entry = slab_table[i].load(std::memory_order_acquire);
+        if (entry == base) return true;
+        if (entry == 0) return false;
+    }
+    return false;
+}
+
+void* new_slab() {
+    if (slab_count.load(std::memory_order_relaxed) >= kMaxSlabs) {
+        return nullptr;
+    }
+    void* slab = std::aligned_alloc(LimbPool::slab_bytes, LimbPool::slab_bytes);
+    if (!slab) {
+        return nullptr;
+    }
+    uintptr_t base = reinterpret_cast<uintptr_t>(slab);
+    SpinGuard guard;
+    for (size_t i = slot_of(base);; i = (i + 1) & (kTableSize - 1)) {
+        if (slab_table[i].load(std::memory_order_relaxed) == 0) {
+            slab_table[i].store(base, std::memory_order_release);
+            break;
+        }
+    }
+    slab_count.fetch_add(1, std::memory_order_relaxed);
+    return slab;
+}
+
+/**
+ * Per-thread free lists and bump region; trivially destructible so frees
+ * after the thread's Retire has run still find valid storage
+ */
+struct ThreadLists {
+    void* head[kClasses];
+    size_t length[kClasses];
+    char* bump;
+    char* bump_end;
+    bool retired;
+};
+
+thread_local ThreadLists lists{};
+
+void push_shared(size_t c, void* first, void* last) {
+    SpinGuard guard;
+    next_of(last) = shared_free[c];
+    shared_free[c] = first;
+}
+
+// Hands the exiting thread's blocks to the shared lists
+struct Retire {
+    ~Retire() {
+        for (size_t c = 0; c < kClasses; ++c) {
+            void* first = lists.head[c];
+            if (!first) continue;
+            void* last = first;
+            while (next_of(last)) last = next_of(last);
+            push_shared(c, first, last);
+            lists.head[c] = nullptr;
+            lists.length[c] = 0;
+        }
+        lists.retired = true;
+    }
+};
+
+thread_local Retire retire;
+
+void* pool_alloc(size_t size) {
+    if (size > LimbPool::max_pooled_bytes) {
+        return previous_alloc(size);
+    }
+    size_t c = class_of(size);
+    ThreadLists& t = lists;
+    if (void* block = t.head[c]) {
+        t.head[c] = next_of(block);
+        --t.length[c];
+        return block;
+    }
+    (void)&retire;  // slow path: make sure this thread hands its blocks back at exit
+    {
+        SpinGuard guard;
+        if (void* block = shared_free[c]) {
+            // Take the whole shared list
+            shared_free[c] = nullptr;
+            void* rest = next_of(block);
+            size_t n = 0;
+            for (void* b = rest; b; b = next_of(b)) ++n;
+            t.head[c] = rest;
+            t.length[c] = n;
+            return block;
+        }
+    }
+    size_t bytes = class_bytes(c);
+    if (!t.bump || t.bump + bytes > t.bump_end) {
+        char* slab = static_cast<char*>(new_slab());
+        if (!slab) {
+            return previous_alloc(size);
+        }
+        t.bump = slab;
+        t.bump_end = slab + LimbPool::slab_bytes;
+    }
+    void* block = t.bump;
+    t.bump += bytes;
+    return block;
+}
+
+void pool_free(void* ptr, size_t size) {
+    if (!ptr) return;
+    if (!is_pooled(ptr)) {
+        previous_free(ptr, size);
+        return;
+    }
+    size_t c = class_of(size);
+    ThreadLists& t = lists;
+    if (t.retired) {
+        next_of(ptr) = nullptr;
+        push_shared(c, ptr, ptr);
+        return;
+    }
+    next_of(ptr) = t.head[c];
+    t.head[c] = ptr;
+    if (++t.length[c] >= kSpillLength) {
+        // Keep half, so a thread freeing another's blocks does not hoard them
+        void* last = t.head[c];
+        for (size_t i = 1; i < kSpillLength / 2; ++i) last = next_of(last);
+        void* spill = next_of(last);
+        next_of(last) = nullptr;
+        t.length[c] = kSpillLength / 2;
+        void* tail = spill;
+        while (next_of(tail)) tail = next_of(tail);
+        push_shared(c, spill, tail);
+    }
+}
+
+void* pool_realloc(void* ptr, size_t old_size, size_t new_size) {
+    if (!is_pooled(ptr)) {
+        return previous_realloc(ptr, old_size, new_size);
+    }
+    if (new_size <= LimbPool::max_pooled_bytes && class_of(new_size) == class_of(old_size)) {
+        return ptr;
+    }
+    void* moved = pool_alloc(new_size);
+    std::memcpy(moved, ptr, std::min(old_size, new_size));
+    pool_free(ptr, old_size);
+    return moved;
+}
+
+#if defined(LIBADIC_POOLED_GMP) && LIBADIC_POOLED_GMP
+struct InstallAtLoad {
+    InstallAtLoad() { LimbPool::install(); }
+} install_at_load;
+#endif
+
+} // namespace
+
+void LimbPool::install() {
+    static std::once_flag once;
+    std::call_once(once, []() {
+        mp_get_memory_functions(&previous_alloc, &previous_realloc, &previous_free);
+        mp_set_memory_functions(pool_alloc, pool_realloc, pool_free);
+        is_installed.store(true, std::memory_order_release);
+    });
+}
+
+bool LimbPool::installed() {
+    return is_installed.load(std::memory_order_acquire);
+}
+
+size_t LimbPool::slabs() {
+    return slab_count.load(std::memory_order_relaxed);
+}
+
+} // namespace libadic
@@ -1,7 +1,203 @@
 #include "libadic/modular_arith.h"
+#include <climits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace libadic {
 
-// All implementation is in the header for inline optimization
+void batch_mod_inverse(BigInt* values, size_t count, const BigInt& mod) {
+    if (count == 0) {
+        return;
+    }
 
-} // namespace libadic
\ No newline at end of file
+    // prefix[i] = values[0] ··· values[i] mod `mod`
+    std::vector<BigInt> prefix(count);
+    mpz_mod(prefix[0].get_mpz(), values[0].get_mpz(), mod.get_mpz());
+    for (size_t i = 1; i < count; ++i) {
+        mpz_mul(prefix[i].get_mpz(), prefix[i - 1].get_mpz(), values[i].get_mpz());
+        mpz_mod(prefix[i].get_mpz(), prefix[i].get_mpz(), mod.get_mpz());
+    }
+
+    BigInt running;
+    if (mpz_invert(running.get_mpz(), prefix[count - 1].get_mpz(), mod.get_mpz()) == 0) {
+        throw std::domain_error("batch_mod_inverse: value not invertible");
+    }
+
+    // running = (values[0] ··· values[i])^{-1} on entry to step i
+    BigInt inverse;
+    for (size_t i = count; i-- > 1;) {
+        mpz_mul(inverse.get_mpz(), running.get_mpz(), prefix[i - 1].get_mpz());
+        mpz_mod(inverse.get_mpz(), inverse.get_mpz(), mod.get_mpz());
+        mpz_mul(running.get_mpz(), running.get_mpz(), values[i].get_mpz());
+        mpz_mod(running.get_mpz(), running.get_mpz(), mod.get_mpz());
+        std::swap(values[i], inverse);
+    }
+    values[0] = std::move(running);
+}
+
+BigInt product_tree_mod(long lo, long hi, const PadicContext& ctx, bool skip_multiples_of_p) {
+    const long p = ctx.get_prime();
+    BigInt result(1);
+    if (hi < lo) {
+        ctx.reduce(result);
+        return result;
+    }
+
+    // Leaves: runs of consecutive factors whose product fits in a word
+    std::vector<BigInt> nodes;
+    nodes.reserve(static_cast<size_t>((hi - lo) / 4 + 1));
+    unsigned long word = 1;
+    for (long k = lo; k <= hi; ++k) {
+        if (skip_multiples_of_p && k % p == 0) continue;
+        unsigned long factor = static_cast<unsigned long>(k);
+        if (word > ULONG_MAX / factor) {
+            nodes.emplace_back();
+            mpz_set_ui(nodes.back().get_mpz(), word);
+            word = 1;
+        }
+        word *= factor;
+    }
+    nodes.emplace_back();
+    mpz_set_ui(nodes.back().get_mpz(), word);
+
+    // Pairwise products; reduce once a node outgrows the modulus
+    const size_t modulus_bits = mpz_sizeinbase(ctx.modulus().get_mpz(), 2);
+    while (nodes.size() > 1) {
+        size_t half = nodes.size() / 2;
+        for (size_t i = 0; i < half; ++i) {
+            BigInt& node = nodes[i];
+            mpz_mul(node.get_mpz(), nodes[2 * i].get_mpz(), nodes[2 * i + 1].get_mpz());
+            if (mpz_sizeinbase(node.get_mpz(), 2) > modulus_bits) {
+                ctx.reduce(node);
+            }
+        }
+        if (nodes.size() % 2 == 1) {
+            nodes[half] = std::move(nodes.back());
+            nodes.resize(half + 1);
+        } else {
+            nodes.resize(half);
+        }
+    }
+    result = std::move(nodes.front());
+    ctx.reduce(result);
+    return result;
+}
+
+namespace {
+
+// Square root of a quadratic residue a mod an odd prime p (Tonelli-Shanks)
+BigInt tonelli_shanks(const BigInt& a, const BigInt& p) {
+    BigInt q = p - BigInt(1);
+    unsigned long s = mpz_scan1(q.get_mpz(), 0);
+    mpz_tdiv_q_2exp(q.get_mpz(), q.get_mpz(), s);
+
+    BigInt half = (p - BigInt(1)) / BigInt(2);
+    BigInt minus_one = p - BigInt(1);
+    BigInt z(2);
+    while (z.pow_mod(half, p) != minus_one) {
+        z += BigInt(1);
+    }
+
+    BigInt c = z.pow_mod(q, p);
+    BigInt t = a.pow_mod(q, p);
+    BigInt r = a.pow_mod((q + BigInt(1)) / BigInt(2), p);
+    unsigned long m = s;
+    while (!t.is_one()) {
+        // Least i with t^(2^i) = 1
+        unsigned long i = 0;
+        BigInt t2 = t;
+        while (!t2.is_one()) {
+            t2 = (t2 * t2) % p;
+            ++i;
+        }
+        BigInt b = c;
+        for (unsigned long j = 0; j + i + 1 < m; ++j) {
+            b = (b * b) % p;
+        }
+        m = i;
+        c = (b * b) % p;
+        t = (t * c) % p;
+        r = (r * b) % p;
+    }
+    return r;
+}
+
+} // namespace
+
+BigInt hensel_lift_root(const std::vector<BigInt>& coefficients, const BigInt& x0, long p, long N) {
+    if (coefficients.empty()) {
+        throw std::invalid_argument("hensel_lift_root: empty polynomial");
+    }
+    // Horner's scheme for f and f' together
+    auto eval = [&](const BigInt& x, const BigInt& m, bool derivative) {
+        BigInt value, slope;
+        for (size_t i = coefficients.size(); i-- > 0;) {
+            if (derivative) {
+                mpz_mul(slope.get_mpz(), slope.get_mpz(), x.get_mpz());
+                mpz_add(slope.get_mpz(), slope.get_mpz(), value.get_mpz());
+                mpz_fdiv_r(slope.get_mpz(), slope.get_mpz(), m.get_mpz());
+            }
+            mpz_mul(value.get_mpz(), value.get_mpz(), x.get_mpz());
+            mpz_add(value.get_mpz(), value.get_mpz(), coefficients[i].get_mpz());
+            mpz_fdiv_r(value.get_mpz(), value.get_mpz(), m.get_mpz());
+        }
+        return derivative ? slope : value;
+    };
+    return hensel_lift_root(
+        [&](const BigInt& x, const BigInt& m) { return eval(x, m, false); },
+        [&](const BigInt& x, const BigInt& m) { return eval(x, m, true); },
+        x0, p, N);
+}
+
+BigInt padic_sqrt(const BigInt& a, long p, long N) {
+    if (p < 2) {
+        throw std::invalid_argument("Prime must be >= 2");
+    }
+    if (N < 1) {
+        throw std::invalid_argument("Precision must be >= 1");
+    }
+    const PadicContext& ctx = PadicContext::get(p, p == 2 ? N + 1 : N);
+    const BigInt& prime = ctx.prime_bigint();
+    BigInt value;
+    mpz_fdiv_r(value.get_mpz(), a.get_mpz(), ctx.power(p == 2 ? N + 1 : N).get_mpz());
+    if (value.is_divisible_by(prime)) {
+        throw std::domain_error("Square root only defined for units in Zp");
+    }
+
+    if (p != 2) {
+        if (value.pow_mod((prime - BigInt(1)) / BigInt(2), prime) != BigInt(1)) {
+            throw std::domain_error("No square root exists (not a quadratic residue)");
+        }
+        BigInt root = tonelli_shanks(value % prime, prime);
+        return hensel_lift_root(
+            [&](const BigInt& x, const BigInt&) { return x * x - value; },
+            [](const BigInt& x, const BigInt&) { return BigInt(2) * x; },
+            root, p, N);
+    }
+
+    // a is a square in Z_2 iff a ≡ 1 (mod 8); only min(N, 3) bits are known
+    long known_bits = std::min<long>(N, 3);
+    if (mpz_fdiv_ui(value.get_mpz(), 1UL << known_bits) != 1) {
+        throw std::domain_error("No square root exists (mod 8 condition)");
+    }
+    // x^2 ≡ a mod 2^k gives x + (a - x^2)/(2x) mod 2^(2k-2); k = N + 1 bits
+    // make the root square to a mod 2^N
+    BigInt root(1), correction, inverse;
+    for (long k = 3; k < N + 1;) {
+        long next = std::min(2 * k - 2, N + 1);
+        const BigInt& m = ctx.power(next);
+        mpz_mul(correction.get_mpz(), root.get_mpz(), root.get_mpz());
+        mpz_sub(correction.get_mpz(), value.get_mpz(), correction.get_mpz());
+        mpz_fdiv_q_2exp(correction.get_mpz(), correction.get_mpz(), 1);
+        mpz_invert(inverse.get_mpz(), root.get_mpz(), m.get_mpz());
+        mpz_mul(correction.get_mpz(), correction.get_mpz(), inverse.get_mpz());
+        mpz_add(root.get_mpz(), root.get_mpz(), correction.get_mpz());
+        mpz_fdiv_r(root.get_mpz(), root.get_mpz(), m.get_mpz());
+        k = next;
+    }
+    mpz_fdiv_r(root.get_mpz(), root.get_mpz(), ctx.power(N).get_mpz());
+    return root;
+}
+
+} // namespace libadic
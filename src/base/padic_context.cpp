@@ -0,0 +1,57 @@
+#include "libadic/padic_context.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace libadic {
+
+namespace {
+
+struct ContextSlot {
+    long p = 0;
+    long N = 0;
+    const PadicContext* ctx = nullptr;
+};
+
+// Direct-mapped per-thread memo in front of the global registry. Arithmetic
+// typically bounces between a handful of precisions (N and N - v), so a few
+// slots remove nearly all registry lookups.
+constexpr size_t kThreadSlots = 16;
+
+} // namespace
+
+const PadicContext& PadicContext::get(long p, long N) {
+    if (p < 2) {
+        throw std::invalid_argument("Prime must be >= 2");
+    }
+    if (N < 1) {
+        throw std::invalid_argument("Precision must be >= 1");
+    }
+
+    thread_local ContextSlot slots[kThreadSlots];
+    ContextSlot& slot = slots[static_cast<size_t>(p * 31 + N) % kThreadSlots];
+    if (slot.ctx != nullptr && slot.p == p && slot.N == N) {
+        return *slot.ctx;
+    }
+
+    static std::mutex registry_mutex;
+    static std::map<std::pair<long, long>, std::unique_ptr<PadicContext>> registry;
+
+    const PadicContext* ctx;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        auto& entry = registry[{p, N}];
+        if (!entry) {
+            entry.reset(new PadicContext(p, N));
+        }
+        ctx = entry.get();
+    }
+
+    slot.p = p;
+    slot.N = N;
+    slot.ctx = ctx;
+    return *ctx;
+}
+
+} // namespace libadic
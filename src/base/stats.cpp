@@ -0,0 +1,112 @@
+#include "libadic/stats.h"
+#include <mutex>
+
+namespace libadic {
+namespace stats {
+
+namespace {
+
+const char* const names[] = {
+    "PadicLog::log",
+    "PadicLog::log_range",
+    "PadicLog::exp",
+    "PadicLog::log_series",
+    "PadicGamma::gamma",
+    "PadicGamma::log_gamma",
+    "BernoulliNumbers::bernoulli_range",
+    "DirichletCharacter::evaluate_at",
+    "DirichletCharacter::group_table",
+    "LFunctions::kubota_leopoldt",
+    "LFunctions::kubota_leopoldt_derivative",
+};
+static_assert(sizeof(names) / sizeof(names[0]) == static_cast<size_t>(Id::count),
+              "one name per stats::Id");
+
+std::atomic<uint64_t> gmp_allocations{0};
+std::atomic<uint64_t> gmp_bytes{0};
+
+#if LIBADIC_STATS
+
+Slot slots[static_cast<size_t>(Id::count)];
+
+// The functions installed before tracking started (GMP's defaults, or the
+// LimbPool), which the counters wrap
+void* (*previous_alloc)(size_t) = nullptr;
+void* (*previous_realloc)(void*, size_t, size_t) = nullptr;
+void (*previous_free)(void*, size_t) = nullptr;
+
+void* counting_alloc(size_t size) {
+    gmp_allocations.fetch_add(1, std::memory_order_relaxed);
+    gmp_bytes.fetch_add(size, std::memory_order_relaxed);
+    return previous_alloc(size);
+}
+
+void* counting_realloc(void* ptr, size_t old_size, size_t size) {
+    gmp_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (size > old_size) {
+        gmp_bytes.fetch_add(size - old_size, std::memory_order_relaxed);
+    }
+    return previous_realloc(ptr, old_size, size);
+}
+
+void counting_free(void* ptr, size_t size) {
+    previous_free(ptr, size);
+}
+
+#endif
+
+} // namespace
+
+#if LIBADIC_STATS
+
+Slot& slot(Id id) {
+    return slots[static_cast<size_t>(id)];
+}
+
+#endif
+
+Snapshot snapshot() {
+    Snapshot snap;
+    snap.enabled = enabled();
+    for (size_t i = 0; i < static_cast<size_t>(Id::count); ++i) {
+        Counter c;
+        c.name = names[i];
+#if LIBADIC_STATS
+        c.calls = slots[i].calls.load(std::memory_order_relaxed);
+        c.nanoseconds = slots[i].nanoseconds.load(std::memory_order_relaxed);
+        c.iterations = slots[i].iterations.load(std::memory_order_relaxed);
+        c.precision_inflation = slots[i].inflation.load(std::memory_order_relaxed);
+#endif
+        snap.counters.push_back(std::move(c));
+    }
+    snap.caches = CacheRegistry::instance().stats();
+    snap.gmp_allocations = gmp_allocations.load(std::memory_order_relaxed);
+    snap.gmp_bytes = gmp_bytes.load(std::memory_order_relaxed);
+    return snap;
+}
+
+void reset() {
+#if LIBADIC_STATS
+    for (Slot& s : slots) {
+        s.calls = 0;
+        s.nanoseconds = 0;
+        s.iterations = 0;
+        s.inflation = 0;
+    }
+#endif
+    gmp_allocations = 0;
+    gmp_bytes = 0;
+}
+
+void track_gmp_allocations() {
+#if LIBADIC_STATS
+    static std::once_flag once;
+    std::call_once(once, []() {
+        mp_get_memory_functions(&previous_alloc, &previous_realloc, &previous_free);
+        mp_set_memory_functions(counting_alloc, counting_realloc, counting_free);
+    });
+#endif
+}
+
+} // namespace stats
+} // namespace libadic
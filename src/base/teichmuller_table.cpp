@@ -0,0 +1,185 @@
+#include "libadic/teichmuller_table.h"
+#include "libadic/cache.h"
+#include "libadic/modular_arith.h"
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace libadic {
+
+namespace {
+
+struct TableKeyHash {
+    size_t operator()(const std::pair<long, long>& k) const {
+        size_t h = std::hash<long>()(k.first);
+        hash_combine(h, std::hash<long>()(k.second));
+        return h;
+    }
+};
+
+using TablePtr = std::shared_ptr<const TeichmullerTable>;
+
+ShardedCache<std::pair<long, long>, TablePtr, TableKeyHash>& table_cache() {
+    static ShardedCache<std::pair<long, long>, TablePtr, TableKeyHash> cache(
+        "TeichmullerTable::tables",
+        [](const std::pair<long, long>& key, const TablePtr& table) {
+            size_t bytes = sizeof(key) + sizeof(TeichmullerTable);
+            for (long a = 0; a < table->get_prime(); ++a) {
+                bytes += cache_footprint((*table)[a]);
+            }
+            return bytes;
+        });
+    return cache;
+}
+
+long smallest_primitive_root(long p) {
+    if (p == 2) {
+        return 1;
+    }
+    std::vector<long> factors;
+    long m = p - 1;
+    for (long q = 2; q * q <= m; ++q) {
+        if (m % q == 0) {
+            factors.push_back(q);
+            while (m % q == 0) m /= q;
+        }
+    }
+    if (m > 1) {
+        factors.push_back(m);
+    }
+    BigInt modulus(p);
+    for (long g = 2; g < p; ++g) {
+        bool generates = true;
+        for (long q : factors) {
+            if (BigInt(g).pow_mod(BigInt((p - 1) / q), modulus) == BigInt(1)) {
+                generates = false;
+                break;
+            }
+        }
+        if (generates) {
+            return g;
+        }
+    }
+    throw std::runtime_error("Failed to find primitive root");
+}
+
+} // namespace
+
+BigInt TeichmullerTable::hensel_lift(const BigInt& a, long p, long N) {
+    if (p < 2) {
+        throw std::invalid_argument("Prime must be >= 2");
+    }
+    if (N < 1) {
+        throw std::invalid_argument("Precision must be >= 1");
+    }
+
+    BigInt x;
+    mpz_fdiv_r_ui(x.get_mpz(), a.get_mpz(), static_cast<unsigned long>(p));
+    if (x.is_zero()) {
+        return BigInt(0);
+    }
+    if (p == 2) {
+        return BigInt(1);  // the only root of unity in Z_2 congruent to 1 mod 2
+    }
+
+    // In machine words ω(a) = a^{p^{N-1}} mod p^N is one allocation-free
+    // powering of about N log p squarings; on mpz, Newton on x^{p-1} - 1
+    // doubles the number of correct digits per step
+    return dispatch_zp_backend(PadicContext::get(p, N),
+        [&](const auto& be) {
+            using word = typename std::decay_t<decltype(be)>::word;
+            word e = 1;
+            for (long i = 1; i < N; ++i) {
+                e *= static_cast<word>(p);
+            }
+            word base = be.to_mont(static_cast<word>(mpz_get_ui(x.get_mpz())));
+            return bigint_from_u128(be.from_mont(be.pow(base, e)));
+        },
+        [&]() {
+            // hensel_lift_root asks for f'(x) at the x of the last f call, at
+            // a modulus dividing f's, so the power x^{p-2} is reused when x
+            // and the modulus allow it and recomputed otherwise
+            BigInt y, y_base, y_modulus;
+            auto power = [&](const BigInt& x, const BigInt& m) -> const BigInt& {
+                if (y_modulus.is_zero() || x != y_base ||
+                    !mpz_divisible_p(y_modulus.get_mpz(), m.get_mpz())) {
+                    mpz_powm_ui(y.get_mpz(), x.get_mpz(), static_cast<unsigned long>(p - 2), m.get_mpz());
+                    y_base = x;
+                    y_modulus = m;
+                }
+                return y;
+            };
+            return hensel_lift_root(
+                [&](const BigInt& x, const BigInt& m) {
+                    BigInt f;
+                    mpz_mul(f.get_mpz(), power(x, m).get_mpz(), x.get_mpz());
+                    mpz_sub_ui(f.get_mpz(), f.get_mpz(), 1);
+                    return f;
+                },
+                [&](const BigInt& x, const BigInt& m) {
+                    BigInt d;
+                    mpz_mul_ui(d.get_mpz(), power(x, m).get_mpz(), static_cast<unsigned long>(p - 1));
+                    return d;
+                },
+                x, p, N);
+        });
+}
+
+TeichmullerTable::TeichmullerTable(long p, long N)
+    : prime(p), precision(N), values(static_cast<size_t>(p)) {
+    if (p < 2) {
+        throw std::invalid_argument("Prime must be >= 2");
+    }
+    if (N < 1) {
+        throw std::invalid_argument("Precision must be >= 1");
+    }
+
+    if (p == 2) {
+        values[1] = BigInt(1);
+        return;
+    }
+
+    // ω is multiplicative, so ω(g^e) = ω(g)^e
+    long g = smallest_primitive_root(p);
+    BigInt omega_g = hensel_lift(BigInt(g), p, N);
+    const PadicContext& ctx = PadicContext::get(p, N);
+    dispatch_zp_backend(ctx,
+        [&](const auto& be) {
+            auto step = be.to_mont(omega_g);
+            auto omega = be.one();
+            long residue = 1;
+            for (long e = 0; e < p - 1; ++e) {
+                values[residue] = bigint_from_u128(be.from_mont(omega));
+                omega = be.mul(omega, step);
+                residue = (residue * g) % p;
+            }
+        },
+        [&]() {
+            const BigInt& m = ctx.modulus();
+            BigInt omega(1);
+            long residue = 1;
+            for (long e = 0; e < p - 1; ++e) {
+                values[residue] = omega;
+                mpz_mul(omega.get_mpz(), omega.get_mpz(), omega_g.get_mpz());
+                mpz_mod(omega.get_mpz(), omega.get_mpz(), m.get_mpz());
+                residue = (residue * g) % p;
+            }
+        });
+}
+
+std::shared_ptr<const TeichmullerTable> TeichmullerTable::get(long p, long N) {
+    return table_cache().get_or_compute({p, N}, [&]() {
+        return std::make_shared<const TeichmullerTable>(p, N);
+    });
+}
+
+BigInt TeichmullerTable::lift(const BigInt& a, long p, long N) {
+    if (p > max_tabulated_prime) {
+        return hensel_lift(a, p, N);
+    }
+    long residue = static_cast<long>(mpz_fdiv_ui(a.get_mpz(), static_cast<unsigned long>(p)));
+    return (*get(p, N))[residue];
+}
+
+} // namespace libadic
@@ -0,0 +1,127 @@
+#include "libadic/thread_pool.h"
+#include <algorithm>
+
+namespace libadic {
+
+namespace {
+
+// Identifies the pool and slot of the current worker thread so that nested
+// submissions land on the submitting worker's own deque.
+thread_local const ThreadPool* tls_pool = nullptr;
+thread_local long tls_index = -1;
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    queues.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        queues.emplace_back(new WorkQueue());
+    }
+    workers.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers.emplace_back([this, i]() { worker_loop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::unique_lock<std::mutex> lock(state_mutex);
+        all_done.wait(lock, [this]() { return pending.load() == 0; });
+        stopping = true;
+    }
+    work_available.notify_all();
+    for (auto& w : workers) {
+        w.join();
+    }
+}
+
+long ThreadPool::current_worker() const {
+    return tls_pool == this ? tls_index : -1;
+}
+
+void ThreadPool::submit(Task task) {
+    long self = current_worker();
+    size_t target = self >= 0 ? static_cast<size_t>(self)
+                              : next_queue.fetch_add(1) % queues.size();
+    pending.fetch_add(1);
+    queued.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(queues[target]->mutex);
+        queues[target]->tasks.push_back(std::move(task));
+    }
+    // Taking the state lock orders this notify after any waiter's predicate check
+    { std::lock_guard<std::mutex> lock(state_mutex); }
+    work_available.notify_one();
+}
+
+bool ThreadPool::try_pop(size_t index, Task& task) {
+    {
+        WorkQueue& own = *queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+    for (size_t k = 1; k < queues.size(); ++k) {
+        WorkQueue& victim = *queues[(index + k) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run_task(Task& task) {
+    try {
+        task();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        if (!first_error) {
+            first_error = std::current_exception();
+        }
+    }
+    task = nullptr;
+    if (pending.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        all_done.notify_all();
+    }
+}
+
+void ThreadPool::worker_loop(size_t index) {
+    tls_pool = this;
+    tls_index = static_cast<long>(index);
+    Task task;
+    while (true) {
+        if (try_pop(index, task)) {
+            run_task(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(state_mutex);
+        work_available.wait(lock, [this]() { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) {
+            return;
+        }
+    }
+}
+
+void ThreadPool::wait_idle() {
+    std::unique_lock<std::mutex> lock(state_mutex);
+    all_done.wait(lock, [this]() { return pending.load() == 0; });
+    if (first_error) {
+        std::exception_ptr error = first_error;
+        first_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace libadic
@@ -0,0 +1,88 @@
+#include "libadic/inverse_table.h"
+#include "libadic/cache.h"
+#include "libadic/modular_arith.h"
+#include "libadic/precision_tracker.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace libadic {
+
+namespace {
+
+struct TableKeyHash {
+    size_t operator()(const std::pair<long, long>& k) const {
+        size_t h = std::hash<long>()(k.first);
+        hash_combine(h, std::hash<long>()(k.second));
+        return h;
+    }
+};
+
+using TablePtr = std::shared_ptr<const InverseTable>;
+
+ShardedCache<std::pair<long, long>, TablePtr, TableKeyHash>& table_cache() {
+    static ShardedCache<std::pair<long, long>, TablePtr, TableKeyHash> cache(
+        "InverseTable::tables",
+        [](const std::pair<long, long>& key, const TablePtr& table) {
+            size_t bytes = sizeof(key) + sizeof(InverseTable) +
+                           static_cast<size_t>(table->bound() + 1) * sizeof(long);
+            for (long n = 1; n <= table->bound(); ++n) {
+                bytes += cache_footprint(table->unit_inverse(n));
+            }
+            return bytes;
+        });
+    return cache;
+}
+
+} // namespace
+
+InverseTable::InverseTable(long p, long N, long bound)
+    : prime(p), precision(N), max_n(bound) {
+    if (p < 2) {
+        throw std::invalid_argument("Prime must be >= 2");
+    }
+    if (N < 1) {
+        throw std::invalid_argument("Precision must be >= 1");
+    }
+    if (bound < 1) {
+        throw std::invalid_argument("InverseTable bound must be >= 1");
+    }
+
+    size_t size = static_cast<size_t>(bound) + 1;
+    valuations.assign(size, 0);
+    units.assign(size, BigInt(0));
+    for (long n = 1; n <= bound; ++n) {
+        long m = n;
+        while (m % p == 0) {
+            m /= p;
+            ++valuations[n];
+        }
+        units[n] = BigInt(m);
+    }
+
+    long digits = N + PrecisionTracker::max_index_valuation(p, bound);
+    batch_mod_inverse(units.data() + 1, size - 1, PadicContext::get(p, digits).modulus());
+}
+
+std::shared_ptr<const InverseTable> InverseTable::get(long p, long N, long bound) {
+    std::pair<long, long> key{p, N};
+    auto hit = table_cache().find(key);
+    if (hit && (*hit)->bound() >= bound) {
+        return *hit;
+    }
+    long size = hit ? std::max(bound, 2 * (*hit)->bound()) : bound;
+    auto table = std::make_shared<const InverseTable>(p, N, size);
+    table_cache().insert(key, table);
+    return table;
+}
+
+Qp InverseTable::inverse(long n) const {
+    if (n < 1 || n > max_n) {
+        throw std::out_of_range("InverseTable::inverse: n outside the table");
+    }
+    long v = valuations[n];
+    BigInt unit = units[n] % PadicContext::get(prime, precision + v).modulus();
+    return Qp::from_unit_and_valuation(prime, precision, unit, -v);
+}
+
+} // namespace libadic
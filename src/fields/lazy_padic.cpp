@@ -0,0 +1,176 @@
+#include "libadic/lazy_padic.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace libadic {
+
+LazyQp::LazyQp(long p) : LazyQp(make(p, 0, [p](long N) { return Qp(p, N, 0); })) {}
+
+LazyQp::LazyQp(const Qp& x) {
+    auto n = std::make_shared<Node>();
+    n->prime = x.get_prime();
+    n->valuation_bound = x.is_zero() ? x.get_precision() : x.valuation();
+    n->precision_cap = x.get_precision();
+    n->evaluate = [x](long N) { return x.with_precision(std::min(N, x.get_precision())); };
+    node = std::move(n);
+}
+
+LazyQp::LazyQp(const Zp& x) : LazyQp(Qp(x)) {}
+
+LazyQp LazyQp::from_integer(long p, long n) {
+    long v = 0;
+    for (long m = n; m != 0 && m % p == 0; m /= p) {
+        ++v;
+    }
+    return make(p, n == 0 ? 0 : v, [p, n](long N) { return Qp(p, N, n); });
+}
+
+LazyQp LazyQp::from_rational(long num, long den, long p) {
+    if (den == 0) {
+        throw std::domain_error("Denominator cannot be zero");
+    }
+    long v = 0;
+    for (long m = num; m != 0 && m % p == 0; m /= p) ++v;
+    for (long m = den; m % p == 0; m /= p) --v;
+    // from_rational keeps N digits of the unit, so the result is exact to N
+    return make(p, num == 0 ? 0 : v, [num, den, p](long N) {
+        return Qp::from_rational(num, den, p, N);
+    });
+}
+
+LazyQp LazyQp::from_function(long p, Evaluator f, long valuation_bound) {
+    return make(p, valuation_bound, std::move(f));
+}
+
+LazyQp LazyQp::make(long p, long valuation_bound, Evaluator f) {
+    if (p < 2) {
+        throw std::invalid_argument("Prime must be >= 2");
+    }
+    auto n = std::make_shared<Node>();
+    n->prime = p;
+    n->valuation_bound = valuation_bound;
+    n->evaluate = std::move(f);
+    return LazyQp(std::shared_ptr<const Node>(std::move(n)));
+}
+
+void LazyQp::check_prime(const LazyQp& other) const {
+    if (node->prime != other.node->prime) {
+        throw std::invalid_argument("Cannot combine p-adic numbers with different primes");
+    }
+}
+
+long LazyQp::known_precision() const {
+    std::lock_guard<std::mutex> lock(node->mutex);
+    return node->cached_precision;
+}
+
+Qp LazyQp::approximate(long N) const {
+    if (N < 1) {
+        throw std::invalid_argument("Precision must be >= 1");
+    }
+    std::lock_guard<std::mutex> lock(node->mutex);
+    if (node->cached_precision >= N ||
+        (node->precision_cap > 0 && node->cached_precision >= node->precision_cap)) {
+        return node->cached.with_precision(std::min(N, node->cached_precision));
+    }
+
+    // Raise the request by whatever the routine fell short, a few times at most
+    long request = N;
+    Qp value = node->evaluate(request);
+    for (int attempt = 0; attempt < 4 && value.get_precision() < N && node->precision_cap == 0; ++attempt) {
+        request += N - value.get_precision();
+        value = node->evaluate(request);
+    }
+    long achieved = std::min(N, value.get_precision());
+    if (achieved > node->cached_precision) {
+        node->cached = value.with_precision(achieved);
+        node->cached_precision = achieved;
+    }
+    return node->cached.with_precision(std::min(N, node->cached_precision));
+}
+
+long LazyQp::valuation(long max_precision, long initial) const {
+    long n = std::max(1L, std::min(initial, max_precision));
+    while (true) {
+        Qp x = approximate(n);
+        if (!x.is_zero()) {
+            return x.valuation();
+        }
+        if (n >= max_precision || x.get_precision() < n) {
+            return std::min(max_precision, x.get_precision());
+        }
+        n = std::min(max_precision, 2 * n);
+    }
+}
+
+LazyQp LazyQp::operator+(const LazyQp& other) const {
+    check_prime(other);
+    auto a = node;
+    auto b = other.node;
+    return make(a->prime, std::min(a->valuation_bound, b->valuation_bound), [a, b](long N) {
+        return LazyQp(a).approximate(N) + LazyQp(b).approximate(N);
+    });
+}
+
+LazyQp LazyQp::operator-(const LazyQp& other) const {
+    check_prime(other);
+    auto a = node;
+    auto b = other.node;
+    return make(a->prime, std::min(a->valuation_bound, b->valuation_bound), [a, b](long N) {
+        return LazyQp(a).approximate(N) - LazyQp(b).approximate(N);
+    });
+}
+
+LazyQp LazyQp::operator-() const {
+    auto a = node;
+    return make(a->prime, a->valuation_bound, [a](long N) {
+        return -LazyQp(a).approximate(N);
+    });
+}
+
+LazyQp LazyQp::operator*(const LazyQp& other) const {
+    check_prime(other);
+    auto a = node;
+    auto b = other.node;
+    return make(a->prime, a->valuation_bound + b->valuation_bound, [a, b](long N) {
+        // An error p^M in one factor costs p^{M + v(other)}
+        long M = N - std::min({0L, a->valuation_bound, b->valuation_bound});
+        Qp product = LazyQp(a).approximate(M) * LazyQp(b).approximate(M);
+        return product.with_precision(std::min(N, product.get_precision()));
+    });
+}
+
+LazyQp LazyQp::operator/(const LazyQp& other) const {
+    check_prime(other);
+    auto a = node;
+    auto b = other.node;
+    long va_bound = a->valuation_bound;
+    return make(a->prime, va_bound - b->valuation_bound, [a, b, va_bound](long N) {
+        long p = a->prime;
+        LazyQp divisor(b);
+        long search = std::max(2 * N, N + 64);
+        long vb = divisor.valuation(search);
+        if (divisor.approximate(vb + 1).is_zero()) {
+            throw std::domain_error("LazyQp division by a number that vanishes to the requested precision");
+        }
+
+        // Relative precision N - v(a/b) on both units
+        Qp x = LazyQp(a).approximate(std::max(1L, N + vb));
+        Qp y = divisor.approximate(std::max(1L, N + 2 * vb - va_bound));
+        if (x.is_zero()) {
+            return Qp(p, N, 0);
+        }
+        long v = x.valuation() - y.valuation();
+        if (v >= N) {
+            return Qp(p, N, 0);
+        }
+        long digits = std::min({N - v, x.get_precision() - x.valuation(), y.get_precision() - y.valuation()});
+        if (digits <= 0) {
+            throw std::domain_error("LazyQp division lost every digit of the quotient");
+        }
+        Zp unit = x.get_unit().with_precision(digits) / y.get_unit().with_precision(digits);
+        return Qp::from_unit_and_valuation(p, v + digits, unit.get_value(), v);
+    });
+}
+
+} // namespace libadic
@@ -0,0 +1,376 @@
+#include "libadic/packed_cyclotomic.h"
+#include "libadic/cyclotomic.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace libadic {
+
+namespace {
+
+const BigInt& p_power(long p, long k) {
+    return PadicContext::get(p, std::max(k, 1L)).power(k);
+}
+
+size_t bit_length(unsigned long x) {
+    size_t bits = 0;
+    while (x > 0) {
+        ++bits;
+        x >>= 1;
+    }
+    return bits;
+}
+
+/**
+ * OR the limbs of x into buf at bit offset `offset` (the target bits are zero)
+ */
+void deposit(std::vector<mp_limb_t>& buf, size_t offset, const mpz_t x) {
+    size_t size = mpz_size(x);
+    const mp_limb_t* xp = mpz_limbs_read(x);
+    size_t q = offset / GMP_NUMB_BITS;
+    unsigned s = static_cast<unsigned>(offset % GMP_NUMB_BITS);
+    for (size_t j = 0; j < size; ++j) {
+        buf[q + j] |= xp[j] << s;
+        if (s != 0) {
+            buf[q + j + 1] |= xp[j] >> (GMP_NUMB_BITS - s);
+        }
+    }
+}
+
+/**
+ * out = bits [offset, offset + bits) of the limb array (xp, size)
+ */
+void extract(const mp_limb_t* xp, size_t size, size_t offset, size_t bits, mpz_t out) {
+    size_t q = offset / GMP_NUMB_BITS;
+    unsigned s = static_cast<unsigned>(offset % GMP_NUMB_BITS);
+    size_t n = bits / GMP_NUMB_BITS + 1;
+    mp_limb_t* w = mpz_limbs_write(out, static_cast<mp_size_t>(n));
+    for (size_t j = 0; j < n; ++j) {
+        mp_limb_t lo = q + j < size ? xp[q + j] : 0;
+        mp_limb_t hi = q + j + 1 < size ? xp[q + j + 1] : 0;
+        w[j] = s == 0 ? lo : (lo >> s) | (hi << (GMP_NUMB_BITS - s));
+    }
+    size_t full = bits / GMP_NUMB_BITS;
+    unsigned rem = static_cast<unsigned>(bits % GMP_NUMB_BITS);
+    w[full] &= rem == 0 ? 0 : (~mp_limb_t(0) >> (GMP_NUMB_BITS - rem));
+    mpz_limbs_finish(out, static_cast<mp_size_t>(n));
+}
+
+} // namespace
+
+PackedCyclotomic::PackedCyclotomic() : PackedCyclotomic(2, 1) {}
+
+PackedCyclotomic::PackedCyclotomic(long p, long N) : prime(p), precision(N), valuation(N), width(0) {
+    if (p < 2) {
+        throw std::invalid_argument("Prime must be >= 2");
+    }
+    if (N < 1) {
+        throw std::invalid_argument("Precision must be >= 1");
+    }
+}
+
+PackedCyclotomic::PackedCyclotomic(long p, long N, const Qp& constant) : PackedCyclotomic(p, N) {
+    if (constant.get_prime() != p) {
+        throw std::invalid_argument("Prime mismatch in cyclotomic constant");
+    }
+    long new_prec = std::min(N, constant.get_precision());
+    if (constant.is_zero()) {
+        reset(new_prec, new_prec);
+        return;
+    }
+    reset(new_prec, constant.valuation());
+    if (unit_precision() <= 0) {
+        return;
+    }
+    BigInt t;
+    mpz_mod(t.get_mpz(), constant.get_unit().get_value().get_mpz(),
+            p_power(prime, unit_precision()).get_mpz());
+    store(0, t.get_mpz());
+}
+
+PackedCyclotomic::PackedCyclotomic(const Cyclotomic& c) : PackedCyclotomic(c.get_prime(), c.get_precision()) {
+    const std::vector<Qp>& cs = c.get_coeffs();
+    long N = c.get_precision();
+    long v = N;
+    for (const Qp& x : cs) {
+        N = std::min(N, x.get_precision());
+    }
+    for (const Qp& x : cs) {
+        if (!x.is_zero()) {
+            v = std::min(v, x.valuation());
+        }
+    }
+    reset(N, v);
+    if (unit_precision() <= 0) {
+        return;
+    }
+
+    const BigInt& m = p_power(prime, unit_precision());
+    BigInt t;
+    for (size_t i = 0; i < cs.size() && static_cast<long>(i) < degree(); ++i) {
+        const Qp& x = cs[i];
+        if (x.is_zero() || x.valuation() >= N) continue;
+        mpz_mul(t.get_mpz(), x.get_unit().get_value().get_mpz(),
+                p_power(prime, x.valuation() - valuation).get_mpz());
+        mpz_mod(t.get_mpz(), t.get_mpz(), m.get_mpz());
+        store(i, t.get_mpz());
+    }
+}
+
+void PackedCyclotomic::reset(long N, long v) {
+    precision = N;
+    valuation = std::min(v, N);
+    width = unit_precision() > 0 ? mpz_size(p_power(prime, unit_precision()).get_mpz()) : 0;
+    limbs.assign(static_cast<size_t>(degree()) * width, 0);
+}
+
+void PackedCyclotomic::view(size_t i, mpz_t out) const {
+    mpz_roinit_n(out, limbs.data() + i * width, static_cast<mp_size_t>(width));
+}
+
+void PackedCyclotomic::store(size_t i, const mpz_t value) {
+    mp_limb_t* slot = limbs.data() + i * width;
+    size_t size = mpz_size(value);
+    const mp_limb_t* vp = mpz_limbs_read(value);
+    std::copy(vp, vp + size, slot);
+    std::fill(slot + size, slot + width, mp_limb_t(0));
+}
+
+PackedCyclotomic PackedCyclotomic::monomial(long p, long N, long k) {
+    PackedCyclotomic result(p, N);
+    result.reset(N, 0);
+    k = ((k % p) + p) % p;
+    const BigInt& m = p_power(p, N);
+    if (k < p - 1) {
+        BigInt one(1);
+        result.store(static_cast<size_t>(k), one.get_mpz());
+    } else {
+        BigInt minus_one = m - BigInt(1);
+        for (long i = 0; i < p - 1; ++i) {
+            result.store(static_cast<size_t>(i), minus_one.get_mpz());
+        }
+    }
+    return result;
+}
+
+Qp PackedCyclotomic::coeff(size_t i) const {
+    if (static_cast<long>(i) >= degree() || unit_precision() <= 0) {
+        return Qp(prime, precision, 0);
+    }
+    mpz_t c;
+    view(i, c);
+    if (mpz_sgn(c) == 0) {
+        return Qp(prime, precision, 0);
+    }
+    BigInt u;
+    BigInt p_big(prime);
+    long extra = static_cast<long>(mpz_remove(u.get_mpz(), c, p_big.get_mpz()));
+    return Qp::from_unit_and_valuation(prime, precision, u, valuation + extra);
+}
+
+Cyclotomic PackedCyclotomic::to_cyclotomic() const {
+    std::vector<Qp> cs;
+    cs.reserve(static_cast<size_t>(degree()));
+    for (long i = 0; i < degree(); ++i) {
+        cs.push_back(coeff(static_cast<size_t>(i)));
+    }
+    return Cyclotomic(prime, precision, cs);
+}
+
+bool PackedCyclotomic::is_zero() const {
+    return std::all_of(limbs.begin(), limbs.end(), [](mp_limb_t l) { return l == 0; });
+}
+
+PackedCyclotomic PackedCyclotomic::operator+(const PackedCyclotomic& other) const {
+    PackedCyclotomic result(*this);
+    result += other;
+    return result;
+}
+
+PackedCyclotomic PackedCyclotomic::operator-(const PackedCyclotomic& other) const {
+    PackedCyclotomic result(*this);
+    result -= other;
+    return result;
+}
+
+PackedCyclotomic& PackedCyclotomic::operator+=(const PackedCyclotomic& other) {
+    if (prime != other.prime) {
+        throw std::invalid_argument("Cannot add cyclotomic elements with different primes");
+    }
+    long N = std::min(precision, other.precision);
+    long v = std::min(valuation, other.valuation);
+    PackedCyclotomic result(prime, N);
+    result.reset(N, v);
+    if (result.unit_precision() <= 0) {
+        return *this = result;
+    }
+
+    const BigInt& m = p_power(prime, result.unit_precision());
+    bool use_a = valuation < N;
+    bool use_b = other.valuation < N;
+    const BigInt& sa = p_power(prime, use_a ? valuation - result.valuation : 0);
+    const BigInt& sb = p_power(prime, use_b ? other.valuation - result.valuation : 0);
+    BigInt t;
+    mpz_t a, b;
+    for (long i = 0; i < degree(); ++i) {
+        mpz_set_ui(t.get_mpz(), 0);
+        if (use_a) {
+            view(static_cast<size_t>(i), a);
+            mpz_addmul(t.get_mpz(), a, sa.get_mpz());
+        }
+        if (use_b) {
+            other.view(static_cast<size_t>(i), b);
+            mpz_addmul(t.get_mpz(), b, sb.get_mpz());
+        }
+        mpz_mod(t.get_mpz(), t.get_mpz(), m.get_mpz());
+        result.store(static_cast<size_t>(i), t.get_mpz());
+    }
+    return *this = std::move(result);
+}
+
+PackedCyclotomic& PackedCyclotomic::operator-=(const PackedCyclotomic& other) {
+    return *this += -other;
+}
+
+PackedCyclotomic PackedCyclotomic::operator-() const {
+    PackedCyclotomic result(*this);
+    if (unit_precision() <= 0) {
+        return result;
+    }
+    const BigInt& m = p_power(prime, unit_precision());
+    BigInt t;
+    mpz_t c;
+    for (long i = 0; i < degree(); ++i) {
+        view(static_cast<size_t>(i), c);
+        if (mpz_sgn(c) == 0) continue;
+        mpz_sub(t.get_mpz(), m.get_mpz(), c);
+        result.store(static_cast<size_t>(i), t.get_mpz());
+    }
+    return result;
+}
+
+PackedCyclotomic multiply(const PackedCyclotomic& a, const PackedCyclotomic& b) {
+    if (a.prime != b.prime) {
+        throw std::invalid_argument("Cannot multiply cyclotomic elements with different primes");
+    }
+    long p = a.prime;
+    long N = std::min(a.precision, b.precision);
+    PackedCyclotomic result(p, N);
+    if (a.valuation >= a.precision || b.valuation >= b.precision) {
+        result.reset(N, N);
+        return result;
+    }
+    result.reset(N, a.valuation + b.valuation);
+    long M = result.unit_precision();
+    if (M <= 0) {
+        return result;
+    }
+
+    const BigInt& m = p_power(p, M);
+    size_t n = static_cast<size_t>(p - 1);
+    size_t coeff_bits = mpz_sizeinbase(m.get_mpz(), 2);
+    // Each product coefficient is a sum of at most p-1 terms below m²
+    size_t slot_bits = 2 * coeff_bits + bit_length(static_cast<unsigned long>(n)) + 1;
+    size_t total_limbs = (n * slot_bits) / GMP_NUMB_BITS + 2;
+
+    BigInt t;
+    auto pack = [&](const PackedCyclotomic& x, BigInt& out) {
+        std::vector<mp_limb_t> buf(total_limbs, 0);
+        bool reduce = x.unit_precision() > M;
+        mpz_t c;
+        for (size_t i = 0; i < n; ++i) {
+            x.view(i, c);
+            if (reduce) {
+                mpz_mod(t.get_mpz(), c, m.get_mpz());
+                deposit(buf, i * slot_bits, t.get_mpz());
+            } else {
+                deposit(buf, i * slot_bits, c);
+            }
+        }
+        mp_limb_t* w = mpz_limbs_write(out.get_mpz(), static_cast<mp_size_t>(total_limbs));
+        std::copy(buf.begin(), buf.end(), w);
+        mpz_limbs_finish(out.get_mpz(), static_cast<mp_size_t>(total_limbs));
+    };
+
+    BigInt A, B, C;
+    pack(a, A);
+    if (&a == &b) {
+        mpz_mul(C.get_mpz(), A.get_mpz(), A.get_mpz());
+    } else {
+        pack(b, B);
+        mpz_mul(C.get_mpz(), A.get_mpz(), B.get_mpz());
+    }
+
+    // Fold degrees k >= p with ζ^p = 1, then eliminate ζ^{p-1}
+    const mp_limb_t* cp = mpz_limbs_read(C.get_mpz());
+    size_t cs = mpz_size(C.get_mpz());
+    std::vector<BigInt> folded(n + 1);
+    for (size_t k = 0; k + 1 < 2 * n; ++k) {
+        extract(cp, cs, k * slot_bits, slot_bits, t.get_mpz());
+        size_t j = k % static_cast<size_t>(p);
+        mpz_add(folded[j].get_mpz(), folded[j].get_mpz(), t.get_mpz());
+    }
+    for (size_t i = 0; i < n; ++i) {
+        mpz_sub(t.get_mpz(), folded[i].get_mpz(), folded[n].get_mpz());
+        mpz_mod(t.get_mpz(), t.get_mpz(), m.get_mpz());
+        result.store(i, t.get_mpz());
+    }
+    return result;
+}
+
+PackedCyclotomic PackedCyclotomic::operator*(const PackedCyclotomic& other) const {
+    return multiply(*this, other);
+}
+
+PackedCyclotomic& PackedCyclotomic::operator*=(const PackedCyclotomic& other) {
+    return *this = multiply(*this, other);
+}
+
+PackedCyclotomic PackedCyclotomic::operator*(const Qp& scalar) const {
+    if (scalar.get_prime() != prime) {
+        throw std::invalid_argument("Cannot multiply cyclotomic elements with different primes");
+    }
+    long N = std::min(precision, scalar.get_precision());
+    PackedCyclotomic result(prime, N);
+    if (scalar.is_zero() || valuation >= precision) {
+        result.reset(N, N);
+        return result;
+    }
+    result.reset(N, valuation + scalar.valuation());
+    if (result.unit_precision() <= 0) {
+        return result;
+    }
+
+    const BigInt& m = p_power(prime, result.unit_precision());
+    const BigInt& u = scalar.get_unit().get_value();
+    BigInt t;
+    mpz_t c;
+    for (long i = 0; i < degree(); ++i) {
+        view(static_cast<size_t>(i), c);
+        if (mpz_sgn(c) == 0) continue;
+        mpz_mul(t.get_mpz(), c, u.get_mpz());
+        mpz_mod(t.get_mpz(), t.get_mpz(), m.get_mpz());
+        result.store(static_cast<size_t>(i), t.get_mpz());
+    }
+    return result;
+}
+
+PackedCyclotomic& PackedCyclotomic::addmul(const PackedCyclotomic& a, const PackedCyclotomic& b) {
+    return *this += multiply(a, b);
+}
+
+PackedCyclotomic& PackedCyclotomic::addmul(const PackedCyclotomic& a, const Qp& scalar) {
+    return *this += a * scalar;
+}
+
+bool PackedCyclotomic::operator==(const PackedCyclotomic& other) const {
+    if (prime != other.prime) {
+        return false;
+    }
+    return (*this - other).is_zero();
+}
+
+std::string PackedCyclotomic::to_string() const {
+    return to_cyclotomic().to_string();
+}
+
+} // namespace libadic
@@ -0,0 +1,284 @@
+#include "libadic/zp_array.h"
+#include "libadic/padic_gamma.h"
+#include "libadic/padic_log.h"
+#include "libadic/teichmuller_table.h"
+#include <climits>
+#include <stdexcept>
+
+namespace libadic {
+
+namespace {
+
+void set_int64(BigInt& x, int64_t v) {
+    mpz_set_si(x.get_mpz(), static_cast<long>(v));
+}
+
+int64_t get_int64(const BigInt& x) {
+    if (!mpz_fits_slong_p(x.get_mpz())) {
+        throw std::overflow_error("Residue does not fit in int64");
+    }
+    return static_cast<int64_t>(mpz_get_si(x.get_mpz()));
+}
+
+} // namespace
+
+ZpArray::ZpArray(long p, long N, size_t count)
+    : prime(p), precision(N), ctx(&PadicContext::get(p, N)), values(count) {
+    if (p < 2) {
+        throw std::invalid_argument("Prime must be >= 2");
+    }
+    if (N < 1) {
+        throw std::invalid_argument("Precision must be >= 1");
+    }
+}
+
+void ZpArray::check_compatible(const ZpArray& other) const {
+    if (prime != other.prime || precision != other.precision) {
+        throw std::invalid_argument("ZpArray operands must share prime and precision");
+    }
+    if (values.size() != other.values.size()) {
+        throw std::invalid_argument("ZpArray operands must have the same length");
+    }
+}
+
+ZpArray ZpArray::from_residues(long p, long N, const int64_t* data, size_t count) {
+    ZpArray result(p, N, count);
+    for (size_t i = 0; i < count; ++i) {
+        set_int64(result.values[i], data[i]);
+        result.ctx->reduce(result.values[i]);
+    }
+    return result;
+}
+
+ZpArray ZpArray::from_limbs(long p, long N, const uint64_t* data, size_t count, size_t limbs) {
+    ZpArray result(p, N, count);
+    for (size_t i = 0; i < count; ++i) {
+        BigInt& x = result.values[i];
+        mpz_import(x.get_mpz(), limbs, -1, sizeof(uint64_t), 0, 0, data + i * limbs);
+        result.ctx->reduce(x);
+    }
+    return result;
+}
+
+size_t ZpArray::limb_count() const {
+    size_t bits = mpz_sizeinbase(ctx->modulus().get_mpz(), 2);
+    return (bits + 63) / 64;
+}
+
+bool ZpArray::fits_int64() const {
+    return mpz_sizeinbase(ctx->modulus().get_mpz(), 2) <= 64 &&
+           mpz_cmp_ui(ctx->modulus().get_mpz(), static_cast<unsigned long>(LONG_MAX)) <= 0;
+}
+
+void ZpArray::to_residues(int64_t* out) const {
+    if (!fits_int64()) {
+        throw std::overflow_error("p^N does not fit in int64; use to_limbs");
+    }
+    for (size_t i = 0; i < values.size(); ++i) {
+        out[i] = get_int64(values[i]);
+    }
+}
+
+void ZpArray::to_limbs(uint64_t* out) const {
+    size_t limbs = limb_count();
+    for (size_t i = 0; i < values.size(); ++i) {
+        uint64_t* dst = out + i * limbs;
+        size_t written = 0;
+        mpz_export(dst, &written, -1, sizeof(uint64_t), 0, 0, values[i].get_mpz());
+        for (size_t j = written; j < limbs; ++j) {
+            dst[j] = 0;
+        }
+    }
+}
+
+void ZpArray::set(size_t i, const Zp& x) {
+    if (x.get_prime() != prime) {
+        throw std::invalid_argument("Prime mismatch in ZpArray::set");
+    }
+    values[i] = x.with_precision(std::min(precision, x.get_precision())).get_value();
+    ctx->reduce(values[i]);
+}
+
+ZpArray ZpArray::operator+(const ZpArray& other) const {
+    check_compatible(other);
+    ZpArray result(prime, precision, values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        BigInt& r = result.values[i];
+        mpz_add(r.get_mpz(), values[i].get_mpz(), other.values[i].get_mpz());
+        ctx->reduce_once(r);
+    }
+    return result;
+}
+
+ZpArray ZpArray::operator-(const ZpArray& other) const {
+    check_compatible(other);
+    ZpArray result(prime, precision, values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        BigInt& r = result.values[i];
+        mpz_sub(r.get_mpz(), values[i].get_mpz(), other.values[i].get_mpz());
+        if (mpz_sgn(r.get_mpz()) < 0) {
+            mpz_add(r.get_mpz(), r.get_mpz(), ctx->modulus().get_mpz());
+        }
+    }
+    return result;
+}
+
+ZpArray ZpArray::operator*(const ZpArray& other) const {
+    check_compatible(other);
+    ZpArray result(prime, precision, values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        BigInt& r = result.values[i];
+        mpz_mul(r.get_mpz(), values[i].get_mpz(), other.values[i].get_mpz());
+        ctx->reduce(r);
+    }
+    return result;
+}
+
+ZpArray ZpArray::operator-() const {
+    ZpArray result(prime, precision, values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (!values[i].is_zero()) {
+            mpz_sub(result.values[i].get_mpz(), ctx->modulus().get_mpz(), values[i].get_mpz());
+        }
+    }
+    return result;
+}
+
+ZpArray ZpArray::scale(const Zp& c) const {
+    if (c.get_prime() != prime) {
+        throw std::invalid_argument("Prime mismatch in ZpArray::scale");
+    }
+    BigInt factor = c.get_value();
+    ctx->reduce(factor);
+    ZpArray result(prime, precision, values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        BigInt& r = result.values[i];
+        mpz_mul(r.get_mpz(), values[i].get_mpz(), factor.get_mpz());
+        ctx->reduce(r);
+    }
+    return result;
+}
+
+ZpArray ZpArray::log() const {
+    ZpArray result(prime, precision, values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        Qp l = PadicLog::log(Qp(prime, precision, values[i]));
+        if (l.is_zero()) continue;
+        // v(log x) >= 1, so p^v · u is an integer residue
+        BigInt& r = result.values[i];
+        mpz_mul(r.get_mpz(), l.get_unit().get_value().get_mpz(), ctx->power(l.valuation()).get_mpz());
+        ctx->reduce(r);
+    }
+    return result;
+}
+
+ZpArray ZpArray::gamma() const {
+    ZpArray result(prime, precision, values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        result.values[i] = PadicGamma::gamma(Zp(prime, precision, values[i])).get_value();
+    }
+    return result;
+}
+
+ZpArray ZpArray::teichmuller() const {
+    ZpArray result(prime, precision, values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        result.values[i] = TeichmullerTable::lift(values[i], prime, precision);
+    }
+    return result;
+}
+
+QpArray::QpArray(long p, long N, size_t count)
+    : prime(p), precision(N), values(count, Qp(p, N, 0)) {}
+
+QpArray::QpArray(const ZpArray& integers)
+    : prime(integers.get_prime()), precision(integers.get_precision()) {
+    values.reserve(integers.size());
+    for (size_t i = 0; i < integers.size(); ++i) {
+        values.emplace_back(prime, precision, integers.residue(i));
+    }
+}
+
+void QpArray::check_compatible(const QpArray& other) const {
+    if (prime != other.prime || precision != other.precision) {
+        throw std::invalid_argument("QpArray operands must share prime and precision");
+    }
+    if (values.size() != other.values.size()) {
+        throw std::invalid_argument("QpArray operands must have the same length");
+    }
+}
+
+QpArray QpArray::from_residues(long p, long N, const int64_t* units, const int64_t* valuations,
+                               size_t count) {
+    QpArray result(p, N, count);
+    BigInt u;
+    for (size_t i = 0; i < count; ++i) {
+        long v = static_cast<long>(valuations[i]);
+        if (units[i] == 0 || v >= N) continue;
+        set_int64(u, units[i]);
+        if (mpz_divisible_ui_p(u.get_mpz(), static_cast<unsigned long>(p))) {
+            throw std::invalid_argument("QpArray unit residues must be prime to p");
+        }
+        const PadicContext& unit_ctx = PadicContext::get(p, N - v);
+        unit_ctx.reduce(u);
+        result.values[i] = Qp::from_unit_and_valuation(p, N, u, v);
+    }
+    return result;
+}
+
+void QpArray::to_residues(int64_t* units, int64_t* valuations) const {
+    for (size_t i = 0; i < values.size(); ++i) {
+        const Qp& x = values[i];
+        if (x.is_zero()) {
+            units[i] = 0;
+            valuations[i] = precision;
+            continue;
+        }
+        units[i] = get_int64(x.get_unit().get_value());
+        valuations[i] = x.valuation();
+    }
+}
+
+void QpArray::set(size_t i, const Qp& x) {
+    if (x.get_prime() != prime) {
+        throw std::invalid_argument("Prime mismatch in QpArray::set");
+    }
+    values[i] = x.with_precision(std::min(precision, x.get_precision()));
+}
+
+QpArray QpArray::operator+(const QpArray& other) const {
+    check_compatible(other);
+    QpArray result(*this);
+    for (size_t i = 0; i < values.size(); ++i) {
+        result.values[i] += other.values[i];
+    }
+    return result;
+}
+
+QpArray QpArray::operator-(const QpArray& other) const {
+    check_compatible(other);
+    QpArray result(*this);
+    for (size_t i = 0; i < values.size(); ++i) {
+        result.values[i] -= other.values[i];
+    }
+    return result;
+}
+
+QpArray QpArray::operator*(const QpArray& other) const {
+    check_compatible(other);
+    QpArray result(*this);
+    for (size_t i = 0; i < values.size(); ++i) {
+        result.values[i] *= other.values[i];
+    }
+    return result;
+}
+
+QpArray QpArray::log() const {
+    QpArray result(prime, precision, values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        result.values[i] = PadicLog::log(values[i]);
+    }
+    return result;
+}
+
+} // namespace libadic
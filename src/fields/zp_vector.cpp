@@ -0,0 +1,354 @@
+#include "libadic/zp_vector.h"
+#include "libadic/cache.h"
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+namespace libadic {
+
+namespace {
+
+constexpr size_t kModulusBits = 29;     // every basis prime exceeds 2^29
+constexpr size_t kDotBlock = 16;        // 16 products below 2^60 fit in a uint64
+constexpr size_t kStackDigits = 128;
+
+/**
+ * Primes below 2^30 in decreasing order, extended on demand
+ */
+const uint32_t* basis_primes(size_t count) {
+    static std::mutex mutex;
+    static std::vector<uint32_t> primes;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (primes.size() < count) {
+        primes.reserve(count);
+        BigInt candidate(primes.empty() ? (1UL << 30) : primes.back());
+        while (primes.size() < count) {
+            mpz_sub_ui(candidate.get_mpz(), candidate.get_mpz(), 1);
+            if (mpz_probab_prime_p(candidate.get_mpz(), 30) != 0) {
+                primes.push_back(static_cast<uint32_t>(mpz_get_ui(candidate.get_mpz())));
+            }
+        }
+    }
+    return primes.data();
+}
+
+uint32_t inverse_mod(uint32_t a, uint32_t q) {
+    // Extended Euclid; a and q are coprime
+    int64_t r0 = q, r1 = a, t0 = 0, t1 = 1;
+    while (r1 != 0) {
+        int64_t quotient = r0 / r1;
+        std::tie(r0, r1) = std::make_pair(r1, r0 - quotient * r1);
+        std::tie(t0, t1) = std::make_pair(t1, t0 - quotient * t1);
+    }
+    return static_cast<uint32_t>(t0 < 0 ? t0 + q : t0);
+}
+
+size_t bits_of(const BigInt& x) {
+    return mpz_sizeinbase(x.get_mpz(), 2);
+}
+
+using BasisKey = std::tuple<long, long, size_t>;  // p, N, moduli
+
+struct BasisKeyHash {
+    size_t operator()(const BasisKey& k) const {
+        size_t h = std::hash<long>()(std::get<0>(k));
+        hash_combine(h, std::hash<long>()(std::get<1>(k)));
+        hash_combine(h, std::hash<size_t>()(std::get<2>(k)));
+        return h;
+    }
+};
+
+using BasisPtr = std::shared_ptr<const RnsBasis>;
+
+ShardedCache<BasisKey, BasisPtr, BasisKeyHash>& basis_cache() {
+    static ShardedCache<BasisKey, BasisPtr, BasisKeyHash> cache(
+        "RnsBasis::bases",
+        [](const BasisKey& key, const BasisPtr& basis) {
+            size_t k = basis->size();
+            return sizeof(key) + sizeof(RnsBasis) + (k + k * k) * sizeof(uint32_t) +
+                   k * (sizeof(BigInt) + mpz_size(PadicContext::get(basis->get_prime(),
+                                                                    basis->get_precision())
+                                                      .modulus().get_mpz()) * sizeof(mp_limb_t));
+        });
+    return cache;
+}
+
+size_t moduli_for(size_t bits) {
+    return std::max<size_t>(1, (bits + kModulusBits - 1) / kModulusBits);
+}
+
+} // namespace
+
+RnsBasis::RnsBasis(long p, long N, size_t bits) : prime(p), precision(N) {
+    if (p < 2) {
+        throw std::invalid_argument("Prime must be >= 2");
+    }
+    if (N < 1) {
+        throw std::invalid_argument("Precision must be >= 1");
+    }
+    size_t k = moduli_for(bits);
+    const uint32_t* primes = basis_primes(k);
+    moduli.assign(primes, primes + k);
+
+    inverses.assign(k * k, 0);
+    for (size_t i = 0; i < k; ++i) {
+        for (size_t j = i + 1; j < k; ++j) {
+            inverses[i * k + j] = inverse_mod(moduli[i] % moduli[j], moduli[j]);
+        }
+    }
+
+    const PadicContext& ctx = PadicContext::get(p, N);
+    BigInt product(1);
+    prefix.reserve(k);
+    for (size_t i = 0; i < k; ++i) {
+        BigInt reduced = product;
+        ctx.reduce(reduced);
+        prefix.push_back(std::move(reduced));
+        mpz_mul_ui(product.get_mpz(), product.get_mpz(), moduli[i]);
+    }
+    capacity = bits_of(product) - 1;
+}
+
+std::shared_ptr<const RnsBasis> RnsBasis::get(long p, long N, size_t bits) {
+    BasisKey key{p, N, moduli_for(bits)};
+    return basis_cache().get_or_compute(key, [&]() {
+        return std::make_shared<const RnsBasis>(p, N, bits);
+    });
+}
+
+BigInt RnsBasis::combine(const uint32_t* residues, size_t stride) const {
+    // Garner: v_j = (x_j - v_0 - v_1 q_0 - ...) / (q_0 ··· q_{j-1}) mod q_j
+    size_t k = moduli.size();
+    uint32_t stack_digits[kStackDigits];
+    std::vector<uint32_t> heap_digits;
+    uint32_t* digits = stack_digits;
+    if (k > kStackDigits) {
+        heap_digits.resize(k);
+        digits = heap_digits.data();
+    }
+    for (size_t j = 0; j < k; ++j) {
+        uint64_t q = moduli[j];
+        uint64_t t = residues[j * stride];
+        for (size_t i = 0; i < j; ++i) {
+            t = (t + q - digits[i] % q) % q;
+            t = t * inverses[i * k + j] % q;
+        }
+        digits[j] = static_cast<uint32_t>(t);
+    }
+
+    BigInt result;
+    for (size_t i = 0; i < k; ++i) {
+        mpz_addmul_ui(result.get_mpz(), prefix[i].get_mpz(), digits[i]);
+    }
+    PadicContext::get(prime, precision).reduce(result);
+    return result;
+}
+
+ZpVector::ZpVector(long p, long N, size_t count, size_t headroom_bits)
+    : prime(p), precision(N), length(count) {
+    size_t element_bits = bits_of(PadicContext::get(p, N).modulus());
+    basis = RnsBasis::get(p, N, 2 * element_bits + headroom_bits + 1);
+    residues.assign(basis->size() * length, 0);
+    bound = element_bits;
+}
+
+ZpVector::ZpVector(const std::vector<Zp>& values, size_t headroom_bits)
+    : ZpVector(values.empty() ? 2 : values[0].get_prime(),
+               values.empty() ? 1 : values[0].get_precision(), values.size(), headroom_bits) {
+    for (size_t i = 0; i < values.size(); ++i) {
+        set(i, values[i]);
+    }
+}
+
+ZpVector::ZpVector(const ZpArray& values, size_t headroom_bits)
+    : ZpVector(values.get_prime(), values.get_precision(), values.size(), headroom_bits) {
+    for (size_t i = 0; i < values.size(); ++i) {
+        store(i, values.residue(i));
+    }
+}
+
+void ZpVector::check_compatible(const ZpVector& other) const {
+    if (prime != other.prime || precision != other.precision) {
+        throw std::invalid_argument("ZpVector operands must share prime and precision");
+    }
+    if (length != other.length) {
+        throw std::invalid_argument("ZpVector operands must have the same length");
+    }
+    if (basis->size() != other.basis->size()) {
+        throw std::invalid_argument("ZpVector operands must share an RNS basis");
+    }
+}
+
+void ZpVector::store(size_t i, const BigInt& value) {
+    for (size_t r = 0; r < basis->size(); ++r) {
+        residues[r * length + i] = static_cast<uint32_t>(mpz_fdiv_ui(value.get_mpz(), basis->modulus(r)));
+    }
+}
+
+void ZpVector::set(size_t i, const Zp& x) {
+    if (x.get_prime() != prime) {
+        throw std::invalid_argument("Prime mismatch in ZpVector::set");
+    }
+    set(i, x.with_precision(std::min(precision, x.get_precision())).get_value());
+}
+
+void ZpVector::set(size_t i, const BigInt& x) {
+    BigInt value = x;
+    PadicContext::get(prime, precision).reduce(value);
+    store(i, value);  // below p^N, so within any bound
+}
+
+Zp ZpVector::operator[](size_t i) const {
+    return Zp(prime, precision, basis->combine(residues.data() + i, length));
+}
+
+std::vector<Zp> ZpVector::to_zp() const {
+    std::vector<Zp> out;
+    out.reserve(length);
+    for (size_t i = 0; i < length; ++i) {
+        out.push_back((*this)[i]);
+    }
+    return out;
+}
+
+ZpArray ZpVector::to_array() const {
+    ZpArray out(prime, precision, length);
+    for (size_t i = 0; i < length; ++i) {
+        out.set(i, (*this)[i]);
+    }
+    return out;
+}
+
+ZpVector& ZpVector::reduce() {
+    size_t element_bits = bits_of(PadicContext::get(prime, precision).modulus());
+    if (bound <= element_bits) {
+        return *this;
+    }
+    for (size_t i = 0; i < length; ++i) {
+        store(i, basis->combine(residues.data() + i, length));
+    }
+    bound = element_bits;
+    return *this;
+}
+
+ZpVector ZpVector::reduced_for(size_t bits) const {
+    ZpVector copy = *this;
+    if (bits > basis->capacity_bits()) {
+        copy.reduce();
+    }
+    return copy;
+}
+
+ZpVector ZpVector::operator+(const ZpVector& other) const {
+    check_compatible(other);
+    size_t bits = std::max(bound, other.bound) + 1;
+    if (bits > basis->capacity_bits()) {
+        return reduced_for(bits) + other.reduced_for(bits);
+    }
+    ZpVector result = *this;
+    result.bound = bits;
+    for (size_t r = 0; r < basis->size(); ++r) {
+        uint32_t q = basis->modulus(r);
+        uint32_t* out = result.residues.data() + r * length;
+        const uint32_t* y = other.plane(r);
+        for (size_t i = 0; i < length; ++i) {
+            uint32_t s = out[i] + y[i];
+            out[i] = s >= q ? s - q : s;
+        }
+    }
+    return result;
+}
+
+ZpVector ZpVector::operator-(const ZpVector& other) const {
+    check_compatible(other);
+    // x - y is represented by x + (C - y) with C = p^N 2^s >= 2^bound(y)
+    const BigInt& modulus = PadicContext::get(prime, precision).modulus();
+    size_t element_bits = bits_of(modulus);
+    size_t shift = other.bound + 1 > element_bits ? other.bound + 1 - element_bits : 0;
+    size_t bits = std::max(bound, element_bits + shift) + 1;
+    if (bits > basis->capacity_bits()) {
+        return reduced_for(bits) - other.reduced_for(bits);
+    }
+    BigInt offset;
+    mpz_mul_2exp(offset.get_mpz(), modulus.get_mpz(), shift);
+    ZpVector result = *this;
+    result.bound = bits;
+    for (size_t r = 0; r < basis->size(); ++r) {
+        uint32_t q = basis->modulus(r);
+        uint32_t c = static_cast<uint32_t>(mpz_fdiv_ui(offset.get_mpz(), q));
+        uint32_t* out = result.residues.data() + r * length;
+        const uint32_t* y = other.plane(r);
+        for (size_t i = 0; i < length; ++i) {
+            uint32_t d = c >= y[i] ? c - y[i] : c + (q - y[i]);
+            uint32_t s = out[i] + d;
+            out[i] = s >= q ? s - q : s;
+        }
+    }
+    return result;
+}
+
+ZpVector ZpVector::operator*(const ZpVector& other) const {
+    check_compatible(other);
+    size_t bits = bound + other.bound;
+    if (bits > basis->capacity_bits()) {
+        return reduced_for(bits) * other.reduced_for(bits);
+    }
+    ZpVector result = *this;
+    result.bound = bits;
+    for (size_t r = 0; r < basis->size(); ++r) {
+        uint64_t q = basis->modulus(r);
+        uint32_t* out = result.residues.data() + r * length;
+        const uint32_t* y = other.plane(r);
+        for (size_t i = 0; i < length; ++i) {
+            out[i] = static_cast<uint32_t>(static_cast<uint64_t>(out[i]) * y[i] % q);
+        }
+    }
+    return result;
+}
+
+Zp ZpVector::dot(const ZpVector& other) const {
+    check_compatible(other);
+    size_t capacity = basis->capacity_bits();
+    if (bound + other.bound > capacity) {
+        return reduced_for(capacity + 1).dot(other.reduced_for(capacity + 1));
+    }
+
+    // Chunks whose exact sum stays below 2^capacity
+    size_t spare = capacity - bound - other.bound;
+    size_t chunk = spare >= 8 * sizeof(size_t) - 1 ? length : (size_t(1) << spare);
+    chunk = std::max<size_t>(chunk, 1);
+
+    size_t k = basis->size();
+    std::vector<uint32_t> partial(k);
+    BigInt total;
+    for (size_t start = 0; start < length; start += chunk) {
+        size_t end = std::min(length, start + chunk);
+        for (size_t r = 0; r < k; ++r) {
+            uint64_t q = basis->modulus(r);
+            const uint32_t* x = plane(r);
+            const uint32_t* y = other.plane(r);
+            uint64_t sum = 0;
+            size_t i = start;
+            for (; i + kDotBlock <= end; i += kDotBlock) {
+                uint64_t acc = 0;
+                for (size_t j = 0; j < kDotBlock; ++j) {
+                    acc += static_cast<uint64_t>(x[i + j]) * y[i + j];
+                }
+                sum = (sum + acc % q) % q;
+            }
+            uint64_t acc = 0;
+            for (; i < end; ++i) {
+                acc += static_cast<uint64_t>(x[i]) * y[i];
+            }
+            partial[r] = static_cast<uint32_t>((sum + acc % q) % q);
+        }
+        BigInt piece = basis->combine(partial.data());
+        mpz_add(total.get_mpz(), total.get_mpz(), piece.get_mpz());
+    }
+    PadicContext::get(prime, precision).reduce(total);
+    return Zp(prime, precision, total);
+}
+
+} // namespace libadic
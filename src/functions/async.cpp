@@ -0,0 +1,57 @@
+#include "libadic/async.h"
+#include "libadic/l_functions.h"
+#include <mutex>
+#include <utility>
+
+namespace libadic {
+
+ThreadPool& Async::pool() {
+    // Never destroyed: tasks may still be queued during static destruction,
+    // after the caches they use are gone
+    static ThreadPool* shared = new ThreadPool();
+    return *shared;
+}
+
+namespace {
+
+std::mutex callback_error_mutex;
+std::exception_ptr callback_error;
+
+} // namespace
+
+std::exception_ptr Async::take_callback_error() {
+    std::lock_guard<std::mutex> lock(callback_error_mutex);
+    return std::exchange(callback_error, nullptr);
+}
+
+void Async::report_callback_error(std::exception_ptr error) {
+    std::lock_guard<std::mutex> lock(callback_error_mutex);
+    if (!callback_error) {
+        callback_error = std::move(error);
+    }
+}
+
+AsyncResult<Qp> Async::kubota_leopoldt(long s, const DirichletCharacter& chi, long precision,
+                                       CancellationToken token, Callback on_ready) {
+    return submit([s, chi, precision]() {
+        return LFunctions::kubota_leopoldt(s, chi, precision);
+    }, std::move(token), std::move(on_ready));
+}
+
+AsyncResult<Qp> Async::kubota_leopoldt_derivative(long s, const DirichletCharacter& chi,
+                                                  long precision, CancellationToken token,
+                                                  Callback on_ready) {
+    return submit([s, chi, precision]() {
+        return LFunctions::kubota_leopoldt_derivative(s, chi, precision);
+    }, std::move(token), std::move(on_ready));
+}
+
+AsyncResult<ReidLiResult> Async::reid_li_verify(const DirichletCharacter& chi, long precision,
+                                                long tolerance, CancellationToken token,
+                                                Callback on_ready) {
+    return submit([chi, precision, tolerance]() {
+        return ReidLi::verify(chi, precision, tolerance);
+    }, std::move(token), std::move(on_ready));
+}
+
+} // namespace libadic
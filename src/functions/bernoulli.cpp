@@ -1,7 +1,201 @@
 #include "libadic/bernoulli.h"
+#include "libadic/stats.h"
 
 namespace libadic {
 
-// Implementation is in header for now due to templates and static members
+BernoulliNumbers::RangePtr BernoulliNumbers::range_table(long n_max, long p, long precision) {
+    stats::Scope scope(stats::Id::bernoulli_range);
+    if (n_max < 0) {
+        throw std::invalid_argument("Bernoulli index must be non-negative");
+    }
+    std::pair<long, long> key{p, precision};
+    if (auto cached = range_cache.find(key)) {
+        if (static_cast<long>((*cached)->size()) > n_max) {
+            return *cached;
+        }
+        n_max = std::max(n_max, 2 * static_cast<long>((*cached)->size()));
+    }
+    if (auto top = range_top.find(p)) {
+        if (top->first > precision && static_cast<long>(top->second->size()) > n_max) {
+            auto truncated = std::make_shared<std::vector<Qp>>();
+            truncated->reserve(top->second->size());
+            for (const Qp& b : *top->second) {
+                truncated->push_back(b.with_precision(std::min(precision, b.get_precision())));
+            }
+            RangePtr table = std::move(truncated);
+            range_cache.insert(key, table);
+            return table;
+        }
+    }
+    ResultStore::Key stored{ResultStore::Table::Bernoulli, {p}, ""};
+    if (auto warm = ResultStore::instance().find(stored, precision, static_cast<size_t>(n_max + 1))) {
+        RangePtr table = std::make_shared<const std::vector<Qp>>(std::move(*warm));
+        range_cache.insert(key, table);
+        return table;
+    }
 
-} // namespace libadic
\ No newline at end of file
+    scope.iterations(static_cast<uint64_t>(n_max + 1));
+    auto values = std::make_shared<std::vector<Qp>>();
+    values->reserve(static_cast<size_t>(n_max + 1));
+    values->push_back(Qp(p, precision, 1));
+    if (n_max >= 1) {
+        values->push_back(Qp::from_rational(-1, 2, p, precision));
+    }
+
+    long k_max = n_max / 2;
+    if (k_max >= 1) {
+        // p-part and p-free part of each denominator 4^k (4^k - 1)
+        std::vector<long> den_val(static_cast<size_t>(k_max + 1), 0);
+        std::vector<BigInt> den_unit(static_cast<size_t>(k_max + 1));
+        BigInt prime_big(p);
+        long extra = 0;
+        for (long k = 1; k <= k_max; ++k) {
+            BigInt& d = den_unit[k];
+            mpz_ui_pow_ui(d.get_mpz(), 4, static_cast<unsigned long>(k));
+            mpz_sub_ui(d.get_mpz(), d.get_mpz(), 1);
+            mpz_mul_2exp(d.get_mpz(), d.get_mpz(), static_cast<mp_bitcnt_t>(2 * k));
+            den_val[k] = static_cast<long>(mpz_remove(d.get_mpz(), d.get_mpz(), prime_big.get_mpz()));
+            extra = std::max(extra, den_val[k]);
+        }
+
+        // Tangent numbers modulo p^W
+        long W = precision + extra;
+        scope.inflation(extra);
+        BigInt modulus = prime_big.pow(W);
+        std::vector<BigInt> T(static_cast<size_t>(k_max + 1));
+        T[1] = BigInt(1);
+        for (long k = 2; k <= k_max; ++k) {
+            mpz_mul_ui(T[k].get_mpz(), T[k - 1].get_mpz(), static_cast<unsigned long>(k - 1));
+            mpz_mod(T[k].get_mpz(), T[k].get_mpz(), modulus.get_mpz());
+        }
+        for (long k = 2; k <= k_max; ++k) {
+            for (long j = k; j <= k_max; ++j) {
+                mpz_mul_ui(T[j].get_mpz(), T[j].get_mpz(), static_cast<unsigned long>(j - k + 2));
+                mpz_addmul_ui(T[j].get_mpz(), T[j - 1].get_mpz(), static_cast<unsigned long>(j - k));
+                mpz_mod(T[j].get_mpz(), T[j].get_mpz(), modulus.get_mpz());
+            }
+        }
+
+        BigInt num, inv, prec_mod;
+        for (long k = 1; k <= k_max; ++k) {
+            // B_{2k-1} = 0 for k >= 2
+            if (k >= 2) {
+                values->push_back(Qp(p, precision, 0));
+            }
+
+            mpz_mul_ui(num.get_mpz(), T[k].get_mpz(), static_cast<unsigned long>(2 * k));
+            if (k % 2 == 0) {
+                mpz_neg(num.get_mpz(), num.get_mpz());
+            }
+            mpz_mod(num.get_mpz(), num.get_mpz(), modulus.get_mpz());
+            if (num.is_zero()) {
+                values->push_back(Qp(p, precision, 0));
+                continue;
+            }
+            long num_val = static_cast<long>(mpz_remove(num.get_mpz(), num.get_mpz(), prime_big.get_mpz()));
+            long val = num_val - den_val[k];
+            if (val >= precision) {
+                values->push_back(Qp(p, precision, 0));
+                continue;
+            }
+
+            // Unit known modulo p^{W - num_val}; keep the N - val digits Qp carries
+            prec_mod = prime_big.pow(precision - val);
+            mpz_invert(inv.get_mpz(), den_unit[k].get_mpz(), prec_mod.get_mpz());
+            mpz_mul(num.get_mpz(), num.get_mpz(), inv.get_mpz());
+            mpz_mod(num.get_mpz(), num.get_mpz(), prec_mod.get_mpz());
+            values->push_back(Qp::from_unit_and_valuation(p, precision, num, val));
+        }
+        if (n_max % 2 == 1 && n_max >= 3) {
+            values->push_back(Qp(p, precision, 0));
+        }
+    }
+
+    RangePtr table = std::move(values);
+    range_cache.insert(key, table);
+    auto top = range_top.find(p);
+    if (!top || top->first < precision ||
+        (top->first == precision && top->second->size() < table->size())) {
+        range_top.insert(p, {precision, table});
+    }
+    return table;
+}
+
+void BernoulliNumbers::export_cache(ResultStore& store) {
+    range_cache.for_each([&](const std::pair<long, long>& key, const RangePtr& values) {
+        store.insert({ResultStore::Table::Bernoulli, {key.first}, ""}, key.second, *values);
+    });
+    generalized_cache.for_each([&](const CharKey& key, long precision, const Qp& value) {
+        store.insert({ResultStore::Table::GeneralizedBernoulli,
+                      {key.n, key.conductor, key.p, key.modulus, key.character}, ""},
+                     precision, {value});
+    });
+}
+
+std::vector<Qp> BernoulliNumbers::bernoulli_polynomial_scaled(long n, long f, long p, long precision) {
+    if (n < 0) {
+        throw std::invalid_argument("Bernoulli index must be non-negative");
+    }
+    if (f < 1) {
+        throw std::invalid_argument("Denominator must be positive");
+    }
+
+    // coeffs[j] = C(n, j) B_{n-j} f^{n-j}, the coefficient of a^j. B_k can
+    // have valuation -1, so integer factors carry one extra digit to keep
+    // the N + 1 unit digits of the products exact.
+    long wide = precision + 1;
+    RangePtr bern = range_table(n, p, precision);
+    std::vector<Qp> coeffs(static_cast<size_t>(n + 1), Qp(p, precision, 0));
+    BigInt binom(1);
+    BigInt f_power = BigInt(f).pow(n);
+    BigInt f_big(f);
+    for (long j = 0; j <= n; ++j) {
+        if (!(*bern)[n - j].is_zero()) {
+            coeffs[j] = Qp(p, wide, binom * f_power) * (*bern)[n - j];
+        }
+        binom = binom * BigInt(n - j) / BigInt(j + 1);
+        if (j < n) {
+            f_power = f_power / f_big;
+        }
+    }
+
+    auto horner = [&](long a) {
+        Qp x(p, wide, a);
+        Qp r = coeffs[n];
+        for (long j = n - 1; j >= 0; --j) {
+            r *= x;
+            r += coeffs[j];
+        }
+        return r;
+    };
+
+    std::vector<Qp> values;
+    values.reserve(static_cast<size_t>(f));
+    long direct = std::min(f, n + 1);
+    for (long a = 0; a < direct; ++a) {
+        values.push_back(horner(a));
+    }
+    if (direct == f) {
+        return values;
+    }
+
+    // diff[i] = Δ^i P(a); Δ^n is constant
+    std::vector<Qp> diff(values.begin(), values.end());
+    for (long i = 1; i <= n; ++i) {
+        for (long j = n; j >= i; --j) {
+            diff[j] -= diff[j - 1];
+        }
+    }
+    for (long a = 1; a < f; ++a) {
+        cancellation_point();
+        for (long i = 0; i < n; ++i) {
+            diff[i] += diff[i + 1];
+        }
+        if (a > n) {
+            values.push_back(diff[0]);
+        }
+    }
+    return values;
+}
+
+} // namespace libadic
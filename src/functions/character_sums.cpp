@@ -0,0 +1,413 @@
+#include "libadic/character_sums.h"
+#include "libadic/cache.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace libadic {
+
+namespace {
+
+struct BatchKeyHash {
+    size_t operator()(const std::pair<long, long>& k) const {
+        size_t h = std::hash<long>()(k.first);
+        hash_combine(h, std::hash<long>()(k.second));
+        return h;
+    }
+};
+
+using BatchPtr = std::shared_ptr<const CharacterSumBatch>;
+
+ShardedCache<std::pair<long, long>, BatchPtr, BatchKeyHash>& batch_cache() {
+    static ShardedCache<std::pair<long, long>, BatchPtr, BatchKeyHash> cache(
+        "CharacterSumBatch::tables",
+        [](const std::pair<long, long>& key, const BatchPtr& batch) {
+            size_t bytes = sizeof(key) + sizeof(CharacterSumBatch) +
+                           2 * batch->size() * sizeof(long);
+            for (size_t j = 0; j < batch->size(); ++j) {
+                bytes += cache_footprint(batch->root(j));
+            }
+            return bytes;
+        });
+    return cache;
+}
+
+// Cost model: Qp::addmul costs qp_base + qp_per_bit per bit of p^N; the
+// residue path pays per gathered word term, per value converted in (plus a
+// split per plane) and per result combined (Garner is quadratic in the planes)
+std::mutex& cost_mutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+CharacterSumCosts& costs() {
+    static CharacterSumCosts model;
+    return model;
+}
+
+constexpr size_t kBlock = 16;  // 16 products below 2^60 fit in a uint64
+
+size_t headroom_for(size_t terms) {
+    size_t bits = 1;
+    while ((size_t(1) << bits) < terms) ++bits;
+    return bits + 1;
+}
+
+// Σ_{j<len} table[(start + step·j) mod n] · values[offset + j·stride] mod q
+uint32_t gathered_dot(const uint32_t* table, size_t n, size_t start, size_t step,
+                      const uint32_t* values, size_t offset, size_t stride, size_t len, uint64_t q) {
+    uint64_t sum = 0;
+    size_t index = start;
+    size_t position = offset;
+    for (size_t j = 0; j < len;) {
+        uint64_t acc = 0;
+        size_t end = std::min(len, j + kBlock);
+        for (; j < end; ++j) {
+            acc += static_cast<uint64_t>(table[index]) * values[position];
+            index += step;
+            if (index >= n) index -= n;
+            position += stride;
+        }
+        sum = (sum + acc % q) % q;
+    }
+    return static_cast<uint32_t>(sum);
+}
+
+} // namespace
+
+CharacterSumBatch::CharacterSumBatch(long p, long N)
+    : prime(p), precision(N), group_order(p - 1) {
+    if (p < 3) {
+        throw std::invalid_argument("CharacterSumBatch requires an odd prime");
+    }
+    if (N < 1) {
+        throw std::invalid_argument("Precision must be >= 1");
+    }
+
+    // Use the same generator as the characters themselves, so index k here
+    // is character_values[0] there
+    DirichletCharacter base(p, p);
+    if (base.generators.size() != 1) {
+        throw std::invalid_argument("CharacterSumBatch requires a prime modulus");
+    }
+    generator = base.generators[0];
+
+    size_t n = static_cast<size_t>(group_order);
+    exponent_of.assign(static_cast<size_t>(p), 0);
+    power_of.assign(n, 0);
+    long x = 1;
+    for (size_t e = 0; e < n; ++e) {
+        power_of[e] = x;
+        exponent_of[x] = static_cast<long>(e);
+        x = (x * generator) % p;
+    }
+
+    Qp omega(Zp(p, N, generator).teichmuller());
+    roots.reserve(n);
+    roots.emplace_back(p, N, 1);
+    for (size_t j = 1; j < n; ++j) {
+        roots.push_back(roots.back() * omega);
+    }
+
+    long m = group_order;
+    for (long q = 2; q * q <= m; ++q) {
+        while (m % q == 0) {
+            radices.push_back(q);
+            m /= q;
+        }
+    }
+    if (m > 1) {
+        radices.push_back(m);
+    }
+}
+
+std::shared_ptr<const CharacterSumBatch> CharacterSumBatch::get(long p, long N) {
+    return batch_cache().get_or_compute({p, N}, [&]() {
+        return std::make_shared<const CharacterSumBatch>(p, N);
+    });
+}
+
+long CharacterSumBatch::discrete_log(long a) const {
+    a %= prime;
+    if (a < 0) a += prime;
+    if (a == 0) {
+        throw std::invalid_argument("discrete_log of a non-unit");
+    }
+    return exponent_of[a];
+}
+
+long CharacterSumBatch::index_of(const DirichletCharacter& chi) {
+    if (chi.get_modulus() != chi.get_prime() || chi.character_values.size() != 1) {
+        throw std::invalid_argument("CharacterSumBatch indexes characters modulo p only");
+    }
+    long n = chi.get_prime() - 1;
+    return ((chi.character_values[0] % n) + n) % n;
+}
+
+/**
+ * out[k] = Σ_{e<len} in[offset + e·stride] · ω_len^{ke}, where ω_len = ω^{(p-1)/len}.
+ * Splitting e = q·e' + r by the radix q of this level gives
+ *   out[k] = Σ_r ω_len^{kr} · Y_r[k mod len/q],
+ * with Y_r the length-len/q transform of the r-th decimated subsequence.
+ */
+void CharacterSumBatch::transform(const std::vector<Qp>& in, size_t offset, size_t stride,
+                                  size_t len, size_t level, std::vector<Qp>& out) const {
+    out.assign(len, Qp(prime, precision, 0));
+    if (len == 1) {
+        out[0] = in[offset];
+        return;
+    }
+
+    size_t n = static_cast<size_t>(group_order);
+    size_t step = n / len;
+    size_t q = static_cast<size_t>(radices[level]);
+    size_t m = len / q;
+
+    if (m == 1) {
+        for (size_t k = 0; k < len; ++k) {
+            for (size_t r = 0; r < q; ++r) {
+                out[k].addmul(roots[(step * k * r) % n], in[offset + r * stride]);
+            }
+        }
+        return;
+    }
+
+    std::vector<std::vector<Qp>> sub(q);
+    for (size_t r = 0; r < q; ++r) {
+        transform(in, offset + r * stride, stride * q, m, level + 1, sub[r]);
+    }
+    for (size_t k = 0; k < len; ++k) {
+        for (size_t r = 0; r < q; ++r) {
+            out[k].addmul(roots[(step * k * r) % n], sub[r][k % m]);
+        }
+    }
+}
+
+const ZpVector& CharacterSumBatch::roots_in_rns() const {
+    std::call_once(root_residues_once, [this]() {
+        size_t n = static_cast<size_t>(group_order);
+        auto table = std::make_unique<ZpVector>(prime, precision, n, headroom_for(n));
+        for (size_t j = 0; j < n; ++j) {
+            table->set(j, roots[j].to_zp());
+        }
+        root_residues = std::move(table);
+    });
+    return *root_residues;
+}
+
+/**
+ * f(g^e) at index e as exact residues, or false when some value is not
+ * in Z_p at this batch's precision (the Qp path then handles it)
+ */
+bool CharacterSumBatch::residues_of(const std::vector<Qp>& f, ZpVector& out) const {
+    size_t n = static_cast<size_t>(group_order);
+    for (long a = 1; a < prime; ++a) {
+        const Qp& x = f[a];
+        if (x.get_prime() != prime || x.get_precision() < precision || (!x.is_zero() && x.valuation() < 0)) {
+            return false;
+        }
+    }
+    out = ZpVector(prime, precision, n, headroom_for(n));
+    for (size_t e = 0; e < n; ++e) {
+        out.set(e, f[power_of[e]].to_zp());
+    }
+    return true;
+}
+
+CharacterSumCosts CharacterSumBatch::cost_model() {
+    std::lock_guard<std::mutex> lock(cost_mutex());
+    return costs();
+}
+
+void CharacterSumBatch::set_cost_model(const CharacterSumCosts& model) {
+    if (!(model.qp_base >= 0 && model.qp_per_bit >= 0 && model.word_term >= 0 && model.convert >= 0 &&
+          model.split >= 0 && model.combine >= 0 && model.setup >= 0)) {
+        throw std::invalid_argument("Character sum costs must be non-negative");
+    }
+    std::lock_guard<std::mutex> lock(cost_mutex());
+    costs() = model;
+}
+
+CharacterSumCosts CharacterSumBatch::calibrate() {
+    using Clock = std::chrono::steady_clock;
+    // ns per call of `step`, repeated until 2 ms have passed
+    auto time_ns = [](auto&& step) {
+        size_t calls = 0;
+        auto start = Clock::now();
+        auto elapsed = Clock::duration::zero();
+        do {
+            for (int i = 0; i < 64; ++i, ++calls) step();
+            elapsed = Clock::now() - start;
+        } while (elapsed < std::chrono::milliseconds(2));
+        return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(calls);
+    };
+
+    CharacterSumCosts model;
+    const long p = 7;
+    double bits[2], ns[2];
+    long precisions[2] = {20, 120};  // 57 and 337 bits, where addmul is near linear
+    for (int i = 0; i < 2; ++i) {
+        long N = precisions[i];
+        Qp a(p, N, BigInt(3).pow(5 * N)), b(p, N, BigInt(5).pow(5 * N)), acc(p, N, 0);
+        bits[i] = static_cast<double>(mpz_sizeinbase(PadicContext::get(p, N).modulus().get_mpz(), 2));
+        ns[i] = time_ns([&]() { acc.addmul(a, b); });
+    }
+    model.qp_per_bit = std::max(0.0, (ns[1] - ns[0]) / (bits[1] - bits[0]));
+    model.qp_base = std::max(0.0, ns[0] - model.qp_per_bit * bits[0]);
+
+    const size_t n = 4096;
+    std::vector<uint32_t> table(n), values(n);
+    for (size_t i = 0; i < n; ++i) {
+        table[i] = static_cast<uint32_t>((i * 2654435761u) >> 3);
+        values[i] = static_cast<uint32_t>((i * 40503u + 7) >> 2);
+    }
+    volatile uint64_t sink = 0;  // keeps the sums observable
+    size_t start = 0;
+    double word = time_ns([&]() {
+        sink += gathered_dot(table.data(), n, start, 3, values.data(), 0, 1, n, 536870909u);
+        start = (start + 1) % n;
+    }) / static_cast<double>(n);
+    double scale = word / model.word_term;
+    model.word_term = word;
+    model.convert *= scale;
+    model.split *= scale;
+    model.combine *= scale;
+    model.setup *= scale;
+    return model;
+}
+
+bool CharacterSumBatch::rns_cheaper(double terms, double outputs, double qp_operations) const {
+    CharacterSumCosts c = cost_model();
+    // Planes of the basis a ZpVector picks: 2 log2 p^N + headroom bits
+    double element_bits = static_cast<double>(
+        mpz_sizeinbase(PadicContext::get(prime, precision).modulus().get_mpz(), 2));
+    double bits = 2.0 * element_bits + static_cast<double>(headroom_for(static_cast<size_t>(group_order)) + 1);
+    double planes = std::ceil(bits / 29.0);
+    double inputs = static_cast<double>(group_order);
+    double rns = planes * terms * c.word_term + inputs * (c.convert + planes * c.split) +
+                 outputs * (c.convert + planes * planes * c.combine) + c.setup;
+    return rns < qp_operations * (c.qp_base + c.qp_per_bit * element_bits);
+}
+
+std::vector<Qp> CharacterSumBatch::sum(const std::vector<Qp>& f) const {
+    if (f.size() != static_cast<size_t>(prime)) {
+        throw std::invalid_argument("CharacterSumBatch::sum expects f[0..p-1]");
+    }
+    size_t n = static_cast<size_t>(group_order);
+
+    double radix_sum = 0;
+    for (long q : radices) radix_sum += static_cast<double>(q);
+    ZpVector values(prime, precision);
+    double dn = static_cast<double>(n);
+    if (rns_cheaper(dn * dn, dn, dn * radix_sum) &&
+        residues_of(f, values)) {
+        // sums[k] = Σ_e ω^{ke} f(g^e), plane by plane
+        const ZpVector& table = roots_in_rns();
+        const RnsBasis& basis = table.get_basis();
+        size_t planes = basis.size();
+        std::vector<uint32_t> out(planes * n);
+        for (size_t r = 0; r < planes; ++r) {
+            const uint32_t* w = table.plane(r);
+            const uint32_t* x = values.plane(r);
+            for (size_t k = 0; k < n; ++k) {
+                out[k * planes + r] = gathered_dot(w, n, 0, k, x, 0, 1, n, basis.modulus(r));
+            }
+        }
+        std::vector<Qp> sums;
+        sums.reserve(n);
+        for (size_t k = 0; k < n; ++k) {
+            sums.emplace_back(Zp(prime, precision, basis.combine(out.data() + k * planes)));
+        }
+        return sums;
+    }
+
+    std::vector<Qp> by_exponent;
+    by_exponent.reserve(n);
+    for (size_t e = 0; e < n; ++e) {
+        by_exponent.push_back(f[power_of[e]]);
+    }
+    std::vector<Qp> sums;
+    transform(by_exponent, 0, 1, n, 0, sums);
+    return sums;
+}
+
+std::vector<Qp> CharacterSumBatch::sum(const std::function<Qp(long)>& f) const {
+    std::vector<Qp> values(static_cast<size_t>(prime), Qp(prime, precision, 0));
+    for (long a = 1; a < prime; ++a) {
+        values[a] = f(a);
+    }
+    return sum(values);
+}
+
+std::vector<Qp> CharacterSumBatch::orbit_sum(const DirichletCharacter& representative,
+                                             const std::vector<Qp>& f) const {
+    if (f.size() != static_cast<size_t>(prime)) {
+        throw std::invalid_argument("CharacterSumBatch::orbit_sum expects f[0..p-1]");
+    }
+    if (representative.get_prime() != prime) {
+        throw std::invalid_argument("Character does not belong to this prime");
+    }
+    size_t n = static_cast<size_t>(group_order);
+    size_t k = static_cast<size_t>(index_of(representative));
+    size_t d = n / std::gcd(k, n);
+
+    size_t conjugates = 0;
+    for (size_t a = 1; a < std::max<size_t>(d, 2); ++a) {
+        if (std::gcd(a, d) == 1) ++conjugates;
+    }
+    double terms = static_cast<double>(conjugates) * static_cast<double>(d);
+    ZpVector values(prime, precision);
+    double dn = static_cast<double>(n);
+    if (rns_cheaper(terms + dn, static_cast<double>(conjugates), terms + dn) && residues_of(f, values)) {
+        // S_j = Σ_{e ≡ j (d)} f(g^e) as exact residues, then d-term sums
+        const ZpVector& table = roots_in_rns();
+        const RnsBasis& basis = table.get_basis();
+        size_t planes = basis.size();
+        std::vector<uint32_t> graded(planes * d);
+        for (size_t r = 0; r < planes; ++r) {
+            uint64_t q = basis.modulus(r);
+            const uint32_t* x = values.plane(r);
+            for (size_t j = 0; j < d; ++j) {
+                uint64_t s = 0;
+                for (size_t e = j; e < n; e += d) {
+                    s += x[e];  // n < 2^32 terms below 2^30
+                }
+                graded[r * d + j] = static_cast<uint32_t>(s % q);
+            }
+        }
+        std::vector<Qp> sums;
+        std::vector<uint32_t> residues(planes);
+        for (size_t a = 1; a < std::max<size_t>(d, 2); ++a) {
+            if (std::gcd(a, d) != 1) continue;
+            size_t ka = (k * a) % n;
+            for (size_t r = 0; r < planes; ++r) {
+                residues[r] = gathered_dot(table.plane(r), n, 0, ka, graded.data() + r * d, 0, 1, d,
+                                           basis.modulus(r));
+            }
+            sums.emplace_back(Zp(prime, precision, basis.combine(residues.data())));
+        }
+        return sums;
+    }
+
+    std::vector<Qp> graded(d, Qp(prime, precision, 0));
+    for (size_t e = 0; e < n; ++e) {
+        graded[e % d] += f[power_of[e]];
+    }
+
+    std::vector<Qp> sums;
+    for (size_t a = 1; a < std::max<size_t>(d, 2); ++a) {
+        if (std::gcd(a, d) != 1) continue;
+        size_t ka = (k * a) % n;
+        Qp s(prime, precision, 0);
+        for (size_t j = 0; j < d; ++j) {
+            s.addmul(roots[(ka * j) % n], graded[j]);
+        }
+        sums.push_back(std::move(s));
+    }
+    return sums;
+}
+
+} // namespace libadic
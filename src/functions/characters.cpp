@@ -1,5 +1,9 @@
 #include "libadic/characters.h"
+#include "libadic/cache.h"
 #include "libadic/l_functions.h"
+#include "libadic/stats.h"
+#include "libadic/teichmuller_table.h"
+#include <algorithm>
 #include <vector>
 #include <map>
 #include <numeric>
@@ -22,7 +26,8 @@ long DirichletCharacter::pow_mod(long base, long exp, long mod) {
 }
 
 // Private method implementations
-void DirichletCharacter::compute_generators() {
+void DirichletCharacter::compute_generators(long modulus, std::vector<long>& generators,
+                                            std::vector<long>& generator_orders) {
     generators.clear();
     generator_orders.clear();
     
@@ -113,61 +118,119 @@ void DirichletCharacter::compute_generators() {
     }
 }
 
-std::vector<long> DirichletCharacter::express_in_generators(long a) const {
-    std::vector<long> exponents(generators.size(), 0);
-    
-    if (std::gcd(a, modulus) != 1) {
-        return exponents;  // Not in (Z/nZ)*
-    }
-    
-    // Normalize a to [1, modulus)
-    a = ((a % modulus) + modulus) % modulus;
-    
-    // For prime modulus, we have a single generator
-    // Need to solve discrete log: find e such that g^e ≡ a (mod modulus)
-    if (generators.size() == 1) {
-        long g = generators[0];
-        long order = generator_orders[0];
+struct DirichletCharacter::GroupTable {
+    long modulus = 1;
+    std::vector<long> generators;
+    std::vector<long> generator_orders;
+    std::vector<char> unit;          // unit[a] = (gcd(a, modulus) == 1)
+    std::vector<long> exponents;     // exponents[a * #generators + i] = e_i in a = Π g_i^{e_i}
+    long primitive_root = 0;         // 0 if (Z/nZ)* has no primitive root below modulus
+    std::vector<long> root_powers;   // root_powers[j] = primitive_root^j mod modulus
+};
+
+std::shared_ptr<const DirichletCharacter::GroupTable> DirichletCharacter::group_table(long modulus) {
+    using GroupTablePtr = std::shared_ptr<const GroupTable>;
+    static ShardedCache<long, GroupTablePtr> cache(
+        "DirichletCharacter::group_tables",
+        [](long, const GroupTablePtr& table) {
+            return sizeof(GroupTable) + table->unit.size() +
+                   (table->exponents.size() + table->root_powers.size()) * sizeof(long);
+        });
+    
+    return cache.get_or_compute(modulus, [modulus]() {
+        stats::Scope scope(stats::Id::character_group_table);
+        auto table = std::make_shared<GroupTable>();
+        table->modulus = modulus;
+        compute_generators(modulus, table->generators, table->generator_orders);
         
-        // Brute force discrete log (fine for small primes)
-        for (long e = 0; e < order; ++e) {
-            if (pow_mod(g, e, modulus) == a) {
-                exponents[0] = e;
-                return exponents;
+        size_t n = static_cast<size_t>(modulus);
+        size_t m = table->generators.size();
+        table->unit.assign(n, 0);
+        for (long a = 0; a < modulus; ++a) {
+            table->unit[a] = std::gcd(a, modulus) == 1;
+        }
+        
+        // Walk every product Π g_i^{e_i} once, outermost generator first;
+        // the first exponent vector to reach a residue is the one recorded
+        table->exponents.assign(n * m, 0);
+        if (m > 0) {
+            std::vector<long> gens(m);
+            for (size_t i = 0; i < m; ++i) {
+                gens[i] = ((table->generators[i] % modulus) + modulus) % modulus;
             }
+            std::vector<char> seen(n, 0);
+            std::vector<long> e(m, 0);
+            std::function<void(size_t, long)> walk = [&](size_t i, long prod) {
+                if (i == m) {
+                    if (!seen[prod]) {
+                        seen[prod] = 1;
+                        std::copy(e.begin(), e.end(), table->exponents.begin() + prod * m);
+                    }
+                    return;
+                }
+                long x = prod;
+                for (e[i] = 0; e[i] < table->generator_orders[i]; ++e[i]) {
+                    walk(i + 1, x);
+                    x = (x * gens[i]) % modulus;
+                }
+                e[i] = 0;
+            };
+            walk(0, 1 % modulus);
         }
-    } else {
-        // For composite modulus with multiple generators
-        // This requires more sophisticated handling
-        // For now, handle the case of two generators (e.g., for 2^k)
-        if (generators.size() == 2) {
-            // Try all combinations
-            for (long e1 = 0; e1 < generator_orders[0]; ++e1) {
-                for (long e2 = 0; e2 < generator_orders[1]; ++e2) {
-                    long prod = (pow_mod(generators[0], e1, modulus) * 
-                                pow_mod(generators[1], e2, modulus)) % modulus;
-                    if (prod == a) {
-                        exponents[0] = e1;
-                        exponents[1] = e2;
-                        return exponents;
+        
+        // Primitive root used to represent χ(n) as a residue mod modulus
+        for (long g = 2; g < modulus; ++g) {
+            scope.iterations(1);
+            bool is_primitive = true;
+            for (long d = 2; d * d <= modulus - 1; ++d) {
+                if ((modulus - 1) % d == 0) {
+                    if (pow_mod(g, d, modulus) == 1 ||
+                        pow_mod(g, (modulus - 1) / d, modulus) == 1) {
+                        is_primitive = false;
+                        break;
                     }
                 }
             }
+            if (is_primitive && pow_mod(g, modulus - 1, modulus) == 1) {
+                table->primitive_root = g;
+                break;
+            }
+        }
+        if (table->primitive_root != 0) {
+            table->root_powers.resize(n - 1);
+            long x = 1;
+            for (size_t j = 0; j + 1 < n; ++j) {
+                table->root_powers[j] = x;
+                x = (x * table->primitive_root) % modulus;
+            }
         }
+        
+        return GroupTablePtr(std::move(table));
+    });
+}
+
+std::vector<long> DirichletCharacter::express_in_generators(long a) const {
+    a = ((a % modulus) + modulus) % modulus;
+    if (!group->unit[a]) {
+        return std::vector<long>(generators.size(), 0);  // Not in (Z/nZ)*
     }
-    
-    return exponents;
+    auto first = group->exponents.begin() + a * static_cast<long>(generators.size());
+    return std::vector<long>(first, first + static_cast<long>(generators.size()));
 }
 
 // Constructor implementations
 DirichletCharacter::DirichletCharacter(long mod, long p) : conductor(mod), modulus(mod), prime(p) {
-    compute_generators();
+    group = group_table(mod);
+    generators = group->generators;
+    generator_orders = group->generator_orders;
     character_values.resize(generators.size(), 0);
 }
 
 DirichletCharacter::DirichletCharacter(long mod, long p, const std::vector<long>& gen_values) 
     : conductor(mod), modulus(mod), prime(p), character_values(gen_values) {
-    compute_generators();
+    group = group_table(mod);
+    generators = group->generators;
+    generator_orders = group->generator_orders;
     if (character_values.size() != generators.size()) {
         throw std::invalid_argument("Wrong number of generator values");
     }
@@ -204,26 +267,23 @@ void DirichletCharacter::compute_conductor() {
 }
 
 long DirichletCharacter::evaluate_at(long n) const {
-    if (std::gcd(n, modulus) != 1) {
+    stats::count(stats::Id::character_evaluate_at);
+    long residue = ((n % modulus) + modulus) % modulus;
+    if (!group->unit[residue]) {
         return -1;  // Special value to indicate χ(n) = 0
     }
     
-    // Express n in terms of generators: n ≡ g₁^e₁ * g₂^e₂ * ... (mod modulus)
-    std::vector<long> exps = express_in_generators(n);
-    
-    // A Dirichlet character is determined by its values on the generators
-    // χ(n) = χ(g₁^e₁ * g₂^e₂ * ...) = χ(g₁)^e₁ * χ(g₂)^e₂ * ...
-    
-    // character_values[i] stores k_i where χ(g_i) = ζ_{d_i}^{k_i}
-    // and d_i = generator_orders[i]
-    
-    // We need to compute the product of roots of unity
-    // ζ_{d₁}^{k₁e₁} * ζ_{d₂}^{k₂e₂} * ...
-    
     if (generators.empty()) {
         return 1;  // Trivial group, principal character
     }
     
+    // n ≡ g₁^e₁ * g₂^e₂ * ... (mod modulus), read from the shared table, and
+    // χ(n) = χ(g₁)^e₁ * χ(g₂)^e₂ * ...
+    //
+    // character_values[i] stores k_i where χ(g_i) = ζ_{d_i}^{k_i}
+    // and d_i = generator_orders[i]
+    const long* exps = group->exponents.data() + residue * static_cast<long>(generators.size());
+    
     // Compute the exponent of the resulting root of unity
     // We work in Q/Z to handle different orders
     long total_numerator = 0;
@@ -257,47 +317,27 @@ long DirichletCharacter::evaluate_at(long n) const {
         return 1;  // χ(n) = 1
     }
     
-    // Find a primitive total_denominator-th root of unity mod modulus
     // For prime modulus p, we need total_denominator | (p-1)
-    
-    // First verify that total_denominator divides φ(modulus) = modulus - 1 for prime
     if ((modulus - 1) % total_denominator != 0) {
         throw std::logic_error("Character order does not divide φ(modulus)");
     }
     
-    // Find a primitive root modulo p
-    long primitive_root = 2;
-    bool found = false;
-    for (long g = 2; g < modulus; ++g) {
-        bool is_primitive = true;
-        
-        // Check if g is a primitive root by verifying g^d ≠ 1 for all proper divisors d of p-1
-        for (long d = 2; d * d <= modulus - 1; ++d) {
-            if ((modulus - 1) % d == 0) {
-                if (pow_mod(g, d, modulus) == 1 || 
-                    pow_mod(g, (modulus - 1) / d, modulus) == 1) {
-                    is_primitive = false;
-                    break;
-                }
-            }
-        }
-        
-        if (is_primitive && pow_mod(g, modulus - 1, modulus) == 1) {
-            primitive_root = g;
-            found = true;
-            break;
-        }
-    }
-    
-    if (!found) {
+    if (group->primitive_root == 0) {
         throw std::runtime_error("Failed to find primitive root");
     }
     
-    // ζ_{total_denominator} = primitive_root^((p-1)/total_denominator) mod p
-    long zeta = pow_mod(primitive_root, (modulus - 1) / total_denominator, modulus);
-    
-    // χ(n) = ζ^{total_numerator}
-    return pow_mod(zeta, total_numerator, modulus);
+    // χ(n) = ζ^{total_numerator} with ζ = g^((p-1)/total_denominator)
+    long exponent = ((modulus - 1) / total_denominator) * total_numerator % (modulus - 1);
+    if (exponent < 0) exponent += modulus - 1;
+    return group->root_powers[exponent];
+}
+
+std::vector<long> DirichletCharacter::values() const {
+    std::vector<long> result(static_cast<size_t>(modulus));
+    for (long n = 0; n < modulus; ++n) {
+        result[n] = evaluate_at(n);
+    }
+    return result;
 }
 
 Zp DirichletCharacter::evaluate(long n, long precision) const {
@@ -320,14 +360,10 @@ Zp DirichletCharacter::evaluate(long n, long precision) const {
     }
     
     // Use Teichmüller lift
-    return Zp(prime, precision, chi_n).teichmuller();
+    return Zp(prime, precision, TeichmullerTable::get(prime, precision)->at(chi_n));
 }
 
 Cyclotomic DirichletCharacter::evaluate_cyclotomic(long n, long precision) const {
-    if (value_cache.find(n) != value_cache.end()) {
-        return value_cache[n];
-    }
-    
     long chi_n = evaluate_at(n);
     
     // χ(n) = 0 is encoded by sentinel value -1 from evaluate_at
@@ -335,21 +371,9 @@ Cyclotomic DirichletCharacter::evaluate_cyclotomic(long n, long precision) const
         return Cyclotomic(prime, precision);
     }
     
-    // Express as power of primitive root of unity
-    long order = get_order();
-    Cyclotomic zeta = Cyclotomic::zeta(prime, precision);
-    
-    // χ(n) = ζ^{chi_n * (p-1)/order}
-    Cyclotomic result(prime, precision, Qp(prime, precision, 1));
-    Cyclotomic zeta_power = zeta;
-    
-    long exponent = (chi_n * (prime - 1)) / order;
-    for (long i = 0; i < exponent; ++i) {
-        result = result * zeta_power;
-    }
-    
-    value_cache[n] = result;
-    return result;
+    // χ(n) = ζ^{chi_n * (p-1)/order}, built directly as a monomial
+    long exponent = (chi_n * (prime - 1)) / get_order();
+    return Cyclotomic::zeta_power(prime, precision, exponent);
 }
 
 bool DirichletCharacter::is_even() const {
@@ -377,8 +401,9 @@ bool DirichletCharacter::is_primitive() const {
 }
 
 bool DirichletCharacter::is_principal() const {
-    for (long val : character_values) {
-        if (val != 1 && val != 0) return false;
+    // character_values holds exponents k_i with χ(g_i) = ζ_{d_i}^{k_i}
+    for (size_t i = 0; i < character_values.size(); ++i) {
+        if (character_values[i] % generator_orders[i] != 0) return false;
     }
     return true;
 }
@@ -403,70 +428,136 @@ long DirichletCharacter::get_order() const {
     return order;
 }
 
+long DirichletCharacter::index() const {
+    long k = 0;
+    for (size_t i = 0; i < character_values.size(); ++i) {
+        k = k * generator_orders[i] + character_values[i];
+    }
+    return k;
+}
+
+DirichletCharacter DirichletCharacter::from_index(long modulus, long prime, long index) {
+    DirichletCharacter chi(modulus, prime);
+    long rest = index;
+    for (size_t i = chi.generators.size(); i-- > 0;) {
+        chi.character_values[i] = rest % chi.generator_orders[i];
+        rest /= chi.generator_orders[i];
+    }
+    if (index < 0 || rest != 0) {
+        throw std::out_of_range("Character index out of range for this modulus");
+    }
+    chi.compute_conductor();
+    return chi;
+}
+
 std::vector<DirichletCharacter> DirichletCharacter::enumerate_characters(long modulus, long prime) {
+    CharacterRange range(modulus, prime);
     std::vector<DirichletCharacter> characters;
-    
-    DirichletCharacter base(modulus, prime);
-    size_t num_generators = base.generators.size();
-    
-    if (num_generators == 0) {
-        // Only trivial character
-        characters.push_back(base);
-        return characters;
+    characters.reserve(static_cast<size_t>(range.group_order()));
+    for (const DirichletCharacter& chi : range) {
+        characters.push_back(chi);
     }
-    
-    // Generate all possible combinations of values on generators
-    std::vector<long> current_values(num_generators, 0);
-    
-    std::function<void(size_t)> generate = [&](size_t index) {
-        if (index == num_generators) {
-            characters.emplace_back(modulus, prime, current_values);
-            return;
-        }
-        
-        // Try all possible values for this generator
-        for (long val = 0; val < base.generator_orders[index]; ++val) {
-            current_values[index] = val;
-            generate(index + 1);
-        }
-    };
-    
-    generate(0);
     return characters;
 }
 
 std::vector<DirichletCharacter> DirichletCharacter::enumerate_primitive_characters(long modulus, long prime) {
-    auto all_chars = enumerate_characters(modulus, prime);
     std::vector<DirichletCharacter> primitive;
-    
-    for (auto& chi : all_chars) {
-        if (chi.is_primitive()) {
-            primitive.push_back(chi);
-        }
+    for (const DirichletCharacter& chi : CharacterRange(modulus, prime, true)) {
+        primitive.push_back(chi);
     }
-    
     return primitive;
 }
 
+std::vector<DirichletCharacter> DirichletCharacter::galois_orbit() const {
+    long order = get_order();
+    std::vector<DirichletCharacter> orbit;
+    for (long a = 1; a < std::max(order, 2L); ++a) {
+        if (std::gcd(a, order) != 1) continue;
+        DirichletCharacter conjugate = *this;
+        for (size_t i = 0; i < character_values.size(); ++i) {
+            conjugate.character_values[i] = (character_values[i] * a) % generator_orders[i];
+        }
+        orbit.push_back(std::move(conjugate));
+    }
+    return orbit;
+}
+
+std::vector<std::vector<DirichletCharacter>> DirichletCharacter::galois_orbits(long modulus, long prime) {
+    CharacterRange range(modulus, prime);
+    std::vector<bool> seen(static_cast<size_t>(range.group_order()), false);
+    std::vector<std::vector<DirichletCharacter>> orbits;
+    for (const DirichletCharacter& chi : range) {
+        if (seen[chi.index()]) continue;
+        orbits.push_back(chi.galois_orbit());
+        for (const DirichletCharacter& conjugate : orbits.back()) {
+            seen[conjugate.index()] = true;
+        }
+    }
+    return orbits;
+}
+
+CharacterRange::CharacterRange(long n, long p, bool primitive)
+    : modulus(n), prime(p), primitive_only(primitive) {
+    for (long o : DirichletCharacter(n, p).generator_orders) {
+        order *= o;
+    }
+}
+
+long CharacterRange::size() const {
+    if (!primitive_only) {
+        return order;
+    }
+    long count = 0;
+    for (auto it = begin(); it != end(); ++it) {
+        ++count;
+    }
+    return count;
+}
+
+CharacterRange::iterator::iterator(const CharacterRange* r, long start)
+    : range(r), position(std::max(0L, std::min(start, r->order))) {
+    if (position < range->order) {
+        current = DirichletCharacter::from_index(range->modulus, range->prime, position);
+        if (range->primitive_only && !current->is_primitive()) {
+            ++*this;
+        }
+    }
+}
+
+CharacterRange::iterator& CharacterRange::iterator::operator++() {
+    do {
+        if (++position >= range->order) {
+            position = range->order;
+            current.reset();
+            return *this;
+        }
+        // Odometer step: the last generator varies fastest
+        std::vector<long>& values = current->character_values;
+        for (size_t i = values.size(); i-- > 0;) {
+            if (++values[i] < current->generator_orders[i]) break;
+            values[i] = 0;
+        }
+        current->compute_conductor();
+    } while (range->primitive_only && !current->is_primitive());
+    return *this;
+}
+
 Cyclotomic DirichletCharacter::gauss_sum(long precision) const {
-    Cyclotomic sum(prime, precision);
-    Cyclotomic zeta = Cyclotomic::zeta(prime, precision);
+    PackedCyclotomic sum(prime, precision);
     
     for (long a = 1; a <= modulus; ++a) {
         if (std::gcd(a, modulus) != 1) continue;
         
-        Cyclotomic chi_a = evaluate_cyclotomic(a, precision);
+        PackedCyclotomic chi_a(evaluate_cyclotomic(a, precision));
         
-        // Compute ζ^{a * (p-1)/modulus}
-        Cyclotomic zeta_power(prime, precision, Qp(prime, precision, 1));
-        for (long j = 0; j < (a * (prime - 1)) / modulus; ++j) {
-            zeta_power = zeta_power * zeta;
-        }
+        // ζ^{a * (p-1)/modulus}
+        PackedCyclotomic zeta_power =
+            PackedCyclotomic::monomial(prime, precision, (a * (prime - 1)) / modulus);
         
-        sum = sum + chi_a * zeta_power;
+        sum.addmul(chi_a, zeta_power);
     }
     
-    return sum;
+    return sum.to_cyclotomic();
 }
 
 Qp DirichletCharacter::L_value(long s, long precision) const {
@@ -0,0 +1,194 @@
+#include "libadic/gamma_engine.h"
+#include "libadic/bernoulli.h"
+#include "libadic/cache.h"
+#include "libadic/modular_arith.h"
+#include "libadic/padic_log.h"
+#include "libadic/precision_tracker.h"
+#include <stdexcept>
+#include <utility>
+
+namespace libadic {
+
+namespace {
+
+struct EngineKeyHash {
+    size_t operator()(const std::pair<long, long>& k) const {
+        size_t h = std::hash<long>()(k.first);
+        hash_combine(h, std::hash<long>()(k.second));
+        return h;
+    }
+};
+
+using EnginePtr = std::shared_ptr<const GammaEngine>;
+
+ShardedCache<std::pair<long, long>, EnginePtr, EngineKeyHash>& engine_cache() {
+    static ShardedCache<std::pair<long, long>, EnginePtr, EngineKeyHash> cache(
+        "GammaEngine::engines",
+        [](const std::pair<long, long>& key, const EnginePtr& engine) {
+            // Coefficients carry about N digits each
+            return sizeof(key) + sizeof(GammaEngine) +
+                   (engine->degree() + 1) * (sizeof(Qp) + static_cast<size_t>(engine->get_precision()));
+        });
+    return cache;
+}
+
+/**
+ * log_Iw(u) for a unit u: log(u^{p-1}) / (p-1), or log(u^2) / 2 for p = 2
+ */
+Qp log_iwasawa_unit(const BigInt& u, long p, long W) {
+    if (p == 2) {
+        const BigInt& modulus = PadicContext::get(p, W + 1).modulus();
+        Qp log_square = PadicLog::log(Qp(p, W + 1, (u * u) % modulus));
+        if (log_square.is_zero()) {
+            return Qp(p, W, 0);
+        }
+        // v(log u^2) >= 3, so halving keeps W digits
+        return Qp::from_unit_and_valuation(p, W, log_square.get_unit().get_value(),
+                                           log_square.valuation() - 1);
+    }
+    BigInt power;
+    mpz_powm_ui(power.get_mpz(), u.get_mpz(), static_cast<unsigned long>(p - 1),
+                PadicContext::get(p, W).modulus().get_mpz());
+    return PadicLog::log(Qp(p, W, power)) * Qp::from_rational(1, p - 1, p, W);
+}
+
+} // namespace
+
+GammaEngine::GammaEngine(long p, long N)
+    : prime(p), precision(N) {
+    if (p < 2) {
+        throw std::invalid_argument("Prime must be >= 2");
+    }
+    if (N < 1) {
+        throw std::invalid_argument("Precision must be >= 1");
+    }
+
+    block = (p == 2) ? 4 : p;
+    long e = (p == 2) ? 2 : 1;  // v_p(q)
+
+    // Terms k > K have v(c_k) >= k·e - ⌊log_p k⌋ >= W. B_j costs one digit
+    // and 1/(k(k+1)) up to 2⌊log_p(K+1)⌋ more; iterate to the fixed point
+    // since K grows with W
+    long K = PrecisionTracker::series_terms(p, N, e);
+    long W = N;
+    while (true) {
+        PrecisionTracker tracker(N);
+        tracker.divide(1).series(p, K + 1).series(p, K + 1);
+        long next_K = PrecisionTracker::series_terms(p, tracker.working(), e);
+        W = tracker.working();
+        if (next_K == K) break;
+        K = next_K;
+    }
+    working = W;
+    const BigInt& modulus = PadicContext::get(p, W).modulus();
+
+    // H_k = Σ_{0<i<q, p∤i} i^{-k} for k = 1..K, and W = ∏ i
+    std::vector<BigInt> H(static_cast<size_t>(K + 1), BigInt(0));
+    BigInt window(1);
+    std::vector<BigInt> inverses;
+    for (long i = 1; i < block; ++i) {
+        if (i % p == 0) continue;
+        window = (window * BigInt(i)) % modulus;
+        inverses.emplace_back(i);
+    }
+    batch_mod_inverse(inverses, modulus);
+    BigInt power;
+    for (const BigInt& inv : inverses) {
+        power = inv;
+        for (long k = 1; k <= K; ++k) {
+            mpz_add(H[k].get_mpz(), H[k].get_mpz(), power.get_mpz());
+            mpz_mod(H[k].get_mpz(), H[k].get_mpz(), modulus.get_mpz());
+            mpz_mul(power.get_mpz(), power.get_mpz(), inv.get_mpz());
+            mpz_mod(power.get_mpz(), power.get_mpz(), modulus.get_mpz());
+        }
+    }
+
+    // Σ_k c_k S_k(Y) with c_k = (-1)^{k+1} q^k H_k / k and
+    // S_k(Y) = (1/(k+1)) Σ_{j<=k} C(k+1, j) B_j Y^{k+1-j}
+    std::vector<Qp> bern = BernoulliNumbers::bernoulli_range(K + 1, p, W);
+    poly.assign(static_cast<size_t>(K + 2), Qp(p, W, 0));
+    BigInt q_power(1);
+    for (long k = 1; k <= K; ++k) {
+        q_power *= BigInt(block);
+        Qp c(p, W, (q_power * H[k]) % modulus);
+        if (c.is_zero()) continue;
+        c *= Qp::from_rational(k % 2 == 1 ? 1 : -1, k * (k + 1), p, W);
+
+        BigInt binom(1);
+        for (long j = 0; j <= k; ++j) {
+            if (!bern[j].is_zero()) {
+                poly[k + 1 - j].addmul(c * Qp(p, W, binom), bern[j]);
+            }
+            binom = binom * BigInt(k + 1 - j) / BigInt(j + 1);
+        }
+    }
+
+    // W^Y = (-1)^Y (-W)^Y, and -W ≡ 1 (mod q)
+    poly[1] += PadicLog::log(Qp(p, W, (modulus - window) % modulus));
+}
+
+std::shared_ptr<const GammaEngine> GammaEngine::get(long p, long N) {
+    return engine_cache().get_or_compute({p, N}, [&]() {
+        return std::make_shared<const GammaEngine>(p, N);
+    });
+}
+
+Qp GammaEngine::log_gamma_parts(const Zp& x, BigInt& Y, long& x0, BigInt& partial) const {
+    if (x.get_prime() != prime) {
+        throw std::invalid_argument("Prime mismatch in GammaEngine");
+    }
+    if (!x.is_unit()) {
+        throw std::domain_error("Gamma_p is only defined for p-adic units");
+    }
+    const BigInt& X = x.get_value();
+    const BigInt& modulus = PadicContext::get(prime, working).modulus();
+
+    x0 = static_cast<long>(mpz_fdiv_ui(X.get_mpz(), static_cast<unsigned long>(block)));
+    mpz_sub_ui(Y.get_mpz(), X.get_mpz(), static_cast<unsigned long>(x0));
+    mpz_divexact_ui(Y.get_mpz(), Y.get_mpz(), static_cast<unsigned long>(block));
+
+    // ∏_{0<i<x_0, p∤i} (qY + i) = ∏ (X - x_0 + i)
+    partial = BigInt(1);
+    BigInt factor;
+    for (long i = 1; i < x0; ++i) {
+        if (i % prime == 0) continue;
+        mpz_sub_ui(factor.get_mpz(), X.get_mpz(), static_cast<unsigned long>(x0 - i));
+        mpz_mul(partial.get_mpz(), partial.get_mpz(), factor.get_mpz());
+        mpz_mod(partial.get_mpz(), partial.get_mpz(), modulus.get_mpz());
+    }
+
+    Qp y(prime, working, Y);
+    Qp acc = poly.back();
+    for (size_t m = poly.size() - 1; m-- > 0;) {
+        acc *= y;
+        acc += poly[m];
+    }
+    return acc;
+}
+
+Qp GammaEngine::log_gamma(const Zp& x) const {
+    BigInt Y, partial;
+    long x0;
+    Qp exponent = log_gamma_parts(x, Y, x0, partial);
+    Qp result = exponent + log_iwasawa_unit(partial, prime, working);
+    return result.with_precision(std::min(precision, x.get_precision()));
+}
+
+Zp GammaEngine::gamma(const Zp& x) const {
+    BigInt Y, partial;
+    long x0;
+    Qp exponent = log_gamma_parts(x, Y, x0, partial);
+    long N = std::min(precision, x.get_precision());
+
+    Qp value = PadicLog::exp(exponent) * Qp(prime, working, partial);
+    Zp result = value.get_unit().with_precision(N);
+
+    // (-1)^{x + Y} = (-1)^{x_0} for odd q, (-1)^{x_0 + Y} for q = 4
+    bool negative = (x0 % 2 == 1);
+    if (prime == 2 && mpz_odd_p(Y.get_mpz())) {
+        negative = !negative;
+    }
+    return negative ? -result : result;
+}
+
+} // namespace libadic
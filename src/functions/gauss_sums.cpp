@@ -0,0 +1,145 @@
+#include "libadic/gauss_sums.h"
+#include "libadic/cache.h"
+#include "libadic/cancellation.h"
+#include "libadic/padic_gamma.h"
+#include <stdexcept>
+#include <utility>
+
+namespace libadic {
+
+namespace {
+
+struct FractionKeyHash {
+    size_t operator()(const std::pair<long, long>& k) const {
+        size_t h = std::hash<long>()(k.first);
+        hash_combine(h, std::hash<long>()(k.second));
+        return h;
+    }
+};
+
+using FractionsPtr = std::shared_ptr<const std::vector<Zp>>;
+
+ShardedCache<std::pair<long, long>, FractionsPtr, FractionKeyHash>& fraction_cache() {
+    static ShardedCache<std::pair<long, long>, FractionsPtr, FractionKeyHash> cache(
+        "GaussSums::gamma_fractions",
+        [](const std::pair<long, long>& key, const FractionsPtr& values) {
+            return sizeof(key) + values->size() * (sizeof(Zp) + static_cast<size_t>(key.second));
+        });
+    return cache;
+}
+
+void check_modulus(const DirichletCharacter& chi) {
+    if (chi.get_modulus() != chi.get_prime()) {
+        throw std::invalid_argument("Gross-Koblitz sums need a character modulo p");
+    }
+}
+
+// J(ω^{-a}, ω^{-b}) from the Γ_p(c/(p-1)) values
+Zp jacobi_from_exponents(long p, long N, long a, long b, const std::vector<Zp>& gamma) {
+    if (a == 0 || b == 0) {
+        return Zp(p, N, a == b ? p - 2 : -1);
+    }
+    if (a + b == p - 1) {
+        return Zp(p, N, a % 2 == 0 ? -1 : 1);  // -χ1(-1), χ1(-1) = (-1)^a
+    }
+    // g(χ1) g(χ2) / g(χ1χ2) = -π^{a+b-c} Γ_a Γ_b / Γ_c, c = a + b mod (p-1),
+    // and π^{p-1} = -p
+    if (a + b < p - 1) {
+        return -(gamma[a] * gamma[b] / gamma[a + b]);
+    }
+    return Zp(p, N, p) * (gamma[a] * gamma[b] / gamma[a + b - (p - 1)]);
+}
+
+} // namespace
+
+Qp GaussSum::power_p_minus_one() const {
+    // π^{a(p-1)} = (-p)^a: the unit (-1)^a c^{p-1} is known to N digits,
+    // so the value is known to N + a
+    long N = coefficient.get_precision();
+    Zp unit = coefficient.pow(prime - 1);
+    if (exponent % 2 == 1) {
+        unit = -unit;
+    }
+    return Qp(prime, N + exponent, exponent, unit);
+}
+
+FractionsPtr GaussSums::gamma_fractions(long p, long N) {
+    return fraction_cache().get_or_compute({p, N}, [&]() {
+        std::vector<Zp> values(static_cast<size_t>(p - 1), Zp(p, N, 1));
+        Zp denominator(p, N, p - 1);
+        for (long a = 1; a < p - 1; ++a) {
+            cancellation_point();
+            long b = p - 1 - a;
+            if (b < a) {
+                // Γ_p(x) Γ_p(1-x) = (-1)^{a_0} with a_0 ≡ x = a/(p-1) ≡ -a (mod p),
+                // so a_0 = p - a and 1 - x = b/(p-1)
+                Zp sign(p, N, (p - a) % 2 == 0 ? 1 : -1);
+                values[a] = sign / values[b];
+            } else {
+                values[a] = PadicGamma::gamma(Zp(p, N, a) / denominator);
+            }
+        }
+        return std::make_shared<const std::vector<Zp>>(std::move(values));
+    });
+}
+
+long GaussSums::teichmuller_exponent(const DirichletCharacter& chi) {
+    check_modulus(chi);
+    long p = chi.get_prime();
+    return (p - 1 - chi.index() % (p - 1)) % (p - 1);
+}
+
+GaussSum GaussSums::gauss_sum(const DirichletCharacter& chi, long N) {
+    long p = chi.get_prime();
+    long a = teichmuller_exponent(chi);
+    return GaussSum{p, a, -(*gamma_fractions(p, N))[a]};
+}
+
+std::vector<GaussSum> GaussSums::gauss_sums(long p, long N) {
+    FractionsPtr gamma = gamma_fractions(p, N);
+    std::vector<GaussSum> sums;
+    sums.reserve(static_cast<size_t>(p - 1));
+    for (long k = 0; k < p - 1; ++k) {
+        long a = (p - 1 - k) % (p - 1);
+        sums.push_back(GaussSum{p, a, -(*gamma)[a]});
+    }
+    return sums;
+}
+
+Cyclotomic GaussSums::gauss_sum_cyclotomic(const DirichletCharacter& chi, long N) {
+    check_modulus(chi);
+    long p = chi.get_prime();
+
+    // Σ_{x=1}^{p-1} χ(x) ζ^x with ζ^{p-1} = -(1 + ζ + ... + ζ^{p-2})
+    Qp top(chi.evaluate(p - 1, N));
+    std::vector<Qp> coeffs(static_cast<size_t>(p - 1));
+    coeffs[0] = -top;
+    for (long x = 1; x < p - 1; ++x) {
+        coeffs[x] = Qp(chi.evaluate(x, N)) - top;
+    }
+    return Cyclotomic(p, N, coeffs);
+}
+
+Zp GaussSums::jacobi_sum(const DirichletCharacter& chi1, const DirichletCharacter& chi2, long N) {
+    check_modulus(chi2);
+    if (chi1.get_prime() != chi2.get_prime()) {
+        throw std::invalid_argument("Jacobi sum of characters for different primes");
+    }
+    long p = chi1.get_prime();
+    return jacobi_from_exponents(p, N, teichmuller_exponent(chi1), teichmuller_exponent(chi2),
+                                 *gamma_fractions(p, N));
+}
+
+std::vector<Zp> GaussSums::jacobi_sums(const DirichletCharacter& chi, long N) {
+    long p = chi.get_prime();
+    long a = teichmuller_exponent(chi);
+    FractionsPtr gamma = gamma_fractions(p, N);
+    std::vector<Zp> sums;
+    sums.reserve(static_cast<size_t>(p - 1));
+    for (long k = 0; k < p - 1; ++k) {
+        sums.push_back(jacobi_from_exponents(p, N, a, (p - 1 - k) % (p - 1), *gamma));
+    }
+    return sums;
+}
+
+} // namespace libadic
@@ -0,0 +1,321 @@
+#include "libadic/iwasawa_series.h"
+#include "libadic/cache.h"
+#include "libadic/bernoulli.h"
+#include "libadic/padic_log.h"
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+namespace libadic {
+
+namespace {
+
+using SeriesKey = std::tuple<long, long, long, long>;  // p, modulus, χ.index(), N
+
+struct SeriesKeyHash {
+    size_t operator()(const SeriesKey& k) const {
+        size_t h = std::hash<long>()(std::get<0>(k));
+        hash_combine(h, std::hash<long>()(std::get<1>(k)));
+        hash_combine(h, std::hash<long>()(std::get<2>(k)));
+        hash_combine(h, std::hash<long>()(std::get<3>(k)));
+        return h;
+    }
+};
+
+using SeriesPtr = std::shared_ptr<const IwasawaSeries>;
+
+ShardedCache<SeriesKey, SeriesPtr, SeriesKeyHash>& series_cache() {
+    static ShardedCache<SeriesKey, SeriesPtr, SeriesKeyHash> cache(
+        "IwasawaSeries::series",
+        [](const SeriesKey& key, const SeriesPtr& series) {
+            return sizeof(key) + sizeof(IwasawaSeries) + cache_footprint(series->coefficients());
+        });
+    return cache;
+}
+
+long factorial_valuation(long n, long p) {
+    long v = 0;
+    for (long q = p; q <= n; q *= p) {
+        v += n / q;
+        if (q > n / p) break;
+    }
+    return v;
+}
+
+// Truncated power series in h: a[0] + a[1] h + ... + a[k] h^k
+std::vector<Qp> series_mul(const std::vector<Qp>& a, const std::vector<Qp>& b, size_t k, long p, long N) {
+    std::vector<Qp> c(k + 1, Qp(p, N, 0));
+    for (size_t i = 0; i < a.size() && i <= k; ++i) {
+        for (size_t j = 0; j < b.size() && i + j <= k; ++j) {
+            c[i + j].addmul(a[i], b[j]);
+        }
+    }
+    return c;
+}
+
+/**
+ * L_p(1-n, χω) = -B_{n,χ}/n for each n in `ns`, with χ(a) the Teichmüller
+ * values used at s = 0. From B_{n,χ} = p^{n-1} Σ_a χ(a) B_n(a/p),
+ *
+ *   B_{n,χ} = Σ_k C(n,k) B_k p^{k-1} S_{n-k},   S_j = Σ_{a=1}^{p-1} χ(a) a^j,
+ *
+ * and v(B_k p^{k-1}) >= k - 2, so only k <= k_max = W + 2 (plus guard
+ * digits) contribute mod p^W. Node n therefore reads S_j only for
+ * n - min(n, k_max) <= j <= n, and the power sums are built for those j
+ * alone, in runs of consecutive indices: O(p · J) Zp multiplications for J
+ * indices used, plus a powering per run and residue. With the nodes
+ * n = 1 + (p-1) i the windows overlap whenever p - 1 <= k_max, and then
+ * J = n_max + 1. Each node then costs O(min(n, k_max)) Qp operations.
+ */
+std::vector<Qp> node_values(const DirichletCharacter& chi, const std::vector<long>& ns, long W) {
+    long p = chi.get_prime();
+    long n_max = *std::max_element(ns.begin(), ns.end());
+    long guard = 3;
+    for (long q = p; q <= n_max; q *= p) {
+        ++guard;  // room for dividing by n
+    }
+    long Wn = W + guard;
+    long k_max = std::min(n_max, Wn + 2);
+
+    // Runs [first, last] of the indices n - k the nodes read
+    std::vector<char> used(static_cast<size_t>(n_max) + 1, 0);
+    for (long n : ns) {
+        std::fill(used.begin() + (n - std::min(n, k_max)), used.begin() + n + 1, 1);
+    }
+    std::vector<std::pair<long, long>> runs;
+    for (long j = 0; j <= n_max; ++j) {
+        if (!used[j]) continue;
+        long first = j;
+        while (j < n_max && used[j + 1]) ++j;
+        runs.emplace_back(first, j);
+    }
+
+    std::vector<Zp> sums(static_cast<size_t>(n_max) + 1, Zp(p, Wn, 0));
+    for (long a = 1; a < p; ++a) {
+        Zp chi_a = chi.evaluate(a, Wn);
+        Zp base(p, Wn, a);
+        for (const auto& run : runs) {
+            Zp term = chi_a * base.pow(run.first);
+            for (long j = run.first; j <= run.second; ++j) {
+                sums[j] += term;
+                term *= base;
+            }
+        }
+    }
+
+    std::vector<Qp> bernoulli = BernoulliNumbers::bernoulli_range(k_max, p, Wn);
+    std::vector<Qp> values;
+    values.reserve(ns.size());
+    for (long n : ns) {
+        Qp B(p, Wn, 0);
+        BigInt binomial(1);
+        for (long k = 0; k <= std::min(n, k_max); ++k) {
+            if (k > 0) {
+                binomial = binomial * BigInt(n - k + 1) / BigInt(k);
+            }
+            const Qp& b_k = bernoulli[k];
+            if (!b_k.is_zero()) {
+                Qp scale = Qp(p, Wn, binomial) * Qp::from_unit_and_valuation(p, Wn, BigInt(1), k - 1);
+                B.addmul(b_k * scale, Qp(sums[n - k]));
+            }
+        }
+        values.push_back((-B / Qp(p, Wn, n)).with_precision(W));
+    }
+    return values;
+}
+
+} // namespace
+
+IwasawaSeries::IwasawaSeries(const DirichletCharacter& chi, long N, long terms)
+    : prime(chi.get_prime()), precision(N), modulus(chi.get_modulus()),
+      character_index(chi.index()), pole(false) {
+    long p = prime;
+    if (p < 3) {
+        throw std::invalid_argument("IwasawaSeries requires an odd prime");
+    }
+    if (N < 1) {
+        throw std::invalid_argument("Precision must be >= 1");
+    }
+    if (modulus != p || chi.is_principal()) {
+        throw std::invalid_argument("IwasawaSeries requires a non-principal character mod p");
+    }
+    if (terms <= 0) {
+        terms = N;
+    }
+
+    // χ(g) = ω(g)^k; χω is trivial for k = p - 2
+    pole = chi.character_values[0] == p - 2;
+
+    // Coefficient m of the degree M-1 interpolant differs from g_m by
+    // O(p^{M-m}), and level k of the difference table divides by
+    // T_i - T_{i-k} of valuation 1 + v(k)
+    long M = N + terms;
+    long W = N + M + factorial_valuation(M, p) + 2;
+
+    Qp u(p, W, 1 + p);
+    Qp step = Qp(p, W, 1) / u.pow(p - 1);  // u^{-(p-1)}
+    std::vector<Zp> nodes;
+    std::vector<Zp> table;
+    nodes.reserve(static_cast<size_t>(M));
+    table.reserve(static_cast<size_t>(M));
+    std::vector<long> ns;
+    for (long i = 0; i < M; ++i) {
+        ns.push_back(1 + (p - 1) * i);
+    }
+    std::vector<Qp> values = node_values(chi, ns, W);
+
+    Qp power(p, W, 1);
+    for (long i = 0; i < M; ++i) {
+        Qp T = power - Qp(p, W, 1);
+        Qp value = values[i];
+        if (pole) {
+            value *= T - Qp(p, W, p);
+        }
+        nodes.push_back(T.to_zp());
+        table.push_back(value.to_zp());
+        power *= step;
+    }
+
+    // Newton divided differences in place: table[k] = G[T_0, ..., T_k]
+    BigInt prime_big(p);
+    for (long k = 1; k < M; ++k) {
+        for (long i = M - 1; i >= k; --i) {
+            Zp numerator = table[i] - table[i - 1];
+            Zp gap = nodes[i] - nodes[i - k];
+            long v = gap.valuation();
+            long prec = numerator.get_precision() - v;
+            if (prec < 1) {
+                throw std::runtime_error("IwasawaSeries: working precision exhausted");
+            }
+            BigInt scaled = numerator.get_value() / prime_big.pow(v);
+            Zp unit = gap.unit_part().with_precision(prec);
+            table[i] = Zp(p, prec, scaled) / unit;
+        }
+    }
+
+    // Expand Σ_k d_k Π_{i<k} (T - T_i) into powers of T by Horner's scheme
+    std::vector<Zp> poly{table[M - 1]};
+    for (long k = M - 2; k >= 0; --k) {
+        std::vector<Zp> next(poly.size() + 1, Zp(p, table[k].get_precision(), 0));
+        for (size_t j = 0; j < poly.size(); ++j) {
+            next[j + 1] += poly[j];
+            next[j] -= poly[j] * nodes[k];
+        }
+        next[0] += table[k];
+        poly = std::move(next);
+    }
+
+    coeffs.reserve(static_cast<size_t>(terms));
+    for (long m = 0; m < terms; ++m) {
+        coeffs.emplace_back(poly[m].with_precision(std::min(N, poly[m].get_precision())));
+    }
+    log_u = PadicLog::log(Qp(p, N, 1 + p));
+}
+
+std::shared_ptr<const IwasawaSeries> IwasawaSeries::get(const DirichletCharacter& chi, long N) {
+    SeriesKey key{chi.get_prime(), chi.get_modulus(), chi.index(), N};
+    return series_cache().get_or_compute(key, [&]() {
+        return std::make_shared<const IwasawaSeries>(chi, N);
+    });
+}
+
+Qp IwasawaSeries::t_of(const Zp& s) const {
+    if (s.get_prime() != prime) {
+        throw std::invalid_argument("Prime mismatch in IwasawaSeries");
+    }
+    Qp exponent = Qp(s.with_precision(std::min(precision, s.get_precision()))) * log_u;
+    return PadicLog::exp(exponent.with_precision(precision)) - Qp(prime, precision, 1);
+}
+
+Qp IwasawaSeries::evaluate_T(const Qp& T) const {
+    if (T.get_prime() != prime) {
+        throw std::invalid_argument("Prime mismatch in IwasawaSeries");
+    }
+    if (!T.is_zero() && T.valuation() < 1) {
+        throw std::domain_error("IwasawaSeries: T must have positive valuation");
+    }
+    Qp result(prime, precision, 0);
+    for (size_t m = coeffs.size(); m-- > 0;) {
+        result *= T;
+        result += coeffs[m];
+    }
+    if (pole) {
+        Qp denominator = T - Qp(prime, precision, prime);
+        if (denominator.is_zero()) {
+            throw std::domain_error("L_p(s, χ) has a pole at s = 1");
+        }
+        result = result / denominator;
+    }
+    return result;
+}
+
+Qp IwasawaSeries::evaluate(const Zp& s) const {
+    return evaluate_T(t_of(s));
+}
+
+Qp IwasawaSeries::evaluate(long s) const {
+    return evaluate(Zp(prime, precision, s));
+}
+
+Qp IwasawaSeries::derivative(const Zp& s, long order) const {
+    if (order < 0) {
+        throw std::invalid_argument("Derivative order must be >= 0");
+    }
+    if (order == 0) {
+        return evaluate(s);
+    }
+    size_t k = static_cast<size_t>(order);
+    long p = prime;
+    long N = precision;
+    Qp T = t_of(s);
+
+    // δ(h) = (1 + T)(e^{h log u} - 1), a series in h with δ(0) = 0
+    std::vector<Qp> delta(k + 1, Qp(p, N, 0));
+    Qp one_plus_T = T + Qp(p, N, 1);
+    Qp term(p, N, 1);
+    for (size_t j = 1; j <= k; ++j) {
+        term = term * log_u / Qp(p, N, static_cast<long>(j));
+        delta[j] = one_plus_T * term;
+    }
+
+    // Σ_m g_m (T + δ)^m by Horner's scheme in truncated series
+    std::vector<Qp> shifted = delta;
+    shifted[0] = T;
+    std::vector<Qp> value(k + 1, Qp(p, N, 0));
+    for (size_t m = coeffs.size(); m-- > 0;) {
+        value = series_mul(value, shifted, k, p, N);
+        value[0] += coeffs[m];
+    }
+
+    if (pole) {
+        // Divide by T - p + δ(h): q_0 = 1/c, q_j = -(Σ_{i=1..j} δ_i q_{j-i}) / c
+        Qp c = T - Qp(p, N, p);
+        if (c.is_zero()) {
+            throw std::domain_error("L_p(s, χ) has a pole at s = 1");
+        }
+        std::vector<Qp> inverse(k + 1, Qp(p, N, 0));
+        inverse[0] = Qp(p, N, 1) / c;
+        for (size_t j = 1; j <= k; ++j) {
+            Qp acc(p, N, 0);
+            for (size_t i = 1; i <= j; ++i) {
+                acc.addmul(delta[i], inverse[j - i]);
+            }
+            inverse[j] = -acc / c;
+        }
+        value = series_mul(value, inverse, k, p, N);
+    }
+
+    // The h^k coefficient is f^{(k)}(s) / k!
+    Qp factorial(p, N, 1);
+    for (size_t j = 2; j <= k; ++j) {
+        factorial *= Qp(p, N, static_cast<long>(j));
+    }
+    return value[k] * factorial;
+}
+
+Qp IwasawaSeries::derivative(long s, long order) const {
+    return derivative(Zp(prime, precision, s), order);
+}
+
+} // namespace libadic
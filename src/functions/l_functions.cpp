@@ -1,48 +1,41 @@
 #include "libadic/l_functions.h"
+#include "libadic/cancellation.h"
+#include "libadic/qp_expr.h"
 #include "libadic/padic_gamma.h"
+#include "libadic/log_gamma_table.h"
+#include "libadic/log_gamma_mahler.h"
+#include "libadic/character_sums.h"
+#include "libadic/stats.h"
+#include "libadic/teichmuller_table.h"
+#include "libadic/thread_pool.h"
 #include <cmath>
 #include <algorithm>
+#include <type_traits>
 
 namespace libadic {
 
 // Static member definitions
-std::map<LFunctions::LKey, Qp> LFunctions::l_cache;
-std::map<LFunctions::LKey, Qp> LFunctions::l_derivative_cache;
-std::map<std::pair<long, long>, std::vector<Qp>> LFunctions::mahler_cache;
-
-static std::string fingerprint_character(const DirichletCharacter& chi) {
-    // Build a deterministic fingerprint from modulus, generators, orders, and values
-    std::string fp;
-    fp.reserve(128);
-    fp += std::to_string(chi.get_modulus());
-    fp += "|g:";
-    for (size_t i = 0; i < chi.generators.size(); ++i) {
-        fp += std::to_string(chi.generators[i]);
-        fp += ",";
-    }
-    fp += "|o:";
-    for (size_t i = 0; i < chi.generator_orders.size(); ++i) {
-        fp += std::to_string(chi.generator_orders[i]);
-        fp += ",";
-    }
-    fp += "|v:";
-    for (size_t i = 0; i < chi.character_values.size(); ++i) {
-        fp += std::to_string(chi.character_values[i]);
-        fp += ",";
-    }
-    return fp;
-}
+PrecisionCache<LFunctions::LKey, LFunctions::LKeyHash>
+    LFunctions::l_cache("LFunctions::l_cache", [](const LKey& key) { return sizeof(key); });
+PrecisionCache<LFunctions::LKey, LFunctions::LKeyHash>
+    LFunctions::l_derivative_cache("LFunctions::l_derivative_cache", [](const LKey& key) { return sizeof(key); });
 
 Qp LFunctions::kubota_leopoldt(long s, const DirichletCharacter& chi, long precision) {
+    stats::Scope scope(stats::Id::kubota_leopoldt);
     long p = chi.get_prime();
     long conductor = chi.get_conductor();
     long modulus = chi.get_modulus();
-    std::string fp = fingerprint_character(chi);
+    long index = chi.index();
     
     // Create cache key
-    LKey key{s, p, precision, modulus, conductor, fp};
-    if (l_cache.find(key) != l_cache.end()) {
-        return l_cache[key];
+    LKey key{s, p, modulus, index};
+    if (auto cached = l_cache.find(key, precision)) {
+        return *cached;
+    }
+    ResultStore::Key stored{ResultStore::Table::LValue, {s, p, modulus, index}, ""};
+    if (auto warm = ResultStore::instance().find(stored, precision)) {
+        l_cache.insert(key, precision, (*warm)[0]);
+        return (*warm)[0];
     }
     
     Qp result(p, precision, 0);
@@ -56,7 +49,7 @@ Qp LFunctions::kubota_leopoldt(long s, const DirichletCharacter& chi, long preci
         // Compute Euler factor (1 - χ(p)p^{-1})
         Qp euler_factor = compute_euler_factor(chi, 1, precision);
         
-        result = -euler_factor * B1_chi;
+        result = -(defer(euler_factor) * B1_chi);
         
     } else if (s < 0) {
         // For s = 1-n where n > 1
@@ -73,16 +66,17 @@ Qp LFunctions::kubota_leopoldt(long s, const DirichletCharacter& chi, long preci
             result = Qp(p, precision, 0);
         } else {
             // Compute generalized Bernoulli number
-            auto chi_func = [&chi, precision](long a) -> Cyclotomic {
-                return chi.evaluate_cyclotomic(a, precision);
+            auto chi_func = [&chi, precision](long a) -> Zp {
+                return chi.evaluate(a, precision);
             };
             
-            Qp Bn_chi = BernoulliNumbers::generalized_bernoulli(n, conductor, chi_func, p, precision);
+            Qp Bn_chi = BernoulliNumbers::generalized_bernoulli(n, conductor, chi_func, p, precision,
+                                                                  modulus, index);
             
             // Compute Euler factor
             Qp euler_factor = compute_euler_factor(chi, n, precision);
             
-            result = -euler_factor * Bn_chi / Qp(p, precision, n);
+            result = Qp(-(defer(euler_factor) * Bn_chi)) / Qp(p, precision, n);
         }
         
     } else if (s > 0) {
@@ -90,19 +84,24 @@ Qp LFunctions::kubota_leopoldt(long s, const DirichletCharacter& chi, long preci
         throw std::invalid_argument("kubota_leopoldt(s>0) is not supported in this implementation");
     }
     
-    l_cache[key] = result;
+    l_cache.insert(key, precision, result);
     return result;
 }
 
 Qp LFunctions::kubota_leopoldt_derivative(long s, const DirichletCharacter& chi, long precision) {
+    stats::Scope scope(stats::Id::kubota_leopoldt_derivative);
     long p = chi.get_prime();
-    long conductor = chi.get_conductor();
     long modulus = chi.get_modulus();
-    std::string fp = fingerprint_character(chi);
+    long index = chi.index();
     
-    LKey key{s, p, precision, modulus, conductor, fp};
-    if (l_derivative_cache.find(key) != l_derivative_cache.end()) {
-        return l_derivative_cache[key];
+    LKey key{s, p, modulus, index};
+    if (auto cached = l_derivative_cache.find(key, precision)) {
+        return *cached;
+    }
+    ResultStore::Key stored{ResultStore::Table::LDerivative, {s, p, modulus, index}, ""};
+    if (auto warm = ResultStore::instance().find(stored, precision)) {
+        l_derivative_cache.insert(key, precision, (*warm)[0]);
+        return (*warm)[0];
     }
     
     Qp result(p, precision, 0);
@@ -128,7 +127,7 @@ Qp LFunctions::kubota_leopoldt_derivative(long s, const DirichletCharacter& chi,
         result = (f_plus - f_minus) / (Qp(p, precision, 2) * h);
     }
     
-    l_derivative_cache[key] = result;
+    l_derivative_cache.insert(key, precision, result);
     return result;
 }
 
@@ -141,16 +140,32 @@ Qp LFunctions::compute_B1_chi(const DirichletCharacter& chi, long precision) {
         return Qp::from_rational(-1, 2, p, precision);
     }
     
-    Qp sum(p, precision, 0);
-    
-    // B_{1,χ} = (1/conductor) * Σ_{a=1}^{conductor} χ(a) * a
-    for (long a = 1; a <= conductor; ++a) {
-        if (std::gcd(a, conductor) != 1) continue;
-        
-        Zp chi_a = chi.evaluate(a, precision);
-        Qp term = Qp(chi_a) * Qp(p, precision, a);
-        sum += term;
-    }
+    // B_{1,χ} = (1/conductor) * Σ_{a=1}^{conductor} χ(a) * a; the sum is an
+    // integer mod p^N, accumulated in machine words when p^N fits
+    Qp sum = dispatch_zp_backend(PadicContext::get(p, precision),
+        [&](const auto& be) {
+            using word = typename std::decay_t<decltype(be)>::word;
+            auto teichmuller = TeichmullerTable::get(p, precision);
+            word acc = 0;
+            for (long a = 1; a <= conductor; ++a) {
+                if (std::gcd(a, conductor) != 1) continue;
+                long chi_a = chi.evaluate_at(a);
+                if (chi_a == -1) continue;
+                word omega = be.to_mont(static_cast<word>(u128_from_bigint(teichmuller->at(chi_a))));
+                acc = be.add(acc, be.mul(omega, be.to_mont(static_cast<word>(a))));
+            }
+            return Qp(p, precision, bigint_from_u128(be.from_mont(acc)));
+        },
+        [&]() {
+            Qp total(p, precision, 0);
+            for (long a = 1; a <= conductor; ++a) {
+                if (std::gcd(a, conductor) != 1) continue;
+                
+                Zp chi_a = chi.evaluate(a, precision);
+                total.addmul(Qp(chi_a), Qp(p, precision, a));
+            }
+            return total;
+        });
     
     return sum / Qp(p, precision, conductor);
 }
@@ -199,18 +214,17 @@ Qp LFunctions::compute_derivative_at_zero_odd(const DirichletCharacter& chi, lon
     if (conductor == p && chi.is_primitive()) {
         Qp sum(p, precision, 0);
         
+        // log Γ_p(a) (Iwasawa branch) is shared by every character mod p,
+        // so read it from the per-(p, N) table rather than recomputing it
+        auto log_gamma = LogGammaTable::get(p, precision);
+        
         // Sum over a = 1, ..., p-1
         for (long a = 1; a < p; ++a) {
+            cancellation_point();
             Zp chi_a = chi.evaluate(a, precision);
             
             if (!chi_a.is_zero()) {
-                // Create Zp for a
-                Zp a_zp(p, precision, a);
-                
-                // Use PadicGamma::log_gamma which internally handles Iwasawa logarithm
-                // This correctly handles roots of unity and all edge cases
-                Qp log_gamma = PadicGamma::log_gamma(a_zp);
-                sum = sum + Qp(chi_a) * log_gamma;
+                sum.addmul(Qp(chi_a), (*log_gamma)[a]);
             }
         }
         
@@ -222,11 +236,12 @@ Qp LFunctions::compute_derivative_at_zero_odd(const DirichletCharacter& chi, lon
     
     for (long a = 1; a < conductor; ++a) {
         if (std::gcd(a, conductor) != 1) continue;
+        cancellation_point();
         
         Zp chi_a = chi.evaluate(a, precision);
         if (!chi_a.is_zero()) {
             Qp log_gamma_term = compute_log_gamma_fractional(a, conductor, p, precision);
-            sum += Qp(chi_a) * log_gamma_term;
+            sum.addmul(Qp(chi_a), log_gamma_term);
         }
     }
     
@@ -245,18 +260,104 @@ Qp LFunctions::compute_derivative_at_zero_even(const DirichletCharacter& chi, lo
     
     for (long a = 1; a < conductor; ++a) {
         if (std::gcd(a, conductor) != 1) continue;
+        cancellation_point();
         
         Zp chi_a = chi.evaluate(a, precision);
         if (!chi_a.is_zero()) {
             // Compute contribution
             Qp log_term = log_p(Qp::from_rational(a, conductor - 1, p, precision));
-            sum += Qp(chi_a) * log_term;
+            sum.addmul(Qp(chi_a), log_term);
         }
     }
     
     return sum;
 }
 
+std::vector<Qp> LFunctions::compute_B1_chi_all(long p, long precision) {
+    auto batch = CharacterSumBatch::get(p, precision);
+    std::vector<Qp> sums = batch->sum([p, precision](long a) { return Qp(p, precision, a); });
+    
+    // Every non-principal character mod p has conductor p
+    Qp conductor(p, precision, p);
+    for (auto& s : sums) {
+        s /= conductor;
+    }
+    sums[0] = Qp::from_rational(-1, 2, p, precision);
+    return sums;
+}
+
+std::vector<Qp> LFunctions::compute_derivative_at_zero_odd_all(long p, long precision) {
+    auto batch = CharacterSumBatch::get(p, precision);
+    auto log_gamma = LogGammaTable::get(p, precision);
+    std::vector<Qp> values(static_cast<size_t>(p), Qp(p, precision, 0));
+    for (long a = 1; a < p; ++a) {
+        values[a] = (*log_gamma)[a];
+    }
+    return batch->sum(values);
+}
+
+std::vector<Qp> LFunctions::compute_B1_chi_orbit(const DirichletCharacter& chi, long precision) {
+    long p = chi.get_prime();
+    if (chi.is_principal()) {
+        return {Qp::from_rational(-1, 2, p, precision)};
+    }
+    auto batch = CharacterSumBatch::get(p, precision);
+    std::vector<Qp> identity(static_cast<size_t>(p), Qp(p, precision, 0));
+    for (long a = 1; a < p; ++a) {
+        identity[a] = Qp(p, precision, a);
+    }
+    std::vector<Qp> sums = batch->orbit_sum(chi, identity);
+    Qp conductor(p, precision, p);
+    for (auto& s : sums) {
+        s /= conductor;
+    }
+    return sums;
+}
+
+std::vector<Qp> LFunctions::compute_derivative_at_zero_odd_orbit(const DirichletCharacter& chi, long precision) {
+    long p = chi.get_prime();
+    auto batch = CharacterSumBatch::get(p, precision);
+    auto log_gamma = LogGammaTable::get(p, precision);
+    std::vector<Qp> values(static_cast<size_t>(p), Qp(p, precision, 0));
+    for (long a = 1; a < p; ++a) {
+        values[a] = (*log_gamma)[a];
+    }
+    return batch->orbit_sum(chi, values);
+}
+
+std::vector<Qp> LFunctions::kubota_leopoldt_derivative_all(long p, long precision, size_t threads,
+                                                           std::vector<std::string>* errors) {
+    std::vector<Qp> values = compute_derivative_at_zero_odd_all(p, precision);
+    std::vector<DirichletCharacter> characters = DirichletCharacter::enumerate_characters(p, p);
+    std::vector<std::string> messages(values.size());
+
+    // χ_k is odd exactly for odd k; the even ones go one per task
+    auto fill = [&](size_t k) {
+        try {
+            values[k] = kubota_leopoldt_derivative(0, characters[k], precision);
+        } catch (const std::exception& e) {
+            values[k] = Qp(p, precision, 0);
+            messages[k] = e.what();
+        }
+    };
+    if (threads == 1) {
+        for (size_t k = 0; k < values.size(); k += 2) {
+            fill(k);
+        }
+    } else {
+        ThreadPool pool(threads);
+        for (size_t k = 0; k < values.size(); k += 2) {
+            pool.submit([&fill, k]() { fill(k); });
+        }
+        pool.wait_idle();
+    }
+
+    if (errors) {
+        *errors = std::move(messages);
+    }
+    return values;
+}
+
 Qp LFunctions::compute_log_gamma_fractional(long numerator, long denominator, 
                                           long p, long precision) {
     if (denominator == 1) {
@@ -296,8 +397,9 @@ Qp LFunctions::compute_log_gamma_fractional(long numerator, long denominator,
         // This is a simplified but mathematically rigorous approach
         
         // Add p-adic corrections
+        std::vector<Qp> bern = BernoulliNumbers::bernoulli_range(2 * (precision / 2), p, precision);
         for (long k = 1; k <= precision / 2; ++k) {
-            Qp B_2k = BernoulliNumbers::bernoulli(2*k, p, precision);
+            const Qp& B_2k = bern[2 * k];
             Qp term = B_2k / Qp(p, precision, 2*k);
             
             // Compute (a/p)^{2k}
@@ -306,7 +408,7 @@ Qp LFunctions::compute_log_gamma_fractional(long numerator, long denominator,
                 x_power = x_power * Qp::from_rational(numerator, p, p, precision);
             }
             
-            result = result + term * x_power;
+            result.addmul(term, x_power);
             
             if (term.valuation() > precision + 5) break;
         }
@@ -314,6 +416,11 @@ Qp LFunctions::compute_log_gamma_fractional(long numerator, long denominator,
         return result;
     }
     
+    // a/f ∈ Z_p^× when p ∤ a f: evaluate Γ_p exactly instead of a padded series
+    if (denominator % p != 0 && numerator % p != 0) {
+        return PadicGamma::log_gamma(Zp::from_rational(numerator, denominator, p, precision));
+    }
+    
     // General case: use Mahler expansion
     Qp x = Qp::from_rational(numerator, denominator, p, precision);
     
@@ -337,11 +444,12 @@ Qp LFunctions::compute_log_gamma_fractional(long numerator, long denominator,
     Qp result = -gamma_p * x_frac;
     
     // Add series terms
+    std::vector<Qp> bern = BernoulliNumbers::bernoulli_range(precision + 10, p, precision);
     for (long n = 2; n <= precision + 10; ++n) {
         // Compute p-adic zeta value ζ_p(n)
         // For now, use Bernoulli numbers: ζ_p(2k) = -B_{2k}/(2k)
         if (n % 2 == 0) {
-            Qp B_n = BernoulliNumbers::bernoulli(n, p, precision);
+            const Qp& B_n = bern[n];
             Qp zeta_n = -B_n * Qp(p, precision, 2) / Qp(p, precision, n);
             
             // Compute x^n
@@ -483,58 +591,40 @@ Qp LFunctions::compute_euler_maclaurin_correction(long n, long p, long precision
 }
 
 std::vector<Qp> LFunctions::compute_mahler_coefficients(long p, long precision) {
-    // Compute Mahler coefficients for log Γ_p
-    // These are the coefficients in the expansion:
-    // log Γ_p(x) = Σ a_n * (x choose n)_p
-    
-    std::vector<Qp> coeffs;
-    coeffs.reserve(precision * 2);
-    
-    // The Mahler coefficients can be computed from:
-    // a_n = Δ^n[log Γ_p](0)
-    // where Δ is the forward difference operator
-    
-    // First coefficient a_0 = log Γ_p(0) = 0 for our normalization
-    coeffs.push_back(Qp(p, precision, 0));
-    
-    // Compute subsequent coefficients using finite differences
-    std::vector<Qp> gamma_values;
-    for (long k = 0; k <= precision * 2; ++k) {
-        if (k % p != 0) {
-            Zp z_k(p, precision, k);
-            gamma_values.push_back(PadicGamma::log_gamma(z_k));
-        } else {
-            gamma_values.push_back(Qp(p, precision, 0));  // log Γ_p(kp) = 0
-        }
-    }
-    
-    // Compute finite differences
-    std::vector<Qp> current_diffs = gamma_values;
-    
-    for (long n = 1; n < precision * 2; ++n) {
-        std::vector<Qp> next_diffs;
-        for (size_t i = 0; i < current_diffs.size() - 1; ++i) {
-            next_diffs.push_back(current_diffs[i + 1] - current_diffs[i]);
-        }
-        
-        if (!next_diffs.empty()) {
-            coeffs.push_back(next_diffs[0]);
-            current_diffs = next_diffs;
-        }
-        
-        // Check if we have enough precision
-        if (n > 10 && coeffs.back().valuation() > precision) {
-            break;
-        }
-    }
-    
-    return coeffs;
+    // log Γ_p(x) = Σ a_n * (x choose n)_p with a_n = Δ^n[log Γ_p](0); the
+    // shared series extends its difference diagonal in place
+    auto series = LogGammaMahlerSeries::get(p, precision);
+    return series->coefficients(series->required_terms());
 }
 
 void LFunctions::clear_cache() {
     l_cache.clear();
     l_derivative_cache.clear();
-    mahler_cache.clear();
+}
+
+void LFunctions::set_cache_budget(size_t bytes) {
+    CacheRegistry::instance().set_total_budget(bytes);
+}
+
+std::vector<CacheStats> LFunctions::cache_stats() {
+    return CacheRegistry::instance().stats();
+}
+
+void LFunctions::save_cache(const std::string& path) {
+    ResultStore& store = ResultStore::instance();
+    auto export_l = [&store](ResultStore::Table table) {
+        return [&store, table](const LKey& key, long precision, const Qp& value) {
+            store.insert({table, {key.s, key.p, key.modulus, key.character}, ""}, precision, {value});
+        };
+    };
+    l_cache.for_each(export_l(ResultStore::Table::LValue));
+    l_derivative_cache.for_each(export_l(ResultStore::Table::LDerivative));
+    BernoulliNumbers::export_cache(store);
+    store.save(path);
+}
+
+size_t LFunctions::load_cache(const std::string& path) {
+    return ResultStore::instance().load(path);
 }
 
 } // namespace libadic
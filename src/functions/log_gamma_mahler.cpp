@@ -0,0 +1,173 @@
+#include "libadic/log_gamma_mahler.h"
+#include "libadic/cache.h"
+#include "libadic/inverse_table.h"
+#include "libadic/padic_gamma.h"
+#include "libadic/padic_log.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace libadic {
+
+namespace {
+
+struct SeriesKeyHash {
+    size_t operator()(const std::pair<long, long>& k) const {
+        size_t h = std::hash<long>()(k.first);
+        hash_combine(h, std::hash<long>()(k.second));
+        return h;
+    }
+};
+
+using SeriesPtr = std::shared_ptr<const LogGammaMahlerSeries>;
+
+ShardedCache<std::pair<long, long>, SeriesPtr, SeriesKeyHash>& series_cache() {
+    static ShardedCache<std::pair<long, long>, SeriesPtr, SeriesKeyHash> cache(
+        "LogGammaMahlerSeries::series",
+        [](const std::pair<long, long>& key, const SeriesPtr& series) {
+            // Two vectors of required_terms() values each
+            return sizeof(key) + sizeof(LogGammaMahlerSeries) +
+                   2 * cache_footprint(series->coefficients(series->required_terms()));
+        });
+    return cache;
+}
+
+} // namespace
+
+LogGammaMahlerSeries::LogGammaMahlerSeries(long p, long N)
+    : prime(p), precision(N), gamma(1) {
+    if (p < 2) {
+        throw std::invalid_argument("Prime must be >= 2");
+    }
+    if (N < 1) {
+        throw std::invalid_argument("Precision must be >= 1");
+    }
+}
+
+std::shared_ptr<const LogGammaMahlerSeries> LogGammaMahlerSeries::get(long p, long N) {
+    return series_cache().get_or_compute({p, N}, [&]() {
+        auto series = std::make_shared<const LogGammaMahlerSeries>(p, N);
+        series->coefficients(series->required_terms());
+        return series;
+    });
+}
+
+Qp LogGammaMahlerSeries::next_value() const {
+    long m = static_cast<long>(coeffs.size());
+    const BigInt& modulus = PadicContext::get(prime, precision + 1).modulus();
+
+    // log_Iw ignores the sign (-1)^m, so only |Γ_p(m)| is needed
+    Qp value(prime, precision, 0);
+    if (prime == 2) {
+        // log_Iw(u) = log(u^2) / 2; v(log u^2) >= 3, so halving keeps N digits
+        BigInt square = (gamma * gamma) % modulus;
+        Qp log_square = PadicLog::log(Qp(prime, precision + 1, square));
+        if (!log_square.is_zero()) {
+            value = Qp::from_unit_and_valuation(prime, precision,
+                log_square.get_unit().get_value(), log_square.valuation() - 1);
+        }
+    } else {
+        // log_Iw(u) = log(u^{p-1}) / (p-1)
+        BigInt power;
+        mpz_powm_ui(power.get_mpz(), gamma.get_mpz(), static_cast<unsigned long>(prime - 1),
+                    modulus.get_mpz());
+        value = PadicLog::log(Qp(prime, precision, power)) *
+                Qp::from_rational(1, prime - 1, prime, precision);
+    }
+
+    if (m % prime != 0) {
+        mpz_mul_si(gamma.get_mpz(), gamma.get_mpz(), m);
+        mpz_mod(gamma.get_mpz(), gamma.get_mpz(), modulus.get_mpz());
+    }
+    return value;
+}
+
+void LogGammaMahlerSeries::extend(size_t count) const {
+    if (coeffs.size() >= count) {
+        return;
+    }
+
+    // Odd p: f(0) = 0 and the rest from one multipoint pass
+    std::vector<Qp> values;
+    size_t next = 0;
+    if (prime != 2) {
+        long first = std::max<long>(static_cast<long>(coeffs.size()), 1);
+        if (coeffs.empty()) {
+            values.emplace_back(prime, precision, 0);
+        }
+        std::vector<Qp> range = PadicGamma::log_gamma_range(prime, precision, first,
+                                                            static_cast<long>(count) - first);
+        values.insert(values.end(), range.begin(), range.end());
+    }
+
+    while (coeffs.size() < count) {
+        // D'[0] = f(m), D'[j] = D'[j-1] - D[j-1], a_m = D'[m]
+        Qp value = prime == 2 ? next_value() : std::move(values[next++]);
+        if (diagonal.empty()) {
+            diagonal.push_back(value);
+        } else {
+            Qp previous = diagonal[0];
+            diagonal[0] = value;
+            for (size_t j = 1; j < diagonal.size(); ++j) {
+                Qp old = diagonal[j];
+                diagonal[j] = diagonal[j - 1] - previous;
+                previous = std::move(old);
+            }
+            diagonal.push_back(diagonal.back() - previous);
+        }
+        coeffs.push_back(diagonal.back());
+    }
+}
+
+std::vector<Qp> LogGammaMahlerSeries::coefficients(size_t count) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    extend(count);
+    return std::vector<Qp>(coeffs.begin(), coeffs.begin() + static_cast<std::ptrdiff_t>(count));
+}
+
+Qp LogGammaMahlerSeries::coefficient(size_t n) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    extend(n + 1);
+    return coeffs[n];
+}
+
+Qp LogGammaMahlerSeries::evaluate(const Zp& x) const {
+    if (x.get_prime() != prime) {
+        throw std::invalid_argument("Prime mismatch in LogGammaMahlerSeries::evaluate");
+    }
+    long N = std::min(precision, x.get_precision());
+    const BigInt& modulus = PadicContext::get(prime, N).modulus();
+    BigInt prime_big(prime);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t terms = required_terms();
+    extend(terms);
+    auto inverses = InverseTable::get(prime, N, static_cast<long>(terms));
+
+    // C(X, n) = p^val · unit, stepped by (X - n) / (n + 1)
+    const BigInt& X = x.get_value();
+    BigInt unit(1);
+    long val = 0;
+    BigInt factor;
+    Qp result(prime, N, 0);
+    for (size_t n = 0; n < terms; ++n) {
+        if (val < N) {
+            const BigInt& m = PadicContext::get(prime, N - val).modulus();
+            result.addmul(coeffs[n], Qp::from_unit_and_valuation(prime, N, unit % m, val));
+        }
+
+        mpz_sub_ui(factor.get_mpz(), X.get_mpz(), static_cast<unsigned long>(n));
+        if (factor.is_zero()) {
+            break;  // X is a non-negative integer and C(X, k) = 0 for k > X
+        }
+        val += static_cast<long>(mpz_remove(factor.get_mpz(), factor.get_mpz(), prime_big.get_mpz()));
+        long next = static_cast<long>(n + 1);
+        val -= inverses->valuation(next);
+        mpz_mul(unit.get_mpz(), unit.get_mpz(), factor.get_mpz());
+        mpz_mul(unit.get_mpz(), unit.get_mpz(), inverses->unit_inverse(next).get_mpz());
+        mpz_mod(unit.get_mpz(), unit.get_mpz(), modulus.get_mpz());
+    }
+    return result;
+}
+
+} // namespace libadic
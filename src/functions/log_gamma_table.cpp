@@ -0,0 +1,79 @@
+#include "libadic/log_gamma_table.h"
+#include "libadic/cache.h"
+#include "libadic/cancellation.h"
+#include "libadic/padic_gamma.h"
+#include "libadic/thread_pool.h"
+#include <utility>
+
+namespace libadic {
+
+namespace {
+
+struct TableKeyHash {
+    size_t operator()(const std::pair<long, long>& k) const {
+        size_t h = std::hash<long>()(k.first);
+        hash_combine(h, std::hash<long>()(k.second));
+        return h;
+    }
+};
+
+using TablePtr = std::shared_ptr<const LogGammaTable>;
+
+ShardedCache<std::pair<long, long>, TablePtr, TableKeyHash>& table_cache() {
+    static ShardedCache<std::pair<long, long>, TablePtr, TableKeyHash> cache(
+        "LogGammaTable::tables",
+        [](const std::pair<long, long>& key, const TablePtr& table) {
+            size_t bytes = sizeof(key) + sizeof(LogGammaTable);
+            for (long a = 1; a < table->get_prime(); ++a) {
+                bytes += cache_footprint((*table)[a]);
+            }
+            return bytes;
+        });
+    return cache;
+}
+
+} // namespace
+
+LogGammaTable::LogGammaTable(long p, long N, size_t threads)
+    : prime(p), precision(N), values(static_cast<size_t>(p)) {
+    if (p < 2) {
+        throw std::invalid_argument("Prime must be >= 2");
+    }
+    if (N < 1) {
+        throw std::invalid_argument("Precision must be >= 1");
+    }
+
+    auto fill = [this](long a) {
+        cancellation_point();
+        values[a] = PadicGamma::log_gamma(Zp(prime, precision, a));
+    };
+
+    if (p < 4) {
+        for (long a = 1; a < p; ++a) {
+            fill(a);
+        }
+        return;
+    }
+    if (threads == 1) {
+        std::vector<Qp> range = PadicGamma::log_gamma_range(p, N, 1, p - 1);
+        for (long a = 1; a < p; ++a) {
+            values[a] = std::move(range[a - 1]);
+        }
+        return;
+    }
+
+    // Each task writes its own slot, so no synchronisation beyond the pool's
+    ThreadPool pool(threads);
+    for (long a = 1; a < p; ++a) {
+        pool.submit([&fill, a]() { fill(a); });
+    }
+    pool.wait_idle();
+}
+
+std::shared_ptr<const LogGammaTable> LogGammaTable::get(long p, long N, size_t threads) {
+    return table_cache().get_or_compute({p, N}, [&]() {
+        return std::make_shared<const LogGammaTable>(p, N, threads);
+    });
+}
+
+} // namespace libadic
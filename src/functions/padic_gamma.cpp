@@ -1,7 +1,95 @@
 #include "libadic/padic_gamma.h"
+#include <stdexcept>
 
 namespace libadic {
 
-// All implementation is in the header
+namespace {
 
-} // namespace libadic
\ No newline at end of file
+// Above this the smallest-factor sieve costs more memory than it saves
+constexpr long kSieveLimit = 1L << 22;
+
+} // namespace
+
+std::vector<Qp> PadicGamma::log_gamma_range(long p, long N, long start, long count) {
+    if (p < 3) {
+        throw std::invalid_argument("log_gamma_range requires an odd prime");
+    }
+    if (N < 1) {
+        throw std::invalid_argument("Precision must be >= 1");
+    }
+    if (start < 1 || count < 0) {
+        throw std::invalid_argument("log_gamma_range requires start >= 1 and count >= 0");
+    }
+    std::vector<Qp> values;
+    if (count == 0) {
+        return values;
+    }
+    values.reserve(static_cast<size_t>(count));
+
+    // Steps x -> x+1 for x in [start, last) need log_Iw(x) for the units x
+    long last = start + count - 1;
+    Qp inverse_order = Qp::from_rational(1, p - 1, p, N);
+
+    std::vector<Qp> increments(static_cast<size_t>(count - 1), Qp(p, N, 0));
+    if (last <= kSieveLimit) {
+        // Smallest prime factor sieve; log_Iw of each prime q ≠ p once
+        std::vector<int> spf(static_cast<size_t>(last) + 1, 0);
+        for (long i = 2; i <= last; ++i) {
+            if (spf[i] != 0) continue;
+            for (long j = i; j <= last; j += i) {
+                if (spf[j] == 0) spf[j] = static_cast<int>(i);
+            }
+        }
+        std::vector<int> slot(static_cast<size_t>(last) + 1, -1);
+        std::vector<long> primes;
+        for (long x = start; x < last; ++x) {
+            if (x % p == 0) continue;
+            for (long m = x; m > 1; m /= spf[m]) {
+                long q = spf[m];
+                if (slot[q] < 0) {
+                    slot[q] = static_cast<int>(primes.size());
+                    primes.push_back(q);
+                }
+            }
+        }
+        // log_Iw(q) = log(q^{p-1}) / (p-1)
+        std::vector<Qp> prime_logs = PadicLog::log_fermat_range(p, N, primes);
+        for (Qp& l : prime_logs) {
+            l *= inverse_order;
+        }
+        for (long x = start; x < last; ++x) {
+            if (x % p == 0) continue;
+            Qp& increment = increments[x - start];
+            for (long m = x; m > 1; m /= spf[m]) {
+                increment += prime_logs[slot[spf[m]]];
+            }
+        }
+    } else {
+        std::vector<long> units;
+        std::vector<long> positions;
+        for (long x = start; x < last; ++x) {
+            if (x % p == 0) continue;
+            units.push_back(x);
+            positions.push_back(x - start);
+        }
+        std::vector<Qp> logs = PadicLog::log_fermat_range(p, N, units);
+        for (size_t i = 0; i < logs.size(); ++i) {
+            increments[positions[i]] = logs[i] * inverse_order;
+        }
+    }
+
+    // log_Iw Γ_p(1) = log_Iw(-1) = 0, and Γ_p(x) = Γ_p(x+1) for p | x
+    Qp current(p, N, 0);
+    if (start > 1) {
+        long base = start % p == 0 ? start + 1 : start;
+        current = log_gamma(Zp(p, N, base));
+    }
+    values.push_back(current);
+    for (long x = start; x < last; ++x) {
+        current += increments[x - start];
+        values.push_back(current);
+    }
+    return values;
+}
+
+} // namespace libadic
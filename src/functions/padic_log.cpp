@@ -1,7 +1,516 @@
 #include "libadic/padic_log.h"
+#include "libadic/cache.h"
+#include "libadic/cancellation.h"
+#include "libadic/modular_arith.h"
+#include "libadic/precision_tracker.h"
+#include "libadic/stats.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
 
 namespace libadic {
 
-// All implementation is in the header
+namespace {
 
-} // namespace libadic
\ No newline at end of file
+/**
+ * Σ_{n=a}^{b-1} z^{n-a} / n = T / Q, with T and U = z^{b-a} reduced mod R
+ * and Q = ∏ n kept exact
+ */
+void split_log_series(long a, long b, const BigInt& z, const BigInt& R,
+                      BigInt& T, BigInt& Q, BigInt& U) {
+    if (b - a == 1) {
+        T = BigInt(1);
+        Q = BigInt(a);
+        U = z;
+        return;
+    }
+    long m = a + (b - a) / 2;
+    BigInt T2, Q2, U2;
+    split_log_series(a, m, z, R, T, Q, U);
+    split_log_series(m, b, z, R, T2, Q2, U2);
+
+    // T = T1 Q2 + U1 T2 Q1
+    mpz_mul(T2.get_mpz(), T2.get_mpz(), U.get_mpz());
+    mpz_mul(T2.get_mpz(), T2.get_mpz(), Q.get_mpz());
+    mpz_mul(T.get_mpz(), T.get_mpz(), Q2.get_mpz());
+    mpz_add(T.get_mpz(), T.get_mpz(), T2.get_mpz());
+    mpz_mod(T.get_mpz(), T.get_mpz(), R.get_mpz());
+    mpz_mul(U.get_mpz(), U.get_mpz(), U2.get_mpz());
+    mpz_mod(U.get_mpz(), U.get_mpz(), R.get_mpz());
+    mpz_mul(Q.get_mpz(), Q.get_mpz(), Q2.get_mpz());
+}
+
+/**
+ * log x = p^{val - k} · u_unit · T / Q with Q a unit, known mod p^{M - val};
+ * everything of log() except the inversion of Q
+ */
+struct LogParts {
+    long p = 0;
+    long N = 0;
+    long k = 0;
+    long M = 0;
+    long val = 0;
+    long terms = 0;    // series terms summed
+    long working = 0;  // digits the binary splitting ran at
+    bool zero = true;  // log x ≡ 0 at precision N
+    BigInt T, Q, u_unit;
+};
+
+LogParts log_parts(const Qp& x) {
+    LogParts parts;
+    long p = x.get_prime();
+    long N = x.get_precision();
+    parts.p = p;
+    parts.N = N;
+    BigInt prime_big(p);
+
+    // y = x^{p^k} mod p^{N+k}
+    long k = static_cast<long>(std::sqrt(static_cast<double>(N)));
+    long M = N + k;
+    parts.k = k;
+    parts.M = M;
+    const PadicContext& ctx = PadicContext::get(p, M);
+    BigInt y;
+    mpz_powm(y.get_mpz(), x.get_unit().get_value().get_mpz(), prime_big.pow(k).get_mpz(),
+             ctx.modulus().get_mpz());
+
+    BigInt u;
+    mpz_sub_ui(u.get_mpz(), y.get_mpz(), 1);
+    if (u.is_zero()) {
+        return parts;
+    }
+    BigInt& u_unit = parts.u_unit;
+    u_unit = u;
+    long w = static_cast<long>(mpz_remove(u_unit.get_mpz(), u_unit.get_mpz(), prime_big.get_mpz()));
+
+    // Terms n >= terms have n·w - v_p(n) >= M
+    long terms = PrecisionTracker::series_terms(p, M, w);
+
+    // R covers the p-part v_p(Q) = v_p(terms!) of the final denominator
+    long e = PrecisionTracker::factorial_valuation(p, terms);
+    const BigInt& R = PadicContext::get(p, M + e).modulus();
+    parts.terms = terms;
+    parts.working = M + e;
+
+    BigInt z;
+    mpz_neg(z.get_mpz(), u.get_mpz());
+    mpz_mod(z.get_mpz(), z.get_mpz(), R.get_mpz());
+    BigInt& T = parts.T;
+    BigInt& Q = parts.Q;
+    BigInt U;
+    split_log_series(1, terms + 1, z, R, T, Q, U);
+
+    if (T.is_zero()) {
+        return parts;
+    }
+    long vt = static_cast<long>(mpz_remove(T.get_mpz(), T.get_mpz(), prime_big.get_mpz()));
+    long vq = static_cast<long>(mpz_remove(Q.get_mpz(), Q.get_mpz(), prime_big.get_mpz()));
+
+    // log y = p^{w + vt - vq} · u_unit · T / Q, known mod p^M; log x = log y / p^k
+    parts.val = w + vt - vq;
+    parts.zero = parts.val >= M;
+    return parts;
+}
+
+/**
+ * log x in the fixed-width backend for p^{M+V}, with the reduction
+ * y = x^{p^k} of log_parts. Each term u^n / n is kept as p^{V - v_p(n)} u^n
+ * over the unit part of n, and the unit denominators are folded into one
+ * fraction, so the whole series costs a single inversion and no heap
+ * allocation; p^V with V = max v_p(n) is divided out at the end.
+ */
+template<class Backend>
+Qp log_in_words(const Backend& be, const Qp& x, long k, long M, long V, long& terms) {
+    using word = typename Backend::word;
+    long p = x.get_prime();
+    long N = x.get_precision();
+    const word prime = static_cast<word>(p);
+    word p_k = 1;
+    for (long i = 0; i < k; ++i) {
+        p_k *= prime;
+    }
+    word y = be.pow(be.to_mont(static_cast<word>(u128_from_bigint(x.get_unit().get_value()))), p_k);
+    word u = be.from_mont(be.sub(y, be.one()));
+    terms = 0;
+    if (u == 0) {
+        return Qp(p, N, 0);
+    }
+    long w = 0;
+    for (word r = u; r % prime == 0; r /= prime) {
+        ++w;
+    }
+    if (w >= M) {
+        return Qp(p, N, 0);
+    }
+    terms = PrecisionTracker::series_terms(p, M, w);
+
+    // Σ (-1)^{n+1} u^n / n = num / den
+    word u_mont = be.to_mont(u);
+    word power = be.one();
+    word num = 0;
+    word den = be.one();
+    for (long n = 1; n <= terms; ++n) {
+        power = be.mul(power, u_mont);
+        long unit = n;
+        word scale = 1;
+        for (long v = 0; v < V; ++v) {
+            if (unit % p == 0) {
+                unit /= p;
+            } else {
+                scale *= prime;
+            }
+        }
+        word unit_mont = be.to_mont(static_cast<word>(unit));
+        word term = be.mul(be.mul(power, be.to_mont(scale)), den);
+        num = be.mul(num, unit_mont);
+        num = (n & 1) == 1 ? be.add(num, term) : be.sub(num, term);
+        den = be.mul(den, unit_mont);
+    }
+
+    // num / den ≡ p^V log y (mod p^{M+V}) with log y ∈ Z_p, so the residue
+    // is p^V times log y mod p^M
+    word scaled = be.from_mont(be.mul(num, be.inverse(den)));
+    for (long v = 0; v < V; ++v) {
+        scaled /= prime;
+    }
+    if (scaled == 0) {
+        return Qp(p, N, 0);
+    }
+    long val = 0;
+    for (; scaled % prime == 0; scaled /= prime) {
+        ++val;
+    }
+    return Qp::from_unit_and_valuation(p, N, bigint_from_u128(scaled), val - k);
+}
+
+/**
+ * log x through log_in_words when p^{M+V} fits in a machine word backend
+ */
+std::optional<Qp> try_log_in_words(const Qp& x, long& terms, long& working) {
+    long p = x.get_prime();
+    long N = x.get_precision();
+    long k = static_cast<long>(std::sqrt(static_cast<double>(N)));
+    long M = N + k;
+    // x ≡ 1 (mod p) gives v(x^{p^k} - 1) >= k + 1, which bounds the terms
+    long V = PrecisionTracker::max_index_valuation(p, PrecisionTracker::series_terms(p, M, k + 1));
+    working = M + V;
+    return dispatch_zp_backend(PadicContext::get(p, M + V),
+        [&](const auto& be) -> std::optional<Qp> { return log_in_words(be, x, k, M, V, terms); },
+        []() -> std::optional<Qp> { return std::nullopt; });
+}
+
+/**
+ * The value described by `parts`, given Q^{-1} modulo (a power of p at
+ * least) p^{M - val}
+ */
+Qp finish_log(const LogParts& parts, const BigInt& q_inverse) {
+    if (parts.zero) {
+        return Qp(parts.p, parts.N, 0);
+    }
+    const BigInt& m = PadicContext::get(parts.p, parts.M - parts.val).modulus();
+    BigInt unit;
+    mpz_mul(unit.get_mpz(), q_inverse.get_mpz(), parts.T.get_mpz());
+    mpz_mod(unit.get_mpz(), unit.get_mpz(), m.get_mpz());
+    mpz_mul(unit.get_mpz(), unit.get_mpz(), parts.u_unit.get_mpz());
+    mpz_mod(unit.get_mpz(), unit.get_mpz(), m.get_mpz());
+    return Qp::from_unit_and_valuation(parts.p, parts.N, unit, parts.val - parts.k);
+}
+
+/**
+ * Per-(p, a) state of log_fermat_range: the highest precision a^{p-1} was
+ * logged at, and the resumable series once a higher one has been asked for
+ */
+struct SeriesEntry {
+    std::mutex mutex;
+    long seen = 0;
+    std::unique_ptr<LogSeries> series;
+    std::atomic<size_t> bytes{0};  // series footprint, read by the sizer
+};
+
+struct SeriesKeyHash {
+    size_t operator()(const std::pair<long, long>& k) const {
+        size_t h = std::hash<long>()(k.first);
+        hash_combine(h, std::hash<long>()(k.second));
+        return h;
+    }
+};
+
+using SeriesPtr = std::shared_ptr<SeriesEntry>;
+
+ShardedCache<std::pair<long, long>, SeriesPtr, SeriesKeyHash>& series_cache() {
+    static ShardedCache<std::pair<long, long>, SeriesPtr, SeriesKeyHash> cache(
+        "PadicLog::series",
+        [](const std::pair<long, long>& key, const SeriesPtr& entry) {
+            return sizeof(key) + sizeof(SeriesEntry) + entry->bytes.load(std::memory_order_relaxed);
+        });
+    return cache;
+}
+
+} // namespace
+
+LogSeries::LogSeries(long p, const BigInt& base, long exponent, long headroom)
+    : prime(p), base(base), exponent(exponent) {
+    if (p < 2) {
+        throw std::invalid_argument("LogSeries requires a prime p");
+    }
+    if (exponent < 1 || headroom < 1) {
+        throw std::invalid_argument("LogSeries requires exponent >= 1 and headroom >= 1");
+    }
+    // x ≡ 1 (mod p), mod 4 for p = 2
+    BigInt q(p == 2 ? 4 : p);
+    BigInt x;
+    mpz_powm_ui(x.get_mpz(), base.get_mpz(), static_cast<unsigned long>(exponent), q.get_mpz());
+    if (mpz_cmp_ui(x.get_mpz(), 1) != 0) {
+        throw std::domain_error("p-adic logarithm does not converge: x must be ≡ 1 (mod p)");
+    }
+    restart(headroom);
+}
+
+void LogSeries::restart(long H) {
+    long p = prime;
+    headroom = H;
+    reduction = static_cast<long>(std::sqrt(static_cast<double>(H)));
+    next = 1;
+    long M = H + reduction;
+
+    // y = x^{p^k}, exact modulo p^{M + ⌊log_p M⌋}, which covers the guard
+    // digits of the working precision below
+    long digits = M + PrecisionTracker::max_index_valuation(p, M);
+    BigInt prime_big(p);
+    BigInt e;
+    mpz_mul_si(e.get_mpz(), prime_big.pow(reduction).get_mpz(), exponent);
+    BigInt y;
+    mpz_powm(y.get_mpz(), base.get_mpz(), e.get_mpz(), PadicContext::get(p, digits).modulus().get_mpz());
+
+    BigInt unit;
+    mpz_sub_ui(unit.get_mpz(), y.get_mpz(), 1);
+    valuation = unit.is_zero() ? digits
+                               : static_cast<long>(mpz_remove(unit.get_mpz(), unit.get_mpz(), prime_big.get_mpz()));
+    if (valuation >= M) {
+        valuation = 0;  // log x ≡ 0 to every precision up to H
+        inverses.reset();
+        u = power = sum = Qp();
+        return;
+    }
+
+    long terms = PrecisionTracker::series_terms(p, M, valuation);
+    PrecisionTracker tracker(M);
+    tracker.series(p, terms);
+    long W = tracker.working();
+    inverses = InverseTable::get(p, W, terms);
+    u = Qp::from_unit_and_valuation(p, W, unit, valuation);
+    power = u;
+    sum = Qp(p, W, 0);
+}
+
+Qp LogSeries::value(long N) {
+    if (N < 1) {
+        throw std::invalid_argument("Precision must be >= 1");
+    }
+    stats::Scope scope(stats::Id::padic_log);
+    if (N > headroom) {
+        restart(std::max(2 * headroom, N));
+    }
+    if (valuation == 0) {
+        return Qp(prime, N, 0);
+    }
+
+    // Terms beyond series_terms(p, N + k, w) vanish mod p^{N+k}; the sum so
+    // far may already hold some of them, which changes nothing at N
+    long target = N + reduction;
+    long terms = PrecisionTracker::series_terms(prime, target, valuation);
+    scope.iterations(static_cast<uint64_t>(std::max(0L, terms - next + 1)));
+    for (; next <= terms; ++next) {
+        if ((next & 1) == 1) {
+            sum.addmul(power, inverses->inverse(next));
+        } else {
+            sum.submul(power, inverses->inverse(next));
+        }
+        power *= u;
+    }
+
+    Qp log_y = sum.with_precision(target);
+    if (log_y.is_zero()) {
+        return Qp(prime, N, 0);
+    }
+    return Qp::from_unit_and_valuation(prime, N, log_y.get_unit().get_value(), log_y.valuation() - reduction);
+}
+
+size_t LogSeries::footprint() const {
+    return sizeof(LogSeries) + cache_footprint(base) + cache_footprint(u) + cache_footprint(power) +
+           cache_footprint(sum);
+}
+
+void PadicLog::check_log_argument(const Qp& x) {
+    if (x.is_zero()) {
+        throw std::domain_error("Logarithm of zero is undefined");
+    }
+    if (x.valuation() != 0) {
+        throw std::domain_error("p-adic logarithm requires valuation 0");
+    }
+    if (!check_convergence_condition(x)) {
+        throw std::domain_error("p-adic logarithm does not converge: x must be ≡ 1 (mod p)");
+    }
+}
+
+Qp PadicLog::log(const Qp& x) {
+    stats::Scope scope(stats::Id::padic_log);
+    cancellation_point();
+    check_log_argument(x);
+    long terms = 0, working = 0;
+    if (std::optional<Qp> fast = try_log_in_words(x, terms, working)) {
+        scope.iterations(static_cast<uint64_t>(terms));
+        scope.inflation(working - x.get_precision());
+        return *fast;
+    }
+    LogParts parts = log_parts(x);
+    scope.iterations(static_cast<uint64_t>(parts.terms));
+    scope.inflation(parts.working - parts.N);
+    if (parts.zero) {
+        return Qp(parts.p, parts.N, 0);
+    }
+    const BigInt& m = PadicContext::get(parts.p, parts.M - parts.val).modulus();
+    BigInt q_inverse;
+    mpz_invert(q_inverse.get_mpz(), parts.Q.get_mpz(), m.get_mpz());
+    return finish_log(parts, q_inverse);
+}
+
+std::vector<Qp> PadicLog::log_range(const std::vector<Qp>& values) {
+    stats::Scope scope(stats::Id::padic_log_range);
+    scope.iterations(values.size());
+    std::vector<Qp> logs;
+    if (values.empty()) {
+        return logs;
+    }
+    long p = values[0].get_prime();
+    std::vector<LogParts> parts;
+    parts.reserve(values.size());
+    std::vector<std::optional<Qp>> word_logs(values.size());
+    long digits = 1;
+    for (size_t i = 0; i < values.size(); ++i) {
+        const Qp& x = values[i];
+        if (x.get_prime() != p) {
+            throw std::invalid_argument("log_range requires a common prime");
+        }
+        check_log_argument(x);
+        long terms = 0, working = 0;
+        word_logs[i] = try_log_in_words(x, terms, working);
+        // Values finished in words stay out of the shared inversion
+        parts.push_back(word_logs[i] ? LogParts() : log_parts(x));
+        if (!parts.back().zero) {
+            digits = std::max(digits, parts.back().M - parts.back().val);
+        }
+    }
+
+    // Every inverse modulo the largest p^{M - val} reduces to the modulus each
+    // value needs, so one batch_mod_inverse serves the whole list
+    std::vector<size_t> live;
+    std::vector<BigInt> denominators;
+    for (size_t i = 0; i < parts.size(); ++i) {
+        if (parts[i].zero) continue;
+        live.push_back(i);
+        denominators.push_back(parts[i].Q);
+    }
+    batch_mod_inverse(denominators, PadicContext::get(p, digits).modulus());
+    std::vector<BigInt> inverses(parts.size());
+    for (size_t j = 0; j < live.size(); ++j) {
+        inverses[live[j]] = std::move(denominators[j]);
+    }
+
+    logs.reserve(values.size());
+    for (size_t i = 0; i < parts.size(); ++i) {
+        cancellation_point();
+        logs.push_back(word_logs[i] ? std::move(*word_logs[i]) : finish_log(parts[i], inverses[i]));
+    }
+    return logs;
+}
+
+std::vector<Qp> PadicLog::log_fermat_range(long p, long N, const std::vector<long>& bases) {
+    if (N < 1) {
+        throw std::invalid_argument("Precision must be >= 1");
+    }
+    std::vector<Qp> logs(bases.size(), Qp(p, N, 0));
+    std::vector<size_t> fresh;
+    std::vector<SeriesPtr> fresh_entries;
+    std::vector<Qp> arguments;
+    const BigInt& modulus = PadicContext::get(p, N).modulus();
+    for (size_t i = 0; i < bases.size(); ++i) {
+        long a = bases[i];
+        if (a % p == 0) {
+            throw std::invalid_argument("log_fermat_range requires bases prime to p");
+        }
+        std::pair<long, long> key{p, a};
+        SeriesPtr entry = series_cache().get_or_compute(key, []() { return std::make_shared<SeriesEntry>(); });
+
+        bool resumed = false;
+        bool resized = false;
+        {
+            std::lock_guard<std::mutex> lock(entry->mutex);
+            if (!entry->series && entry->seen > 0 && entry->seen < N) {
+                entry->series.reset(new LogSeries(p, BigInt(a), p - 1, 2 * N));
+            }
+            if (entry->series) {
+                cancellation_point();
+                logs[i] = entry->series->value(N);
+                resumed = true;
+                size_t bytes = entry->series->footprint();
+                resized = entry->bytes.exchange(bytes, std::memory_order_relaxed) != bytes;
+            }
+        }
+        if (resized) {
+            series_cache().insert(key, entry);  // re-account the grown state
+        }
+        if (resumed) {
+            continue;
+        }
+
+        BigInt power;
+        mpz_powm_ui(power.get_mpz(), BigInt(a).get_mpz(), static_cast<unsigned long>(p - 1),
+                    modulus.get_mpz());
+        fresh.push_back(i);
+        fresh_entries.push_back(std::move(entry));
+        arguments.push_back(Qp(p, N, power));
+    }
+
+    std::vector<Qp> fresh_logs = log_range(arguments);
+    for (size_t j = 0; j < fresh.size(); ++j) {
+        logs[fresh[j]] = std::move(fresh_logs[j]);
+        std::lock_guard<std::mutex> lock(fresh_entries[j]->mutex);
+        fresh_entries[j]->seen = std::max(fresh_entries[j]->seen, N);
+    }
+    return logs;
+}
+
+Qp PadicLog::exp(const Qp& x) {
+    stats::Scope scope(stats::Id::padic_exp);
+    long p = x.get_prime();
+    long N = x.get_precision();
+    if (x.is_zero()) {
+        return Qp(p, N, 1);
+    }
+    long v = x.valuation();
+    if (v < 1 || (p == 2 && v < 2)) {
+        throw std::domain_error("exp requires positive valuation for convergence");
+    }
+
+    // y ≡ exp(x) mod p^m; one Newton step squares the relative error
+    // (up to the factor 1/2 for p = 2)
+    Qp y(p, std::min(v, N), 1);
+    long m = v;
+    while (m < N) {
+        cancellation_point();
+        m = std::min(N, p == 2 ? 2 * m - 1 : 2 * m);
+        scope.iterations(1);
+        Qp ym = y.with_precision(m);
+        Qp correction = x.with_precision(m) - log(ym);
+        correction += Qp(p, m, 1);
+        y = ym * correction;
+    }
+    return y.with_precision(N);
+}
+
+} // namespace libadic
@@ -0,0 +1,364 @@
+#include "libadic/reid_li.h"
+#include "libadic/cancellation.h"
+#include "libadic/character_sums.h"
+#include "libadic/l_functions.h"
+#include "libadic/lazy_padic.h"
+#include "libadic/log_gamma_table.h"
+#include "libadic/padic_gamma.h"
+#include "libadic/padic_log.h"
+#include "libadic/thread_pool.h"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace libadic {
+
+Qp ReidLi::phi_odd(const DirichletCharacter& chi, long precision) {
+    long p = chi.get_prime();
+    Qp result(p, precision, 0);
+    auto log_gamma = LogGammaTable::get(p, precision);
+
+    // Φ_p^{(odd)}(χ) = Σ_{a=1}^{p-1} χ(a) log Γ_p(a)
+    for (long a = 1; a < p; ++a) {
+        Zp chi_a = chi.evaluate(a, precision);
+        if (!chi_a.is_zero()) {
+            result.addmul(Qp(chi_a), (*log_gamma)[a]);
+        }
+    }
+
+    return result;
+}
+
+Qp ReidLi::phi_even(const DirichletCharacter& chi, long precision) {
+    long p = chi.get_prime();
+    Qp result(p, precision, 0);
+
+    // Φ_p^{(even)}(χ) = Σ_{a=1}^{p-1} χ(a) log_p(a/(p-1)), over the terms
+    // where the logarithm converges
+    for (long a = 1; a < p; ++a) {
+        Zp chi_a = chi.evaluate(a, precision);
+        if (chi_a.is_zero()) continue;
+
+        Qp ratio = Qp::from_rational(a, p - 1, p, precision);
+        if (ratio.valuation() != 0) continue;
+
+        Qp ratio_minus_one = ratio - Qp(p, precision, 1);
+        if ((p != 2 && ratio_minus_one.valuation() >= 1) ||
+            (p == 2 && ratio_minus_one.valuation() >= 2)) {
+            result.addmul(Qp(chi_a), PadicLog::log(ratio));
+        }
+    }
+
+    return result;
+}
+
+Qp ReidLi::psi_odd(const DirichletCharacter& chi, long precision) {
+    return LFunctions::kubota_leopoldt_derivative(0, chi, precision);
+}
+
+Qp ReidLi::psi_even(const DirichletCharacter& chi, long precision) {
+    return LFunctions::kubota_leopoldt(0, chi, precision);
+}
+
+ReidLiResult ReidLi::compare(const DirichletCharacter& chi, const Qp& phi, const Qp& psi,
+                             long precision, long tolerance) {
+    ReidLiResult result;
+    result.prime = chi.get_prime();
+    result.precision = precision;
+    result.order = chi.get_order();
+    result.is_odd = chi.is_odd();
+    result.is_primitive = chi.is_primitive();
+    result.phi_value = phi;
+    result.psi_value = psi;
+
+    Qp diff = phi - psi;
+    if (diff.is_zero()) {
+        result.precision_achieved = precision;
+        result.matches = true;
+    } else {
+        result.precision_achieved = diff.valuation();
+        result.matches = result.precision_achieved >= precision - tolerance;
+    }
+    return result;
+}
+
+namespace {
+
+// a ↦ log_p(a/(p-1)) where the logarithm converges, 0 elsewhere: the even Φ
+// summand as a function for CharacterSumBatch
+std::vector<Qp> log_ratio_terms(long p, long precision) {
+    std::vector<Qp> log_ratio(static_cast<size_t>(p), Qp(p, precision, 0));
+    Qp one(p, precision, 1);
+    for (long a = 1; a < p; ++a) {
+        Qp ratio = Qp::from_rational(a, p - 1, p, precision);
+        if (ratio.valuation() != 0) continue;
+        long v = (ratio - one).valuation();
+        if ((p != 2 && v >= 1) || (p == 2 && v >= 2)) {
+            log_ratio[a] = PadicLog::log(ratio);
+        }
+    }
+    return log_ratio;
+}
+
+ReidLiResult error_result(const DirichletCharacter& chi, long precision, const char* what) {
+    ReidLiResult result;
+    result.prime = chi.get_prime();
+    result.precision = precision;
+    result.order = chi.get_order();
+    result.is_odd = chi.is_odd();
+    result.is_primitive = chi.is_primitive();
+    result.error = what;
+    result.matches = false;
+    result.precision_achieved = 0;
+    return result;
+}
+
+} // namespace
+
+ReidLiResult ReidLi::verify(const DirichletCharacter& chi, long precision, long tolerance) {
+    try {
+        if (chi.is_odd()) {
+            return compare(chi, phi_odd(chi, precision), psi_odd(chi, precision),
+                           precision, tolerance);
+        }
+        return compare(chi, phi_even(chi, precision), psi_even(chi, precision),
+                       precision, tolerance);
+    } catch (const OperationCancelled&) {
+        throw;
+    } catch (const std::exception& e) {
+        return error_result(chi, precision, e.what());
+    }
+}
+
+ReidLiResult ReidLi::verify_lazy(const DirichletCharacter& chi, long max_precision,
+                                 long tolerance, long initial_precision) {
+    try {
+        long p = chi.get_prime();
+        bool odd = chi.is_odd();
+        LazyQp phi = LazyQp::from_function(p, [chi, odd](long N) {
+            return odd ? phi_odd(chi, N) : phi_even(chi, N);
+        }, -1);
+        LazyQp psi = LazyQp::from_function(p, [chi, odd](long N) {
+            return odd ? psi_odd(chi, N) : psi_even(chi, N);
+        }, -1);
+        LazyQp diff = phi - psi;
+
+        long n = std::max(tolerance + 1, std::min(initial_precision, max_precision));
+        while (true) {
+            Qp d = diff.approximate(n);
+            bool determined = !d.is_zero() && d.valuation() < n - tolerance;
+            if (determined || n >= max_precision) {
+                return compare(chi, phi.approximate(n), psi.approximate(n), n, tolerance);
+            }
+            n = std::min(max_precision, 2 * n);
+        }
+    } catch (const OperationCancelled&) {
+        throw;
+    } catch (const std::exception& e) {
+        return error_result(chi, max_precision, e.what());
+    }
+}
+
+void ReidLi::sides_all(long p, long precision, std::vector<Qp>& phi, std::vector<Qp>& psi) {
+    auto batch = CharacterSumBatch::get(p, precision);
+
+    // χ_k(-1) = ω^{k(p-1)/2} = (-1)^k: odd indices are the odd characters.
+    // Φ for those is the batched log Γ_p sum; Ψ = L'_p(0, χ) comes from
+    // LFunctions per character below, so the comparison checks the batch
+    // against an evaluation that does not share it.
+    std::vector<Qp> log_gamma_sums = LFunctions::compute_derivative_at_zero_odd_all(p, precision);
+    std::vector<DirichletCharacter> characters = DirichletCharacter::enumerate_characters(p, p);
+
+    std::vector<Qp> log_ratio_sums = batch->sum(log_ratio_terms(p, precision));
+
+    // Non-principal characters mod p have conductor p, so the Euler factor
+    // in L_p(0, χ) = -(1 - χ(p)/p) B_{1,χ} is 1
+    std::vector<Qp> B1 = LFunctions::compute_B1_chi_all(p, precision);
+
+    size_t n = batch->size();
+    phi.assign(n, Qp(p, precision, 0));
+    psi.assign(n, Qp(p, precision, 0));
+    for (size_t k = 1; k < n; ++k) {
+        if (k % 2 == 1) {
+            phi[k] = log_gamma_sums[k];
+            psi[k] = psi_odd(characters[k], precision);
+        } else {
+            phi[k] = log_ratio_sums[k];
+            psi[k] = -B1[k];
+        }
+    }
+
+    DirichletCharacter principal(p, p, {0});
+    phi[0] = phi_even(principal, precision);
+    psi[0] = psi_even(principal, precision);
+}
+
+void ReidLi::sides_orbit(const DirichletCharacter& chi, long precision,
+                         std::vector<Qp>& phi, std::vector<Qp>& psi) {
+    long p = chi.get_prime();
+    if (chi.is_principal()) {
+        phi.assign(1, phi_even(chi, precision));
+        psi.assign(1, psi_even(chi, precision));
+        return;
+    }
+    if (chi.is_odd()) {
+        phi = LFunctions::compute_derivative_at_zero_odd_orbit(chi, precision);
+        psi.clear();
+        for (const DirichletCharacter& conjugate : chi.galois_orbit()) {
+            psi.push_back(psi_odd(conjugate, precision));
+        }
+        return;
+    }
+    auto batch = CharacterSumBatch::get(p, precision);
+    phi = batch->orbit_sum(chi, log_ratio_terms(p, precision));
+    psi = LFunctions::compute_B1_chi_orbit(chi, precision);
+    for (auto& x : psi) {
+        x = -x;
+    }
+}
+
+ReidLiEngine::ReidLiEngine(ReidLiConfig cfg) : config(std::move(cfg)) {
+    if (config.min_prime < 2) {
+        config.min_prime = 2;
+    }
+    if (config.max_prime < config.min_prime && config.primes.empty()) {
+        throw std::invalid_argument("ReidLiEngine: max_prime < min_prime");
+    }
+    for (long p : config.primes) {
+        bool prime = p >= 2;
+        for (long d = 2; prime && d * d <= p; ++d) {
+            prime = p % d != 0;
+        }
+        if (!prime) {
+            throw std::invalid_argument("ReidLiEngine: " + std::to_string(p) + " is not prime");
+        }
+    }
+    if (config.precision < 1 && !config.precision_for_prime) {
+        throw std::invalid_argument("Precision must be >= 1");
+    }
+}
+
+std::vector<long> ReidLiEngine::primes_in_range(long lo, long hi) {
+    std::vector<long> primes;
+    if (hi < 2) {
+        return primes;
+    }
+    std::vector<bool> composite(static_cast<size_t>(hi) + 1, false);
+    for (long i = 2; i <= hi; ++i) {
+        if (composite[i]) continue;
+        if (i >= lo) {
+            primes.push_back(i);
+        }
+        for (long j = i * i; j <= hi; j += i) {
+            composite[j] = true;
+        }
+    }
+    return primes;
+}
+
+ReidLiSummary ReidLiEngine::run(const Sink& sink) const {
+    std::vector<long> primes = config.primes.empty()
+        ? primes_in_range(config.min_prime, config.max_prime)
+        : config.primes;
+
+    ReidLiSummary summary;
+    summary.primes = static_cast<long>(primes.size());
+    std::mutex sink_mutex;
+
+    auto emit = [&](const ReidLiResult& r) {
+        std::lock_guard<std::mutex> lock(sink_mutex);
+        ++summary.characters;
+        if (!r.error.empty()) {
+            ++summary.errors;
+        } else if (r.matches) {
+            ++summary.matched;
+        } else {
+            ++summary.failed;
+        }
+        if (sink) {
+            sink(r);
+        }
+    };
+
+    ThreadPool pool(config.threads);
+
+    for (long p : primes) {
+        pool.submit([this, p, &pool, &emit]() {
+            long N = config.precision_for_prime ? config.precision_for_prime(p) : config.precision;
+            if (config.galois_orbits && p > 2) {
+                for (auto& members : DirichletCharacter::galois_orbits(p, p)) {
+                    const DirichletCharacter& rep = members.front();
+                    if (config.skip_principal && rep.is_principal()) continue;
+                    if (config.primitive_only && !rep.is_primitive()) continue;
+
+                    auto orbit = std::make_shared<std::vector<DirichletCharacter>>(std::move(members));
+                    pool.submit([this, orbit, N, &emit]() {
+                        std::vector<Qp> phi, psi;
+                        bool batched = true;
+                        try {
+                            ReidLi::sides_orbit(orbit->front(), N, phi, psi);
+                        } catch (const std::exception&) {
+                            batched = false;
+                        }
+                        for (size_t i = 0; i < orbit->size(); ++i) {
+                            const DirichletCharacter& c = (*orbit)[i];
+                            ReidLiResult r = batched
+                                ? ReidLi::compare(c, phi[i], psi[i], N, config.tolerance)
+                                : ReidLi::verify(c, N, config.tolerance);
+                            r.character_index = c.index();
+                            emit(r);
+                        }
+                    });
+                }
+                return;
+            }
+
+            auto characters = std::make_shared<std::vector<DirichletCharacter>>(
+                DirichletCharacter::enumerate_characters(p, p));
+
+            // Both sides for every character in one pass; if that fails (or
+            // p = 2), each character task falls back to ReidLi::verify
+            auto phi = std::make_shared<std::vector<Qp>>();
+            auto psi = std::make_shared<std::vector<Qp>>();
+            bool batched = false;
+            if (p > 2) {
+                try {
+                    ReidLi::sides_all(p, N, *phi, *psi);
+                    batched = true;
+                } catch (const std::exception&) {
+                    batched = false;
+                }
+            }
+
+            for (size_t i = 0; i < characters->size(); ++i) {
+                const DirichletCharacter& chi = (*characters)[i];
+                if (config.skip_principal && chi.is_principal()) continue;
+                if (config.primitive_only && !chi.is_primitive()) continue;
+
+                pool.submit([this, characters, phi, psi, batched, i, N, &emit]() {
+                    const DirichletCharacter& c = (*characters)[i];
+                    ReidLiResult r = batched
+                        ? ReidLi::compare(c, (*phi)[i], (*psi)[i], N, config.tolerance)
+                        : ReidLi::verify(c, N, config.tolerance);
+                    r.character_index = static_cast<long>(i);
+                    emit(r);
+                });
+            }
+        });
+    }
+
+    pool.wait_idle();
+    return summary;
+}
+
+std::vector<ReidLiResult> ReidLiEngine::run() const {
+    std::vector<ReidLiResult> results;
+    run([&results](const ReidLiResult& r) { results.push_back(r); });
+    std::sort(results.begin(), results.end(), [](const ReidLiResult& a, const ReidLiResult& b) {
+        return a.prime != b.prime ? a.prime < b.prime : a.character_index < b.character_index;
+    });
+    return results;
+}
+
+} // namespace libadic
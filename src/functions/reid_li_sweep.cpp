@@ -0,0 +1,279 @@
+#include "libadic/reid_li_sweep.h"
+#include "libadic/result_store.h"
+#include "libadic/thread_pool.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+
+namespace libadic {
+
+namespace {
+
+long euler_phi(long n) {
+    long result = n;
+    for (long q = 2; q * q <= n; ++q) {
+        if (n % q == 0) {
+            while (n % q == 0) n /= q;
+            result -= result / q;
+        }
+    }
+    if (n > 1) {
+        result -= result / n;
+    }
+    return result;
+}
+
+bool file_exists(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return in.good();
+}
+
+// Worker id recorded in a claim file, empty if there is none
+std::string claim_owner(const std::string& path) {
+    std::ifstream in(path);
+    std::string owner;
+    in >> owner;
+    return owner;
+}
+
+// Create the claim file exclusively; false if it already exists
+bool try_claim(const std::string& path, const std::string& owner, bool overwrite) {
+    std::FILE* f = std::fopen(path.c_str(), overwrite ? "w" : "wx");
+    if (!f) {
+        return false;
+    }
+    std::fputs(owner.c_str(), f);
+    std::fputc('\n', f);
+    return std::fclose(f) == 0;
+}
+
+ResultStore::Key sides_key(long p, long index) {
+    return ResultStore::Key{ResultStore::Table::ReidLiSides, {p, index}, ""};
+}
+
+} // namespace
+
+std::string ReidLiUnit::name() const {
+    return "p" + std::to_string(prime) + "_chi" + std::to_string(representative) +
+           "_N" + std::to_string(precision);
+}
+
+double ReidLiSweep::estimated_cost(long p, long N, long order) {
+    double n = static_cast<double>(N);
+    return (static_cast<double>(p) + static_cast<double>(euler_phi(order)) * order) * n * n;
+}
+
+ReidLiSweep::ReidLiSweep(ReidLiSweepConfig cfg) : config(std::move(cfg)) {
+    ReidLiEngine engine(config.sweep);  // validates the primes and precision
+    if (config.directory.empty()) {
+        throw std::invalid_argument("ReidLiSweep: no checkpoint directory");
+    }
+    if (config.workers == 0 || config.worker >= config.workers) {
+        throw std::invalid_argument("ReidLiSweep: worker must be in [0, workers)");
+    }
+
+    const ReidLiConfig& sweep = config.sweep;
+    std::vector<long> primes = sweep.primes.empty()
+        ? ReidLiEngine::primes_in_range(sweep.min_prime, sweep.max_prime)
+        : sweep.primes;
+
+    // The orbits mod p are the character orders d | p-1; the characters of
+    // order d are χ_k with gcd(k, p-1) = (p-1)/d, the smallest being k = (p-1)/d.
+    // Only the principal character (d = 1) is imprimitive mod p.
+    for (long p : primes) {
+        long N = sweep.precision_for_prime ? sweep.precision_for_prime(p) : sweep.precision;
+        if (N < 1) {
+            throw std::invalid_argument("Precision must be >= 1");
+        }
+        for (long d = 1; d <= p - 1; ++d) {
+            if ((p - 1) % d != 0) continue;
+            if (d == 1 && (sweep.skip_principal || sweep.primitive_only)) continue;
+            ReidLiUnit unit;
+            unit.prime = p;
+            unit.precision = N;
+            unit.representative = d == 1 ? 0 : (p - 1) / d;
+            unit.order = d;
+            unit.size = euler_phi(d);
+            unit.cost = estimated_cost(p, N, d);
+            units.push_back(unit);
+        }
+    }
+    std::stable_sort(units.begin(), units.end(), [](const ReidLiUnit& a, const ReidLiUnit& b) {
+        return a.cost > b.cost;
+    });
+}
+
+std::vector<size_t> ReidLiSweep::share(size_t worker) const {
+    std::vector<double> load(config.workers, 0.0);
+    std::vector<size_t> mine;
+    for (size_t i = 0; i < units.size(); ++i) {
+        size_t w = static_cast<size_t>(std::min_element(load.begin(), load.end()) - load.begin());
+        load[w] += units[i].cost;
+        if (w == worker) {
+            mine.push_back(i);
+        }
+    }
+    return mine;
+}
+
+std::string ReidLiSweep::checkpoint_path(const ReidLiUnit& unit) const {
+    return config.directory + "/" + unit.name() + ".bin";
+}
+
+std::string ReidLiSweep::claim_path(const ReidLiUnit& unit) const {
+    return config.directory + "/" + unit.name() + ".claim";
+}
+
+bool ReidLiSweep::load_checkpoint(const ReidLiUnit& unit, const Sink& emit) const {
+    ResultStore store;
+    try {
+        store.load(checkpoint_path(unit));
+    } catch (const std::runtime_error&) {
+        return false;
+    }
+    DirichletCharacter rep = DirichletCharacter::from_index(unit.prime, unit.prime, unit.representative);
+    std::vector<ReidLiResult> results;
+    for (const DirichletCharacter& c : rep.galois_orbit()) {
+        auto sides = store.find(sides_key(unit.prime, c.index()), unit.precision, 2);
+        if (!sides) {
+            return false;
+        }
+        ReidLiResult r = ReidLi::compare(c, (*sides)[0], (*sides)[1], unit.precision,
+                                         config.sweep.tolerance);
+        r.character_index = c.index();
+        results.push_back(std::move(r));
+    }
+    for (const ReidLiResult& r : results) {
+        emit(r);
+    }
+    return true;
+}
+
+ReidLiSweepSummary ReidLiSweep::run(const Sink& sink) const {
+    std::vector<size_t> todo;
+    if (config.dynamic) {
+        for (size_t i = 0; i < units.size(); ++i) todo.push_back(i);
+    } else {
+        todo = share(config.worker);
+    }
+
+    ReidLiSweepSummary summary;
+    summary.units = static_cast<long>(todo.size());
+    std::set<long> primes;
+    for (size_t i : todo) primes.insert(units[i].prime);
+    summary.results.primes = static_cast<long>(primes.size());
+
+    std::mutex mutex;
+    Sink emit = [&](const ReidLiResult& r) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++summary.results.characters;
+        if (!r.error.empty()) {
+            ++summary.results.errors;
+        } else if (r.matches) {
+            ++summary.results.matched;
+        } else {
+            ++summary.results.failed;
+        }
+        if (sink) {
+            sink(r);
+        }
+    };
+    auto count = [&](long ReidLiSweepSummary::*field) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++(summary.*field);
+    };
+    const std::string me = std::to_string(config.worker);
+
+    ThreadPool pool(config.sweep.threads);
+    for (size_t i : todo) {
+        pool.submit([this, i, &me, &emit, &count]() {
+            const ReidLiUnit& unit = units[i];
+            std::string claim = claim_path(unit);
+
+            if (file_exists(checkpoint_path(unit))) {
+                bool mine = !config.dynamic || claim_owner(claim) == me;
+                if (mine && load_checkpoint(unit, emit)) {
+                    count(&ReidLiSweepSummary::resumed);
+                    return;
+                }
+                if (!mine) {
+                    count(&ReidLiSweepSummary::elsewhere);
+                    return;
+                }
+            }
+            if (config.dynamic && !try_claim(claim, me, false)) {
+                // Claimed earlier by this worker (an interrupted run), by a
+                // stopped worker when reclaiming, or by a running one
+                if (claim_owner(claim) != me && !config.reclaim) {
+                    count(&ReidLiSweepSummary::elsewhere);
+                    return;
+                }
+                try_claim(claim, me, true);
+            }
+
+            long p = unit.prime, N = unit.precision;
+            DirichletCharacter rep = DirichletCharacter::from_index(p, p, unit.representative);
+            std::vector<DirichletCharacter> orbit = rep.galois_orbit();
+            std::vector<Qp> phi, psi;
+            bool batched = true;
+            try {
+                ReidLi::sides_orbit(rep, N, phi, psi);
+            } catch (const std::exception&) {
+                batched = false;
+            }
+
+            ResultStore checkpoint;
+            bool complete = true;
+            std::vector<ReidLiResult> results;
+            for (size_t j = 0; j < orbit.size(); ++j) {
+                const DirichletCharacter& c = orbit[j];
+                ReidLiResult r = batched
+                    ? ReidLi::compare(c, phi[j], psi[j], N, config.sweep.tolerance)
+                    : ReidLi::verify(c, N, config.sweep.tolerance);
+                r.character_index = c.index();
+                if (r.error.empty()) {
+                    checkpoint.insert(sides_key(p, c.index()), N, {r.phi_value, r.psi_value});
+                } else {
+                    complete = false;
+                }
+                results.push_back(std::move(r));
+            }
+
+            if (complete) {
+                checkpoint.save(checkpoint_path(unit));
+                count(&ReidLiSweepSummary::computed);
+            } else if (config.dynamic) {
+                std::remove(claim.c_str());
+            }
+            for (const ReidLiResult& r : results) {
+                emit(r);
+            }
+        });
+    }
+
+    pool.wait_idle();
+    return summary;
+}
+
+std::vector<ReidLiResult> ReidLiSweep::collect(size_t* missing) const {
+    std::vector<ReidLiResult> results;
+    size_t absent = 0;
+    Sink keep = [&results](const ReidLiResult& r) { results.push_back(r); };
+    for (const ReidLiUnit& unit : units) {
+        if (!load_checkpoint(unit, keep)) {
+            ++absent;
+        }
+    }
+    if (missing) {
+        *missing = absent;
+    }
+    std::sort(results.begin(), results.end(), [](const ReidLiResult& a, const ReidLiResult& b) {
+        return a.prime != b.prime ? a.prime < b.prime : a.character_index < b.character_index;
+    });
+    return results;
+}
+
+} // namespace libadic
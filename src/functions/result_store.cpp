@@ -0,0 +1,157 @@
+#include "libadic/result_store.h"
+#include "libadic/serialization.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace libadic {
+
+namespace {
+
+const char magic[8] = {'L', 'I', 'B', 'A', 'D', 'I', 'C', 'S'};
+
+} // namespace
+
+ResultStore& ResultStore::instance() {
+    static ResultStore store;
+    return store;
+}
+
+std::optional<std::vector<Qp>> ResultStore::find(const Key& key, long precision, size_t min_length) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(key);
+    if (it == entries.end() || it->second.precision < precision ||
+        it->second.values.size() < min_length) {
+        return std::nullopt;
+    }
+    std::vector<Qp> values;
+    values.reserve(it->second.values.size());
+    for (const Qp& x : it->second.values) {
+        values.push_back(x.with_precision(std::min(precision, x.get_precision())));
+    }
+    return values;
+}
+
+void ResultStore::insert(const Key& key, long precision, std::vector<Qp> values) {
+    std::lock_guard<std::mutex> lock(mutex);
+    insert_locked(key, precision, std::move(values));
+}
+
+void ResultStore::insert_locked(const Key& key, long precision, std::vector<Qp> values) {
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+        entries.emplace(key, Entry{precision, std::move(values)});
+        return;
+    }
+    Entry& e = it->second;
+    if (precision > e.precision ||
+        (precision == e.precision && values.size() > e.values.size())) {
+        e.precision = precision;
+        e.values = std::move(values);
+    }
+}
+
+size_t ResultStore::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("ResultStore: cannot open " + path);
+    }
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (bytes.size() < 8 || std::memcmp(bytes.data(), magic, 8) != 0) {
+        throw std::runtime_error("ResultStore: " + path + " is not a result store");
+    }
+
+    // Parse everything before merging so a corrupt file leaves the store untouched
+    BinaryReader reader(bytes.data() + 8, bytes.size() - 8);
+    uint64_t version = reader.read_uvarint();
+    if (version != format_version) {
+        throw std::runtime_error("ResultStore: unsupported format version " + std::to_string(version));
+    }
+    uint64_t count = reader.read_uvarint();
+    std::vector<std::pair<Key, Entry>> records;
+    for (uint64_t r = 0; r < count; ++r) {
+        Key key;
+        key.table = static_cast<Table>(reader.read_u8());
+        uint64_t fields = reader.read_uvarint();
+        if (fields > 64) {
+            throw std::runtime_error("ResultStore: corrupt key record");
+        }
+        for (uint64_t i = 0; i < fields; ++i) {
+            key.fields.push_back(static_cast<long>(reader.read_varint()));
+        }
+        uint64_t tag_length = reader.read_uvarint();
+        if (tag_length > reader.remaining()) {
+            throw std::runtime_error("ResultStore: corrupt key record");
+        }
+        key.tag.assign(reinterpret_cast<const char*>(reader.read_bytes(tag_length)), tag_length);
+        Entry entry;
+        entry.precision = static_cast<long>(reader.read_varint());
+        uint64_t values = reader.read_uvarint();
+        if (values > reader.remaining()) {
+            throw std::runtime_error("ResultStore: corrupt value record");
+        }
+        entry.values.reserve(values);
+        for (uint64_t i = 0; i < values; ++i) {
+            entry.values.push_back(reader.read_qp());
+        }
+        records.emplace_back(std::move(key), std::move(entry));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& record : records) {
+        insert_locked(record.first, record.second.precision, std::move(record.second.values));
+    }
+    return records.size();
+}
+
+void ResultStore::save(const std::string& path) const {
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("ResultStore: cannot write " + temporary);
+        }
+        BinaryWriter writer(out);
+        writer.write_bytes(magic, 8);
+        writer.write_uvarint(format_version);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        writer.write_uvarint(entries.size());
+        for (const auto& kv : entries) {
+            const Key& key = kv.first;
+            writer.write_u8(static_cast<uint8_t>(key.table));
+            writer.write_uvarint(key.fields.size());
+            for (long f : key.fields) {
+                writer.write_varint(f);
+            }
+            writer.write_uvarint(key.tag.size());
+            writer.write_bytes(key.tag.data(), key.tag.size());
+            writer.write_varint(kv.second.precision);
+            writer.write_uvarint(kv.second.values.size());
+            for (const Qp& x : kv.second.values) {
+                writer.write(x);
+            }
+        }
+        if (!out.flush()) {
+            throw std::runtime_error("ResultStore: write to " + temporary + " failed");
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("ResultStore: cannot replace " + path);
+    }
+}
+
+size_t ResultStore::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+void ResultStore::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+}
+
+} // namespace libadic
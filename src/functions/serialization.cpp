@@ -0,0 +1,279 @@
+#include "libadic/serialization.h"
+#include <climits>
+#include <stdexcept>
+#include <vector>
+
+namespace libadic {
+
+namespace {
+
+// Bounds that reject corrupt headers before they turn into huge allocations
+constexpr uint64_t max_limbs = uint64_t(1) << 24;
+constexpr uint64_t max_count = uint64_t(1) << 24;
+constexpr long max_modulus = 1L << 20;  // characters build O(modulus) tables
+
+// Smallest encoded Qp: tag, four one-byte varints and an empty limb count
+constexpr size_t min_qp_bytes = 6;
+
+long checked_long(int64_t x) {
+    if (x < static_cast<int64_t>(LONG_MIN) || x > static_cast<int64_t>(LONG_MAX)) {
+        throw std::runtime_error("Wire value out of range");
+    }
+    return static_cast<long>(x);
+}
+
+} // namespace
+
+void BinaryWriter::write_u8(uint8_t x) {
+    out.put(static_cast<char>(x));
+    ++written;
+}
+
+void BinaryWriter::write_uvarint(uint64_t x) {
+    unsigned char bytes[10];
+    size_t n = 0;
+    do {
+        unsigned char b = static_cast<unsigned char>(x & 0x7f);
+        x >>= 7;
+        bytes[n++] = static_cast<unsigned char>(b | (x ? 0x80 : 0));
+    } while (x);
+    write_bytes(bytes, n);
+}
+
+void BinaryWriter::write_varint(int64_t x) {
+    uint64_t u = static_cast<uint64_t>(x);
+    write_uvarint((u << 1) ^ (x < 0 ? ~uint64_t(0) : 0));
+}
+
+void BinaryWriter::write_bytes(const void* bytes, size_t n) {
+    out.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(n));
+    written += n;
+}
+
+void BinaryWriter::write_limbs(const BigInt& x) {
+    if (mpz_sgn(x.get_mpz()) < 0) {
+        throw std::invalid_argument("Only non-negative residues go on the wire");
+    }
+    size_t limbs = mpz_sgn(x.get_mpz()) == 0 ? 0 : (mpz_sizeinbase(x.get_mpz(), 2) + 63) / 64;
+    write_uvarint(limbs);
+    if (limbs == 0) return;
+    std::vector<unsigned char> bytes(limbs * 8, 0);
+    mpz_export(bytes.data(), nullptr, -1, 8, -1, 0, x.get_mpz());
+    write_bytes(bytes.data(), bytes.size());
+}
+
+void BinaryWriter::write(const Zp& x) {
+    write_u8(static_cast<uint8_t>(WireTag::Zp));
+    write_varint(x.get_prime());
+    write_varint(x.get_precision());
+    write_limbs(x.get_value());
+}
+
+void BinaryWriter::write(const Qp& x) {
+    write_u8(static_cast<uint8_t>(WireTag::Qp));
+    write_varint(x.get_prime());
+    write_varint(x.get_precision());
+    if (x.is_zero()) {
+        write_varint(x.get_precision());
+        write_varint(0);
+        write_uvarint(0);
+        return;
+    }
+    write_varint(x.valuation());
+    write_varint(x.get_unit().get_precision());
+    write_limbs(x.get_unit().get_value());
+}
+
+void BinaryWriter::write(const Cyclotomic& x) {
+    write_u8(static_cast<uint8_t>(WireTag::Cyclotomic));
+    write_varint(x.get_prime());
+    write_varint(x.get_precision());
+    write_uvarint(x.get_coeffs().size());
+    for (const Qp& c : x.get_coeffs()) {
+        write(c);
+    }
+}
+
+void BinaryWriter::write(const DirichletCharacter& chi) {
+    write_u8(static_cast<uint8_t>(WireTag::Character));
+    write_varint(chi.get_modulus());
+    write_varint(chi.get_prime());
+    write_varint(chi.get_conductor());
+    write_uvarint(chi.generators.size());
+    for (size_t i = 0; i < chi.generators.size(); ++i) {
+        write_varint(chi.generators[i]);
+        write_varint(chi.generator_orders[i]);
+        write_varint(chi.character_values[i]);
+    }
+}
+
+uint64_t ZpView::limb(size_t i) const {
+    uint64_t x = 0;
+    for (int b = 0; b < 8; ++b) {
+        x |= static_cast<uint64_t>(limbs[8 * i + b]) << (8 * b);
+    }
+    return x;
+}
+
+void ZpView::value_into(BigInt& out) const {
+    if (limb_count == 0) {
+        mpz_set_ui(out.get_mpz(), 0);
+        return;
+    }
+    mpz_import(out.get_mpz(), limb_count, -1, 8, -1, 0, limbs);
+}
+
+Zp ZpView::to_zp() const {
+    BigInt value;
+    value_into(value);
+    return Zp(prime, precision, value);
+}
+
+Qp QpView::to_qp() const {
+    if (is_zero()) {
+        return Qp(prime, precision, 0);
+    }
+    return Qp(prime, precision, valuation, unit.to_zp());
+}
+
+const unsigned char* BinaryReader::take(size_t n) {
+    if (n > size - offset) {
+        throw std::runtime_error("Truncated wire data");
+    }
+    const unsigned char* p = data + offset;
+    offset += n;
+    return p;
+}
+
+uint8_t BinaryReader::read_u8() {
+    return *take(1);
+}
+
+uint64_t BinaryReader::read_uvarint() {
+    uint64_t x = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t b = read_u8();
+        x |= static_cast<uint64_t>(b & 0x7f) << shift;
+        if (!(b & 0x80)) {
+            return x;
+        }
+    }
+    throw std::runtime_error("Malformed varint in wire data");
+}
+
+int64_t BinaryReader::read_varint() {
+    uint64_t u = read_uvarint();
+    return static_cast<int64_t>((u >> 1) ^ (~(u & 1) + 1));
+}
+
+WireTag BinaryReader::peek_tag() const {
+    if (offset >= size) {
+        throw std::runtime_error("Truncated wire data");
+    }
+    return static_cast<WireTag>(data[offset]);
+}
+
+void BinaryReader::expect(WireTag tag) {
+    if (read_u8() != static_cast<uint8_t>(tag)) {
+        throw std::runtime_error("Unexpected value type in wire data");
+    }
+}
+
+ZpView BinaryReader::read_zp_body(long prime, long precision) {
+    ZpView view;
+    view.prime = prime;
+    view.precision = precision;
+    uint64_t limbs = read_uvarint();
+    if (limbs > max_limbs) {
+        throw std::runtime_error("Corrupt limb count in wire data");
+    }
+    view.limb_count = static_cast<size_t>(limbs);
+    view.limbs = take(view.limb_count * 8);
+    return view;
+}
+
+ZpView BinaryReader::read_zp_view() {
+    expect(WireTag::Zp);
+    long p = checked_long(read_varint());
+    long N = checked_long(read_varint());
+    if (p < 2 || N < 1) {
+        throw std::runtime_error("Corrupt Zp header in wire data");
+    }
+    return read_zp_body(p, N);
+}
+
+QpView BinaryReader::read_qp_view() {
+    expect(WireTag::Qp);
+    QpView view;
+    view.prime = checked_long(read_varint());
+    view.precision = checked_long(read_varint());
+    view.valuation = checked_long(read_varint());
+    long unit_precision = checked_long(read_varint());
+    if (view.prime < 2 || view.precision < 1 || unit_precision < 0) {
+        throw std::runtime_error("Corrupt Qp header in wire data");
+    }
+    view.unit = read_zp_body(view.prime, unit_precision);
+    if (!view.is_zero() && unit_precision < 1) {
+        throw std::runtime_error("Corrupt Qp header in wire data");
+    }
+    return view;
+}
+
+Cyclotomic BinaryReader::read_cyclotomic() {
+    expect(WireTag::Cyclotomic);
+    long p = checked_long(read_varint());
+    long N = checked_long(read_varint());
+    uint64_t count = read_uvarint();
+    // Q_p(ζ) has exactly p-1 coordinates; check the header against the bytes
+    // left before anything is sized from it
+    if (p < 2 || N < 1 || count > max_count || count != static_cast<uint64_t>(p - 1) ||
+        mpz_probab_prime_p(BigInt(p).get_mpz(), 30) == 0) {
+        throw std::runtime_error("Corrupt Cyclotomic header in wire data");
+    }
+    if (count > remaining() / min_qp_bytes) {
+        throw std::runtime_error("Truncated Cyclotomic in wire data");
+    }
+    std::vector<Qp> coeffs;
+    coeffs.reserve(static_cast<size_t>(count));
+    for (uint64_t i = 0; i < count; ++i) {
+        coeffs.push_back(read_qp());
+        if (coeffs.back().get_prime() != p) {
+            throw std::runtime_error("Cyclotomic coefficient prime does not match its header");
+        }
+    }
+    return Cyclotomic(p, N, coeffs);
+}
+
+DirichletCharacter BinaryReader::read_character() {
+    expect(WireTag::Character);
+    long modulus = checked_long(read_varint());
+    long p = checked_long(read_varint());
+    long conductor = checked_long(read_varint());
+    uint64_t count = read_uvarint();
+    if (modulus < 1 || modulus > max_modulus || p < 2 || conductor < 1 || conductor > modulus ||
+        count > 64) {
+        throw std::runtime_error("Corrupt character header in wire data");
+    }
+
+    // The group table fixes the generators; the stored ones only validate it
+    DirichletCharacter chi(modulus, p);
+    if (chi.generators.size() != count) {
+        throw std::runtime_error("Character generators do not match this modulus");
+    }
+    for (size_t i = 0; i < count; ++i) {
+        long g = checked_long(read_varint());
+        long order = checked_long(read_varint());
+        long value = checked_long(read_varint());
+        if (g != chi.generators[i] || order != chi.generator_orders[i] || value < 0 || value >= order) {
+            throw std::runtime_error("Character generators do not match this modulus");
+        }
+        chi.character_values[i] = value;
+    }
+    chi.compute_conductor();
+    if (chi.conductor != conductor) {
+        throw std::runtime_error("Character conductor does not match its values");
+    }
+    return chi;
+}
+
+} // namespace libadic
@@ -2,6 +2,7 @@
 #include "libadic/padic_gamma.h"
 #include "libadic/l_functions.h"
 #include "libadic/characters.h"
+#include "libadic/reid_li.h"
 #include "libadic/test_framework.h"
 #include <iostream>
 #include <vector>
@@ -11,156 +12,35 @@
 using namespace libadic;
 using namespace libadic::test;
 
-struct ReidLiTestResult {
-    long prime;
-    long character_id;
-    bool is_odd;
-    bool is_primitive;
-    Qp phi_value;
-    Qp psi_value;
-    bool matches;
-    long precision_achieved;
-};
-
-/**
- * Compute Φ_p^{(odd)}(χ) = Σ_{a=1}^{p-1} χ(a) * log_p(Γ_p(a))
- * For odd characters according to Reid-Li
- */
-Qp compute_phi_odd(const DirichletCharacter& chi, long p, long N) {
-    Qp result(p, N, 0);
-    
-    // Sum over a = 1, ..., p-1 where (a,p) = 1
-    for (long a = 1; a < p; ++a) {
-        // Evaluate character at a
-        Zp chi_a = chi.evaluate(a, N);
-        
-        if (!chi_a.is_zero()) {
-            // Create Zp for a
-            Zp a_zp(p, N, a);
-            
-            // Use PadicGamma::log_gamma which internally handles Iwasawa logarithm
-            Qp log_gamma = PadicGamma::log_gamma(a_zp);
-            result += Qp(chi_a) * log_gamma;
-        }
-    }
-    
-    return result;
-}
-
-/**
- * Compute Ψ_p^{(odd)}(χ) = L'_p(0, χ)
- * Derivative of Kubota-Leopoldt L-function at s=0
- */
-Qp compute_psi_odd(const DirichletCharacter& chi, long N) {
-    return LFunctions::kubota_leopoldt_derivative(0, chi, N);
-}
-
-/**
- * Compute Φ_p^{(even)}(χ) = Σ_{a=1}^{p-1} χ(a) * log_p(a/(p-1))
- */
-Qp compute_phi_even(const DirichletCharacter& chi, long p, long N) {
-    Qp result(p, N, 0);
-    
-    for (long a = 1; a < p; ++a) {
-        Zp chi_a = chi.evaluate(a, N);
-        
-        if (!chi_a.is_zero()) {
-            // Compute a/(p-1) in Q_p
-            Qp ratio = Qp::from_rational(a, p - 1, p, N);
-            
-            // Check convergence for log_p
-            if (ratio.valuation() == 0) {
-                Qp ratio_minus_one = ratio - Qp(p, N, 1);
-                
-                // Check if ≡ 1 (mod p) for convergence
-                if ((p != 2 && ratio_minus_one.valuation() >= 1) ||
-                    (p == 2 && ratio_minus_one.valuation() >= 2)) {
-                    Qp log_term = PadicLog::log(ratio);
-                    result += Qp(chi_a) * log_term;
-                }
-            }
-        }
-    }
-    
-    return result;
-}
-
-/**
- * Compute Ψ_p^{(even)}(χ) = L_p(0, χ)
- * Kubota-Leopoldt L-function at s=0
- */
-Qp compute_psi_even(const DirichletCharacter& chi, long N) {
-    return LFunctions::kubota_leopoldt(0, chi, N);
-}
-
-bool test_reid_li_for_character(const DirichletCharacter& chi, long p, long N, ReidLiTestResult& result) {
-    result.prime = p;
-    result.character_id = chi.get_order();  // Use order as ID
-    result.is_odd = chi.is_odd();
-    result.is_primitive = chi.is_primitive();
-    
-    try {
-        if (chi.is_odd()) {
-            result.phi_value = compute_phi_odd(chi, p, N);
-            result.psi_value = compute_psi_odd(chi, N);
-        } else {
-            result.phi_value = compute_phi_even(chi, p, N);
-            result.psi_value = compute_psi_even(chi, N);
-        }
-        
-        // Check if values match within precision
-        Qp diff = result.phi_value - result.psi_value;
-        
-        if (diff.is_zero()) {
-            result.matches = true;
-            result.precision_achieved = N;
-        } else {
-            result.precision_achieved = diff.valuation();
-            // Allow some tolerance for computational errors
-            result.matches = (result.precision_achieved >= N - 5);
-        }
-        
-        return result.matches;
-        
-    } catch (const std::exception& e) {
-        std::cerr << "Error computing for character: " << e.what() << std::endl;
-        result.matches = false;
-        result.precision_achieved = 0;
-        return false;
-    }
-}
-
 void run_reid_li_test(long p, long N) {
     std::cout << "\n========================================\n";
     std::cout << "Testing Reid-Li Criterion for p = " << p << ", precision = " << N << "\n";
     std::cout << "========================================\n\n";
     
-    // Enumerate all primitive characters modulo p
-    auto characters = DirichletCharacter::enumerate_primitive_characters(p, p);
+    // Sweep all primitive characters modulo p (Φ and Ψ per character run
+    // in parallel; results come back ordered by character index)
+    ReidLiConfig config;
+    config.min_prime = p;
+    config.max_prime = p;
+    config.precision = N;
+    std::vector<ReidLiResult> results = ReidLiEngine(config).run();
     
-    std::cout << "Found " << characters.size() << " primitive characters modulo " << p << "\n\n";
+    std::cout << "Found " << results.size() << " non-principal primitive characters modulo " << p << "\n\n";
     
-    std::vector<ReidLiTestResult> results;
     int total_tests = 0;
     int passed_tests = 0;
     
-    for (const auto& chi : characters) {
-        if (chi.is_principal()) {
-            // Skip trivial character
-            continue;
+    for (const auto& result : results) {
+        if (!result.error.empty()) {
+            std::cerr << "Error computing for character: " << result.error << std::endl;
         }
-        
-        ReidLiTestResult result;
-        bool success = test_reid_li_for_character(chi, p, N, result);
-        
-        if (success) {
+        if (result.matches) {
             passed_tests++;
         }
         total_tests++;
-        results.push_back(result);
         
         std::cout << (result.is_odd ? "ODD " : "EVEN") 
-                  << " character (order " << result.character_id << "): ";
+                  << " character (order " << result.order << "): ";
         
         if (result.phi_value.valuation() < N && result.psi_value.valuation() < N) {
             std::cout << "\n  Φ_p = " << result.phi_value.to_string() 
@@ -186,7 +66,7 @@ void run_reid_li_test(long p, long N) {
         for (const auto& r : results) {
             if (!r.matches) {
                 std::cout << "  " << (r.is_odd ? "ODD" : "EVEN") 
-                          << " character (order " << r.character_id 
+                          << " character (order " << r.order 
                           << "), precision achieved: " << r.precision_achieved << "\n";
             }
         }
@@ -1,7 +1,21 @@
 #include "libadic/padic_log.h"
 #include "libadic/padic_gamma.h"
+#include "libadic/l_functions.h"
+#include "libadic/log_gamma_table.h"
+#include "libadic/log_gamma_mahler.h"
+#include "libadic/gamma_engine.h"
+#include "libadic/factorial_table.h"
+#include "libadic/precision_tracker.h"
+#include "libadic/inverse_table.h"
+#include "libadic/modular_arith.h"
+#include "libadic/stats.h"
+#include "libadic/limb_pool.h"
+#include "libadic/characters.h"
+#include "libadic/character_sums.h"
+#include "libadic/cache.h"
 #include "libadic/test_framework.h"
 #include <cmath>
+#include <thread>
 
 using namespace libadic;
 using namespace libadic::test;
@@ -339,6 +353,708 @@ void test_convergence_radius() {
     test.require_all_passed();
 }
 
+void test_sharded_cache() {
+    TestFramework test("Sharded Library Caches");
+    
+    ShardedCache<long, long> cache("test_cache", [](const long&, const long&) { return size_t(100); }, 4);
+    cache.set_budget(4 * 1000);  // 10 entries per shard
+    
+    test.assert_true(!cache.find(1).has_value(), "Empty cache misses");
+    cache.insert(1, 10);
+    test.assert_true(cache.find(1).value_or(0) == 10, "Inserted value is found");
+    cache.insert(1, 11);
+    test.assert_true(cache.find(1).value_or(0) == 11, "Re-insert replaces the value");
+    
+    for (long k = 0; k < 1000; ++k) {
+        cache.insert(k, k * k);
+    }
+    CacheStats st = cache.stats();
+    test.assert_true(st.bytes <= st.budget, "Footprint stays within budget");
+    test.assert_true(st.entries <= 40, "Entry count bounded by budget");
+    test.assert_true(st.evictions > 0, "Evictions were recorded");
+    test.assert_true(cache.find(999).value_or(0) == 999 * 999, "Most recent entry survives eviction");
+    test.assert_true(st.hits == 2 && st.misses == 1, "Hit and miss counters");
+    
+    long computed = cache.get_or_compute(5000, []() { return 42L; });
+    test.assert_true(computed == 42 && cache.find(5000).value_or(0) == 42, "get_or_compute stores its result");
+    
+    // An entry above budget / shards is kept while it fits the whole budget
+    ShardedCache<long, long> sized("test_sized_cache", [](const long&, const long& bytes) {
+        return static_cast<size_t>(bytes);
+    }, 4);
+    sized.set_budget(4000);
+    for (long k = 0; k < 20; ++k) {
+        sized.insert(k, 100);
+    }
+    sized.insert(100, 2500);
+    test.assert_true(sized.find(100).value_or(0) == 2500, "Entry larger than its shard's share stays cached");
+    test.assert_true(sized.stats().bytes <= 4000, "Other shards make room within the cache budget");
+    sized.insert(101, 2500);
+    CacheStats big = sized.stats();
+    test.assert_true(sized.find(101).value_or(0) == 2500 && big.bytes <= 4000,
+                     "A second large entry displaces the first rather than overflowing");
+    sized.insert(102, 5000);
+    test.assert_true(!sized.find(102).has_value() && sized.stats().bytes <= 4000,
+                     "Entry larger than the whole budget is not kept");
+    
+    // Concurrent L-value computation agrees with a serial run
+    long p = 7;
+    long N = 10;
+    auto chars = DirichletCharacter::enumerate_primitive_characters(p, p);
+    LFunctions::clear_cache();
+    std::vector<Qp> serial;
+    for (const auto& chi : chars) {
+        serial.push_back(LFunctions::kubota_leopoldt(0, chi, N));
+    }
+    
+    LFunctions::clear_cache();
+    std::vector<std::vector<Qp>> parallel(4);
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < parallel.size(); ++t) {
+        workers.emplace_back([&, t]() {
+            for (const auto& chi : chars) {
+                parallel[t].push_back(LFunctions::kubota_leopoldt(0, chi, N));
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+    
+    bool all_match = true;
+    for (const auto& run : parallel) {
+        for (size_t i = 0; i < chars.size(); ++i) {
+            all_match = all_match && run[i] == serial[i];
+        }
+    }
+    test.assert_true(all_match, "Threads sharing the caches reproduce serial L-values");
+    
+    bool found_l_cache = false;
+    for (const CacheStats& s : LFunctions::cache_stats()) {
+        if (s.name == "LFunctions::l_cache") {
+            found_l_cache = s.entries > 0 && s.hits > 0;
+        }
+    }
+    test.assert_true(found_l_cache, "cache_stats reports the populated L-value cache");
+    
+    LFunctions::set_cache_budget(0);
+    bool all_empty = true;
+    for (const CacheStats& s : LFunctions::cache_stats()) {
+        all_empty = all_empty && s.entries == 0;
+    }
+    test.assert_true(all_empty, "A zero budget evicts everything");
+    LFunctions::set_cache_budget(size_t(256) << 20);
+    
+    test.report();
+    test.require_all_passed();
+}
+
+void test_log_gamma_table() {
+    TestFramework test("LogGammaTable");
+
+    long p = 11;
+    long N = 12;
+    LogGammaTable serial(p, N);
+    LogGammaTable parallel(p, N, 4);
+
+    bool serial_matches = true;
+    bool parallel_matches = true;
+    for (long a = 1; a < p; ++a) {
+        Qp direct = PadicGamma::log_gamma(Zp(p, N, a));
+        serial_matches = serial_matches && serial.at(a) == direct;
+        parallel_matches = parallel_matches && parallel.at(a) == direct;
+    }
+    test.assert_true(serial_matches, "Table entries equal PadicGamma::log_gamma(a)");
+    test.assert_true(parallel_matches, "Parallel build matches serial build");
+
+    auto first = LogGammaTable::get(p, N);
+    auto second = LogGammaTable::get(p, N);
+    test.assert_true(first.get() == second.get(), "get() returns the shared table for (p, N)");
+    test.assert_true(LogGammaTable::get(p, N + 1).get() != first.get(),
+                     "Different precision gets its own table");
+
+    bool threw = false;
+    try {
+        serial.at(p);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    test.assert_true(threw, "at(p) is out of range");
+
+    test.report();
+    test.require_all_passed();
+}
+
+void test_character_sum_batch() {
+    TestFramework test("CharacterSumBatch");
+
+    // 12 = 2·2·3 and 10 = 2·5 exercise repeated and mixed radices
+    for (long p : {7L, 11L, 13L}) {
+        long N = 8;
+        auto batch = CharacterSumBatch::get(p, N);
+        auto chars = DirichletCharacter::enumerate_characters(p, p);
+
+        bool logs_ok = true;
+        for (long a = 1; a < p; ++a) {
+            long e = batch->discrete_log(a);
+            long g_e = 1;
+            for (long i = 0; i < e; ++i) g_e = (g_e * batch->get_generator()) % p;
+            logs_ok = logs_ok && g_e == a;
+        }
+        test.assert_true(logs_ok, "g^log(a) = a for p=" + std::to_string(p));
+
+        // f(a) = a^2 + 3 has no symmetry the transform could get away with
+        std::vector<Qp> sums = batch->sum([p, N](long a) { return Qp(p, N, a * a + 3); });
+        std::vector<Qp> B1 = LFunctions::compute_B1_chi_all(p, N);
+
+        bool sums_ok = sums.size() == chars.size();
+        bool B1_ok = sums_ok;
+        for (size_t k = 0; sums_ok && k < chars.size(); ++k) {
+            Qp direct(p, N, 0);
+            for (long a = 1; a < p; ++a) {
+                direct.addmul(Qp(chars[k].evaluate(a, N)), Qp(p, N, a * a + 3));
+            }
+            sums_ok = CharacterSumBatch::index_of(chars[k]) == static_cast<long>(k) &&
+                      (sums[k] - direct).valuation() >= N;
+            B1_ok = B1_ok && (B1[k] - LFunctions::compute_B1_chi(chars[k], N)).is_zero();
+        }
+        test.assert_true(sums_ok, "Batched sums match direct per-character sums for p=" + std::to_string(p));
+        test.assert_true(B1_ok, "compute_B1_chi_all matches compute_B1_chi for p=" + std::to_string(p));
+        bool B1_words = true;
+        for (size_t k = 1; k < chars.size(); ++k) {
+            B1_words = B1_words && LFunctions::compute_B1_chi(chars[k], 12) ==
+                                       LFunctions::compute_B1_chi(chars[k], 90).with_precision(11);
+        }
+        test.assert_true(B1_words, "Word-sized B_{1,χ} agrees with the mpz sum for p=" + std::to_string(p));
+    }
+
+    // Forcing either path through the cost model gives the same sums
+    CharacterSumCosts defaults = CharacterSumBatch::cost_model();
+    CharacterSumCosts qp_only, rns_only;
+    qp_only.word_term = 1e9;
+    rns_only.qp_base = 1e9;
+    long q = 107;
+    auto batch = CharacterSumBatch::get(q, 10);
+    std::vector<Qp> f(static_cast<size_t>(q), Qp(q, 10, 0));
+    for (long x = 1; x < q; ++x) f[x] = Qp(q, 10, BigInt(x + 5).pow(33));
+    CharacterSumBatch::set_cost_model(qp_only);
+    std::vector<Qp> via_qp = batch->sum(f);
+    CharacterSumBatch::set_cost_model(rns_only);
+    std::vector<Qp> via_rns = batch->sum(f);
+    CharacterSumBatch::set_cost_model(defaults);
+    test.assert_true(via_qp == via_rns, "Cost model override switches paths without changing sums");
+    CharacterSumCosts measured = CharacterSumBatch::calibrate();
+    test.assert_true(measured.word_term > 0 && measured.qp_base + measured.qp_per_bit > 0,
+                     "Calibration measures positive costs");
+    bool threw = false;
+    try {
+        CharacterSumCosts negative;
+        negative.convert = -1;
+        CharacterSumBatch::set_cost_model(negative);
+    } catch (const std::invalid_argument&) { threw = true; }
+    test.assert_true(threw, "Negative costs rejected");
+
+    test.report();
+    test.require_all_passed();
+}
+
+void test_fast_log_exp() {
+    TestFramework test("Reduced binary-splitting log and Newton exp");
+
+    for (long p : {2L, 3L, 5L, 101L}) {
+        long N = 40;
+        BigInt a(p == 2 ? 5 : 1 + p);
+        BigInt b(p == 2 ? 13 : 1 + 3 * p * p);
+        Qp x(p, N, a);
+        Qp y(p, N, b);
+        Qp log_x = PadicLog::log(x);
+        std::string tag = " for p=" + std::to_string(p);
+
+        test.assert_true(log_x == PadicLog::log_series(x), "log matches the term-by-term series" + tag);
+        test.assert_true(log_x == PadicLog::log(Qp(p, 3 * N, a)).with_precision(N),
+                         "log is stable under higher input precision" + tag);
+        test.assert_true(PadicLog::log(x * y) == log_x + PadicLog::log(y), "log(xy) = log x + log y" + tag);
+        test.assert_true(PadicLog::exp(log_x) == x, "exp(log x) = x" + tag);
+
+        Qp t = Qp(p, N, p == 2 ? 4 : p) * Qp(p, N, 7);
+        test.assert_true(PadicLog::log(PadicLog::exp(t)) == t, "log(exp t) = t" + tag);
+    }
+
+    // The word kernel (p^{N+k+V} fits) against the mpz reduction at N = 90
+    bool words_ok = true;
+    std::vector<Qp> word_args;
+    for (long p : {2L, 3L, 7L, 11L, 101L}) {
+        for (long N : {2L, 5L, 16L}) {
+            for (long a : {1L, 1 + p, 1 + 4 * p * p, 1 + 5 * p, 1 + p * p * p * p * p}) {
+                if (p == 2 && a % 4 != 1) continue;
+                Qp x(p, N, BigInt(a));
+                Qp value = PadicLog::log(x);
+                words_ok = words_ok && value == PadicLog::log(Qp(p, 90, BigInt(a))).with_precision(N) &&
+                           value.get_precision() == N;
+                if (p == 7) word_args.push_back(x);
+            }
+        }
+    }
+    word_args.push_back(Qp(7, 60, BigInt(8)));
+    test.assert_true(words_ok, "Word-sized log agrees with the mpz path");
+    std::vector<Qp> mixed = PadicLog::log_range(word_args);
+    bool mixed_ok = mixed.size() == word_args.size();
+    for (size_t i = 0; mixed_ok && i < word_args.size(); ++i) {
+        mixed_ok = mixed[i] == PadicLog::log(word_args[i]);
+    }
+    test.assert_true(mixed_ok, "log_range mixes word-sized and mpz values");
+
+    // Large N: a few hundred digits still agree with the series
+    Qp big(7, 300, BigInt(8));
+    test.assert_true(PadicLog::log(big) == PadicLog::log_series(big), "log at N = 300");
+
+    test.report();
+    test.require_all_passed();
+}
+
+void test_log_gamma_mahler_series() {
+    TestFramework test("LogGammaMahlerSeries");
+
+    for (long p : {2L, 5L, 7L}) {
+        long N = 8;
+        std::string tag = " for p=" + std::to_string(p);
+        BigInt modulus = BigInt(p).pow(N);
+        auto series = LogGammaMahlerSeries::get(p, N);
+
+        // Integers beyond p against Γ_p(n) = (-1)^n ∏_{j<n, p∤j} j
+        bool integers_ok = true;
+        bool gamma_ok = true;
+        BigInt product(1);
+        for (long n = 1; n <= 4 * p + 3; ++n) {
+            if (n > 1 && (n - 1) % p != 0) {
+                product = (product * BigInt(n - 1)) % modulus;
+            }
+            if (n % p == 0 || n < p) continue;
+            Zp expected(p, N, n % 2 == 0 ? product : modulus - product);
+            Zp x(p, N, n);
+            gamma_ok = gamma_ok && PadicGamma::gamma(x) == expected;
+            // IwasawaLog::log_iwasawa needs x^{p-1} ≡ 1 (mod 4) for p = 2
+            integers_ok = integers_ok && (p == 2 ||
+                series->evaluate(x).with_precision(N - 1) ==
+                IwasawaLog::log_iwasawa(expected).with_precision(N - 1));
+        }
+        test.assert_true(integers_ok, "evaluate(n) = log Γ_p(n)" + tag);
+        test.assert_true(gamma_ok, "Γ_p(n) from the series matches the product" + tag);
+
+        // Non-integer arguments: Γ_p(-1) = Γ_p(0) = 1, and the reflection formula
+        test.assert_true(PadicGamma::gamma(Zp(p, N, -1)) == Zp(p, N, 1), "Γ_p(-1) = 1" + tag);
+        if (p != 2) {
+            Zp third = Zp::from_rational(1, 3, p, N);
+            test.assert_true(PadicGamma::verify_reflection_formula(third, N),
+                             "Γ_p(1/3) Γ_p(2/3) = ±1" + tag);
+        }
+
+        std::vector<Qp> coeffs = LFunctions::compute_mahler_coefficients(p, N);
+        test.assert_true(coeffs.size() == series->required_terms() && coeffs[0].is_zero() &&
+                         series->coefficient(coeffs.size()) == series->coefficients(coeffs.size() + 1).back(),
+                         "coefficients are shared and extend lazily" + tag);
+    }
+
+    test.report();
+    test.require_all_passed();
+}
+
+void test_gamma_engine() {
+    TestFramework test("GammaEngine");
+
+    for (long p : {2L, 3L, 7L}) {
+        std::string tag = " for p=" + std::to_string(p);
+
+        // Integers against the defining product at moderate precision
+        long N = 12;
+        BigInt modulus = BigInt(p).pow(N);
+        auto engine = GammaEngine::get(p, N);
+        auto series = LogGammaMahlerSeries::get(p, N);
+        bool product_ok = true;
+        bool series_ok = true;
+        BigInt product(1);
+        for (long n = 1; n <= 6 * p + 5; ++n) {
+            if (n > 1 && (n - 1) % p != 0) {
+                product = (product * BigInt(n - 1)) % modulus;
+            }
+            if (n % p == 0) continue;
+            Zp x(p, N, n);
+            product_ok = product_ok && engine->gamma(x) == Zp(p, N, n % 2 == 0 ? product : modulus - product);
+            series_ok = series_ok && engine->log_gamma(x) == series->evaluate(x);
+        }
+        test.assert_true(product_ok, "Γ_p(n) matches ∏_{j<n, p∤j} j" + tag);
+        test.assert_true(series_ok, "log Γ_p(n) matches the Mahler series" + tag);
+        test.assert_true(engine->log_gamma(Zp(p, N, -5)) == series->evaluate(Zp(p, N, -5)),
+                         "log Γ_p(-5) matches the Mahler series" + tag);
+
+        // High precision: Γ_p(x + 4) = Γ_p(x) ∏_{i<4} (-(x+i) for units, -1 otherwise)
+        long M = 200;
+        Zp x = Zp::from_rational(11, 5, p, M);
+        Zp ratio(p, M, 1);
+        for (long i = 0; i < 4; ++i) {
+            Zp xi = x + Zp(p, M, i);
+            ratio = xi.is_unit() ? -ratio * xi : -ratio;
+        }
+        test.assert_true(GammaEngine::get(p, M)->gamma(x + Zp(p, M, 4)) == ratio * PadicGamma::gamma(x),
+                         "functional equation at N=200" + tag);
+        Zp y = Zp::from_rational(4, 5, p, M);
+        if (p != 2) {
+            test.assert_true(PadicGamma::verify_reflection_formula(y, M), "reflection formula at N=200" + tag);
+        }
+        test.assert_true(GammaEngine::get(p, M).get() == GammaEngine::get(p, M).get(),
+                         "engines are shared per (p, N)" + tag);
+    }
+
+    test.report();
+    test.require_all_passed();
+}
+
+void test_product_tree_factorials() {
+    TestFramework test("Product-tree factorials");
+
+    for (long p : {3L, 13L, 101L}) {
+        std::string tag = " for p=" + std::to_string(p);
+
+        // N = 60 forces the mpz path; both variants against the linear chain
+        long N = 60;
+        const PadicContext& ctx = PadicContext::get(p, N);
+        bool products_ok = true;
+        for (long hi : {0L, 1L, 7L, 250L, 3001L}) {
+            for (bool skip : {false, true}) {
+                BigInt expected(1);
+                for (long k = 1; k <= hi; ++k) {
+                    if (skip && k % p == 0) continue;
+                    expected = (expected * BigInt(k)) % ctx.modulus();
+                }
+                products_ok = products_ok && product_mod(1, hi, ctx, skip) == expected;
+            }
+        }
+        test.assert_true(products_ok, "product_mod matches the linear product" + tag);
+
+        // Prefix table against Γ_p(a) = (-1)^a (a-1)!
+        auto table = FactorialTable::get(p, N);
+        bool gamma_ok = true;
+        for (long a = 1; a < p; ++a) {
+            gamma_ok = gamma_ok && Zp(p, N, table->gamma(a)) == PadicGamma::gamma(Zp(p, N, a)) &&
+                       table->at(a - 1) == FactorialTable::factorial(a - 1, p, N);
+        }
+        test.assert_true(gamma_ok, "prefix factorials give Γ_p(a) for 0 < a < p" + tag);
+        test.assert_true(FactorialTable::get(p, N).get() == table.get(), "tables are shared per (p, N)" + tag);
+    }
+
+    // Beyond the tabulation bound factorial() computes directly
+    long big = 32771;
+    BigInt wilson = FactorialTable::factorial(big - 1, big, 2);
+    test.assert_true(wilson % BigInt(big) == BigInt(big - 1) &&
+                     wilson == product_mod(1, big - 1, PadicContext::get(big, 2), false),
+                     "untabulated factorial satisfies Wilson's theorem");
+
+    test.report();
+    test.require_all_passed();
+}
+
+void test_precision_tracker() {
+    TestFramework test("PrecisionTracker");
+
+    // Bounds against brute force
+    bool bounds_ok = true;
+    for (long p : {2L, 3L, 7L}) {
+        for (long n = 1; n <= 200; ++n) {
+            long max_v = 0;
+            long fact_v = 0;
+            for (long k = 1; k <= n; ++k) {
+                long v = 0;
+                for (long m = k; m % p == 0; m /= p) ++v;
+                max_v = std::max(max_v, v);
+                fact_v += v;
+            }
+            bounds_ok = bounds_ok && PrecisionTracker::max_index_valuation(p, n) == max_v &&
+                        PrecisionTracker::factorial_valuation(p, n) == fact_v;
+        }
+        for (long w : {1L, 2L, 5L}) {
+            long T = PrecisionTracker::series_terms(p, 60, w);
+            bool tail_ok = true;
+            for (long n = T + 1; n <= T + 300; ++n) {
+                tail_ok = tail_ok && n * w - PrecisionTracker::max_index_valuation(p, n) >= 60;
+            }
+            bounds_ok = bounds_ok && tail_ok && (T - 1) * w - PrecisionTracker::max_index_valuation(p, T - 1) < 60;
+        }
+    }
+    test.assert_true(bounds_ok, "max v_p(n), v_p(n!) and series_terms match brute force");
+
+    PrecisionTracker tracker(20);
+    tracker.divide(3).series(5, 30).divide(-2);
+    test.assert_equal(tracker.working(), 25L, "Losses add up to the working precision");
+    test.assert_equal(tracker.guaranteed(25), 20L, "Working precision guarantees the target");
+    test.assert_equal(tracker.guaranteed(23), 18L, "Short working precision is reported");
+
+    // The term-by-term log carries exactly the guard digits its terms need
+    bool log_ok = true;
+    for (long p : {2L, 5L, 13L}) {
+        for (long N : {3L, 25L, 120L}) {
+            for (long w : {p == 2 ? 2L : 1L, 3L}) {
+                Qp x = Qp(p, N, 1) + Qp(p, N, BigInt(p).pow(w) * BigInt(p == 2 ? 3 : 2));
+                Qp s = PadicLog::log_series(x);
+                log_ok = log_ok && s.get_precision() == N && s == PadicLog::log(x);
+            }
+        }
+    }
+    test.assert_true(log_ok, "log_series is exact to the input precision");
+
+    // Fractions a/f with p ∤ af go through Γ_p directly
+    Qp fractional = LFunctions::compute_log_gamma_fractional(2, 3, 7, 30);
+    test.assert_true(fractional == PadicGamma::log_gamma(Zp::from_rational(2, 3, 7, 30)) &&
+                     fractional.get_precision() == 30,
+                     "log Γ_p(2/3) at full precision");
+
+    test.report();
+    test.require_all_passed();
+}
+
+void test_multipoint_log() {
+    TestFramework test("Multipoint log and log Gamma");
+
+    // log_range against one log per value, mixed precisions and a zero log
+    bool logs_ok = true;
+    for (long p : {2L, 5L, 13L}) {
+        std::vector<Qp> values;
+        for (long j = 1; j <= 12; ++j) {
+            long N = 5 + 3 * j;
+            long step = p == 2 ? 4 : p;
+            values.push_back(Qp(p, N, 1 + step * j * (j + 1)));
+        }
+        values.push_back(Qp(p, 9, 1));
+        std::vector<Qp> logs = PadicLog::log_range(values);
+        logs_ok = logs_ok && logs.size() == values.size();
+        for (size_t i = 0; i < values.size() && logs_ok; ++i) {
+            Qp expected = PadicLog::log(values[i]);
+            logs_ok = logs[i] == expected && logs[i].get_precision() == expected.get_precision();
+        }
+    }
+    test.assert_true(logs_ok, "log_range matches log value by value");
+    test.assert_true(PadicLog::log_range({}).empty(), "log_range of nothing is empty");
+    bool threw = false;
+    try { (void)PadicLog::log_range({Qp(5, 10, 1), Qp(5, 10, 2)}); } catch (const std::domain_error&) { threw = true; }
+    test.assert_true(threw, "log_range checks every argument");
+
+    // log_gamma_range against log_gamma at units and Γ_p(x) = Γ_p(x+1) for p | x
+    for (long p : {3L, 7L, 31L}) {
+        long N = 12;
+        std::string tag = " for p=" + std::to_string(p);
+        for (long start : {1L, 2L, p, 3 * p + 2}) {
+            long count = 4 * p + 5;
+            std::vector<Qp> range = PadicGamma::log_gamma_range(p, N, start, count);
+            bool units_ok = range.size() == static_cast<size_t>(count);
+            bool multiples_ok = true;
+            for (long i = 0; i < count && units_ok; ++i) {
+                long x = start + i;
+                if (x % p != 0) {
+                    units_ok = range[i] == PadicGamma::log_gamma(Zp(p, N, x));
+                } else if (i + 1 < count) {
+                    multiples_ok = multiples_ok && range[i] == range[i + 1];
+                }
+            }
+            std::string where = tag + ", start=" + std::to_string(start);
+            test.assert_true(units_ok, "log_gamma_range matches log_gamma" + where);
+            test.assert_true(multiples_ok, "log_gamma_range is flat across p | x" + where);
+        }
+        test.assert_true(PadicGamma::log_gamma(Zp(p, N, 1)).is_zero() && LogGammaTable::get(p, N)->at(1).is_zero() &&
+                         PadicGamma::log_gamma_range(p, N, 1, 1)[0].is_zero(),
+                         "log Γ_p(1) = log_Iw(-1) = 0 on every path" + tag);
+    }
+    threw = false;
+    try { (void)PadicGamma::log_gamma_range(5, 10, 0, 3); } catch (const std::invalid_argument&) { threw = true; }
+    test.assert_true(threw, "log_gamma_range starts at 1");
+
+    test.report();
+    test.require_all_passed();
+}
+
+void test_batch_inverse() {
+    TestFramework test("Batch modular inversion");
+
+    BigInt modulus = BigInt(7).pow(30);
+    std::vector<BigInt> values;
+    for (long i = 1; i <= 50; ++i) {
+        if (i % 7 != 0) values.emplace_back(i * i + 3 * i + 1);
+    }
+    std::vector<BigInt> inverses = values;
+    batch_mod_inverse(inverses, modulus);
+    bool batch_ok = true;
+    for (size_t i = 0; i < values.size(); ++i) {
+        batch_ok = batch_ok && inverses[i] == values[i].mod_inverse(modulus);
+    }
+    test.assert_true(batch_ok, "batch_mod_inverse matches mod_inverse");
+
+    std::vector<BigInt> bad{BigInt(2), BigInt(14), BigInt(3)};
+    bool threw = false;
+    try { batch_mod_inverse(bad, modulus); } catch (const std::domain_error&) { threw = true; }
+    test.assert_true(threw && bad[1] == BigInt(14), "A non-unit throws and leaves the batch untouched");
+
+    // 1/n from the table against from_rational, including p | n
+    bool table_ok = true;
+    for (long p : {2L, 5L, 13L}) {
+        auto table = InverseTable::get(p, 20, 40);
+        auto grown = InverseTable::get(p, 20, 100);
+        table_ok = table_ok && table->bound() >= 40 && grown->bound() >= 100 &&
+                   InverseTable::get(p, 20, 60) == grown;
+        for (long n = 1; n <= 100; ++n) {
+            Qp expected = Qp::from_rational(1, n, p, 20);
+            Qp inverse = grown->inverse(n);
+            table_ok = table_ok && inverse == expected &&
+                       inverse.get_unit().get_precision() == expected.get_unit().get_precision();
+        }
+    }
+    test.assert_true(table_ok, "InverseTable gives from_rational(1, n) and grows on demand");
+
+    test.report();
+    test.require_all_passed();
+}
+
+void test_stats_counters() {
+    TestFramework test("Hot-path statistics");
+
+    stats::reset();
+    stats::track_gmp_allocations();
+    Qp x(7, 30, 1 + 7 * 3);
+    Qp l = PadicLog::log(x);
+    (void)PadicLog::log_series(x);
+    (void)PadicGamma::log_gamma(Zp(7, 30, 12));
+    DirichletCharacter chi(7, 7, {1});
+    (void)chi.evaluate_at(3);
+    stats::Snapshot snap = stats::snapshot();
+
+    test.assert_true(snap.enabled == stats::enabled() &&
+                     snap.counters.size() == static_cast<size_t>(stats::Id::count) &&
+                     !snap.caches.empty(),
+                     "Snapshot lists every counter and cache");
+    const stats::Counter& log_counter = snap.counters[static_cast<size_t>(stats::Id::padic_log)];
+    const stats::Counter& series_counter = snap.counters[static_cast<size_t>(stats::Id::log_series)];
+    if (stats::enabled()) {
+        test.assert_true(log_counter.calls >= 1 && log_counter.iterations >= 1 &&
+                         log_counter.precision_inflation >= 1 && log_counter.name == "PadicLog::log",
+                         "log_p calls, series terms and working precision are counted");
+        test.assert_true(series_counter.calls == 1 &&
+                         snap.counters[static_cast<size_t>(stats::Id::character_evaluate_at)].calls >= 1 &&
+                         snap.counters[static_cast<size_t>(stats::Id::log_gamma)].calls >= 1 &&
+                         snap.gmp_allocations > 0,
+                         "Other hot paths and GMP allocations are counted");
+        stats::reset();
+        test.assert_true(stats::snapshot().counters[static_cast<size_t>(stats::Id::padic_log)].calls == 0,
+                         "reset() zeroes the counters");
+    } else {
+        test.assert_true(log_counter.calls == 0 && series_counter.calls == 0 && snap.gmp_allocations == 0,
+                         "Counters stay zero when compiled out");
+    }
+    test.assert_true(!l.is_zero(), "Instrumented log still computes");
+
+    test.report();
+    test.require_all_passed();
+}
+
+void test_limb_pool() {
+    TestFramework test("Pooled GMP limb allocator");
+
+    // Values computed before install() are freed through the old functions
+    Qp before = PadicLog::log(Qp(7, 30, 1 + 7 * 5));
+    BigInt large = BigInt(7).pow(400);
+    LimbPool::install();
+    LimbPool::install();
+    Qp after = PadicLog::log(Qp(7, 30, 1 + 7 * 5));
+    test.assert_true(LimbPool::installed() && LimbPool::slabs() >= 1, "Pool installs once and carves a slab");
+    test.assert_true(after == before, "Results agree with the default allocator");
+    BigInt grown = large * large;
+    test.assert_true(grown == BigInt(7).pow(800), "Blocks above max_pooled_bytes and pre-install blocks work");
+
+    // Blocks freed on other threads and by exiting threads are recycled
+    std::vector<BigInt> shared(64);
+    std::vector<std::thread> workers;
+    std::vector<int> ok(4, 0);
+    for (int w = 0; w < 4; ++w) {
+        workers.emplace_back([&, w]() {
+            Zp acc(11, 40, 1);
+            for (long i = 1; i <= 2000; ++i) {
+                acc *= Zp(11, 40, i % 11 == 0 ? i + 1 : i);
+            }
+            for (int j = w; j < 64; j += 4) {
+                shared[j] = BigInt(3).pow(20 + j);
+            }
+            ok[w] = acc.is_unit() ? 1 : 0;
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    bool shared_ok = true;
+    for (int j = 0; j < 64; ++j) {
+        shared_ok = shared_ok && shared[j] == BigInt(3).pow(20 + j);
+    }
+    shared.clear();
+    test.assert_true(ok[0] && ok[1] && ok[2] && ok[3] && shared_ok, "Threads allocate and hand blocks across");
+
+    test.report();
+    test.require_all_passed();
+}
+
+void test_resumable_log() {
+    TestFramework test("Resumable log series");
+
+    // value(N) against a fresh log at every N, across a headroom restart
+    bool values_ok = true;
+    bool resumed = true;
+    for (long p : {2L, 5L, 13L}) {
+        long a = p == 2 ? 5 : 3;
+        long e = p == 2 ? 1 : p - 1;
+        LogSeries series(p, BigInt(a), e, 20);
+        long terms = 0;
+        for (long N = 2; N <= 41 && values_ok; N += 3) {
+            long headroom = series.get_headroom();
+            Qp value = series.value(N);
+            BigInt x;
+            mpz_powm_ui(x.get_mpz(), BigInt(a).get_mpz(), static_cast<unsigned long>(e),
+                        PadicContext::get(p, N).modulus().get_mpz());
+            Qp expected = PadicLog::log(Qp(p, N, x));
+            values_ok = value == expected && value.get_precision() == N;
+            if (N <= headroom) {
+                resumed = resumed && series.get_headroom() == headroom && series.terms() >= terms;
+            } else {
+                resumed = resumed && series.get_headroom() == std::max(2 * headroom, N);
+            }
+            terms = series.terms();
+        }
+    }
+    test.assert_true(values_ok, "LogSeries matches log as N grows");
+    test.assert_true(resumed, "LogSeries resumes within its headroom and doubles past it");
+    test.assert_true(LogSeries(5, BigInt(1), 4, 10).value(7).is_zero(), "log 1 = 0");
+    bool threw = false;
+    try { LogSeries(5, BigInt(2), 1, 10); } catch (const std::domain_error&) { threw = true; }
+    test.assert_true(threw, "LogSeries rejects x not ≡ 1 (mod p)");
+
+    // log_fermat_range and log_gamma_range over an increasing-N loop
+    bool fermat_ok = true;
+    bool gamma_ok = true;
+    long p = 7;
+    std::vector<long> bases = {2, 3, 10, 23};
+    for (long N : {8L, 15L, 25L, 30L, 12L}) {
+        std::vector<Qp> logs = PadicLog::log_fermat_range(p, N, bases);
+        for (size_t i = 0; i < bases.size(); ++i) {
+            BigInt x;
+            mpz_powm_ui(x.get_mpz(), BigInt(bases[i]).get_mpz(), static_cast<unsigned long>(p - 1),
+                        PadicContext::get(p, N).modulus().get_mpz());
+            fermat_ok = fermat_ok && logs[i] == PadicLog::log(Qp(p, N, x));
+        }
+        std::vector<Qp> range = PadicGamma::log_gamma_range(p, N, 1, 17);
+        for (long x = 1; x <= 17; ++x) {
+            if (x % p != 0) {
+                gamma_ok = gamma_ok && range[x - 1] == PadicGamma::log_gamma(Zp(p, N, x));
+            }
+        }
+    }
+    test.assert_true(fermat_ok, "log_fermat_range matches log at rising and falling N");
+    test.assert_true(gamma_ok, "log_gamma_range stays exact on resumed logs");
+
+    test.report();
+    test.require_all_passed();
+}
+
 int main() {
     std::cout << "========== EXHAUSTIVE SPECIAL FUNCTIONS VALIDATION ==========\n\n";
     
@@ -352,6 +1068,19 @@ int main() {
     test_log_domain_assertions();
     test_mahler_expansion();
     test_convergence_radius();
+    test_sharded_cache();
+    test_log_gamma_table();
+    test_character_sum_batch();
+    test_fast_log_exp();
+    test_log_gamma_mahler_series();
+    test_gamma_engine();
+    test_product_tree_factorials();
+    test_precision_tracker();
+    test_multipoint_log();
+    test_batch_inverse();
+    test_stats_counters();
+    test_limb_pool();
+    test_resumable_log();
     
     std::cout << "\n========== ALL SPECIAL FUNCTIONS TESTS PASSED ==========\n";
     std::cout << "The p-adic special functions are mathematically sound.\n";
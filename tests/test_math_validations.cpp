@@ -9,11 +9,71 @@
 #include "libadic/l_functions.h"
 #include "libadic/characters.h"
 #include "libadic/bernoulli.h"
+#include "libadic/gauss_sums.h"
+#include "libadic/reid_li.h"
+#include "libadic/reid_li_sweep.h"
+#include "libadic/async.h"
+#include "libadic/iwasawa_series.h"
+#include "libadic/thread_pool.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
 #include "libadic/test_framework.h"
 
 using namespace libadic;
 using namespace libadic::test;
 
+/**
+ * B_{n,χ} = f^{n-1} Σ_{a=1}^{f} χ(a) B_n(a/f) in exact rationals, for χ
+ * with integer values chi[a]; returned as numerator / denominator
+ */
+static std::pair<BigInt, BigInt> exact_generalized_bernoulli(long n, long f, const std::vector<long>& chi) {
+    std::vector<mpq_t> b(static_cast<size_t>(n) + 1);
+    mpq_t term, x_power, sum, scratch;
+    mpq_inits(term, x_power, sum, scratch, nullptr);
+    for (auto& q : b) mpq_init(q);
+    // B_0 = 1, Σ_{k<m} C(m+1, k) B_k = -(m+1) B_m
+    mpq_set_ui(b[0], 1, 1);
+    for (long m = 1; m <= n; ++m) {
+        mpq_set_ui(sum, 0, 1);
+        for (long k = 0; k < m; ++k) {
+            mpz_bin_uiui(mpq_numref(scratch), static_cast<unsigned long>(m + 1), static_cast<unsigned long>(k));
+            mpz_set_ui(mpq_denref(scratch), 1);
+            mpq_mul(scratch, scratch, b[k]);
+            mpq_add(sum, sum, scratch);
+        }
+        mpz_set_si(mpq_numref(scratch), -(m + 1));
+        mpz_set_ui(mpq_denref(scratch), 1);
+        mpq_div(b[m], sum, scratch);
+    }
+    // Σ_a χ(a) Σ_k C(n,k) B_k (a/f)^{n-k}, times f^{n-1}
+    mpq_set_ui(sum, 0, 1);
+    for (long a = 1; a <= f; ++a) {
+        if (chi[a % f] == 0) continue;
+        for (long k = 0; k <= n; ++k) {
+            mpz_bin_uiui(mpq_numref(term), static_cast<unsigned long>(n), static_cast<unsigned long>(k));
+            mpz_mul_si(mpq_numref(term), mpq_numref(term), chi[a % f]);
+            mpz_set_ui(mpq_denref(term), 1);
+            mpq_mul(term, term, b[k]);
+            mpz_ui_pow_ui(mpq_numref(x_power), static_cast<unsigned long>(a), static_cast<unsigned long>(n - k));
+            mpz_ui_pow_ui(mpq_denref(x_power), static_cast<unsigned long>(f), static_cast<unsigned long>(n - k));
+            mpq_canonicalize(x_power);
+            mpq_mul(term, term, x_power);
+            mpq_add(sum, sum, term);
+        }
+    }
+    mpz_ui_pow_ui(mpq_numref(scratch), static_cast<unsigned long>(f), static_cast<unsigned long>(n - 1));
+    mpz_set_ui(mpq_denref(scratch), 1);
+    mpq_mul(sum, sum, scratch);
+    std::pair<BigInt, BigInt> result;
+    mpz_set(result.first.get_mpz(), mpq_numref(sum));
+    mpz_set(result.second.get_mpz(), mpq_denref(sum));
+    for (auto& q : b) mpq_clear(q);
+    mpq_clears(term, x_power, sum, scratch, nullptr);
+    return result;
+}
+
 static Qp remove_p_factors_factorial(long n, long p, long precision) {
     // Compute (n-1)! with all factors divisible by p removed, modulo p^precision
     BigInt p_pow = BigInt(p).pow(precision);
@@ -51,7 +111,7 @@ void test_Lp_special_values() {
                     test.assert_true(L.is_zero(), "Parity zero: L_p(1-n,χ)=0");
                 } else {
                     Qp Bn_chi = BernoulliNumbers::generalized_bernoulli(n, chi.get_conductor(),
-                        [&chi, precision](long a){ return chi.evaluate_cyclotomic(a, precision); }, p, precision);
+                        [&chi, precision](long a){ return chi.evaluate(a, precision); }, p, precision);
                     Qp expected = -Bn_chi / Qp(p, precision, n);
                     test.assert_equal(L, expected, "L_p(1-n,χ) matches -B_{n,χ}/n for primitive mod p");
                 }
@@ -274,6 +334,257 @@ void test_characters_properties() {
     test.require_all_passed();
 }
 
+void test_character_value_table() {
+    TestFramework test("Dirichlet character discrete-log table");
+    for (long p : std::vector<long>{7, 11, 13}) {
+        auto chars = DirichletCharacter::enumerate_characters(p, p);
+        long g = chars[0].generators[0];
+
+        bool dense_ok = true, reference_ok = true, multiplicative_ok = true;
+        for (const auto& chi : chars) {
+            std::vector<long> vals = chi.values();
+            dense_ok = dense_ok && static_cast<long>(vals.size()) == p && vals[0] == -1;
+
+            // χ_k(g^e) = g^{ke} mod p (as a residue)
+            long k = chi.character_values[0];
+            long x = 1;
+            for (long e = 0; e < p - 1; ++e) {
+                long expected = 1;
+                for (long i = 0; i < (k * e) % (p - 1); ++i) expected = (expected * g) % p;
+                reference_ok = reference_ok && vals[x] == expected && chi.evaluate_at(x) == expected;
+                x = (x * g) % p;
+            }
+
+            for (long a = 1; a < p; ++a) {
+                for (long b = 1; b < p; ++b) {
+                    multiplicative_ok = multiplicative_ok &&
+                        vals[(a * b) % p] == (vals[a] * vals[b]) % p;
+                }
+            }
+        }
+        std::string suffix = " for p=" + std::to_string(p);
+        test.assert_true(dense_ok, "values() covers every residue" + suffix);
+        test.assert_true(reference_ok, "χ_k(g^e) = g^{ke}" + suffix);
+        test.assert_true(multiplicative_ok, "χ(ab) = χ(a)χ(b)" + suffix);
+    }
+    test.report();
+    test.require_all_passed();
+}
+
+void test_cyclotomic_character_values() {
+    TestFramework test("Cyclotomic character values and B_{n,χ}");
+    long p = 7;
+    long N = 10;
+    Cyclotomic zeta = Cyclotomic::zeta(p, N);
+    Cyclotomic one(p, N, Qp(p, N, 1));
+
+    bool monomial_ok = true;
+    bool bernoulli_ok = true;
+    for (const auto& chi : DirichletCharacter::enumerate_primitive_characters(p, p)) {
+        for (long a = 1; a < p; ++a) {
+            long e = (chi.evaluate_at(a) * (p - 1)) / chi.get_order();
+            Cyclotomic expected = one;
+            for (long i = 0; i < e; ++i) expected = expected * zeta;
+            monomial_ok = monomial_ok && chi.evaluate_cyclotomic(a, N) == expected;
+        }
+
+        // The quadratic character takes two values, χ(1) = 1 and -1, so its
+        // cyclotomic values fix the signs that must reproduce B_{n,χ}
+        if (chi.get_order() != 2) continue;
+        Cyclotomic chi_one = chi.evaluate_cyclotomic(1, N);
+        for (long n = 1; n <= 3; ++n) {
+            Qp expected(p, N, 0);
+            for (long a = 1; a < p; ++a) {
+                Qp bn = BernoulliNumbers::bernoulli_polynomial(n, Qp::from_rational(a, p, p, N), p, N);
+                expected += chi.evaluate_cyclotomic(a, N) == chi_one ? bn : -bn;
+            }
+            expected = expected * Qp(p, N, BigInt(p).pow(n - 1));
+            Qp actual = BernoulliNumbers::generalized_bernoulli(n, p,
+                [&chi, N](long a) { return chi.evaluate(a, N); }, p, N);
+            // Both sides divide by p once, so only N - 1 digits are meaningful
+            bernoulli_ok = bernoulli_ok && actual.with_precision(N - 1) == expected.with_precision(N - 1);
+        }
+    }
+    test.assert_true(monomial_ok, "evaluate_cyclotomic(a) = ζ^e by repeated products");
+    test.assert_true(bernoulli_ok, "B_{n,χ} matches the cyclotomic sum for the quadratic character");
+    test.report();
+    test.require_all_passed();
+}
+
+void test_gauss_jacobi_sums() {
+    TestFramework test("Gross-Koblitz Gauss and Jacobi sums");
+    long N = 8;
+
+    bool power_ok = true, batch_ok = true, jacobi_ok = true;
+    for (long p : {5L, 7L, 11L}) {
+        std::vector<GaussSum> all = GaussSums::gauss_sums(p, N);
+        auto chars = DirichletCharacter::enumerate_characters(p, p);
+        for (const auto& chi : chars) {
+            // g(χ)^{p-1} from the direct cyclotomic sum is (-p)^a Γ_p(a/(p-1))^{p-1}
+            GaussSum g = GaussSums::gauss_sum(chi, N);
+            Cyclotomic direct = GaussSums::gauss_sum_cyclotomic(chi, N);
+            Cyclotomic power = direct;
+            for (long i = 1; i < p - 1; ++i) power = power * direct;
+            Qp expected = g.power_p_minus_one();
+            power_ok = power_ok && power.get_coeff(0).with_precision(N) == expected.with_precision(N);
+            for (long i = 1; i < p - 1; ++i) {
+                power_ok = power_ok && power.get_coeff(i).with_precision(N) == Qp(p, N, 0);
+            }
+            batch_ok = batch_ok && all[chi.index()].exponent == g.exponent &&
+                       all[chi.index()].coefficient == g.coefficient;
+
+            // J(χ, ψ) = Σ χ(x) ψ(1-x) term by term
+            std::vector<Zp> row = GaussSums::jacobi_sums(chi, N);
+            for (const auto& psi : chars) {
+                Zp sum(p, N, 0);
+                for (long x = 2; x < p; ++x) {
+                    sum += chi.evaluate(x, N) * psi.evaluate(1 - x, N);
+                }
+                jacobi_ok = jacobi_ok && row[psi.index()] == sum &&
+                            GaussSums::jacobi_sum(chi, psi, N) == sum;
+            }
+        }
+    }
+    test.assert_true(power_ok, "g(χ)^{p-1} matches the direct sum in Q_p(ζ)");
+    test.assert_true(batch_ok, "Batch Gauss sums match the per-character ones");
+    test.assert_true(jacobi_ok, "Jacobi sums match Σ χ(x)ψ(1-x) for every pair");
+
+    bool rejected = false;
+    try {
+        GaussSums::gauss_sum(DirichletCharacter(15, 5), N);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    test.assert_true(rejected, "Characters of composite modulus are rejected");
+    test.report();
+    test.require_all_passed();
+}
+
+void test_bernoulli_range() {
+    TestFramework test("Bernoulli numbers from bernoulli_range");
+    long N = 12;
+
+    // Exact values B_2..B_14
+    const long known[][2] = {{1, 6}, {-1, 30}, {1, 42}, {-1, 30}, {5, 66}, {-691, 2730}, {7, 6}};
+    bool known_ok = true;
+    for (long p : {2L, 3L, 5L, 7L, 13L}) {
+        std::vector<Qp> b = BernoulliNumbers::bernoulli_range(14, p, N);
+        known_ok = known_ok && b.size() == 15 && b[0] == Qp(p, N, 1) &&
+                   b[1] == Qp::from_rational(-1, 2, p, N);
+        for (long k = 1; k <= 7; ++k) {
+            known_ok = known_ok && b[2 * k] == Qp::from_rational(known[k - 1][0], known[k - 1][1], p, N);
+            known_ok = known_ok && (k == 1 || b[2 * k - 1].is_zero());
+        }
+    }
+    test.assert_true(known_ok, "B_0..B_14 match the exact rationals for p = 2, 3, 5, 7, 13");
+
+    // Σ_{k<=n} C(n+1,k) B_k = 0, including primes above 1000 where the old
+    // cache key collided
+    bool recurrence_ok = true;
+    for (long p : {3L, 1009L}) {
+        std::vector<Qp> b = BernoulliNumbers::bernoulli_range(60, p, N);
+        for (long n = 1; n <= 60; ++n) {
+            Qp sum(p, N, 0);
+            for (long k = 0; k <= n; ++k) {
+                sum += Qp(p, N, BigInt::binomial(n + 1, k)) * b[k];
+            }
+            recurrence_ok = recurrence_ok && sum.valuation() >= N - 2;
+        }
+        recurrence_ok = recurrence_ok && BernoulliNumbers::bernoulli(40, p, N) == b[40];
+    }
+    test.assert_true(recurrence_ok, "range satisfies Σ C(n+1,k) B_k = 0 up to n = 60");
+
+    // Large indices: a single pass reaches n in the thousands, and growing
+    // the cached table keeps earlier entries
+    std::vector<Qp> small = BernoulliNumbers::bernoulli_range(100, 7, N);
+    std::vector<Qp> large = BernoulliNumbers::bernoulli_range(2000, 7, N);
+    bool prefix_ok = large.size() == 2001;
+    for (long n = 0; n <= 100; ++n) {
+        prefix_ok = prefix_ok && small[n] == large[n];
+    }
+    test.assert_true(prefix_ok, "extending the range preserves B_0..B_100");
+    test.assert_true(BernoulliNumbers::verify_kummer_congruence(1000, 7, N),
+                     "Kummer congruence B_1000/1000 ≡ B_1006/1006 (mod 7)");
+    test.report();
+    test.require_all_passed();
+}
+
+void test_bernoulli_polynomial_batch() {
+    TestFramework test("Batched Bernoulli polynomial values B_n(a/f)");
+    long p = 5;
+    long N = 12;
+
+    bool scaled_ok = true;
+    bool values_ok = true;
+    for (long f : {4L, 5L, 12L, 13L}) {
+        for (long n : {0L, 1L, 2L, 5L, 8L}) {
+            std::vector<Qp> scaled = BernoulliNumbers::bernoulli_polynomial_scaled(n, f, p, N);
+            std::vector<Qp> values = BernoulliNumbers::bernoulli_polynomial_values(n, f, p, N);
+            scaled_ok = scaled_ok && scaled.size() == static_cast<size_t>(f);
+            for (long a = 0; a < f; ++a) {
+                // Compare integers f^n B_n(a/f) against the direct expansion in a/f
+                Qp x = Qp::from_rational(a, f, p, N);
+                Qp direct = BernoulliNumbers::bernoulli_polynomial(n, x, p, N);
+                // (a/f)^k loses a digit per factor of p in f
+                long digits = f % p == 0 ? N - n - 1 : N;
+                values_ok = values_ok && values[a].with_precision(digits) == direct.with_precision(digits);
+                if (f % p != 0) {
+                    scaled_ok = scaled_ok && scaled[a] == direct * Qp(p, N + 1, BigInt(f).pow(n));
+                }
+            }
+        }
+    }
+    test.assert_true(scaled_ok, "f^n B_n(a/f) from forward differences");
+    test.assert_true(values_ok, "B_n(a/f) matches bernoulli_polynomial for every residue");
+
+    // B_{n,χ} for a character of conductor 5, matching the naive sum f^{n-1} Σ χ(a) B_n(a/f)
+    bool chi_ok = true;
+    for (const auto& chi : DirichletCharacter::enumerate_primitive_characters(p, p)) {
+        for (long n = 1; n <= 6; ++n) {
+            Qp naive(p, N, 0);
+            for (long a = 1; a < p; ++a) {
+                Qp bn = BernoulliNumbers::bernoulli_polynomial(n, Qp::from_rational(a, p, p, N), p, N);
+                naive += Qp(chi.evaluate(a, N)) * bn;
+            }
+            naive = naive * Qp(p, N, BigInt(p).pow(n - 1));
+            Qp batched = BernoulliNumbers::generalized_bernoulli(n, p,
+                [&chi, N](long a) { return chi.evaluate(a, N); }, p, N);
+            chi_ok = chi_ok && batched.with_precision(N - 1) == naive.with_precision(N - 1);
+        }
+    }
+    test.assert_true(chi_ok, "generalized_bernoulli matches the per-residue expansion");
+    
+    // Against exact rationals for the Legendre symbol ω^{(q-1)/2} mod q, and
+    // through kubota_leopoldt at s = 1 - n
+    bool exact_ok = true;
+    bool l_value_ok = true;
+    for (long q : {7L, 11L}) {
+        std::vector<long> legendre(static_cast<size_t>(q), 0);
+        for (long a = 1; a < q; ++a) legendre[(a * a) % q] = 1;
+        for (long a = 1; a < q; ++a) legendre[a] = legendre[a] == 1 ? 1 : -1;
+        DirichletCharacter chi(q, q, {(q - 1) / 2});
+        for (long n = 1; n <= 6; ++n) {
+            auto B = exact_generalized_bernoulli(n, q, legendre);
+            Qp expected = Qp(q, N + 5, B.first) / Qp(q, N + 5, B.second);
+            Qp batched = BernoulliNumbers::generalized_bernoulli(n, q,
+                [&chi, N](long a) { return chi.evaluate(a, N); }, q, N);
+            // generalized_bernoulli divides by f = p once, so N - 1 digits are meaningful
+            exact_ok = exact_ok && batched.with_precision(N - 1) == expected.with_precision(N - 1);
+            if (n % 2 == 1) {
+                // χ odd, so L_p(1-n, χ) = -B_{n,χ}/n with Euler factor 1
+                Qp value = LFunctions::kubota_leopoldt(1 - n, chi, N);
+                Qp exact_value = -expected / Qp(q, N + 5, n);
+                l_value_ok = l_value_ok && !value.is_zero() &&
+                             value == exact_value.with_precision(value.get_precision());
+            }
+        }
+    }
+    test.assert_true(exact_ok, "generalized_bernoulli matches exact rational B_{n,χ} (q = 7, 11)");
+    test.assert_true(l_value_ok, "L_p(1-n, χ) = -B_{n,χ}/n ≠ 0 for the odd quadratic character");
+    test.report();
+    test.require_all_passed();
+}
+
 void test_reid_li_criterion() {
     TestFramework test("Reid-Li Criterion Verification (Φ_p = Ψ_p)");
     long p = 5;
@@ -305,17 +616,675 @@ void test_reid_li_criterion() {
     test.require_all_passed();
 }
 
+void test_reid_li_engine() {
+    TestFramework test("Parallel Reid-Li Sweep Engine");
+    
+    // Nested submissions on the work-stealing pool all run
+    {
+        ThreadPool pool(4);
+        std::atomic<long> count{0};
+        for (int i = 0; i < 16; ++i) {
+            pool.submit([&pool, &count]() {
+                for (int j = 0; j < 16; ++j) {
+                    pool.submit([&count]() { count.fetch_add(1); });
+                }
+            });
+        }
+        pool.wait_idle();
+        test.assert_equal(count.load(), 256L, "All nested pool tasks ran");
+        
+        pool.submit([]() { throw std::runtime_error("boom"); });
+        bool rethrown = false;
+        try { pool.wait_idle(); } catch (const std::runtime_error&) { rethrown = true; }
+        test.assert_true(rethrown, "Task exceptions surface from wait_idle");
+    }
+    
+    test.assert_true(ReidLiEngine::primes_in_range(5, 30) ==
+                     std::vector<long>({5, 7, 11, 13, 17, 19, 23, 29}), "Primes in [5, 30]");
+    
+    ReidLiConfig config;
+    config.min_prime = 5;
+    config.max_prime = 13;
+    config.precision = 10;
+    config.threads = 4;
+    
+    std::vector<ReidLiResult> streamed;
+    ReidLiSummary summary = ReidLiEngine(config).run([&](const ReidLiResult& r) { streamed.push_back(r); });
+    
+    long expected_chars = 0;
+    for (long p : {5L, 7L, 11L, 13L}) {
+        for (const auto& chi : DirichletCharacter::enumerate_primitive_characters(p, p)) {
+            if (!chi.is_principal()) expected_chars++;
+        }
+    }
+    test.assert_equal(summary.primes, 4L, "Sweep covers 4 primes");
+    test.assert_equal(summary.characters, expected_chars, "One result per non-principal primitive character");
+    test.assert_equal(static_cast<long>(streamed.size()), expected_chars, "Every result reaches the sink");
+    test.assert_equal(summary.errors, 0L, "No character failed to compute");
+    
+    // Parallel results agree with a direct serial evaluation
+    std::vector<ReidLiResult> sorted = ReidLiEngine(config).run();
+    bool agree = true;
+    for (const auto& r : sorted) {
+        auto chars = DirichletCharacter::enumerate_characters(r.prime, r.prime);
+        ReidLiResult direct = ReidLi::verify(chars[r.character_index], config.precision);
+        agree = agree && direct.phi_value == r.phi_value && direct.psi_value == r.psi_value &&
+                direct.matches == r.matches;
+    }
+    test.assert_true(agree, "Engine results match serial ReidLi::verify");
+    
+    test.report();
+    test.require_all_passed();
+}
+
+void test_reid_li_sweep() {
+    TestFramework test("Checkpointed Reid-Li sweep");
+    
+    ReidLiSweepConfig config;
+    config.sweep.primes = {11, 13};
+    config.sweep.precision = 10;
+    config.sweep.threads = 2;
+    config.directory = ".";
+    config.workers = 2;
+    ReidLiSweep sweep(config);
+    const auto& units = sweep.get_units();
+    auto clean = [&]() {
+        for (const auto& u : units) {
+            std::remove(sweep.checkpoint_path(u).c_str());
+            std::remove(sweep.claim_path(u).c_str());
+        }
+    };
+    clean();
+    
+    // Non-principal orbits: orders 2, 5, 10 mod 11 and 2, 3, 4, 6, 12 mod 13
+    test.assert_equal(static_cast<long>(units.size()), 8L, "One unit per non-principal orbit");
+    long members = 0;
+    bool by_cost = true;
+    for (size_t i = 0; i < units.size(); ++i) {
+        members += units[i].size;
+        by_cost = by_cost && (i == 0 || units[i - 1].cost >= units[i].cost);
+    }
+    test.assert_equal(members, 20L, "Units cover every non-principal character");
+    test.assert_true(by_cost, "Units scheduled by decreasing estimated cost");
+    std::vector<size_t> both = sweep.share(0);
+    std::vector<size_t> other = sweep.share(1);
+    both.insert(both.end(), other.begin(), other.end());
+    std::sort(both.begin(), both.end());
+    bool partition = both.size() == units.size();
+    for (size_t i = 0; partition && i < both.size(); ++i) partition = both[i] == i;
+    test.assert_true(partition, "Fixed shares partition the units");
+    
+    ReidLiConfig engine_config = config.sweep;
+    engine_config.galois_orbits = true;
+    std::vector<ReidLiResult> expected = ReidLiEngine(engine_config).run();
+    auto same = [&](std::vector<ReidLiResult> got) {
+        std::sort(got.begin(), got.end(), [](const ReidLiResult& a, const ReidLiResult& b) {
+            return a.prime != b.prime ? a.prime < b.prime : a.character_index < b.character_index;
+        });
+        bool ok = got.size() == expected.size();
+        for (size_t i = 0; ok && i < got.size(); ++i) {
+            ok = got[i].prime == expected[i].prime &&
+                 got[i].character_index == expected[i].character_index &&
+                 got[i].phi_value == expected[i].phi_value &&
+                 got[i].psi_value == expected[i].psi_value &&
+                 got[i].matches == expected[i].matches;
+        }
+        return ok;
+    };
+    
+    std::vector<ReidLiResult> first;
+    ReidLiSweepSummary s0 = sweep.run([&](const ReidLiResult& r) { first.push_back(r); });
+    test.assert_equal(s0.computed, 8L, "Lone worker claims and checkpoints every unit");
+    test.assert_true(same(first), "Sweep results match the orbit engine");
+    
+    std::vector<ReidLiResult> resumed;
+    ReidLiSweepSummary s1 = sweep.run([&](const ReidLiResult& r) { resumed.push_back(r); });
+    test.assert_equal(s1.resumed, 8L, "Rerun resumes from checkpoints");
+    test.assert_equal(s1.computed, 0L, "Rerun computes nothing");
+    test.assert_true(same(resumed), "Checkpointed results read back exactly");
+    
+    config.worker = 1;
+    ReidLiSweepSummary s2 = ReidLiSweep(config).run(nullptr);
+    test.assert_equal(s2.elsewhere, 8L, "Second worker skips units completed by the first");
+    test.assert_equal(s2.results.characters, 0L, "Second worker streams nothing");
+    
+    // An interrupted unit: claimed by worker 0, never checkpointed
+    std::remove(sweep.checkpoint_path(units[3]).c_str());
+    ReidLiSweepSummary s3 = sweep.run(nullptr);
+    test.assert_equal(s3.computed, 1L, "Only the unfinished unit is recomputed");
+    test.assert_equal(s3.resumed, 7L, "Finished units are resumed");
+    
+    size_t missing = 1;
+    test.assert_true(same(sweep.collect(&missing)), "Collected checkpoints reproduce the sweep");
+    test.assert_equal(static_cast<long>(missing), 0L, "No unit left without a checkpoint");
+    
+    bool threw = false;
+    try {
+        config.worker = 2;
+        ReidLiSweep bad(config);
+    } catch (const std::invalid_argument&) { threw = true; }
+    test.assert_true(threw, "Worker id outside [0, workers) rejected");
+    
+    clean();
+    test.report();
+    test.require_all_passed();
+}
+
+void test_async_calls() {
+    TestFramework test("Async special-function calls");
+    
+    long p = 11, N = 12;
+    auto chars = DirichletCharacter::enumerate_characters(p, p);
+    const DirichletCharacter& odd = chars[1];
+    
+    std::atomic<bool> notified{false};
+    AsyncResult<Qp> pending = Async::kubota_leopoldt_derivative(0, odd, N, {}, [&]() { notified = true; });
+    Qp value = pending.get();
+    test.assert_true(value == LFunctions::kubota_leopoldt_derivative(0, odd, N),
+                     "Async L'_p(0, χ) matches the blocking call");
+    // on_ready runs once the value is available, possibly after get() returned
+    auto limit = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!notified && std::chrono::steady_clock::now() < limit) std::this_thread::yield();
+    test.assert_true(notified.load(), "Completion callback ran");
+    
+    // A throwing callback is caught on the worker and kept for the caller
+    Async::take_callback_error();
+    Async::submit([]() { return 1; }, {}, []() { throw std::runtime_error("on_ready failed"); }).get();
+    std::exception_ptr callback_error;
+    limit = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!(callback_error = Async::take_callback_error()) && std::chrono::steady_clock::now() < limit) {
+        std::this_thread::yield();
+    }
+    bool reported = false;
+    try {
+        if (callback_error) std::rethrow_exception(callback_error);
+    } catch (const std::runtime_error& e) {
+        reported = std::string(e.what()) == "on_ready failed";
+    }
+    test.assert_true(reported, "Exception from on_ready is reported by take_callback_error");
+    test.assert_true(!Async::take_callback_error(), "take_callback_error clears the report");
+    test.assert_true(Async::kubota_leopoldt(0, chars[2], N).get() ==
+                     LFunctions::kubota_leopoldt(0, chars[2], N), "Async L_p(0, χ) matches");
+    
+    auto outcome = [](auto& result) {
+        try {
+            result.get();
+        } catch (const OperationCancelled& e) {
+            return e.deadline_exceeded() ? 2 : 1;
+        }
+        return 0;
+    };
+    
+    CancellationToken cancelled;
+    cancelled.cancel();
+    auto never = Async::kubota_leopoldt_derivative(0, chars[3], N + 1, cancelled);
+    test.assert_equal(static_cast<long>(outcome(never)), 1L, "Cancelled before start: never runs");
+    auto expired = Async::reid_li_verify(odd, N, 5,
+                                         CancellationToken::with_timeout(std::chrono::milliseconds(0)));
+    test.assert_equal(static_cast<long>(outcome(expired)), 2L, "Expired deadline reported as such");
+    
+    // Running work stops at its next cancellation point
+    std::atomic<bool> started{false};
+    auto spin = Async::submit([&started]() {
+        started = true;
+        while (true) cancellation_point();
+    });
+    while (!started) std::this_thread::yield();
+    spin.cancel();
+    test.assert_equal(static_cast<long>(outcome(spin)), 1L, "Cancel stops a running task");
+    auto budget = Async::submit([]() { while (true) cancellation_point(); },
+                                CancellationToken::with_timeout(std::chrono::milliseconds(20)));
+    test.assert_equal(static_cast<long>(outcome(budget)), 2L, "Deadline stops a running task");
+    
+    // A cancelled L-function call propagates through ReidLi::verify and
+    // leaves the caches usable
+    bool propagated = false;
+    {
+        CancellationToken stop;
+        stop.cancel();
+        CancellationScope scope(stop);
+        try {
+            ReidLi::verify(chars[5], N + 3);
+        } catch (const OperationCancelled&) { propagated = true; }
+    }
+    test.assert_true(propagated, "ReidLi::verify rethrows cancellation");
+    ReidLiResult after = Async::reid_li_verify(chars[5], N + 3).get();
+    test.assert_true(after.error.empty() && after.phi_value == ReidLi::verify(chars[5], N + 3).phi_value,
+                     "Computation after a cancelled one is unaffected");
+    
+    test.report();
+    test.require_all_passed();
+}
+
+void test_batch_entry_points() {
+    TestFramework test("Batch entry points");
+    
+    long p = 7, N = 8;
+    std::vector<std::string> errors;
+    std::vector<Qp> all = LFunctions::kubota_leopoldt_derivative_all(p, N, 3, &errors);
+    auto chars = DirichletCharacter::enumerate_characters(p, p);
+    test.assert_equal(static_cast<long>(all.size()), static_cast<long>(chars.size()),
+                      "One value per character mod p");
+    bool agree = true;
+    for (size_t k = 0; k < chars.size(); ++k) {
+        try {
+            Qp direct = LFunctions::kubota_leopoldt_derivative(0, chars[k], N);
+            agree = agree && errors[k].empty() && direct == all[k];
+        } catch (const std::exception& e) {
+            agree = agree && errors[k] == e.what() && all[k].is_zero();
+        }
+    }
+    test.assert_true(agree, "Batch matches per-character L'_p(0, χ), errors included");
+    std::vector<Qp> serial = LFunctions::kubota_leopoldt_derivative_all(p, N);
+    test.assert_true(serial == all, "Serial and threaded batches agree");
+    
+    ReidLiConfig range;
+    range.min_prime = 5;
+    range.max_prime = 11;
+    range.precision = 8;
+    range.threads = 2;
+    ReidLiConfig listed = range;
+    listed.primes = {5, 11};
+    std::vector<ReidLiResult> from_list = ReidLiEngine(listed).run();
+    std::vector<ReidLiResult> from_range = ReidLiEngine(range).run();
+    std::vector<ReidLiResult> expected;
+    for (const auto& r : from_range) {
+        if (r.prime != 7) expected.push_back(r);
+    }
+    bool same = from_list.size() == expected.size();
+    for (size_t i = 0; same && i < expected.size(); ++i) {
+        same = from_list[i].prime == expected[i].prime &&
+               from_list[i].character_index == expected[i].character_index &&
+               from_list[i].phi_value == expected[i].phi_value &&
+               from_list[i].psi_value == expected[i].psi_value;
+    }
+    test.assert_true(same, "Explicit primes sweep only those primes");
+    
+    listed.primes = {5, 9};
+    bool threw = false;
+    try {
+        ReidLiEngine bad(listed);
+    } catch (const std::invalid_argument&) { threw = true; }
+    test.assert_true(threw, "Non-prime entry rejected");
+    
+    test.report();
+    test.require_all_passed();
+}
+
+void test_result_store() {
+    TestFramework test("Persistent result store");
+    
+    long p = 7;
+    auto chars = DirichletCharacter::enumerate_primitive_characters(p, p);
+    std::vector<Qp> high, low;
+    for (const auto& chi : chars) {
+        high.push_back(LFunctions::kubota_leopoldt(0, chi, 20));
+    }
+    Qp b12 = BernoulliNumbers::bernoulli(12, p, 20);
+    
+    std::string path = "test_result_store.bin";
+    LFunctions::save_cache(path);
+    
+    // Reference values at the lower precision, computed cold
+    LFunctions::clear_cache();
+    BernoulliNumbers::clear_cache();
+    ResultStore::instance().clear();
+    for (const auto& chi : chars) {
+        low.push_back(LFunctions::kubota_leopoldt(0, chi, 12));
+    }
+    
+    LFunctions::clear_cache();
+    BernoulliNumbers::clear_cache();
+    size_t records = LFunctions::load_cache(path);
+    test.assert_true(records > chars.size(), "Store holds the L-values and Bernoulli tables");
+    
+    bool same = true;
+    for (size_t i = 0; i < chars.size(); ++i) {
+        same = same && LFunctions::kubota_leopoldt(0, chars[i], 20) == high[i];
+    }
+    test.assert_true(same, "Warm start returns the saved L-values");
+    
+    bool truncated = true;
+    for (size_t i = 0; i < chars.size(); ++i) {
+        Qp x = LFunctions::kubota_leopoldt(0, chars[i], 12);
+        truncated = truncated && x == low[i] && x.get_precision() <= 12;
+    }
+    test.assert_true(truncated, "Lower precision served by truncating stored values");
+    test.assert_true(BernoulliNumbers::bernoulli(12, p, 20) == b12, "Bernoulli table warm-started");
+    
+    {
+        std::ofstream junk("test_result_store.bad", std::ios::binary);
+        junk << "not a store";
+    }
+    bool threw = false;
+    try {
+        LFunctions::load_cache("test_result_store.bad");
+    } catch (const std::runtime_error&) { threw = true; }
+    test.assert_true(threw, "Foreign file rejected");
+    
+    std::remove(path.c_str());
+    std::remove("test_result_store.bad");
+    ResultStore::instance().clear();
+    
+    test.report();
+    test.require_all_passed();
+}
+
+void test_precision_reuse_caches() {
+    TestFramework test("Precision-reuse caches");
+    
+    auto l_cache_hits = []() {
+        for (const CacheStats& s : LFunctions::cache_stats()) {
+            if (s.name == "LFunctions::l_cache") return s.hits;
+        }
+        return uint64_t(0);
+    };
+    
+    long p = 11;
+    auto chars = DirichletCharacter::enumerate_primitive_characters(p, p);
+    std::vector<Qp> cold;
+    for (const auto& chi : chars) {
+        cold.push_back(LFunctions::kubota_leopoldt(0, chi, 15));
+    }
+    
+    LFunctions::clear_cache();
+    for (const auto& chi : chars) {
+        LFunctions::kubota_leopoldt(0, chi, 40);
+        LFunctions::kubota_leopoldt(-2, chi, 40);
+    }
+    uint64_t hits = l_cache_hits();
+    bool same = true;
+    for (size_t i = 0; i < chars.size(); ++i) {
+        Qp x = LFunctions::kubota_leopoldt(0, chars[i], 15);
+        same = same && x == cold[i] && x.get_precision() <= 15;
+    }
+    test.assert_equal(l_cache_hits() - hits, static_cast<uint64_t>(chars.size()),
+                      "Lower-precision queries hit the N = 40 entries");
+    test.assert_true(same, "Truncated values equal a cold computation at N = 15");
+    
+    Qp b_high = BernoulliNumbers::bernoulli(20, p, 40);
+    Qp b_low = BernoulliNumbers::bernoulli(20, p, 12);
+    test.assert_true(b_low == b_high && b_low.get_precision() == 12,
+                     "Bernoulli table at N = 12 truncated from N = 40");
+    
+    test.report();
+    test.require_all_passed();
+}
+
+void test_character_index() {
+    TestFramework test("Canonical character index");
+    
+    bool positions = true;
+    for (long modulus : {5L, 7L, 11L, 13L}) {
+        auto chars = DirichletCharacter::enumerate_characters(modulus, modulus);
+        for (size_t k = 0; k < chars.size(); ++k) {
+            positions = positions && chars[k].index() == static_cast<long>(k);
+        }
+    }
+    test.assert_true(positions, "index() is the position in enumerate_characters");
+    
+    // Characters of one modulus and conductor get separate cache entries
+    auto chars = DirichletCharacter::enumerate_primitive_characters(13, 13);
+    bool distinct = true;
+    for (size_t i = 0; i + 1 < chars.size(); ++i) {
+        if (!chars[i].is_odd() || !chars[i + 1].is_odd()) continue;
+        Qp a = LFunctions::kubota_leopoldt(0, chars[i], 10);
+        Qp b = LFunctions::kubota_leopoldt(0, chars[i + 1], 10);
+        distinct = distinct && a == LFunctions::compute_B1_chi(chars[i], 10) * Qp(13, 10, -1) && !(a == b);
+    }
+    test.assert_true(distinct, "L-value cache keys separate characters");
+    
+    test.report();
+    test.require_all_passed();
+}
+
+void test_character_range() {
+    TestFramework test("Streaming character range");
+    
+    for (long p : {7L, 13L}) {
+        auto all = DirichletCharacter::enumerate_characters(p, p);
+        CharacterRange range(p, p);
+        test.assert_equal(range.group_order(), static_cast<long>(all.size()), "group_order() = φ(p)");
+        bool same = true;
+        long k = 0;
+        for (auto it = range.begin(); it != range.end(); ++it, ++k) {
+            same = same && it.index() == k && it->values() == all[k].values() &&
+                   it->get_conductor() == all[k].get_conductor();
+        }
+        test.assert_true(same && k == range.group_order(),
+                         "Range visits enumerate_characters in order mod " + std::to_string(p));
+        
+        long primitive = 0;
+        for (const DirichletCharacter& chi : CharacterRange(p, p, true)) {
+            primitive += chi.is_primitive() ? 1 : 0;
+        }
+        test.assert_equal(primitive, static_cast<long>(DirichletCharacter::enumerate_primitive_characters(p, p).size()),
+                          "Primitive filter mod " + std::to_string(p));
+        
+        auto mid = range.begin_at(range.group_order() / 2);
+        test.assert_true(mid->values() == all[range.group_order() / 2].values() &&
+                         DirichletCharacter::from_index(p, p, 3).values() == all[3].values(),
+                         "Random access by index");
+    }
+    
+    bool sizes_ok = true;
+    for (long n : {3L, 7L, 11L, 13L}) {
+        for (bool primitive : {false, true}) {
+            CharacterRange r(n, n, primitive);
+            long walked = 0;
+            for (auto it = r.begin(); it != r.end(); ++it) ++walked;
+            sizes_ok = sizes_ok && r.size() == walked;
+        }
+    }
+    test.assert_true(sizes_ok, "size() counts what the range yields, filtered or not");
+    
+    bool threw = false;
+    try {
+        DirichletCharacter::from_index(7, 7, 6);
+    } catch (const std::out_of_range&) { threw = true; }
+    test.assert_true(threw, "Index past φ(n) rejected");
+    
+    test.report();
+    test.require_all_passed();
+}
+
+void test_galois_orbits() {
+    TestFramework test("Galois-orbit character sweeps");
+    
+    // p - 1 = 12 has divisors 1, 2, 3, 4, 6, 12: one orbit per order
+    long p = 13, N = 12;
+    auto orbits = DirichletCharacter::galois_orbits(p, p);
+    test.assert_equal(static_cast<long>(orbits.size()), 6L, "One orbit per divisor of p - 1");
+    long members = 0;
+    bool uniform = true;
+    for (const auto& orbit : orbits) {
+        members += static_cast<long>(orbit.size());
+        for (const DirichletCharacter& c : orbit) {
+            uniform = uniform && c.get_order() == orbit[0].get_order() &&
+                      c.is_odd() == orbit[0].is_odd() && c.index() >= orbit[0].index();
+        }
+    }
+    test.assert_equal(members, p - 1, "Orbits partition the characters");
+    test.assert_true(uniform, "Conjugates share order and parity; representative has the smallest index");
+    
+    std::vector<Qp> B1 = LFunctions::compute_B1_chi_all(p, N);
+    std::vector<Qp> log_gamma = LFunctions::compute_derivative_at_zero_odd_all(p, N);
+    std::vector<Qp> phi, psi;
+    ReidLi::sides_all(p, N, phi, psi);
+    bool same_B1 = true, same_log_gamma = true, same_sides = true;
+    for (const auto& orbit : orbits) {
+        std::vector<Qp> b = LFunctions::compute_B1_chi_orbit(orbit[0], N);
+        std::vector<Qp> g = LFunctions::compute_derivative_at_zero_odd_orbit(orbit[0], N);
+        std::vector<Qp> phi_orbit, psi_orbit;
+        ReidLi::sides_orbit(orbit[0], N, phi_orbit, psi_orbit);
+        for (size_t i = 0; i < orbit.size(); ++i) {
+            long k = orbit[i].index();
+            same_B1 = same_B1 && b[i] == B1[k];
+            same_log_gamma = same_log_gamma && g[i] == log_gamma[k];
+            same_sides = same_sides && phi_orbit[i] == phi[k] && psi_orbit[i] == psi[k];
+        }
+    }
+    test.assert_true(same_B1, "Orbit B_{1,χ} matches the full transform");
+    test.assert_true(same_log_gamma, "Orbit log Γ_p sums match the full transform");
+    test.assert_true(same_sides, "Orbit Reid-Li sides match sides_all");
+    
+    // Odd Ψ is the per-character L-function value, not a copy of the batched Φ
+    auto all_chars = DirichletCharacter::enumerate_characters(p, p);
+    bool odd_sides = true;
+    for (size_t k = 1; k < all_chars.size(); k += 2) {
+        odd_sides = odd_sides && all_chars[k].is_odd() &&
+                    psi[k] == LFunctions::kubota_leopoldt_derivative(0, all_chars[k], N) &&
+                    phi[k] == ReidLi::phi_odd(all_chars[k], N);
+    }
+    test.assert_true(odd_sides, "sides_all odd Φ and Ψ match phi_odd and L'_p(0, χ)");
+    
+    ReidLiConfig config;
+    config.primes = {11, 13};
+    config.precision = 10;
+    config.threads = 2;
+    std::vector<ReidLiResult> by_prime = ReidLiEngine(config).run();
+    config.galois_orbits = true;
+    std::vector<ReidLiResult> by_orbit = ReidLiEngine(config).run();
+    bool agree = by_prime.size() == by_orbit.size();
+    for (size_t i = 0; agree && i < by_prime.size(); ++i) {
+        agree = by_prime[i].prime == by_orbit[i].prime &&
+                by_prime[i].character_index == by_orbit[i].character_index &&
+                by_prime[i].matches == by_orbit[i].matches &&
+                by_prime[i].phi_value == by_orbit[i].phi_value;
+    }
+    test.assert_true(agree, "Orbit-scheduled engine reproduces the per-prime sweep");
+    
+    test.report();
+    test.require_all_passed();
+}
+
+void test_iwasawa_series() {
+    TestFramework test("Iwasawa power series of L_p");
+    
+    long p = 7, N = 10;
+    for (long k : {1L, 3L, 5L}) {
+        DirichletCharacter chi(p, p, {k});
+        auto series = IwasawaSeries::get(chi, N);
+        std::string label = " (χ = ω^" + std::to_string(k) + ")";
+        test.assert_equal(series->has_pole(), k == p - 2, "Pole exactly for χω trivial" + label);
+        test.assert_equal(series->evaluate(0L), LFunctions::kubota_leopoldt(0, chi, N),
+                          "G(0) = L_p(0, χ)" + label);
+        
+        // s = 1 - n far past the interpolation nodes, against B_{n,χ} directly
+        long n = 1 + (p - 1) * 40;
+        long W = N + 5;
+        std::vector<Qp> scaled = BernoulliNumbers::bernoulli_polynomial_scaled(n, p, p, W);
+        Qp B(p, W, 0);
+        for (long a = 1; a < p; ++a) {
+            B.addmul(Qp(chi.evaluate(a, W)), scaled[a]);
+        }
+        Qp direct = (-(B / Qp(p, W, p)) / Qp(p, W, n)).with_precision(N);
+        Qp value = series->evaluate(1 - n);
+        test.assert_equal(value, direct.with_precision(value.get_precision()),
+                          "L_p(1-n) = -B_{n,χ}/n beyond the nodes" + label);
+        
+        IwasawaSeries finer(chi, N + 5);
+        bool stable = true;
+        for (size_t m = 0; m < series->coefficients().size(); ++m) {
+            stable = stable && finer.coefficients()[m].with_precision(N) == series->coefficients()[m];
+        }
+        test.assert_true(stable, "Coefficients agree with a more precise build" + label);
+    }
+    
+    // Against exact rationals: ω^{(q-1)/2} is the Legendre symbol, so the
+    // series takes the values -B_{n,(·/q)}/n at s = 1 - n, n ≡ 1 (mod q-1)
+    bool exact_ok = true;
+    for (long q : {7L, 11L}) {
+        std::vector<long> legendre(static_cast<size_t>(q), 0);
+        for (long a = 1; a < q; ++a) legendre[(a * a) % q] = 1;
+        for (long a = 1; a < q; ++a) legendre[a] = legendre[a] == 1 ? 1 : -1;
+        IwasawaSeries legendre_series(DirichletCharacter(q, q, {(q - 1) / 2}), N);
+        for (long n = 1; n <= 1 + 2 * (q - 1); n += q - 1) {
+            auto B = exact_generalized_bernoulli(n, q, legendre);
+            Qp expected = -(Qp(q, N + 5, B.first) / Qp(q, N + 5, B.second)) / Qp(q, N + 5, n);
+            Qp value = legendre_series.evaluate(1 - n);
+            exact_ok = exact_ok && value == expected.with_precision(value.get_precision());
+        }
+    }
+    test.assert_true(exact_ok, "L_p(1-n) = -B_{n,χ}/n against exact rational B_{n,χ} (p = 7, 11)");
+    
+    // f'(s) against a difference quotient with step p^2
+    IwasawaSeries series(DirichletCharacter(p, p, {1}), N);
+    Zp s(p, N, 2), h(p, N, p * p);
+    Qp quotient = (series.evaluate(s + h) - series.evaluate(s)) / Qp(h);
+    Qp slope = series.derivative(s, 1);
+    test.assert_true((quotient - slope).is_zero() || (quotient - slope).valuation() >= 2,
+                     "derivative(s, 1) matches the difference quotient");
+    
+    // derivative(0) is the limit of difference quotients of the exact values
+    // at s = -(p-1)p^m, to O(p^{m+1}); kubota_leopoldt_derivative(0, χ) is
+    // the Reid-Li log Γ_p sum, a different element of pZ_p
+    for (long k : {1L, 3L}) {
+        DirichletCharacter chi(p, p, {k});
+        std::string label = " (χ = ω^" + std::to_string(k) + ")";
+        Qp slope_at_zero = IwasawaSeries::get(chi, N)->derivative(0L, 1);
+        long W = N + 10;
+        Qp at_zero = LFunctions::kubota_leopoldt(0, chi, W);
+        bool converges = true;
+        for (long m : {2L, 3L}) {
+            long n = 1 + (p - 1) * BigInt(p).pow(m).to_long();
+            std::vector<Qp> scaled = BernoulliNumbers::bernoulli_polynomial_scaled(n, p, p, W);
+            Qp B(p, W, 0);
+            for (long a = 1; a < p; ++a) {
+                B.addmul(Qp(chi.evaluate(a, W)), scaled[a]);
+            }
+            Qp value = -(B / Qp(p, W, p)) / Qp(p, W, n);
+            Qp diff = (value - at_zero) / Qp(p, W, 1 - n) - slope_at_zero;
+            converges = converges && (diff.is_zero() || diff.valuation() >= m + 1);
+        }
+        test.assert_true(converges, "derivative(0) is the limit of exact difference quotients" + label);
+        
+        Qp reid_li = LFunctions::kubota_leopoldt_derivative(0, chi, N);
+        test.assert_true(reid_li == ReidLi::phi_odd(chi, N), "kubota_leopoldt_derivative(0) is Σ χ(a) log Γ_p(a)" + label);
+        test.assert_true(reid_li.valuation() >= 1 && slope_at_zero.valuation() >= 1,
+                         "Both derivatives lie in pZ_p" + label);
+    }
+    Qp omega_slope = IwasawaSeries::get(DirichletCharacter(p, p, {1}), N)->derivative(0L, 1);
+    test.assert_true(!(omega_slope == LFunctions::kubota_leopoldt_derivative(0, DirichletCharacter(p, p, {1}), N)
+                           .with_precision(omega_slope.get_precision())),
+                     "The two derivatives at 0 differ beyond mod p (p = 7, χ = ω)");
+    
+    bool threw = false;
+    try {
+        IwasawaSeries(DirichletCharacter(p, p, {0}), N);
+    } catch (const std::invalid_argument&) { threw = true; }
+    test.assert_true(threw, "Principal character rejected");
+    
+    test.report();
+    test.require_all_passed();
+}
+
 int main() {
     std::cout << "========== MATHEMATICAL VALIDATIONS ==========" << "\n\n";
 
     test_log_1_plus_ap_identity();
     test_Lp_special_values();
     test_Lp_positive_s_throws();
+    test_iwasawa_series();
     test_lp_derivative_small_primes();
     test_gamma_n_ge_p();
     test_composite_modulus_characters();
     test_characters_properties();
+    test_character_value_table();
+    test_character_index();
+    test_character_range();
+    test_galois_orbits();
+    test_cyclotomic_character_values();
+    test_gauss_jacobi_sums();
+    test_bernoulli_range();
+    test_bernoulli_polynomial_batch();
     test_reid_li_criterion();
+    test_reid_li_engine();
+    test_reid_li_sweep();
+    test_async_calls();
+    test_batch_entry_points();
+    test_result_store();
+    test_precision_reuse_caches();
 
     std::cout << "\n========== ALL VALIDATION TESTS PASSED ==========" << "\n";
     std::cout << "Core mathematical identities validated for small primes." << "\n";
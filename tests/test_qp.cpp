@@ -1,4 +1,9 @@
 #include "libadic/qp.h"
+#include "libadic/cyclotomic.h"
+#include "libadic/lazy_padic.h"
+#include "libadic/qp_expr.h"
+#include "libadic/reid_li.h"
+#include "libadic/serialization.h"
 #include "libadic/test_framework.h"
 #include <vector>
 
@@ -326,6 +331,372 @@ void test_special_identities() {
     test.require_all_passed();
 }
 
+void test_in_place_arithmetic() {
+    TestFramework test("Qp In-place and Fused Arithmetic");
+    
+    long p = 7;
+    long N = 12;
+    
+    // Alignment keeps every digit of the higher-valuation operand
+    BigInt big_unit = BigInt(3) * BigInt(p).pow(N - 2) + BigInt(1);
+    Qp a(p, N, BigInt(p) * big_unit);
+    Qp one(p, N, 1);
+    test.assert_true(a + one == Qp(p, N, BigInt(p) * big_unit + BigInt(1)),
+                    "Sum keeps the top digit of p*u");
+    test.assert_true(one - a == Qp(p, N, BigInt(1) - BigInt(p) * big_unit),
+                    "Difference keeps the top digit of p*u");
+    
+    std::vector<long> values = {1, 2, 7, 49, -3, 350, 1000, -2401};
+    for (long x : values) {
+        for (long y : values) {
+            Qp qx(p, N, x), qy(p, N, y);
+            
+            Qp s = qx; s += qy;
+            test.assert_true(s == Qp(p, N, x + y), "In-place += matches integer sum");
+            Qp d = qx; d -= qy;
+            test.assert_true(d == Qp(p, N, x - y), "In-place -= matches integer difference");
+            Qp m = qx; m *= qy;
+            test.assert_true(m == Qp(p, N, x * y), "In-place *= matches integer product");
+            
+            Qp acc(p, N, 5);
+            acc.addmul(qx, qy);
+            test.assert_true(acc == Qp(p, N, 5 + x * y), "addmul matches 5 + x*y");
+            acc.submul(qx, qy);
+            test.assert_true(acc == Qp(p, N, 5), "submul undoes addmul");
+        }
+    }
+    
+    // Aliased operands
+    Qp b(p, N, 14);
+    b += b;
+    test.assert_true(b == Qp(p, N, 28), "x += x");
+    b.addmul(b, Qp(p, N, 2));
+    test.assert_true(b == Qp(p, N, 84), "x.addmul(x, 2)");
+    b -= b;
+    test.assert_true(b.is_zero(), "x -= x is zero");
+    
+    // Accumulation with fractions and mixed precision
+    Qp sum(p, N, 0);
+    for (long k = 1; k <= 20; ++k) {
+        sum.addmul(Qp::from_rational(1, k, p, N), Qp(p, N, k));
+    }
+    test.assert_true(sum == Qp(p, N, 20), "Sum of (1/k)*k over 20 terms");
+    
+    Qp low(p, 5, 3);
+    Qp high(p, N, 4);
+    high += low;
+    test.assert_equal(high.get_precision(), 5L, "Mixed-precision += takes the lower precision");
+    test.assert_true(high == Qp(p, 5, 7), "Mixed-precision += value");
+    
+    test.report();
+    test.require_all_passed();
+}
+
+void test_packed_cyclotomic() {
+    TestFramework test("Packed Cyclotomic Arithmetic");
+    
+    for (long p : {2L, 3L, 5L, 7L, 13L}) {
+        long N = 12;
+        std::string tag = " for p=" + std::to_string(p);
+        
+        // Coefficients with mixed and negative valuations
+        std::vector<Qp> ca, cb;
+        for (long i = 0; i < p - 1; ++i) {
+            ca.push_back(Qp::from_rational(3 * i + 1, i % 3 == 2 ? p : 1, p, N));
+            cb.push_back(Qp(p, N, (i * i + 2) * (i % 2 == 0 ? p : 1)));
+        }
+        Cyclotomic a(p, N, ca), b(p, N, cb);
+        
+        // Schoolbook product reduced with ζ^p = 1, ζ^{p-1} = -(1 + ... + ζ^{p-2})
+        std::vector<Qp> d(p, Qp(p, N, 0));
+        for (long i = 0; i < p - 1; ++i) {
+            for (long j = 0; j < p - 1; ++j) {
+                d[(i + j) % p] += ca[i] * cb[j];
+            }
+        }
+        std::vector<Qp> expected;
+        for (long i = 0; i < p - 1; ++i) {
+            expected.push_back(d[i] - d[p - 1]);
+        }
+        
+        Cyclotomic product = a * b;
+        bool product_ok = true;
+        for (long i = 0; i < p - 1; ++i) {
+            product_ok = product_ok && product.get_coeff(i) == expected[i];
+        }
+        test.assert_true(product_ok, "a*b matches reduced schoolbook product" + tag);
+        
+        PackedCyclotomic pa(a), pb(b);
+        test.assert_true(pa.to_cyclotomic() == a, "Pack/unpack round trip" + tag);
+        test.assert_true((pa + pb).to_cyclotomic() == a + b, "Packed addition" + tag);
+        test.assert_true((pa - pb).to_cyclotomic() == a - b, "Packed subtraction" + tag);
+        test.assert_true(pa * pa == PackedCyclotomic(a * a), "Packed squaring" + tag);
+        
+        PackedCyclotomic acc(p, N);
+        acc.addmul(pa, pb);
+        acc.addmul(pb, Qp(p, N, 5));
+        test.assert_true(acc == pa * pb + pb * Qp(p, N, 5), "addmul" + tag);
+        
+        PackedCyclotomic z = PackedCyclotomic::monomial(p, N, 1);
+        PackedCyclotomic z_power(p, N, Qp(p, N, 1));
+        bool monomials_ok = true;
+        for (long k = 1; k <= 2 * p; ++k) {
+            z_power *= z;
+            monomials_ok = monomials_ok && z_power == PackedCyclotomic::monomial(p, N, k);
+        }
+        test.assert_true(monomials_ok, "ζ^k by repeated product equals monomial(k)" + tag);
+        test.assert_true(PackedCyclotomic::monomial(p, N, p) == PackedCyclotomic(p, N, Qp(p, N, 1)),
+                         "ζ^p = 1" + tag);
+    }
+    
+    test.report();
+    test.require_all_passed();
+}
+
+void test_lazy_qp() {
+    TestFramework test("LazyQp");
+    
+    long p = 7;
+    
+    // (xy + x)/y = 2/3 + 2/147 = 100/147 at any requested precision
+    LazyQp x = LazyQp::from_rational(2, 3, p);
+    LazyQp y = LazyQp::from_integer(p, 49);
+    LazyQp z = (x * y + x) / y;
+    for (long N : {5L, 20L, 60L}) {
+        test.assert_true(z.approximate(N) == Qp::from_rational(100, 147, p, N),
+                        "(xy + x)/y = 100/147 at N=" + std::to_string(N));
+        test.assert_equal(z.approximate(N).get_precision(), N, "Requested precision is delivered");
+    }
+    test.assert_equal((y - LazyQp::from_integer(p, 0)).valuation(40), 2L, "Valuation found by doubling");
+    test.assert_equal(LazyQp(p).valuation(40), 40L, "Zero vanishes to the search limit");
+    
+    // Shared subexpressions are evaluated once per precision increase
+    long calls = 0;
+    LazyQp f = LazyQp::from_function(p, [&calls, p](long N) {
+        ++calls;
+        return Qp::from_rational(1, 5, p, N);
+    });
+    LazyQp g = f * f + f;
+    g.approximate(30);
+    test.assert_equal(calls, 1L, "f is evaluated once for f*f + f");
+    g.approximate(10);
+    test.assert_equal(calls, 1L, "Lower precision is a truncation of the memo");
+    test.assert_true(g.approximate(50) == Qp::from_rational(6, 25, p, 50), "f*f + f = 6/25 at N=50");
+    test.assert_equal(calls, 2L, "Higher precision reruns the leaf once");
+    test.assert_equal(g.known_precision(), 50L, "Memo records the highest precision");
+    
+    // Routines that lose digits are asked for more
+    LazyQp lossy = LazyQp::from_function(p, [p](long N) {
+        return Qp::from_rational(1, 3, p, N).with_precision(std::max(1L, N - 2));
+    });
+    test.assert_equal(lossy.approximate(20).get_precision(), 20L, "Shortfall is made up by a larger request");
+    
+    // Reid-Li with on-demand precision agrees with the fixed-precision check
+    bool agree = true;
+    for (const auto& chi : DirichletCharacter::enumerate_primitive_characters(p, p)) {
+        if (chi.is_principal()) continue;
+        ReidLiResult fixed = ReidLi::verify(chi, 20);
+        ReidLiResult lazy = ReidLi::verify_lazy(chi, 20);
+        agree = agree && lazy.error.empty() && lazy.matches == fixed.matches &&
+                (!fixed.matches || lazy.precision == 20);
+    }
+    test.assert_true(agree, "ReidLi::verify_lazy matches ReidLi::verify");
+    
+    test.report();
+    test.require_all_passed();
+}
+
+void test_binary_serialization() {
+    TestFramework test("Binary serialization");
+    
+    long p = 7, N = 120;
+    Zp a = Zp::from_rational(-5, 3, p, N);
+    Qp b = Qp::from_rational(100, 49 * 3, p, N);
+    Qp zero(p, 30, 0);
+    Cyclotomic c(p, 20, std::vector<Qp>{Qp(p, 20, 3), Qp::from_rational(1, 7, p, 20), Qp(p, 20, 0),
+                                         Qp(p, 20, -1), Qp(p, 20, 5), Qp(p, 20, 2)});
+    DirichletCharacter chi = DirichletCharacter::enumerate_characters(11, 11)[7];
+    
+    std::ostringstream stream;
+    BinaryWriter writer(stream);
+    writer.write(a);
+    writer.write(b);
+    writer.write(zero);
+    writer.write(c);
+    writer.write(chi);
+    std::string bytes = stream.str();
+    test.assert_equal(writer.bytes_written(), bytes.size(), "Writer counts its bytes");
+    test.assert_true(BinaryWriter::to_bytes(b).size() < b.get_unit().get_value().to_string().size(),
+                     "Wire form is shorter than the decimal string");
+    
+    BinaryReader reader(bytes);
+    test.assert_true(reader.peek_tag() == WireTag::Zp, "Tag peeked without consuming");
+    ZpView view = reader.read_zp_view();
+    BigInt limbs_value;
+    view.value_into(limbs_value);
+    test.assert_true(view.prime == p && view.precision == N && limbs_value == a.get_value(),
+                     "Zp view reads header and limbs in place");
+    test.assert_equal(view.limb(0), static_cast<uint64_t>(mpz_getlimbn(a.get_value().get_mpz(), 0)),
+                      "View exposes the low limb");
+    Qp b2 = reader.read_qp();
+    test.assert_true(b2 == b && b2.valuation() == -2 && b2.get_precision() == b.get_precision(),
+                     "Qp with negative valuation round-trips");
+    test.assert_true(reader.read_qp().is_zero(), "Zero round-trips");
+    test.assert_true(reader.read_cyclotomic() == c, "Cyclotomic round-trips");
+    DirichletCharacter chi2 = reader.read_character();
+    test.assert_true(chi2.values() == chi.values() && chi2.get_conductor() == chi.get_conductor(),
+                     "Character round-trips");
+    test.assert_true(reader.at_end(), "Every byte consumed");
+    
+    bool threw = false;
+    try {
+        BinaryReader truncated(bytes.data(), 5);
+        truncated.read_zp();
+    } catch (const std::runtime_error&) { threw = true; }
+    test.assert_true(threw, "Truncated input rejected");
+    
+    // Crafted headers: huge prime with no coefficients, wrong count, bad conductor
+    auto rejected = [](const std::string& wire, bool character) {
+        try {
+            BinaryReader crafted(wire);
+            if (character) {
+                (void)crafted.read_character();
+            } else {
+                (void)crafted.read_cyclotomic();
+            }
+        } catch (const std::runtime_error&) { return true; }
+        return false;
+    };
+    auto cyclotomic_header = [](long q, uint64_t count) {
+        std::ostringstream out;
+        BinaryWriter w(out);
+        w.write_u8(static_cast<uint8_t>(WireTag::Cyclotomic));
+        w.write_varint(q);
+        w.write_varint(10);
+        w.write_uvarint(count);
+        return out.str();
+    };
+    test.assert_true(rejected(cyclotomic_header(4000000007L, 0), false), "Cyclotomic with a huge prime rejected");
+    test.assert_true(rejected(cyclotomic_header(7, 2), false), "Cyclotomic with count != p-1 rejected");
+    test.assert_true(rejected(cyclotomic_header(9, 8), false), "Cyclotomic with composite p rejected");
+    test.assert_true(rejected(cyclotomic_header(1000003, 1000002), false), "Cyclotomic count beyond the input rejected");
+    std::string chi_bytes = BinaryWriter::to_bytes(chi);
+    std::ostringstream forged;
+    BinaryWriter fw(forged);
+    fw.write_u8(static_cast<uint8_t>(WireTag::Character));
+    fw.write_varint(chi.get_modulus());
+    fw.write_varint(chi.get_prime());
+    fw.write_varint(chi.get_conductor() == 1 ? chi.get_modulus() : 1);
+    BinaryReader original(chi_bytes);
+    original.read_u8();
+    for (int i = 0; i < 3; ++i) original.read_varint();
+    fw.write_bytes(chi_bytes.data() + original.position(), chi_bytes.size() - original.position());
+    test.assert_true(rejected(forged.str(), true), "Character with a forged conductor rejected");
+    
+    test.report();
+    test.require_all_passed();
+}
+
+void test_split_valuation() {
+    TestFramework test("Single-pass valuation split");
+    
+    BigInt p(7);
+    BigInt unit(123456790);  // 7 ∤ unit
+    bool all_match = true;
+    for (unsigned long v = 0; v <= 300; v += 13) {
+        BigInt n = unit * p.pow(v);
+        ValuationSplit split = split_valuation(n, p);
+        all_match = all_match && split.valuation == static_cast<long>(v) && split.unit == unit &&
+                    p_adic_valuation(n, p) == static_cast<long>(v);
+        ValuationSplit negative = split_valuation(-n, p);
+        all_match = all_match && negative.valuation == static_cast<long>(v) && negative.unit == -unit;
+    }
+    test.assert_true(all_match, "v and unit of ±u·7^v for v up to 300");
+    ValuationSplit zero = split_valuation(BigInt(0), p);
+    test.assert_true(zero.valuation == -1 && zero.unit.is_zero(), "Zero has valuation -1 and unit 0");
+    ValuationSplit two = split_valuation(BigInt(96), BigInt(2));
+    test.assert_true(two.valuation == 5 && two.unit == BigInt(3), "p = 2");
+    
+    long N = 20;
+    Qp a(7, N, unit * p.pow(4));
+    test.assert_true(a.valuation() == 4 && a.get_unit().get_value() == unit % p.pow(N - 4) &&
+                     a.get_unit().get_precision() == N - 4,
+                     "Qp(p, N, BigInt) splits the value");
+    Zp z(7, N, unit * p.pow(3));
+    Qp from_z(z);
+    test.assert_true(z.valuation() == 3 && z.unit_part().get_value() == unit % p.pow(N - 3) &&
+                     from_z == a / Qp(7, N, 7),
+                     "Zp::valuation, Zp::unit_part and Qp(Zp) agree");
+    Qp r = Qp::from_rational(-7 * 7 * 5, 7 * 3, 7, N);
+    test.assert_true(r.valuation() == 1 && r * Qp(7, N, 3) == Qp(7, N, -7 * 5),
+                     "from_rational splits numerator and denominator");
+    
+    test.report();
+    test.require_all_passed();
+}
+
+void test_deferred_arithmetic() {
+    TestFramework test("Deferred Qp expressions and Cyclotomic FMA");
+    
+    long p = 7, N = 12;
+    Qp a(p, N, 12345), b(p, N - 2, 49 * 3), c = Qp::from_rational(2, 9, p, N), d(p, N, -16);
+    Qp zero(p, N, 0);
+    
+    test.assert_true(Qp(defer(a) * b + defer(c) * d - a) == a * b + c * d - a,
+                     "Sum of products matches eager evaluation");
+    Qp chained = defer(a) * b * c * d;
+    test.assert_true(chained == a * b * c * d, "Product chain matches");
+    test.assert_equal(chained.get_precision(), (a * b * c * d).get_precision(), "Same absolute precision");
+    test.assert_true(Qp(-(defer(a) * c)) == -(a * c), "Negated product matches");
+    
+    // Cancellation: the sum's valuation is found once at the end
+    Qp cancel = defer(a) * b - a * b + defer(b) * Qp(p, N, 7);
+    test.assert_true(cancel == b * Qp(p, N, 7), "Cancelling terms normalise the valuation");
+    test.assert_true(Qp(defer(a) * zero + b) == b.with_precision(N - 2), "Zero operands drop out");
+    test.assert_true(Qp(defer(a) - a).is_zero(), "Exact cancellation gives zero");
+    
+    // A nested sum divisible by p keeps its factor of p through the outer step
+    Qp one5(5, 10, 1), two5(5, 10, 2), three5(5, 10, 3), zero5(5, 10, 0);
+    Qp nested_product = defer(one5) * (defer(two5) + three5);
+    test.assert_true(nested_product == one5 * (two5 + three5) && nested_product.valuation() == 1,
+                     "Product with a nested sum divisible by p normalises");
+    Qp nested_sum = defer(zero5) + (defer(two5) + three5);
+    test.assert_true(nested_sum == two5 + three5 && nested_sum.valuation() == 1,
+                     "Sum onto zero of a nested sum divisible by p normalises");
+    
+    bool threw = false;
+    try {
+        Qp mixed = defer(a) + Qp(5, N, 1);
+        (void)mixed;
+    } catch (const std::invalid_argument&) { threw = true; }
+    test.assert_true(threw, "Mixed primes rejected");
+    
+    bool fma_agrees = true;
+    for (long q : {5L, 7L, 11L, 29L}) {
+        std::vector<Qp> ca, cb, cc;
+        for (long i = 0; i < q - 1; ++i) {
+            ca.push_back(Qp(q, 10, 3 * i + 1));
+            cb.push_back(Qp::from_rational(i + 2, q * (i + 1), q, 10));
+            cc.push_back(Qp(q, 10, i * i));
+        }
+        Cyclotomic x(q, 10, ca), y(q, 10, cb), acc(q, 10, cc);
+        Cyclotomic expected = acc + x * y;
+        acc.addmul(x, y);
+        fma_agrees = fma_agrees && acc == expected;
+        Cyclotomic self = x;
+        self.addmul(self, y);
+        fma_agrees = fma_agrees && self == x + x * y;
+        Cyclotomic scaled = x;
+        Qp scalar = Qp::from_rational(3, q, q, 10);
+        scaled.addmul(y, scalar);
+        fma_agrees = fma_agrees && scaled == x + y * scalar;
+    }
+    test.assert_true(fma_agrees, "Cyclotomic addmul matches x + a * b on both paths");
+    
+    test.report();
+    test.require_all_passed();
+}
+
 int main() {
     std::cout << "========== EXHAUSTIVE Qp VALIDATION ==========\n\n";
     
@@ -339,6 +710,12 @@ int main() {
     test_field_completeness();
     test_negative_valuation();
     test_special_identities();
+    test_in_place_arithmetic();
+    test_packed_cyclotomic();
+    test_lazy_qp();
+    test_binary_serialization();
+    test_split_valuation();
+    test_deferred_arithmetic();
     
     std::cout << "\n========== ALL Qp TESTS PASSED ==========\n";
     std::cout << "The Qp class is mathematically sound and ready for p-adic analysis.\n";